@@ -166,7 +166,7 @@ double BrainSurfaceEvolver::NormalIntensityWeightFunction(const pmp::vec3& vPos,
 	const auto iz0 = static_cast<int>(std::floor((vShiftedByNormal[2] - fieldOrigin[2]) / cellSize));
 	if (ix0 < 0 || iy0 < 0 || iz0 < 0 || ix0 >= Nx || iy0 >= Ny || iz0 >= Nz)
 		return 0.0; // Leave if indices are out of bounds.
-	const unsigned int gridPos0 = Nx * Ny * iz0 + Nx * iy0 + ix0;
+	const size_t gridPos0 = Nx * Ny * iz0 + Nx * iy0 + ix0;
 	const double im0 = fieldValues[gridPos0];
 
 	if (im0 < Imin) Imin = im0;
@@ -185,7 +185,7 @@ double BrainSurfaceEvolver::NormalIntensityWeightFunction(const pmp::vec3& vPos,
 	const auto iz1 = iz0 - (d1 - 1) * iNormalStepZ;
 	if (ix1 < 0 || iy1 < 0 || iz1 < 0 || ix1 >= Nx || iy1 >= Ny || iz1 >= Nz)
 		return 0.0; // Leave if indices are out of bounds.
-	const unsigned int gridPos1 = Nx * Ny * iz1 + Nx * iy1 + ix1;
+	const size_t gridPos1 = Nx * Ny * iz1 + Nx * iy1 + ix1;
 	const double im1 = fieldValues[gridPos1];
 
 	if (im1 < Imin) Imin = im1;
@@ -204,7 +204,7 @@ double BrainSurfaceEvolver::NormalIntensityWeightFunction(const pmp::vec3& vPos,
 		if (ix < 0 || iy < 0 || iz < 0 || ix >= Nx || iy >= Ny || iz >= Nz)
 			break; // Break out of the loop if indices are out of bounds.
 
-		const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
+		const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
 		if (gridPos >= gridExtent)
 			continue;
 		const double im = fieldValues[gridPos];
@@ -320,7 +320,7 @@ void BrainSurfaceEvolver::Evolve()
 
 	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
 	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
+	CSRSparseMatrix sysMat(NVertices, NVertices);
 	Eigen::MatrixXd sysRhs(NVertices, 3);
 	auto vIntensity = m_EvolvingSurface->vertex_property<pmp::Scalar>("v:normalIntensity", 0.0f);
 	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
@@ -333,7 +333,8 @@ void BrainSurfaceEvolver::Evolve()
 	{
 		const float meanInterVertexDistance = ComputeMeanInterVertexDistance(*m_EvolvingSurface);
 
-		for (const auto v : m_EvolvingSurface->vertices())
+		// rows are assembled concurrently, so the row function only reads the mesh and its properties.
+		const auto getVertexSystemRow = [&](const pmp::Vertex& v)
 		{
 			const auto vPosToUpdate = m_EvolvingSurface->position(v);
 
@@ -342,9 +343,7 @@ void BrainSurfaceEvolver::Evolve()
 			{
 				// freeze boundary/feature vertices
 				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
+				return ImplicitSystemRow{ vertexRhs, 0.0, true };
 			}
 			
 			const auto vNormal = vNormalsProp[v]; // vertex unit normal
@@ -354,16 +353,11 @@ void BrainSurfaceEvolver::Evolve()
 			const double etaCtrlWeight = BET_NORMAL_INTENSITY_FACTOR * meanInterVertexDistance * vIntensity[v];
 
 			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal /* + tStep * tanRedistWeight * vTanVelocity */;
-			sysRhs.row(v.idx()) = vertexRhs;
 
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
+			return ImplicitSystemRow{ vertexRhs, tStep * epsilonCtrlWeight, false };
+		};
 
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
-		}
+		AssembleImplicitLaplacianSystem(*m_EvolvingSurface, (m_EvolSettings.LaplacianType == BE_MeshLaplacian::Barycentric ? MeshLaplacian::Barycentric : MeshLaplacian::Voronoi), getVertexSystemRow, sysMat, sysRhs, m_EvolSettings.NThreads);
 	};
 	// -----------------------------------------------------------------
 
@@ -411,7 +405,7 @@ void BrainSurfaceEvolver::Evolve()
 		std::cout << "Solving linear system ... ";
 #endif
 		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
+		Eigen::BiCGSTAB<CSRSparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
 		Eigen::MatrixXd x = solver.solve(sysRhs);
 		if (solver.info() != Eigen::Success)
 		{
@@ -472,7 +466,9 @@ void BrainSurfaceEvolver::Evolve()
 				minEdgeLength, maxEdgeLength, 2.0f * minEdgeLength,
 				m_EvolSettings.TopoParams.NRemeshingIters,
 				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
+				m_EvolSettings.TopoParams.UseBackProjection,
+				m_EvolSettings.NThreads,
+				m_EvolSettings.TopoParams.UseParallelCandidateEvaluation });
 			//remeshing.uniform_remeshing(targetEdgeLength);
 #if REPORT_EVOL_STEPS
 			std::cout << "done\n";
@@ -506,7 +502,7 @@ void BrainSurfaceEvolver::Evolve()
 		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
 		{
 			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
+			sysMat = CSRSparseMatrix(NVertices, NVertices);
 			sysRhs = Eigen::MatrixXd(NVertices, 3);
 		}
 
@@ -70,6 +70,7 @@ struct BE_MeshTopologySettings
 
 	double MinDihedralAngle{ 0.9 * M_PI_2 * 180.0 }; //>! critical dihedral angle for feature detection
 	double MaxDihedralAngle{ 1.9 * M_PI_2 * 180.0 }; //>! critical dihedral angle for feature detection
+	bool UseParallelCandidateEvaluation{ false }; //>! if true, pmp::Remeshing evaluates edge split, collapse, and flip candidates in parallel; the chosen splits, collapses, and flips are applied serially.
 };
 
 /// \brief An enumerator for the choice of mesh Laplacian scheme [Meyer, Desbrun, Schroder, Barr, 2003].
@@ -111,6 +112,7 @@ struct BrainExtractionSettings
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+	unsigned int NThreads{ 1 }; //>! the number of worker threads for assembling the linear system and for remeshing in each time step. NThreads == 0 uses all hardware threads.
 };
 
 /**
@@ -429,8 +429,8 @@ Geometry::ScalarGrid ImportVTI(const std::string& fileName)
 	// >>>>>>> load values <<<<<<<<<<<<<<<<
 	LoadTokenLine(line, fileIStream, "<DataArray");
 	auto& resultValues = result.Values();
-	const unsigned int gridExtent = (Nx - 1) * (Ny - 1) * (Nz - 1);
-	unsigned int gridPos = 0;
+	const size_t gridExtent = (Nx - 1) * (Ny - 1) * (Nz - 1);
+	size_t gridPos = 0;
 	std::string token;
 	while (token != "</DataArray>" && !fileIStream.eof())
 	{
@@ -41,6 +41,7 @@ struct ConvexHullSurfaceEvolutionSettings
 	bool IdentityForBoundaryVertices{ true }; //>! if true, boundary vertices give rise to: updated vertex = previous vertex.
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+	unsigned int NThreads{ 1 }; //>! the number of worker threads for assembling the linear system and for remeshing in each time step. NThreads == 0 uses all hardware threads.
 };
 
 class ConvexHullEvolver
@@ -1,7 +1,20 @@
 #include "EvolverUtilsCommon.h"
 
 #include "pmp/SurfaceMesh.h"
+#include "pmp/algorithms/Curvature.h"
+#include "pmp/algorithms/DifferentialGeometry.h"
+#include "pmp/algorithms/Features.h"
+#include "pmp/algorithms/Normals.h"
 #include "geometry/IcoSphereBuilder.h"
+#include "geometry/MeshAnalysis.h"
+#include "utils/ParallelUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
 
 CoVolumeStats AnalyzeMeshCoVolumes(pmp::SurfaceMesh& mesh, const AreaFunction& areaFunction)
 {
@@ -24,6 +37,204 @@ CoVolumeStats AnalyzeMeshCoVolumes(pmp::SurfaceMesh& mesh, const AreaFunction& a
 	return stats;
 }
 
+CoVolumeStats AnalyzeMeshAfterTimeStep(pmp::SurfaceMesh& mesh, const AreaFunction& areaFunction, const PostStepAnalysisSettings& settings)
+{
+	// triangle metrics are evaluated once per face, and averaged for vertices in the vertex pass.
+	std::vector<std::string> metricNames{};
+	std::vector<Geometry::FaceMetricFunction> faceMetrics{};
+	for (const auto& metricName : settings.TriMetrics)
+	{
+		if (!Geometry::IsMetricRegistered(metricName))
+			continue;
+
+		metricNames.push_back(metricName);
+		faceMetrics.push_back(Geometry::IdentifyFaceMetricFunction(metricName));
+	}
+	if (!faceMetrics.empty() && !mesh.is_triangle_mesh())
+	{
+		for (const auto& metricName : metricNames)
+			std::cerr << "AnalyzeMeshAfterTimeStep: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
+		metricNames.clear();
+		faceMetrics.clear();
+	}
+
+	// the curvature tensor needs dihedral angles of the two-ring neighborhood, so it is evaluated by pmp::Curvature before the vertex pass.
+	std::optional<pmp::Curvature> curvAlg{};
+	if (settings.ComputeCurvatures)
+	{
+		curvAlg.emplace(mesh);
+		curvAlg->analyze_tensor(1);
+	}
+
+	// all properties are added before the passes, so that the threads only write values.
+	pmp::VertexProperty<pmp::Scalar> vCoVols{};
+	std::vector<double> coVolMeasures{}; // the stats are evaluated from double precision measures.
+	if (settings.ComputeCoVolumes)
+	{
+		vCoVols = mesh.vertex_property<pmp::Scalar>(coVolMeasureVertexPropertyName);
+		coVolMeasures.resize(mesh.vertices_size(), 0.0);
+	}
+	pmp::EdgeProperty<pmp::Scalar> eDihedralAngle{};
+	pmp::VertexProperty<pmp::Scalar> vDihedralAngle{};
+	if (settings.ComputeDihedralAngles)
+	{
+		eDihedralAngle = mesh.edge_property<pmp::Scalar>("e:dihedralAngle", 2.0f * M_PI);
+		vDihedralAngle = mesh.vertex_property<pmp::Scalar>("v:dihedralAngle", 2.0f * M_PI);
+	}
+	pmp::VertexProperty<pmp::Scalar> vMinCurvature{}, vMaxCurvature{}, vMeanCurvature{}, vGaussianCurvature{}, vIsCDSVal{};
+	if (settings.ComputeCurvatures)
+	{
+		vMinCurvature = mesh.vertex_property<pmp::Scalar>("v:minCurvature");
+		vMaxCurvature = mesh.vertex_property<pmp::Scalar>("v:maxCurvature");
+		vMeanCurvature = mesh.vertex_property<pmp::Scalar>("v:meanCurvature");
+		vGaussianCurvature = mesh.vertex_property<pmp::Scalar>("v:GaussianCurvature");
+		vIsCDSVal = mesh.vertex_property<pmp::Scalar>("v:isCDS", -1.0f);
+	}
+	std::vector<pmp::VertexProperty<pmp::Scalar>> vMetrics{};
+	for (const auto& metricName : metricNames)
+		vMetrics.push_back(mesh.vertex_property<pmp::Scalar>("v:" + metricName, 0.0f));
+
+	// ....... face pass: normals & triangle metric values ..........
+	const size_t nFaces = mesh.faces_size();
+	std::vector<pmp::Normal> faceNormals(settings.ComputeDihedralAngles ? nFaces : 0);
+	std::vector<std::vector<float>> faceMetricValues(faceMetrics.size(), std::vector<float>(nFaces, 0.0f));
+	if (settings.ComputeDihedralAngles || !faceMetrics.empty())
+	{
+		Utils::ParallelForChunks(0, nFaces, settings.NThreads, [&](const size_t chunkStart, const size_t chunkEnd, const unsigned int /* threadId */)
+		{
+			for (size_t i = chunkStart; i < chunkEnd; ++i)
+			{
+				const pmp::Face f(static_cast<pmp::IndexType>(i));
+				if (mesh.is_deleted(f))
+					continue;
+
+				if (settings.ComputeDihedralAngles)
+					faceNormals[i] = pmp::Normals::compute_face_normal(mesh, f);
+				for (size_t k = 0; k < faceMetrics.size(); ++k)
+					faceMetricValues[k][i] = faceMetrics[k](mesh, f);
+			}
+		});
+	}
+
+	// ....... edge pass: dihedral angles ...........................
+	if (settings.ComputeDihedralAngles)
+	{
+		Utils::ParallelForChunks(0, mesh.edges_size(), settings.NThreads, [&](const size_t chunkStart, const size_t chunkEnd, const unsigned int /* threadId */)
+		{
+			for (size_t i = chunkStart; i < chunkEnd; ++i)
+			{
+				const pmp::Edge e(static_cast<pmp::IndexType>(i));
+				if (mesh.is_deleted(e) || mesh.is_boundary(e))
+					continue;
+
+				const auto& n0 = faceNormals[mesh.face(mesh.halfedge(e, 0)).idx()];
+				const auto& n1 = faceNormals[mesh.face(mesh.halfedge(e, 1)).idx()];
+				eDihedralAngle[e] = angle(n0, n1) + M_PI_2;
+			}
+		});
+	}
+
+	// ....... vertex pass ...........................................
+	// a metric fails at its first invalid vertex value. As in Geometry::ComputeInterpolatedTrianglesMetric, only the values
+	// of the vertices preceding it are written, so the vertex values are buffered and written serially after the pass.
+	const unsigned int nThreads = Utils::GetWorkerThreadCount(settings.NThreads);
+	constexpr size_t noInvalidVertex = std::numeric_limits<size_t>::max();
+	std::vector<std::vector<size_t>> firstInvalidVertex(nThreads, std::vector<size_t>(faceMetrics.size(), noInvalidVertex));
+	std::vector<std::vector<float>> vertexMetricValues(faceMetrics.size(), std::vector<float>(mesh.vertices_size(), 0.0f));
+	Utils::ParallelForChunks(0, mesh.vertices_size(), settings.NThreads, [&](const size_t chunkStart, const size_t chunkEnd, const unsigned int threadId)
+	{
+		for (size_t i = chunkStart; i < chunkEnd; ++i)
+		{
+			const pmp::Vertex v(static_cast<pmp::IndexType>(i));
+			if (mesh.is_deleted(v))
+				continue;
+
+			if (settings.ComputeCoVolumes)
+			{
+				coVolMeasures[i] = areaFunction(mesh, v);
+				vCoVols[v] = static_cast<pmp::Scalar>(coVolMeasures[i]);
+			}
+
+			if (settings.ComputeDihedralAngles && !mesh.is_boundary(v))
+			{
+				pmp::Scalar dihedralAngleSum = 0.0f;
+				for (const auto h : mesh.halfedges(v))
+					dihedralAngleSum += eDihedralAngle[mesh.edge(h)];
+				const auto valence = mesh.valence(v);
+				if (valence > 0)
+					vDihedralAngle[v] = dihedralAngleSum / static_cast<pmp::Scalar>(valence);
+			}
+
+			if (settings.ComputeCurvatures)
+			{
+				vMinCurvature[v] = curvAlg->min_curvature(v);
+				vMaxCurvature[v] = curvAlg->max_curvature(v);
+				vMeanCurvature[v] = vMinCurvature[v] + vMaxCurvature[v];
+				vGaussianCurvature[v] = vMinCurvature[v] * vMaxCurvature[v];
+				vIsCDSVal[v] = pmp::IsConvexDominantSaddle(vMinCurvature[v], vMaxCurvature[v], settings.PrincipalCurvatureFactor) ? 1.0f : -1.0f;
+			}
+
+			for (size_t k = 0; k < faceMetrics.size(); ++k)
+			{
+				float mean = 0.0f;
+				size_t nAdjacentFaces = 0;
+				bool isValid = true;
+				for (const auto f : mesh.faces(v))
+				{
+					nAdjacentFaces++;
+					const auto val = faceMetricValues[k][f.idx()];
+					if (val < 0.0f)
+					{
+						isValid = false; // invalid triangle
+						break;
+					}
+					if (std::fabs(val) > Geometry::METRIC_MAX_VAL)
+						continue; // skipping triangle
+					mean += val;
+				}
+				if (!isValid || mean < FLT_EPSILON)
+				{
+					firstInvalidVertex[threadId][k] = std::min(firstInvalidVertex[threadId][k], i);
+					continue;
+				}
+				vertexMetricValues[k][i] = mean / static_cast<float>(nAdjacentFaces);
+			}
+		}
+	});
+
+	for (size_t k = 0; k < faceMetrics.size(); ++k)
+	{
+		size_t firstInvalid = noInvalidVertex;
+		for (const auto& threadFirstInvalid : firstInvalidVertex)
+			firstInvalid = std::min(firstInvalid, threadFirstInvalid[k]);
+
+		for (const auto v : mesh.vertices())
+		{
+			if (v.idx() >= firstInvalid)
+				break;
+			vMetrics[k][v] = vertexMetricValues[k][v.idx()];
+		}
+
+		if (firstInvalid != noInvalidVertex)
+			std::cerr << "AnalyzeMeshAfterTimeStep: [WARNING] Computation of metric " << metricNames[k] << " finished with errors!\n";
+	}
+
+	// the stats are reduced serially in vertex order, so that they do not depend on the number of threads.
+	CoVolumeStats stats{};
+	if (!settings.ComputeCoVolumes)
+		return stats;
+
+	for (const auto v : mesh.vertices())
+	{
+		const double measure = coVolMeasures[v.idx()];
+		if (stats.Max < measure) stats.Max = measure;
+		if (stats.Min > measure) stats.Min = measure;
+		stats.Mean += measure;
+	}
+	stats.Mean /= static_cast<double>(mesh.n_vertices());
+	return stats;
+}
+
 /// \brief The power of the stabilizing scale factor.
 constexpr float SCALE_FACTOR_POWER = 1.0f / 2.0f;
 /// \brief the reciprocal value of how many times the surface area element shrinks during evolution.
@@ -108,6 +319,22 @@ bool IsRemeshingNecessary(const std::vector<float>& equilateralJacobianCondition
 		     (maxVal > JACOBIAN_COND_MIN && maxVal < JACOBIAN_COND_MAX));
 }
 
+std::vector<pmp::Vertex> CollectVerticesForRemeshing(const pmp::SurfaceMesh& mesh)
+{
+	const auto vQualityProp = mesh.get_vertex_property<float>("v:equilateralJacobianCondition");
+	if (!vQualityProp)
+		throw std::invalid_argument("CollectVerticesForRemeshing: mesh has no \"v:equilateralJacobianCondition\" property!\n");
+
+	std::vector<pmp::Vertex> result;
+	for (const auto v : mesh.vertices())
+	{
+		const auto& val = vQualityProp[v];
+		if (!(val > JACOBIAN_COND_MIN && val < JACOBIAN_COND_MAX))
+			result.push_back(v);
+	}
+	return result;
+}
+
 bool IsNonFeatureRemeshingNecessary(const pmp::SurfaceMesh& mesh)
 {
 	float minVal = FLT_MAX;
@@ -164,3 +391,638 @@ void AdjustRemeshingLengths(const float& decayFactor, float& minEdgeLength, floa
 	maxEdgeLength *= decayFactor;
 	approxError = 0.1f * (minEdgeLength + maxEdgeLength);
 }
+
+/// \brief CSR entries of a contiguous range of system rows assembled by a single worker thread.
+struct ImplicitSystemRowsBuffer
+{
+	size_t FirstRow{ 0 }; //>! index of the first assembled row.
+	std::vector<CSRSparseMatrix::StorageIndex> Columns{}; //>! column indices of the assembled rows.
+	std::vector<double> Values{}; //>! values of the assembled rows.
+};
+
+/**
+ * \brief Assembles the general or the symmetric form of the semi-implicit system of an evolution step into CSR storage.
+ * \param mesh           evolving surface mesh without garbage.
+ * \param laplacian      type of mesh Laplacian.
+ * \param rowFunction    evaluator of the rhs and the Laplacian weight multiplier for each vertex row.
+ * \param symmetric      if true, rows are scaled by 2 * A_i / (tau * eps_i), and identity rows are eliminated from the other rows.
+ * \param workerRows     resulting CSR entries of the rows (one buffer per worker thread, each with a contiguous range of rows).
+ * \param rowSizes       resulting number of entries of each row (including the diagonal).
+ * \param sysRhs         resulting right-hand side.
+ * \param nThreads       the number of worker threads.
+ */
+static void AssembleImplicitLaplacianSystemRows(const pmp::SurfaceMesh& mesh, const MeshLaplacian& laplacian, const ImplicitSystemRowFunction& rowFunction,
+	const bool& symmetric, std::vector<ImplicitSystemRowsBuffer>& workerRows, std::vector<CSRSparseMatrix::StorageIndex>& rowSizes,
+	Eigen::MatrixXd& sysRhs, const unsigned int& nThreads)
+{
+	using StorageIndex = CSRSparseMatrix::StorageIndex;
+	const size_t nVertices = mesh.n_vertices();
+	const auto areaFunction = (laplacian == MeshLaplacian::Barycentric ? pmp::voronoi_area_barycentric : pmp::voronoi_area);
+	const unsigned int nWorkers = Utils::GetWorkerThreadCount(nThreads);
+
+	// the symmetric form needs the rows of all neighbors, so all rows are evaluated first
+	std::vector<ImplicitSystemRow> rows(nVertices);
+	Utils::ParallelForChunks(0, nVertices, nWorkers, [&](size_t chunkStart, size_t chunkEnd, unsigned int /* threadId */)
+	{
+		for (size_t i = chunkStart; i < chunkEnd; ++i)
+		{
+			const pmp::Vertex v(static_cast<pmp::IndexType>(i));
+			rows[i] = rowFunction(v);
+			if (mesh.is_isolated(v) || (symmetric && !(rows[i].LaplacianWeight > 0.0)))
+				rows[i].IsIdentity = true;
+		}
+	});
+
+	sysRhs.resize(static_cast<Eigen::Index>(nVertices), 3);
+	rowSizes.assign(nVertices, 0);
+
+	// each worker assembles its contiguous range of rows into its own buffer
+	workerRows.assign(nWorkers, ImplicitSystemRowsBuffer{});
+	Utils::ParallelForChunks(0, nVertices, nWorkers, [&](size_t chunkStart, size_t chunkEnd, unsigned int threadId)
+	{
+		auto& [firstRow, columns, values] = workerRows[threadId];
+		firstRow = chunkStart;
+		std::vector<std::pair<StorageIndex, pmp::Scalar>> rowWeights{}; // (column, cotan weight) pairs reused for all rows of this worker.
+
+		for (size_t i = chunkStart; i < chunkEnd; ++i)
+		{
+			const pmp::Vertex v(static_cast<pmp::IndexType>(i));
+			const auto& row = rows[i];
+			const auto rowStart = columns.size();
+			if (row.IsIdentity)
+			{
+				sysRhs.row(static_cast<Eigen::Index>(i)) = row.Rhs;
+				columns.push_back(static_cast<StorageIndex>(i));
+				values.push_back(1.0);
+				rowSizes[i] = 1;
+				continue;
+			}
+
+			// the same evaluation as pmp::laplace_implicit_voronoi (or pmp::laplace_implicit_barycentric)
+			rowWeights.clear();
+			pmp::Scalar sumWeights = 0.0f;
+			for (const auto h : mesh.halfedges(v))
+			{
+				const auto weight = static_cast<pmp::Scalar>(pmp::cotan_weight(mesh, mesh.edge(h)));
+				sumWeights += weight;
+				rowWeights.emplace_back(static_cast<StorageIndex>(mesh.to_vertex(h).idx()), weight);
+			}
+			rowWeights.emplace_back(static_cast<StorageIndex>(i), sumWeights); // diagonal entry
+			std::stable_sort(rowWeights.begin(), rowWeights.end(),
+				[](const auto& a, const auto& b) { return a.first < b.first; });
+
+			if (symmetric)
+			{
+				// row * 2 * A_i / (tau * eps_i) with known values of identity neighbors moved to the rhs
+				const double massWeight = 2.0 * areaFunction(mesh, v) / row.LaplacianWeight;
+				Eigen::Vector3d rhs = massWeight * row.Rhs;
+				for (const auto& [col, weight] : rowWeights)
+				{
+					const auto& colRow = rows[static_cast<size_t>(col)];
+					if (static_cast<size_t>(col) != i && colRow.IsIdentity)
+					{
+						rhs += static_cast<double>(weight) * colRow.Rhs;
+						continue;
+					}
+					const double value = (static_cast<size_t>(col) == i ? massWeight + static_cast<double>(weight) : -static_cast<double>(weight));
+					if (columns.size() > rowStart && columns.back() == col)
+					{
+						values.back() = value;
+						continue;
+					}
+					columns.push_back(col);
+					values.push_back(value);
+				}
+				sysRhs.row(static_cast<Eigen::Index>(i)) = rhs;
+				rowSizes[i] = static_cast<StorageIndex>(columns.size() - rowStart);
+				continue;
+			}
+
+			sysRhs.row(static_cast<Eigen::Index>(i)) = row.Rhs;
+			const pmp::Scalar areaNorm = 2.0f * static_cast<pmp::Scalar>(areaFunction(mesh, v));
+			for (const auto& [col, weight] : rowWeights)
+			{
+				const double value = (static_cast<size_t>(col) == i ?
+					1.0 + row.LaplacianWeight * static_cast<double>(weight / areaNorm) :
+					-row.LaplacianWeight * static_cast<double>(weight / areaNorm));
+				if (columns.size() > rowStart && columns.back() == col)
+				{
+					// a repeated neighbor overwrites the previous weight (as in ImplicitLaplaceInfo::vertexWeights)
+					values.back() = value;
+					continue;
+				}
+				columns.push_back(col);
+				values.push_back(value);
+			}
+			rowSizes[i] = static_cast<StorageIndex>(columns.size() - rowStart);
+		}
+	});
+}
+
+/**
+ * \brief Copies the assembled rows into a CSR matrix.
+ * \param workerRows     CSR entries of the rows assembled by the worker threads.
+ * \param rowSizes       the number of entries of each row.
+ * \param sysMat         resulting system matrix.
+ * \param nThreads       the number of worker threads.
+ */
+static void CopyImplicitSystemRowsToMatrix(const std::vector<ImplicitSystemRowsBuffer>& workerRows, const std::vector<CSRSparseMatrix::StorageIndex>& rowSizes,
+	CSRSparseMatrix& sysMat, const unsigned int& nThreads)
+{
+	using StorageIndex = CSRSparseMatrix::StorageIndex;
+	const size_t nVertices = rowSizes.size();
+
+	// row offsets
+	sysMat.resize(static_cast<Eigen::Index>(nVertices), static_cast<Eigen::Index>(nVertices));
+	StorageIndex* outerIndex = sysMat.outerIndexPtr();
+	outerIndex[0] = 0;
+	for (size_t i = 0; i < nVertices; ++i)
+		outerIndex[i + 1] = outerIndex[i] + rowSizes[i];
+	sysMat.resizeNonZeros(static_cast<Eigen::Index>(outerIndex[nVertices]));
+
+	// each worker buffer is a contiguous block of the CSR arrays
+	Utils::ParallelForChunks(0, workerRows.size(), nThreads, [&](size_t chunkStart, size_t chunkEnd, unsigned int /* threadId */)
+	{
+		for (size_t w = chunkStart; w < chunkEnd; ++w)
+		{
+			const auto& [firstRow, columns, values] = workerRows[w];
+			if (columns.empty())
+				continue;
+
+			const auto offset = static_cast<size_t>(outerIndex[firstRow]);
+			std::copy(columns.begin(), columns.end(), sysMat.innerIndexPtr() + offset);
+			std::copy(values.begin(), values.end(), sysMat.valuePtr() + offset);
+		}
+	});
+}
+
+void AssembleImplicitLaplacianSystem(const pmp::SurfaceMesh& mesh, const MeshLaplacian& laplacian, const ImplicitSystemRowFunction& rowFunction,
+	CSRSparseMatrix& sysMat, Eigen::MatrixXd& sysRhs, const unsigned int& nThreads)
+{
+	std::vector<ImplicitSystemRowsBuffer> workerRows;
+	std::vector<CSRSparseMatrix::StorageIndex> rowSizes;
+	AssembleImplicitLaplacianSystemRows(mesh, laplacian, rowFunction, false, workerRows, rowSizes, sysRhs, nThreads);
+	CopyImplicitSystemRowsToMatrix(workerRows, rowSizes, sysMat, nThreads);
+}
+
+void AssembleSymmetricImplicitLaplacianSystem(const pmp::SurfaceMesh& mesh, const MeshLaplacian& laplacian, const ImplicitSystemRowFunction& rowFunction,
+	CSRSparseMatrix& sysMat, Eigen::MatrixXd& sysRhs, const unsigned int& nThreads)
+{
+	std::vector<ImplicitSystemRowsBuffer> workerRows;
+	std::vector<CSRSparseMatrix::StorageIndex> rowSizes;
+	AssembleImplicitLaplacianSystemRows(mesh, laplacian, rowFunction, true, workerRows, rowSizes, sysRhs, nThreads);
+	CopyImplicitSystemRowsToMatrix(workerRows, rowSizes, sysMat, nThreads);
+}
+
+void AssembleImplicitLaplacianStencil(const pmp::SurfaceMesh& mesh, const MeshLaplacian& laplacian, const ImplicitSystemRowFunction& rowFunction,
+	ImplicitSystemStencil& stencil, Eigen::MatrixXd& sysRhs, const unsigned int& nThreads)
+{
+	std::vector<ImplicitSystemRowsBuffer> workerRows;
+	std::vector<CSRSparseMatrix::StorageIndex> rowSizes;
+	AssembleImplicitLaplacianSystemRows(mesh, laplacian, rowFunction, false, workerRows, rowSizes, sysRhs, nThreads);
+
+	// neighbor offsets (each row has exactly one diagonal entry)
+	const size_t nVertices = rowSizes.size();
+	auto& [rowOffsets, neighbors, weights, diagonal] = stencil;
+	rowOffsets.resize(nVertices + 1);
+	rowOffsets[0] = 0;
+	for (size_t i = 0; i < nVertices; ++i)
+		rowOffsets[i + 1] = rowOffsets[i] + rowSizes[i] - 1;
+	neighbors.resize(static_cast<size_t>(rowOffsets[nVertices]));
+	weights.resize(static_cast<size_t>(rowOffsets[nVertices]));
+	diagonal.resize(nVertices);
+
+	// split the rows of each worker buffer into the diagonal and the neighbor entries
+	Utils::ParallelForChunks(0, workerRows.size(), nThreads, [&](size_t chunkStart, size_t chunkEnd, unsigned int /* threadId */)
+	{
+		for (size_t w = chunkStart; w < chunkEnd; ++w)
+		{
+			const auto& [firstRow, columns, values] = workerRows[w];
+			size_t entryId = 0;
+			for (size_t i = firstRow; entryId < columns.size(); ++i)
+			{
+				auto neighborId = static_cast<size_t>(rowOffsets[i]);
+				for (CSRSparseMatrix::StorageIndex k = 0; k < rowSizes[i]; ++k, ++entryId)
+				{
+					if (static_cast<size_t>(columns[entryId]) == i)
+					{
+						diagonal[i] = values[entryId];
+						continue;
+					}
+					neighbors[neighborId] = columns[entryId];
+					weights[neighborId] = values[entryId];
+					++neighborId;
+				}
+			}
+		}
+	});
+}
+
+/**
+ * \brief Copies a system stencil into a CSR matrix.
+ * \param stencil        system stencil (the neighbors of each row are sorted).
+ * \param sysMat         resulting system matrix.
+ * \param nThreads       the number of worker threads.
+ */
+static void CopyImplicitSystemStencilToMatrix(const ImplicitSystemStencil& stencil, CSRSparseMatrix& sysMat, const unsigned int& nThreads)
+{
+	using StorageIndex = CSRSparseMatrix::StorageIndex;
+	const auto& [rowOffsets, neighbors, weights, diagonal] = stencil;
+	const size_t nRows = diagonal.size();
+
+	// each row has its neighbor entries and one diagonal entry
+	sysMat.resize(static_cast<Eigen::Index>(nRows), static_cast<Eigen::Index>(nRows));
+	StorageIndex* outerIndex = sysMat.outerIndexPtr();
+	for (size_t i = 0; i <= nRows; ++i)
+		outerIndex[i] = rowOffsets[i] + static_cast<StorageIndex>(i);
+	sysMat.resizeNonZeros(static_cast<Eigen::Index>(outerIndex[nRows]));
+
+	Utils::ParallelForChunks(0, nRows, nThreads, [&](size_t chunkStart, size_t chunkEnd, unsigned int /* threadId */)
+	{
+		for (size_t i = chunkStart; i < chunkEnd; ++i)
+		{
+			auto entryId = static_cast<size_t>(outerIndex[i]);
+			bool isDiagonalCopied = false;
+			for (auto k = rowOffsets[i]; k < rowOffsets[i + 1]; ++k, ++entryId)
+			{
+				if (!isDiagonalCopied && static_cast<size_t>(neighbors[k]) > i)
+				{
+					sysMat.innerIndexPtr()[entryId] = static_cast<StorageIndex>(i);
+					sysMat.valuePtr()[entryId] = diagonal[i];
+					isDiagonalCopied = true;
+					++entryId;
+				}
+				sysMat.innerIndexPtr()[entryId] = neighbors[k];
+				sysMat.valuePtr()[entryId] = weights[k];
+			}
+			if (!isDiagonalCopied)
+			{
+				sysMat.innerIndexPtr()[entryId] = static_cast<StorageIndex>(i);
+				sysMat.valuePtr()[entryId] = diagonal[i];
+			}
+		}
+	});
+}
+
+bool IsSymmetricSolverType(const ImplicitSystemSolverType& type)
+{
+	return type == ImplicitSystemSolverType::CG_IncompleteCholesky || type == ImplicitSystemSolverType::SimplicialLDLT;
+}
+
+bool IsMatrixFreeSolverType(const ImplicitSystemSolverType& type)
+{
+	return type == ImplicitSystemSolverType::MatrixFreeJacobi || type == ImplicitSystemSolverType::MatrixFreeChebyshev;
+}
+
+/// \brief relative residual tolerance of the block conjugate gradient solver.
+constexpr double BLOCK_CG_TOLERANCE = 1e-12;
+
+ImplicitSystemSolver::ImplicitSystemSolver(const ImplicitSystemSolverType& type, const unsigned int& preconditionerRefreshStride,
+	const unsigned int& nMatrixFreeIterations, const unsigned int& nThreads)
+	: m_Type(type), m_PreconditionerRefreshStride(preconditionerRefreshStride), m_NMatrixFreeIterations(nMatrixFreeIterations), m_NThreads(nThreads)
+{
+}
+
+void ImplicitSystemSolver::Compute(const CSRSparseMatrix& sysMat, const unsigned int& ti)
+{
+	if (IsMatrixFreeSolverType(m_Type))
+		throw std::invalid_argument("ImplicitSystemSolver::Compute: a matrix-free solver type requires a system stencil!\n");
+
+	m_SysMat = &sysMat;
+	const bool refreshStep = (m_PreconditionerRefreshStride > 0 && ti % m_PreconditionerRefreshStride == 0);
+
+	if (m_Type == ImplicitSystemSolverType::BiCGSTAB_ILUT)
+	{
+		ComputeBiCGSTAB(sysMat, refreshStep);
+		return;
+	}
+
+	if (m_Type == ImplicitSystemSolverType::CG_IncompleteCholesky)
+	{
+		if (refreshStep)
+			m_IncompleteCholesky.RequestRefresh();
+		m_IncompleteCholesky.compute(sysMat);
+		m_WasRefactorized = m_IncompleteCholesky.WasRefreshed();
+		m_Info = m_IncompleteCholesky.info();
+		return;
+	}
+
+	// A symmetric CSR matrix has the same arrays as its CSC form.
+	const Eigen::Map<const Eigen::SparseMatrix<double>> cscSysMat(sysMat.rows(), sysMat.cols(), sysMat.nonZeros(),
+		sysMat.outerIndexPtr(), sysMat.innerIndexPtr(), sysMat.valuePtr());
+	m_WasRefactorized = m_LDLTPattern.Update(cscSysMat);
+	if (m_WasRefactorized)
+		m_LDLT.analyzePattern(cscSysMat);
+	m_LDLT.factorize(cscSysMat);
+	m_Info = m_LDLT.info();
+}
+
+void ImplicitSystemSolver::Compute(const ImplicitSystemStencil& stencil, const unsigned int& ti)
+{
+	if (!IsMatrixFreeSolverType(m_Type))
+		throw std::invalid_argument("ImplicitSystemSolver::Compute: a system stencil requires a matrix-free solver type!\n");
+
+	m_Stencil = &stencil;
+	m_SysMat = nullptr;
+	m_WasRefactorized = false;
+	m_UsedFallback = false;
+
+	// Gershgorin bound of the spectrum of D^-1 A around 1
+	const size_t nRows = stencil.Diagonal.size();
+	double maxRatio = 0.0;
+	for (size_t i = 0; i < nRows; ++i)
+	{
+		double offDiagonalSum = 0.0;
+		for (auto k = stencil.RowOffsets[i]; k < stencil.RowOffsets[i + 1]; ++k)
+			offDiagonalSum += std::abs(stencil.Weights[k]);
+		maxRatio = std::max(maxRatio, offDiagonalSum / std::abs(stencil.Diagonal[i]));
+	}
+	m_StencilOffDiagonalRatio = maxRatio;
+	if (maxRatio < 1.0)
+	{
+		m_Info = Eigen::Success;
+		return;
+	}
+
+	// Jacobi iterations would diverge (e.g.: negative cotan weights of obtuse triangles), so this step is solved by BiCGSTAB with ILUT.
+	m_UsedFallback = true;
+	if (!m_HasWarnedFallback)
+	{
+		std::cerr << "ImplicitSystemSolver::Compute: [WARNING] The system stencil is not strictly diagonally dominant (max off-diagonal ratio: "
+			<< maxRatio << ") for time step id: " << ti << ". Falling back to BiCGSTAB_ILUT (further fallbacks of this solver are not reported).\n";
+		m_HasWarnedFallback = true;
+	}
+	CopyImplicitSystemStencilToMatrix(stencil, m_FallbackSysMat, m_NThreads);
+	m_SysMat = &m_FallbackSysMat;
+	const bool refreshStep = (m_PreconditionerRefreshStride > 0 && ti % m_PreconditionerRefreshStride == 0);
+	ComputeBiCGSTAB(m_FallbackSysMat, refreshStep);
+}
+
+void ImplicitSystemSolver::ComputeBiCGSTAB(const CSRSparseMatrix& sysMat, const bool& refreshPreconditioner)
+{
+	if (refreshPreconditioner)
+		m_BiCGSTAB.preconditioner().RequestRefresh();
+	m_BiCGSTAB.compute(sysMat);
+	m_WasRefactorized = m_BiCGSTAB.preconditioner().WasRefreshed();
+	m_Info = m_BiCGSTAB.info();
+}
+
+Eigen::MatrixXd ImplicitSystemSolver::Solve(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& xGuess)
+{
+	if (IsMatrixFreeSolverType(m_Type))
+	{
+		if (!m_Stencil)
+			throw std::logic_error("ImplicitSystemSolver::Solve: Compute was not called!\n");
+		if (!m_SysMat)
+			return SolveMatrixFree(sysRhs, xGuess);
+		// otherwise the stencil was copied into m_FallbackSysMat for BiCGSTAB
+	}
+
+	if (!m_SysMat)
+		throw std::logic_error("ImplicitSystemSolver::Solve: Compute was not called!\n");
+
+	if (m_Type == ImplicitSystemSolverType::SimplicialLDLT)
+	{
+		m_Iterations = 0;
+		Eigen::MatrixXd x = m_LDLT.solve(sysRhs);
+		m_Info = m_LDLT.info();
+		return x;
+	}
+
+	const auto solveIterative = [&]()
+	{
+		if (m_Type == ImplicitSystemSolverType::CG_IncompleteCholesky)
+			return SolveBlockCG(sysRhs, xGuess);
+
+		Eigen::MatrixXd x = m_BiCGSTAB.solveWithGuess(sysRhs, xGuess);
+		m_Iterations = m_BiCGSTAB.iterations();
+		m_Info = m_BiCGSTAB.info();
+		return x;
+	};
+
+	Eigen::MatrixXd x = solveIterative();
+	if (m_Info == Eigen::Success || m_WasRefactorized)
+		return x;
+
+	// the preconditioner from an earlier time step is not good enough
+	if (m_Type == ImplicitSystemSolverType::CG_IncompleteCholesky)
+	{
+		m_IncompleteCholesky.RequestRefresh();
+		Compute(*m_SysMat, 0);
+	}
+	else
+	{
+		ComputeBiCGSTAB(*m_SysMat, true);
+	}
+	if (m_Info != Eigen::Success)
+		return x;
+	return solveIterative();
+}
+
+Eigen::MatrixXd ImplicitSystemSolver::SolveBlockCG(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& xGuess)
+{
+	const auto& A = *m_SysMat;
+	const Eigen::Index nCols = sysRhs.cols();
+	const Eigen::Index maxIters = 2 * A.rows();
+
+	Eigen::MatrixXd x = xGuess;
+	Eigen::MatrixXd r = sysRhs - A * x;
+	const Eigen::VectorXd rhsNorms2 = sysRhs.colwise().squaredNorm().transpose();
+	const Eigen::VectorXd thresholds = (BLOCK_CG_TOLERANCE * BLOCK_CG_TOLERANCE * rhsNorms2).cwiseMax((std::numeric_limits<double>::min)());
+
+	Eigen::MatrixXd z = m_IncompleteCholesky.solve(r);
+	Eigen::MatrixXd p = z;
+	Eigen::VectorXd rz = r.cwiseProduct(z).colwise().sum().transpose();
+	Eigen::MatrixXd ap(A.rows(), nCols);
+
+	m_Iterations = 0;
+	m_Info = Eigen::NoConvergence;
+	while (m_Iterations < maxIters)
+	{
+		const Eigen::VectorXd residualNorms2 = r.colwise().squaredNorm().transpose();
+		if ((residualNorms2.array() < thresholds.array()).all())
+		{
+			m_Info = Eigen::Success;
+			break;
+		}
+
+		// one matrix product for all columns, converged columns are not updated
+		ap.noalias() = A * p;
+		const Eigen::VectorXd pap = p.cwiseProduct(ap).colwise().sum().transpose();
+		Eigen::VectorXd alpha(nCols);
+		for (Eigen::Index c = 0; c < nCols; ++c)
+			alpha[c] = (residualNorms2[c] < thresholds[c] || pap[c] == 0.0 ? 0.0 : rz[c] / pap[c]);
+		x.noalias() += p * alpha.asDiagonal();
+		r.noalias() -= ap * alpha.asDiagonal();
+
+		z = m_IncompleteCholesky.solve(r);
+		const Eigen::VectorXd rzNew = r.cwiseProduct(z).colwise().sum().transpose();
+		Eigen::VectorXd beta(nCols);
+		for (Eigen::Index c = 0; c < nCols; ++c)
+			beta[c] = (rz[c] == 0.0 ? 0.0 : rzNew[c] / rz[c]);
+		p = z + p * beta.asDiagonal();
+		rz = rzNew;
+		++m_Iterations;
+	}
+	return x;
+}
+
+double ImplicitSystemSolver::ApplyJacobiStencil(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& x, Eigen::MatrixXd& z, const bool& computeResidualNorm) const
+{
+	const auto& [rowOffsets, neighbors, weights, diagonal] = *m_Stencil;
+	const unsigned int nWorkers = Utils::GetWorkerThreadCount(m_NThreads);
+	std::vector<double> workerResidualNorms2(nWorkers, 0.0);
+
+	// the columns of x are contiguous, so the neighbor gathers of the three coordinates share the loaded stencil entries
+	const double* x0 = x.col(0).data();
+	const double* x1 = x.col(1).data();
+	const double* x2 = x.col(2).data();
+	Utils::ParallelForChunks(0, diagonal.size(), nWorkers, [&](size_t chunkStart, size_t chunkEnd, unsigned int threadId)
+	{
+		double residualNorm2 = 0.0;
+		for (size_t i = chunkStart; i < chunkEnd; ++i)
+		{
+			const auto row = static_cast<Eigen::Index>(i);
+			double r0 = sysRhs(row, 0) - diagonal[i] * x0[i];
+			double r1 = sysRhs(row, 1) - diagonal[i] * x1[i];
+			double r2 = sysRhs(row, 2) - diagonal[i] * x2[i];
+			for (auto k = rowOffsets[i]; k < rowOffsets[i + 1]; ++k)
+			{
+				const auto j = neighbors[k];
+				r0 -= weights[k] * x0[j];
+				r1 -= weights[k] * x1[j];
+				r2 -= weights[k] * x2[j];
+			}
+			const double invDiagonal = 1.0 / diagonal[i];
+			z(row, 0) = invDiagonal * r0;
+			z(row, 1) = invDiagonal * r1;
+			z(row, 2) = invDiagonal * r2;
+			if (computeResidualNorm)
+				residualNorm2 += r0 * r0 + r1 * r1 + r2 * r2;
+		}
+		workerResidualNorms2[threadId] = residualNorm2;
+	});
+
+	double residualNorm2 = 0.0;
+	for (const auto& workerNorm2 : workerResidualNorms2)
+		residualNorm2 += workerNorm2;
+	return residualNorm2;
+}
+
+Eigen::MatrixXd ImplicitSystemSolver::SolveMatrixFree(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& xGuess)
+{
+	if (sysRhs.cols() != 3 || xGuess.rows() != sysRhs.rows() || xGuess.cols() != 3 || static_cast<size_t>(sysRhs.rows()) != m_Stencil->Diagonal.size())
+		throw std::invalid_argument("ImplicitSystemSolver::SolveMatrixFree: sysRhs and xGuess must be NVertices x 3 matrices!\n");
+
+	Eigen::MatrixXd x = xGuess;
+	Eigen::MatrixXd z(x.rows(), 3);
+	m_Iterations = 0;
+	if (m_Info != Eigen::Success)
+		return x;
+
+	// Chebyshev acceleration of the Jacobi iteration for the spectrum of D^-1 A within [1 - delta, 1 + delta] [Saad, Iterative Methods for Sparse Linear Systems, Alg. 12.1]
+	const double delta = m_StencilOffDiagonalRatio;
+	const bool useChebyshev = (m_Type == ImplicitSystemSolverType::MatrixFreeChebyshev && delta > 0.0);
+	const double sigma = (useChebyshev ? 1.0 / delta : 0.0);
+	double rho = (useChebyshev ? delta : 0.0);
+	Eigen::MatrixXd d;
+
+	for (unsigned int k = 0; k < m_NMatrixFreeIterations; ++k)
+	{
+		ApplyJacobiStencil(sysRhs, x, z, false);
+		if (!useChebyshev)
+		{
+			x += z;
+			continue;
+		}
+
+		if (k == 0)
+		{
+			d = z;
+		}
+		else
+		{
+			const double rhoNew = 1.0 / (2.0 * sigma - rho);
+			d = (rhoNew * rho) * d + (2.0 * rhoNew / delta) * z;
+			rho = rhoNew;
+		}
+		x += d;
+	}
+	m_Iterations = static_cast<Eigen::Index>(m_NMatrixFreeIterations);
+
+	const double residualNorm2 = ApplyJacobiStencil(sysRhs, x, z, true);
+	const double rhsNorm2 = sysRhs.squaredNorm();
+	m_Error = (rhsNorm2 > 0.0 ? std::sqrt(residualNorm2 / rhsNorm2) : std::sqrt(residualNorm2));
+	m_Info = (std::isfinite(m_Error) ? Eigen::Success : Eigen::NumericalIssue);
+	return x;
+}
+
+// ================================================================================================
+
+double ComputeMaxDisplacementRatio(const pmp::SurfaceMesh& mesh, const Eigen::MatrixXd& x, const double& isoLevel, const unsigned int& nThreads)
+{
+	if (static_cast<size_t>(x.rows()) != mesh.n_vertices())
+		throw std::invalid_argument("ComputeMaxDisplacementRatio: x.rows() != mesh.n_vertices()!\n");
+	const auto vDistance = mesh.get_vertex_property<pmp::Scalar>("v:distance");
+	const auto vCoVols = mesh.get_vertex_property<pmp::Scalar>(coVolMeasureVertexPropertyName);
+	if (!vDistance || !vCoVols)
+		throw std::invalid_argument("ComputeMaxDisplacementRatio: missing vertex property \"v:distance\" or " + coVolMeasureVertexPropertyName + "!\n");
+
+	std::vector<double> threadMaxRatios(Utils::GetWorkerThreadCount(nThreads), 0.0);
+	Utils::ParallelForChunks(0, mesh.n_vertices(), nThreads, [&](const size_t chunkStart, const size_t chunkEnd, const unsigned int threadId)
+	{
+		double& maxRatio = threadMaxRatios[threadId];
+		for (size_t i = chunkStart; i < chunkEnd; ++i)
+		{
+			const pmp::Vertex v(static_cast<pmp::IndexType>(i));
+			const double lengthScale = std::fabs(static_cast<double>(vDistance[v]) - isoLevel) + std::sqrt(std::max(static_cast<double>(vCoVols[v]), 0.0));
+			if (lengthScale < FLT_EPSILON)
+				continue; // degenerate co-volume on the iso-level
+
+			const Eigen::Vector3d displacement = x.row(static_cast<Eigen::Index>(i)).transpose() - Eigen::Vector3d(mesh.position(v));
+			maxRatio = std::max(maxRatio, displacement.norm() / lengthScale);
+		}
+	});
+	return *std::ranges::max_element(threadMaxRatios);
+}
+
+/// \brief the fraction of the target displacement ratio aimed at by the proposed time step.
+constexpr double TIME_STEP_SAFETY_FACTOR = 0.9;
+
+AdaptiveTimeStepController::AdaptiveTimeStepController(const double& initialTimeStep, const AdaptiveTimeStepSettings& settings)
+	: m_Settings(settings), m_TimeStep(initialTimeStep),
+	m_MinTimeStep(settings.MinTimeStepFactor * initialTimeStep), m_MaxTimeStep(settings.MaxTimeStepFactor * initialTimeStep)
+{
+	if (initialTimeStep <= 0.0)
+		throw std::invalid_argument("AdaptiveTimeStepController::AdaptiveTimeStepController: initialTimeStep <= 0!\n");
+	if (settings.TargetDisplacementRatio <= 0.0 || settings.RejectionDisplacementRatio < settings.TargetDisplacementRatio)
+		throw std::invalid_argument("AdaptiveTimeStepController::AdaptiveTimeStepController: settings.RejectionDisplacementRatio < settings.TargetDisplacementRatio or settings.TargetDisplacementRatio <= 0!\n");
+	if (settings.MinTimeStepFactor <= 0.0 || settings.MinTimeStepFactor > 1.0 || settings.MaxTimeStepFactor < 1.0 || settings.MaxGrowthFactor < 1.0)
+		throw std::invalid_argument("AdaptiveTimeStepController::AdaptiveTimeStepController: settings.MinTimeStepFactor not in (0, 1], or settings.MaxTimeStepFactor < 1, or settings.MaxGrowthFactor < 1!\n");
+}
+
+bool AdaptiveTimeStepController::Update(const double& displacementRatio)
+{
+	const bool isAccepted = displacementRatio <= m_Settings.RejectionDisplacementRatio ||
+		m_TimeStep <= m_MinTimeStep || m_NStepRepetitions >= m_Settings.MaxRejectedSteps;
+
+	// the displacement of a step is proportional to the time step.
+	const double factor = (displacementRatio > 0.0 ? TIME_STEP_SAFETY_FACTOR * m_Settings.TargetDisplacementRatio / displacementRatio : m_Settings.MaxGrowthFactor);
+	m_TimeStep = std::clamp(m_TimeStep * std::min(factor, m_Settings.MaxGrowthFactor), m_MinTimeStep, m_MaxTimeStep);
+
+	if (isAccepted)
+	{
+		m_NStepRepetitions = 0;
+		return true;
+	}
+	m_NStepRepetitions++;
+	m_NRejectedSteps++;
+	return false;
+}
+
+void AdaptiveTimeStepController::Scale(const double& factor)
+{
+	m_TimeStep *= factor;
+	m_MinTimeStep *= factor;
+	m_MaxTimeStep *= factor;
+}
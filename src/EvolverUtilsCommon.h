@@ -4,8 +4,10 @@
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <algorithm>
 #include <functional>
 #include <unordered_set>
+#include <vector>
 
 namespace pmp
 {
@@ -127,8 +129,55 @@ struct MeshTopologySettings
 	float PrincipalCurvatureFactor{ 2.0f }; //>! vertices with |Kmax| > \p principalCurvatureFactor * |Kmin| are marked as feature.
 	float CriticalMeanCurvatureAngle{ 1.0f * static_cast<float>(M_PI_2) }; //>! vertices with curvature angles smaller than this value are feature vertices. 
 	bool ExcludeEdgesWithoutBothFeaturePts{ false }; //>! if true, edges with only one vertex detected as feature will not be marked as feature.
+	bool UseLocalRemeshing{ false }; //>! if true, pmp::Remeshing is restricted to the neighborhoods of vertices with degraded mesh quality (see CollectVerticesForRemeshing).
+	unsigned int NLocalRemeshingRings{ 2 }; //>! the number of vertex rings around degraded vertices remeshed if UseLocalRemeshing == true.
+	bool UseParallelCandidateEvaluation{ false }; //>! if true, pmp::Remeshing evaluates edge split, collapse, and flip candidates in parallel; the chosen splits, collapses, and flips are applied serially.
 };
 
+/**
+ * \brief A wrapper for parameters of the adaptive time step control (see AdaptiveTimeStepController).
+ * \struct AdaptiveTimeStepSettings
+ */
+struct AdaptiveTimeStepSettings
+{
+	bool UseAdaptiveTimeStep{ false }; //>! if true, the time step is adapted after each step. Otherwise it stays fixed.
+	double TargetDisplacementRatio{ 0.5 }; //>! the controlled max vertex displacement per step relative to (distance to the iso-level + co-volume size), see ComputeMaxDisplacementRatio.
+	double RejectionDisplacementRatio{ 1.0 }; //>! a step whose displacement ratio exceeds this value is repeated with a shorter time step.
+	double MinTimeStepFactor{ 0.1 }; //>! the time step does not decrease below this multiple of the initial time step.
+	double MaxTimeStepFactor{ 10.0 }; //>! the time step does not increase above this multiple of the initial time step.
+	double MaxGrowthFactor{ 1.5 }; //>! the maximum ratio of two consecutive time steps.
+	unsigned int MaxRejectedSteps{ 3 }; //>! the maximum number of repetitions of a single time step.
+};
+
+/**
+ * \brief A specification of the mesh properties evaluated by AnalyzeMeshAfterTimeStep.
+ * \struct PostStepAnalysisSettings
+ */
+struct PostStepAnalysisSettings
+{
+	bool ComputeCoVolumes{ true }; //>! if true, co-volume measures (coVolMeasureVertexPropertyName) and their stats are computed.
+	bool ComputeDihedralAngles{ true }; //>! if true, "e:dihedralAngle" and "v:dihedralAngle" are computed.
+	bool ComputeCurvatures{ true }; //>! if true, principal curvatures and the related vertex properties are computed.
+	float PrincipalCurvatureFactor{ 2.0f }; //>! vertices with |Kmax| > \p principalCurvatureFactor * |Kmin| are marked by "v:isCDS".
+	TriangleMetrics TriMetrics{}; //>! triangle metrics averaged for each vertex.
+	unsigned int NThreads{ 1 }; //>! the number of threads for the analysis passes. Zero means "use all hardware threads".
+};
+
+/**
+ * \brief Computes the vertex (and edge) properties of an evolving surface after a time step in three fused multithreaded passes:
+ *        over faces (normals and triangle metrics), over edges (dihedral angles), and over vertices (co-volumes, and the averaged and curvature-related values).
+ * \param mesh             input mesh.
+ * \param areaFunction     function to evaluate vertex co-volume area.
+ * \param settings         specification of the computed properties.
+ * \return co-volume stats (default-initialized if settings.ComputeCoVolumes == false).
+ *
+ * DISCLAIMER: The properties have the same values as the ones from AnalyzeMeshCoVolumes, Geometry::ComputeEdgeDihedralAngles,
+ *             Geometry::ComputeVertexCurvaturesAndRelatedProperties, and Geometry::IdentifyMetricFunction, but each triangle metric is evaluated once per face.
+ *             This includes failing metrics: their values are written only for the vertices preceding the first invalid one.
+ *             The curvature tensor itself is evaluated serially by pmp::Curvature.
+ */
+[[nodiscard]] CoVolumeStats AnalyzeMeshAfterTimeStep(pmp::SurfaceMesh& mesh, const AreaFunction& areaFunction, const PostStepAnalysisSettings& settings);
+
 /**
  * \brief Precomputes parameters for advection-diffusion model within (Iso)SurfaceEvolver.
  * \param distanceMax             maximum effective distance from target (affects diffusion term weight).
@@ -143,6 +192,9 @@ struct MeshTopologySettings
 /// \brief Evaluates whether remeshing is necessary from the condition number metric for equilateral triangles.
 [[nodiscard]] bool IsRemeshingNecessary(const std::vector<float>& equilateralJacobianConditionNumbers);
 
+/// \brief Collects the vertices whose condition number metric for equilateral triangles ("v:equilateralJacobianCondition") violates the bounds checked by IsRemeshingNecessary.
+[[nodiscard]] std::vector<pmp::Vertex> CollectVerticesForRemeshing(const pmp::SurfaceMesh& mesh);
+
 /// \brief Evaluates whether remeshing is necessary from the condition number metric for equilateral triangles that do not have a feature vertex.
 [[nodiscard]] bool IsNonFeatureRemeshingNecessary(const pmp::SurfaceMesh& mesh);
 
@@ -168,4 +220,366 @@ void SetRemeshingAdjustmentTimeIndices(const std::unordered_set<unsigned int>& v
 ///	\param maxEdgeLength    the maximum edge length to be adjusted.
 ///	\param approxError      approximation error to be adjusted.
 ///
-void AdjustRemeshingLengths(const float& decayFactor, float& minEdgeLength, float& maxEdgeLength, float& approxError);
\ No newline at end of file
+void AdjustRemeshingLengths(const float& decayFactor, float& minEdgeLength, float& maxEdgeLength, float& approxError);
+
+// ======================================================================================================================
+
+/// \brief identifier for a row-major (CSR) sparse matrix whose rows can be assembled independently.
+using CSRSparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+/**
+ * \brief A single vertex row of the semi-implicit system (I + tau * eps * L) X = rhs of an evolution step.
+ * \struct ImplicitSystemRow
+ */
+struct ImplicitSystemRow
+{
+	Eigen::Vector3d Rhs{ Eigen::Vector3d::Zero() }; //>! right-hand side of the row.
+	double LaplacianWeight{ 0.0 }; //>! multiplier tau * eps of the mesh Laplacian weights of the row.
+	bool IsIdentity{ false }; //>! if true, the row is an identity row (e.g.: a frozen boundary or feature vertex) and LaplacianWeight is ignored.
+};
+
+/// \brief an evaluator of the system row for a mesh vertex.
+using ImplicitSystemRowFunction = std::function<ImplicitSystemRow(const pmp::Vertex&)>;
+
+/**
+ * \brief Assembles the semi-implicit system (I + tau * eps * L) X = rhs of an evolution step directly into CSR storage, in parallel over vertices.
+ * \param mesh           evolving surface mesh without garbage (vertex indices form the range [0, mesh.n_vertices())).
+ * \param laplacian      type of mesh Laplacian.
+ * \param rowFunction    evaluator of the rhs and the Laplacian weight multiplier for each vertex row.
+ * \param sysMat         resulting system matrix of size mesh.n_vertices() x mesh.n_vertices().
+ * \param sysRhs         resulting right-hand side of size mesh.n_vertices() x 3.
+ * \param nThreads       the number of worker threads. Zero means "use all hardware threads".
+ *
+ * DISCLAIMER: rowFunction is called concurrently for different vertices, so it may only read shared data.
+ *             The Laplacian weights are evaluated with the same formulas as pmp::laplace_implicit_voronoi (or pmp::laplace_implicit_barycentric),
+ *             and the result does not depend on nThreads.
+ */
+void AssembleImplicitLaplacianSystem(const pmp::SurfaceMesh& mesh, const MeshLaplacian& laplacian, const ImplicitSystemRowFunction& rowFunction,
+	CSRSparseMatrix& sysMat, Eigen::MatrixXd& sysRhs, const unsigned int& nThreads = 1);
+
+/**
+ * \brief Assembles the symmetric positive definite form of the semi-implicit system of an evolution step:
+ *        each row of (I + tau * eps * L) X = rhs is multiplied by 2 * A_i / (tau * eps_i), which yields (M / (tau * eps) + L_c) X = M / (tau * eps) rhs,
+ *        where M is the diagonal matrix of doubled co-volume areas 2 * A_i and L_c is the (symmetric) cotangent stiffness matrix.
+ * \param mesh           evolving surface mesh without garbage (vertex indices form the range [0, mesh.n_vertices())).
+ * \param laplacian      type of mesh Laplacian.
+ * \param rowFunction    evaluator of the rhs and the Laplacian weight multiplier for each vertex row.
+ * \param sysMat         resulting symmetric system matrix of size mesh.n_vertices() x mesh.n_vertices() (both triangles are stored).
+ * \param sysRhs         resulting right-hand side of size mesh.n_vertices() x 3.
+ * \param nThreads       the number of worker threads. Zero means "use all hardware threads".
+ *
+ * DISCLAIMER: The solution is the same as for AssembleImplicitLaplacianSystem, up to the float division of the cotan weights in the general form. Identity rows (and rows with zero Laplacian weight)
+ *             are eliminated from the other rows by moving their known values to the right-hand side, which keeps the matrix symmetric.
+ *             The matrix is positive definite if all co-volume areas are positive.
+ */
+void AssembleSymmetricImplicitLaplacianSystem(const pmp::SurfaceMesh& mesh, const MeshLaplacian& laplacian, const ImplicitSystemRowFunction& rowFunction,
+	CSRSparseMatrix& sysMat, Eigen::MatrixXd& sysRhs, const unsigned int& nThreads = 1);
+
+/**
+ * \brief A matrix-free snapshot of the semi-implicit system (I + tau * eps * L) X = rhs of an evolution step:
+ *        the one-ring adjacency of the vertices in CSR layout with the off-diagonal coefficients, and the diagonal coefficients stored separately.
+ * \struct ImplicitSystemStencil
+ */
+struct ImplicitSystemStencil
+{
+	std::vector<CSRSparseMatrix::StorageIndex> RowOffsets{}; //>! offsets of the vertex rows in Neighbors and Weights (NVertices + 1 values).
+	std::vector<CSRSparseMatrix::StorageIndex> Neighbors{}; //>! one-ring neighbor indices of each vertex (empty for identity rows).
+	std::vector<double> Weights{}; //>! off-diagonal coefficients for Neighbors.
+	std::vector<double> Diagonal{}; //>! diagonal coefficients.
+};
+
+/**
+ * \brief Assembles the stencil of the semi-implicit system (I + tau * eps * L) X = rhs of an evolution step without an Eigen::SparseMatrix.
+ * \param mesh           evolving surface mesh without garbage (vertex indices form the range [0, mesh.n_vertices())).
+ * \param laplacian      type of mesh Laplacian.
+ * \param rowFunction    evaluator of the rhs and the Laplacian weight multiplier for each vertex row.
+ * \param stencil        resulting system stencil.
+ * \param sysRhs         resulting right-hand side of size mesh.n_vertices() x 3.
+ * \param nThreads       the number of worker threads. Zero means "use all hardware threads".
+ *
+ * DISCLAIMER: The coefficients are the same as those of AssembleImplicitLaplacianSystem.
+ */
+void AssembleImplicitLaplacianStencil(const pmp::SurfaceMesh& mesh, const MeshLaplacian& laplacian, const ImplicitSystemRowFunction& rowFunction,
+	ImplicitSystemStencil& stencil, Eigen::MatrixXd& sysRhs, const unsigned int& nThreads = 1);
+
+/**
+ * \brief A copy of the sparsity pattern of a compressed sparse matrix for detecting pattern changes between time steps.
+ */
+class SparsityPatternCache
+{
+public:
+	/**
+	 * \brief Compares the pattern of mat with the stored pattern, and stores the pattern of mat.
+	 * \param mat      compressed sparse matrix.
+	 * \return true if the pattern of mat differs from the stored one.
+	 */
+	template <typename MatType>
+	bool Update(const MatType& mat)
+	{
+		const auto outerSize = static_cast<size_t>(mat.outerSize());
+		const auto nonZeros = static_cast<size_t>(mat.nonZeros());
+		if (outerSize + 1 == m_OuterIndices.size() && nonZeros == m_InnerIndices.size() &&
+			std::equal(m_OuterIndices.begin(), m_OuterIndices.end(), mat.outerIndexPtr()) &&
+			std::equal(m_InnerIndices.begin(), m_InnerIndices.end(), mat.innerIndexPtr()))
+			return false;
+
+		m_OuterIndices.assign(mat.outerIndexPtr(), mat.outerIndexPtr() + outerSize + 1);
+		m_InnerIndices.assign(mat.innerIndexPtr(), mat.innerIndexPtr() + nonZeros);
+		return true;
+	}
+
+	/// \brief Forgets the stored pattern, so that the next Update reports a change.
+	void Clear()
+	{
+		m_OuterIndices.clear();
+		m_InnerIndices.clear();
+	}
+
+private:
+	std::vector<CSRSparseMatrix::StorageIndex> m_OuterIndices{}; //>! outer index offsets of the stored pattern.
+	std::vector<CSRSparseMatrix::StorageIndex> m_InnerIndices{}; //>! inner indices of the stored pattern.
+};
+
+
+/**
+ * \brief A preconditioner wrapper which keeps its factorization between the time steps of an evolution,
+ *        and refactorizes only if the sparsity pattern (or the size) of the system matrix changes, or if a refresh is requested.
+ * \tparam Preconditioner    wrapped Eigen preconditioner (e.g.: Eigen::IncompleteLUT<double>).
+ *
+ * DISCLAIMER: Only the preconditioner's compute call is skipped, so the iterative solver's compute(sysMat) still updates the system matrix.
+ *             A preconditioner factorized from the matrix of an earlier time step remains a valid (if less effective) approximate inverse.
+ */
+template <typename Preconditioner>
+class CachedPreconditioner : public Preconditioner
+{
+public:
+	using Preconditioner::Preconditioner;
+
+	/// \brief Forces the next compute call to refactorize the preconditioner.
+	void RequestRefresh()
+	{
+		m_Pattern.Clear();
+	}
+
+	/// \brief Returns true if the last compute call refactorized the preconditioner.
+	[[nodiscard]] bool WasRefreshed() const
+	{
+		return m_WasRefreshed;
+	}
+
+	/// \brief Refactorizes the preconditioner if it was requested, or if the pattern of mat differs from the last factorized matrix.
+	template <typename MatType>
+	CachedPreconditioner& compute(const MatType& mat)
+	{
+		m_WasRefreshed = m_Pattern.Update(mat);
+		if (m_WasRefreshed)
+			Preconditioner::compute(mat);
+		return *this;
+	}
+
+private:
+	SparsityPatternCache m_Pattern{}; //>! pattern of the last factorized matrix.
+	bool m_WasRefreshed{ false }; //>! true if the last compute call refactorized.
+};
+
+/// \brief the BiCGSTAB solver of the implicit evolution system whose ILUT preconditioner is kept between time steps.
+using CachedImplicitSystemSolver = Eigen::BiCGSTAB<CSRSparseMatrix, CachedPreconditioner<Eigen::IncompleteLUT<double>>>;
+
+/**
+ * \brief An enumerator for the formulation and the solver of the linear system of each implicit evolution step.
+ * \enum ImplicitSystemSolverType
+ */
+enum class [[nodiscard]] ImplicitSystemSolverType
+{
+	BiCGSTAB_ILUT = 0, //>! the general system from AssembleImplicitLaplacianSystem solved by BiCGSTAB with an incomplete LU preconditioner.
+	CG_IncompleteCholesky = 1, //>! the symmetric system from AssembleSymmetricImplicitLaplacianSystem solved by conjugate gradients with an incomplete Cholesky preconditioner (usually the fastest, since the three coordinate columns share each sparse product).
+	SimplicialLDLT = 2, //>! the symmetric system from AssembleSymmetricImplicitLaplacianSystem solved by a sparse LDLT factorization whose symbolic analysis is kept while the pattern does not change (the fill-in makes it slower than the iterative solvers on large meshes).
+	MatrixFreeJacobi = 3, //>! the stencil from AssembleImplicitLaplacianStencil smoothed by a fixed number of Jacobi iterations (for small time steps).
+	MatrixFreeChebyshev = 4 //>! the stencil from AssembleImplicitLaplacianStencil smoothed by a fixed number of Chebyshev-accelerated Jacobi iterations (for small time steps).
+};
+
+/// \brief Returns true if the solver type expects the symmetric system from AssembleSymmetricImplicitLaplacianSystem.
+[[nodiscard]] bool IsSymmetricSolverType(const ImplicitSystemSolverType& type);
+
+/// \brief Returns true if the solver type expects the stencil from AssembleImplicitLaplacianStencil.
+[[nodiscard]] bool IsMatrixFreeSolverType(const ImplicitSystemSolverType& type);
+
+/**
+ * \brief A solver of the linear systems of implicit evolution steps which is kept alive between time steps,
+ *        so that the preconditioners (or the symbolic factorization) can be reused while the sparsity pattern does not change.
+ */
+class ImplicitSystemSolver
+{
+public:
+	/**
+	 * \brief Constructor.
+	 * \param type                          formulation and solver of the system.
+	 * \param preconditionerRefreshStride   if > 0, the preconditioner of an iterative solver is refactorized every preconditionerRefreshStride steps.
+	 * \param nMatrixFreeIterations         the fixed number of iterations of matrix-free solvers.
+	 * \param nThreads                      the number of worker threads of matrix-free solvers. Zero means "use all hardware threads".
+	 */
+	explicit ImplicitSystemSolver(const ImplicitSystemSolverType& type = ImplicitSystemSolverType::BiCGSTAB_ILUT, const unsigned int& preconditionerRefreshStride = 3,
+		const unsigned int& nMatrixFreeIterations = 10, const unsigned int& nThreads = 1);
+
+	/**
+	 * \brief Prepares the solver for the system matrix of a time step.
+	 * \param sysMat     system matrix. It is referenced until the next Compute call, so it must stay alive.
+	 * \param ti         time step index.
+	 */
+	void Compute(const CSRSparseMatrix& sysMat, const unsigned int& ti);
+
+	/**
+	 * \brief Prepares a matrix-free solver for the system stencil of a time step.
+	 * \param stencil    system stencil. It is referenced until the next Compute call, so it must stay alive.
+	 * \param ti         time step index.
+	 *
+	 * DISCLAIMER: If the stencil is not strictly diagonally dominant, Jacobi iterations would diverge, so the stencil is copied into a CSR matrix,
+	 *             and the step is solved by BiCGSTAB with the ILUT preconditioner of ImplicitSystemSolverType::BiCGSTAB_ILUT.
+ *             A warning is printed for the first fallback of this solver, and UsedFallback() reports it for every step.
+	 */
+	void Compute(const ImplicitSystemStencil& stencil, const unsigned int& ti);
+
+	/**
+	 * \brief Solves the system for all right-hand side columns at once.
+	 * \param sysRhs     right-hand side (one column per coordinate).
+	 * \param xGuess     initial guess for iterative solvers (e.g.: the vertex positions from the previous time step).
+	 * \return the solution.
+	 *
+	 * DISCLAIMER: If an iterative solve fails with a preconditioner from an earlier time step, the preconditioner is refactorized and the solve is repeated.
+	 */
+	[[nodiscard]] Eigen::MatrixXd Solve(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& xGuess);
+
+	[[nodiscard]] const ImplicitSystemSolverType& Type() const
+	{
+		return m_Type;
+	}
+
+	/// \brief status of the last Compute or Solve call.
+	[[nodiscard]] Eigen::ComputationInfo Info() const
+	{
+		return m_Info;
+	}
+
+	/// \brief the number of iterations of the last Solve call (the maximum over rhs columns, zero for direct solvers).
+	[[nodiscard]] Eigen::Index Iterations() const
+	{
+		return m_Iterations;
+	}
+
+	/// \brief the relative residual |rhs - A x| / |rhs| of the last matrix-free Solve call.
+	[[nodiscard]] double Error() const
+	{
+		return m_Error;
+	}
+
+	/// \brief true if the last Compute or Solve call refactorized the preconditioner (or recomputed the symbolic factorization).
+	[[nodiscard]] bool WasRefactorized() const
+	{
+		return m_WasRefactorized;
+	}
+
+	/// \brief true if the last Compute call of a matrix-free solver fell back to BiCGSTAB_ILUT (the stencil was not strictly diagonally dominant).
+	[[nodiscard]] bool UsedFallback() const
+	{
+		return m_UsedFallback;
+	}
+
+private:
+	/// \brief Block preconditioned conjugate gradients for all rhs columns with a shared matrix product per iteration.
+	[[nodiscard]] Eigen::MatrixXd SolveBlockCG(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& xGuess);
+
+	/// \brief Prepares m_BiCGSTAB for the system matrix, and refactorizes its preconditioner if requested.
+	void ComputeBiCGSTAB(const CSRSparseMatrix& sysMat, const bool& refreshPreconditioner);
+
+	/// \brief A fixed number of Jacobi or Chebyshev iterations on the system stencil for all rhs columns.
+	[[nodiscard]] Eigen::MatrixXd SolveMatrixFree(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& xGuess);
+
+	/// \brief Evaluates z = D^-1 (rhs - A x) for all rhs columns, and returns |rhs - A x|^2 if requested.
+	double ApplyJacobiStencil(const Eigen::MatrixXd& sysRhs, const Eigen::MatrixXd& x, Eigen::MatrixXd& z, const bool& computeResidualNorm) const;
+
+	ImplicitSystemSolverType m_Type{ ImplicitSystemSolverType::BiCGSTAB_ILUT }; //>! formulation and solver of the system.
+	unsigned int m_PreconditionerRefreshStride{ 3 }; //>! if > 0, iterative solver preconditioners are refactorized every this many steps.
+	unsigned int m_NMatrixFreeIterations{ 10 }; //>! the fixed number of iterations of matrix-free solvers.
+	unsigned int m_NThreads{ 1 }; //>! the number of worker threads of matrix-free solvers.
+
+	const CSRSparseMatrix* m_SysMat{ nullptr }; //>! system matrix of the current time step (m_FallbackSysMat if a matrix-free step falls back to BiCGSTAB).
+	const ImplicitSystemStencil* m_Stencil{ nullptr }; //>! system stencil of the current time step.
+	CSRSparseMatrix m_FallbackSysMat{}; //>! the stencil copied into a CSR matrix if it is not strictly diagonally dominant.
+	double m_StencilOffDiagonalRatio{ 0.0 }; //>! max_i sum_j |a_ij| / |a_ii| over the off-diagonal entries of the stencil (bounds the spectrum of D^-1 A).
+	CachedImplicitSystemSolver m_BiCGSTAB{}; //>! solver for ImplicitSystemSolverType::BiCGSTAB_ILUT.
+	CachedPreconditioner<Eigen::IncompleteCholesky<double, Eigen::Lower, Eigen::NaturalOrdering<CSRSparseMatrix::StorageIndex>>> m_IncompleteCholesky{}; //>! preconditioner for ImplicitSystemSolverType::CG_IncompleteCholesky (mesh vertex order keeps neighbors close).
+	Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> m_LDLT{}; //>! factorization for ImplicitSystemSolverType::SimplicialLDLT.
+	SparsityPatternCache m_LDLTPattern{}; //>! pattern of the last symbolic LDLT analysis.
+
+	Eigen::ComputationInfo m_Info{ Eigen::Success }; //>! status of the last Compute or Solve call.
+	Eigen::Index m_Iterations{ 0 }; //>! iterations of the last Solve call.
+	double m_Error{ 0.0 }; //>! relative residual of the last matrix-free Solve call.
+	bool m_WasRefactorized{ false }; //>! true if the last call refactorized.
+	bool m_UsedFallback{ false }; //>! true if the last matrix-free Compute call fell back to BiCGSTAB_ILUT.
+	bool m_HasWarnedFallback{ false }; //>! true once the fallback warning was printed, so that it is printed once per solver.
+};
+
+/**
+ * \brief Evaluates the max vertex displacement of a time step relative to the local length scale: max_v |x_v - p_v| / (|d_v - isoLevel| + sqrt(c_v)),
+ *        where p_v is the vertex position before the step, d_v its field value ("v:distance"), and c_v its co-volume measure (coVolMeasureVertexPropertyName).
+ *        Far from the iso-level the displacement may reach a fraction of the remaining distance, close to it only a fraction of the co-volume size (a CFL-like limit).
+ * \param mesh          evolving surface mesh before the step (without garbage).
+ * \param x             solution of the step (one row per vertex).
+ * \param isoLevel      target level of the scalar field.
+ * \param nThreads      the number of worker threads. Zero means "use all hardware threads".
+ * \return the max displacement ratio.
+ * \throw std::invalid_argument if x has a different number of rows than mesh vertices, or if "v:distance" or coVolMeasureVertexPropertyName are missing.
+ */
+[[nodiscard]] double ComputeMaxDisplacementRatio(const pmp::SurfaceMesh& mesh, const Eigen::MatrixXd& x, const double& isoLevel, const unsigned int& nThreads = 1);
+
+/**
+ * \brief A time step controller for surface evolution. After each step, the next time step is proposed from the displacement ratio of the step (see ComputeMaxDisplacementRatio),
+ *        so that the time step grows while the surface is far from the target and shrinks close to the iso-level or on fine meshes.
+ * \class AdaptiveTimeStepController
+ *
+ * DISCLAIMER: Step doubling is not used, because it needs two extra implicit solves per step, whereas the displacement ratio costs one pass over the vertices.
+ *             From a small initial time step, the surface gets close to the iso-level in far fewer steps than with the fixed time step.
+ */
+class AdaptiveTimeStepController
+{
+public:
+	/**
+	 * \brief Constructor.
+	 * \param initialTimeStep    the time step of the first step (the reference for the time step bounds).
+	 * \param settings           controller settings.
+	 * \throw std::invalid_argument if initialTimeStep <= 0, or if the settings are inconsistent.
+	 */
+	AdaptiveTimeStepController(const double& initialTimeStep, const AdaptiveTimeStepSettings& settings);
+
+	/**
+	 * \brief Adapts the time step after an evaluated step.
+	 * \param displacementRatio    displacement ratio of the step.
+	 * \return true if the step is accepted. Otherwise it should be repeated with TimeStep().
+	 *
+	 * DISCLAIMER: A step is always accepted with the minimum time step, or after settings.MaxRejectedSteps repetitions.
+	 */
+	[[nodiscard]] bool Update(const double& displacementRatio);
+
+	/// \brief Multiplies the time step and its bounds by a given factor (e.g.: after the decay of edge lengths for remeshing).
+	void Scale(const double& factor);
+
+	/// \brief the time step of the next step.
+	[[nodiscard]] const double& TimeStep() const
+	{
+		return m_TimeStep;
+	}
+
+	/// \brief the total number of repeated steps.
+	[[nodiscard]] unsigned int NRejectedSteps() const
+	{
+		return m_NRejectedSteps;
+	}
+
+private:
+	AdaptiveTimeStepSettings m_Settings{}; //>! controller settings.
+	double m_TimeStep{ 0.0 }; //>! the time step of the next step.
+	double m_MinTimeStep{ 0.0 }; //>! lower bound of the time step.
+	double m_MaxTimeStep{ 0.0 }; //>! upper bound of the time step.
+	unsigned int m_NStepRepetitions{ 0 }; //>! the number of repetitions of the current step.
+	unsigned int m_NRejectedSteps{ 0 }; //>! the total number of repeated steps.
+};
\ No newline at end of file
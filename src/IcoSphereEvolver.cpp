@@ -69,20 +69,24 @@ void IcoSphereEvolver::ExportField(const bool& transformToOriginal) const
 	ExportToVTI(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_SDF", exportedField);
 }
 
-void IcoSphereEvolver::ComputeTriangleMetrics() const
+PostStepAnalysisSettings IcoSphereEvolver::GetPostStepAnalysisSettings(const bool& isExported) const
 {
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
+	PostStepAnalysisSettings settings{};
+	settings.ComputeCoVolumes = isExported || REPORT_EVOL_STEPS;
+	settings.ComputeDihedralAngles = isExported;
+	settings.ComputeCurvatures = isExported;
+	settings.PrincipalCurvatureFactor = m_EvolSettings.TopoParams.PrincipalCurvatureFactor;
+	settings.NThreads = m_EvolSettings.NThreads;
+	if (isExported)
 	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
-
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
-
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "IcoSphereEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
+		settings.TriMetrics = m_EvolSettings.TriMetrics;
+		return settings;
 	}
+
+	// the next time step tests remeshing necessity by "v:equilateralJacobianCondition".
+	if (m_EvolSettings.DoRemeshing && std::ranges::find(m_EvolSettings.TriMetrics, "equilateralJacobianCondition") != m_EvolSettings.TriMetrics.end())
+		settings.TriMetrics = { "equilateralJacobianCondition" };
+	return settings;
 }
 
 //
@@ -290,7 +294,7 @@ void IcoSphereEvolver::Evolve()
 
 	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
 	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
+	CSRSparseMatrix sysMat(NVertices, NVertices);
 	Eigen::MatrixXd sysRhs(NVertices, 3);
 	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
 	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
@@ -302,7 +306,8 @@ void IcoSphereEvolver::Evolve()
 	// ----------- System fill function --------------------------------
 	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
 	{
-		for (const auto v : m_EvolvingSurface->vertices())
+		// rows are assembled concurrently, so the row function only reads the mesh and its properties.
+		const auto getVertexSystemRow = [&](const pmp::Vertex& v)
 		{
 			const auto vPosToUpdate = m_EvolvingSurface->position(v);
 
@@ -311,9 +316,7 @@ void IcoSphereEvolver::Evolve()
 			{
 				// freeze boundary/feature vertices
 				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
+				return ImplicitSystemRow{ vertexRhs, 0.0, true };
 			}
 
 			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
@@ -322,29 +325,24 @@ void IcoSphereEvolver::Evolve()
 			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
 			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
 
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
+			Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
 			const float tanRedistWeight = m_EvolSettings.TangentialVelocityWeight * epsilonCtrlWeight;
 			if (tanRedistWeight > 0.0f)
 			{
 				// compute tangential velocity
 				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
+				vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 			}
 
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
+			return ImplicitSystemRow{ vertexRhs, tStep * epsilonCtrlWeight, false };
+		};
 
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
-		}
+		AssembleImplicitLaplacianSystem(*m_EvolvingSurface, m_EvolSettings.LaplacianType, getVertexSystemRow, sysMat, sysRhs, m_EvolSettings.NThreads);
 	};
 	// -----------------------------------------------------------------
 
 	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+	auto coVolStats = AnalyzeMeshAfterTimeStep(*m_EvolvingSurface, m_LaplacianAreaFunction, GetPostStepAnalysisSettings(m_EvolSettings.ExportSurfacePerTimeStep || NSteps == 0));
 #if REPORT_EVOL_STEPS
 	std::ofstream fileOStreamMins(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMins.txt");
 	std::ofstream fileOStreamMeans(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMeans.txt");
@@ -355,16 +353,12 @@ void IcoSphereEvolver::Evolve()
 	fileOStreamMaxes << coVolStats.Max << ", ";
 #endif
 	// set initial surface vertex properties
+	const auto vInitDistances = Geometry::TrilinearInterpolateScalarValues(m_EvolvingSurface->positions(), field, m_EvolSettings.NThreads);
 	for (const auto v : m_EvolvingSurface->vertices())
 	{
-		const auto vPos = m_EvolvingSurface->position(v);
-		const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-		vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+		vDistance[v] = static_cast<pmp::Scalar>(vInitDistances[v.idx()]);
 		vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
 	}
-	Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-	Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface, m_EvolSettings.TopoParams.PrincipalCurvatureFactor);
-	ComputeTriangleMetrics();
 	if (m_EvolSettings.ExportSurfacePerTimeStep)
 		ExportSurface(0);
 
@@ -393,7 +387,7 @@ void IcoSphereEvolver::Evolve()
 		std::cout << "Solving linear system ... ";
 #endif
 		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
+		Eigen::BiCGSTAB<CSRSparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
 		Eigen::MatrixXd x = solver.solve(sysRhs);
 		if (solver.info() != Eigen::Success)
 		{
@@ -453,7 +447,9 @@ void IcoSphereEvolver::Evolve()
 				minEdgeLength, maxEdgeLength, approxError,
 				m_EvolSettings.TopoParams.NRemeshingIters,
 				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
+				m_EvolSettings.TopoParams.UseBackProjection,
+				m_EvolSettings.NThreads,
+				m_EvolSettings.TopoParams.UseParallelCandidateEvaluation });
 #if REPORT_EVOL_STEPS
 			std::cout << "done\n";
 #endif
@@ -487,7 +483,8 @@ void IcoSphereEvolver::Evolve()
 
 		// --------------------------------------------------------------------
 
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+		// the last time step is fully analyzed for the result surface.
+		coVolStats = AnalyzeMeshAfterTimeStep(*m_EvolvingSurface, m_LaplacianAreaFunction, GetPostStepAnalysisSettings(m_EvolSettings.ExportSurfacePerTimeStep || ti == NSteps));
 
 #if REPORT_EVOL_STEPS
 		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
@@ -496,16 +493,12 @@ void IcoSphereEvolver::Evolve()
 		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
 #endif
 		// set surface vertex properties
+		const auto vDistances = Geometry::TrilinearInterpolateScalarValues(m_EvolvingSurface->positions(), field, m_EvolSettings.NThreads);
 		for (const auto v : m_EvolvingSurface->vertices())
 		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-			vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+			vDistance[v] = static_cast<pmp::Scalar>(vDistances[v.idx()]);
 			vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
 		}
-		Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-		Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface, m_EvolSettings.TopoParams.PrincipalCurvatureFactor);
-		ComputeTriangleMetrics();
 
 		if (m_EvolSettings.ExportSurfacePerTimeStep)
 			ExportSurface(ti);
@@ -514,7 +507,7 @@ void IcoSphereEvolver::Evolve()
 		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
 		{
 			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
+			sysMat = CSRSparseMatrix(NVertices, NVertices);
 			sysRhs = Eigen::MatrixXd(NVertices, 3);
 		}
 
@@ -176,20 +176,16 @@ void IsoSurfaceEvolver::ExportSurface(const unsigned int& tId, const bool& isRes
 	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
 }
 
-void IsoSurfaceEvolver::ComputeTriangleMetrics() const
+PostStepAnalysisSettings IsoSurfaceEvolver::GetPostStepAnalysisSettings(const bool& isExported) const
 {
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
-	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
-
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
-
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "IsoSurfaceEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
-	}
+	PostStepAnalysisSettings settings{};
+	settings.ComputeCoVolumes = isExported || REPORT_EVOL_STEPS;
+	settings.ComputeDihedralAngles = isExported;
+	settings.ComputeCurvatures = isExported;
+	settings.NThreads = m_EvolSettings.NThreads;
+	if (isExported)
+		settings.TriMetrics = m_EvolSettings.TriMetrics;
+	return settings;
 }
 
 // ================================================================================================
@@ -229,7 +225,7 @@ void IsoSurfaceEvolver::Evolve()
 
 	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
 	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
+	CSRSparseMatrix sysMat(NVertices, NVertices);
 	Eigen::MatrixXd sysRhs(NVertices, 3);
 	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
 	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
@@ -240,7 +236,8 @@ void IsoSurfaceEvolver::Evolve()
 	// ----------- System fill function --------------------------------
 	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
 	{
-		for (const auto v : m_EvolvingSurface->vertices())
+		// rows are assembled concurrently, so the row function only reads the mesh and its properties.
+		const auto getVertexSystemRow = [&](const pmp::Vertex& v)
 		{
 			const auto vPosToUpdate = m_EvolvingSurface->position(v);
 
@@ -249,9 +246,7 @@ void IsoSurfaceEvolver::Evolve()
 			{
 				// freeze boundary/feature vertices
 				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
+				return ImplicitSystemRow{ vertexRhs, 0.0, true };
 			}
 
 			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
@@ -260,29 +255,24 @@ void IsoSurfaceEvolver::Evolve()
 			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
 			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
 
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
+			Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
 			const float tanRedistWeight = m_EvolSettings.TangentialVelocityWeight * epsilonCtrlWeight;
 			if (tanRedistWeight > 0.0f)
 			{
 				// compute tangential velocity
 				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
+				vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 			}
 
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
+			return ImplicitSystemRow{ vertexRhs, tStep * epsilonCtrlWeight, false };
+		};
 
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
-		}
+		AssembleImplicitLaplacianSystem(*m_EvolvingSurface, m_EvolSettings.LaplacianType, getVertexSystemRow, sysMat, sysRhs, m_EvolSettings.NThreads);
 	};
 	// -----------------------------------------------------------------
 
 	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+	auto coVolStats = AnalyzeMeshAfterTimeStep(*m_EvolvingSurface, m_LaplacianAreaFunction, GetPostStepAnalysisSettings(m_EvolSettings.ExportSurfacePerTimeStep || NSteps == 0));
 #if REPORT_EVOL_STEPS
 	std::ofstream fileOStreamMins(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMins.txt");
 	std::ofstream fileOStreamMeans(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMeans.txt");
@@ -293,15 +283,9 @@ void IsoSurfaceEvolver::Evolve()
 	fileOStreamMaxes << coVolStats.Max << ", ";
 #endif
 	// set initial surface vertex properties
+	const auto vInitDistances = Geometry::TrilinearInterpolateScalarValues(m_EvolvingSurface->positions(), field, m_EvolSettings.NThreads);
 	for (const auto v : m_EvolvingSurface->vertices())
-	{
-		const auto vPos = m_EvolvingSurface->position(v);
-		const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-		vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-	}
-	Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-	Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface);
-	ComputeTriangleMetrics();
+		vDistance[v] = static_cast<pmp::Scalar>(vInitDistances[v.idx()]);
 	if (m_EvolSettings.ExportSurfacePerTimeStep)
 		ExportSurface(0);
 
@@ -330,7 +314,7 @@ void IsoSurfaceEvolver::Evolve()
 		std::cout << "Solving linear system ... ";
 #endif
 		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
+		Eigen::BiCGSTAB<CSRSparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
 		Eigen::MatrixXd x = solver.solve(sysRhs);
 		if (solver.info() != Eigen::Success)
 		{
@@ -395,7 +379,9 @@ void IsoSurfaceEvolver::Evolve()
 				minEdgeLength, maxEdgeLength, approxError,
 				m_EvolSettings.TopoParams.NRemeshingIters,
 				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
+				m_EvolSettings.TopoParams.UseBackProjection,
+				m_EvolSettings.NThreads,
+				m_EvolSettings.TopoParams.UseParallelCandidateEvaluation });
 			//remeshing.uniform_remeshing(targetEdgeLength);
 #if REPORT_EVOL_STEPS
 			std::cout << "done\n";
@@ -410,7 +396,8 @@ void IsoSurfaceEvolver::Evolve()
 			}
 		}
 
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+		// the last time step is fully analyzed for the result surface.
+		coVolStats = AnalyzeMeshAfterTimeStep(*m_EvolvingSurface, m_LaplacianAreaFunction, GetPostStepAnalysisSettings(m_EvolSettings.ExportSurfacePerTimeStep || ti == NSteps));
 #if REPORT_EVOL_STEPS
 		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
 		fileOStreamMins << coVolStats.Min << (ti < NSteps ? ", " : "");
@@ -418,15 +405,9 @@ void IsoSurfaceEvolver::Evolve()
 		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
 #endif
 		// set surface vertex properties
+		const auto vDistances = Geometry::TrilinearInterpolateScalarValues(m_EvolvingSurface->positions(), field, m_EvolSettings.NThreads);
 		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-			vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-		}
-		Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-		Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface);
-		ComputeTriangleMetrics();
+			vDistance[v] = static_cast<pmp::Scalar>(vDistances[v.idx()]);
 
 		if (m_EvolSettings.ExportSurfacePerTimeStep)
 			ExportSurface(ti);
@@ -435,7 +416,7 @@ void IsoSurfaceEvolver::Evolve()
 		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
 		{
 			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
+			sysMat = CSRSparseMatrix(NVertices, NVertices);
 			sysRhs = Eigen::MatrixXd(NVertices, 3);
 		}
 
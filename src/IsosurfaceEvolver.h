@@ -39,6 +39,7 @@ struct IsoSurfaceEvolutionSettings
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+	unsigned int NThreads{ 1 }; //>! the number of worker threads for assembling the linear system, for remeshing, and for the mesh analysis in each time step. NThreads == 0 uses all hardware threads.
 };
 
 /**
@@ -104,9 +105,11 @@ private:
 	void ExportSurface(const unsigned int& tId, const bool& isResult = false, const bool& transformToOriginal = true) const;
 
 	/**
-	 * \brief Computes triangle metrics interpolated to vertices according to list m_EvolSettings.TriMetrics.
+	 * \brief Specifies the mesh properties computed after a time step by AnalyzeMeshAfterTimeStep.
+	 * \param isExported    if true, all properties (including the whole list m_EvolSettings.TriMetrics) are computed for the exported surface.
+	 * \return analysis settings. Without export, only the properties consumed by the next time step (or by REPORT_EVOL_STEPS) are computed.
 	 */
-	void ComputeTriangleMetrics() const;
+	[[nodiscard]] PostStepAnalysisSettings GetPostStepAnalysisSettings(const bool& isExported) const;
 
 	// ----------------------------------------------------------------
 
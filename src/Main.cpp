@@ -32,6 +32,7 @@
 #include <filesystem>
 #include <chrono>
 #include <map>
+#include <random>
 
 
 // set up root directory
@@ -95,6 +96,23 @@ constexpr bool performApollonArtecEvaLSWHausdorffEval = false;
 constexpr bool performVertexNormalSampling = true;
 constexpr bool performTerrainPtGenerationTest = false;
 constexpr bool perfromTerrainTriangulationTest = false;
+constexpr bool performParallelFastSweepBenchmark = false;
+constexpr bool performSparseDistanceFieldBenchmark = false;
+constexpr bool performDistanceFieldBatchBenchmark = false;
+constexpr bool performSinglePrecisionDistanceFieldBenchmark = false;
+constexpr bool performClosestTrianglePropagationBenchmark = false;
+constexpr bool performExactPointCloudDistanceFieldBenchmark = false;
+constexpr bool performSeparableBlurBenchmark = false;
+constexpr bool performCollisionKdTreeQueryBenchmark = false;
+constexpr bool performParallelKdTreeBuildBenchmark = false;
+constexpr bool performClosestTriangleQueryBenchmark = false;
+constexpr bool performOutOfCoreDistanceFieldTest = false;
+constexpr bool performNormalizedGradientKernelBenchmark = false;
+constexpr bool performBatchInterpolationBenchmark = false;
+constexpr bool performImplicitSystemAssemblyBenchmark = false;
+constexpr bool performImplicitSystemSolverComparison = false;
+constexpr bool performPreconditionerRefreshBenchmark = false;
+constexpr bool performMatrixFreeSolverBenchmark = false;
 
 int main()
 {
@@ -3188,4 +3206,1288 @@ int main()
 		}
 
 	} // endif perfromTerrainTriangulationTest
-}
+
+	if (performParallelFastSweepBenchmark)
+	{
+		const std::vector<std::string> meshForPtCloudNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nTimings = 5;
+		constexpr double maxAllowedDifference = 1e-9; // tolerance w.r.t. the serial FastSweep result
+		const std::vector<unsigned int> threadCounts{ 2, 4, 8, 16 };
+
+		for (const auto& meshName : meshForPtCloudNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto& ptCloud = mesh.positions();
+			const pmp::BoundingBox ptCloudBBox(ptCloud);
+			const auto ptCloudBBoxSize = ptCloudBBox.max() - ptCloudBBox.min();
+			const float minSize = std::min({ ptCloudBBoxSize[0], ptCloudBBoxSize[1], ptCloudBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			SDF::PointCloudDistanceFieldSettings dfSettings{
+				cellSize,
+					1.0f,
+					DBL_MAX,
+					SDF::BlurPostprocessingType::None
+			};
+
+			std::cout << "==================================================================\n";
+			std::cout << "Parallel FastSweep benchmark: " << meshName << " vertices, " << nVoxelsPerMinDimension << " voxels per min dimension\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			// serial reference
+			dfSettings.NThreads = 1;
+			double serialTiming = 0.0;
+			auto serialDF = SDF::PointCloudDistanceFieldGenerator::Generate(ptCloud, dfSettings);
+			for (size_t j = 0; j < nTimings; j++)
+			{
+				const auto startSerial = std::chrono::high_resolution_clock::now();
+				serialDF = SDF::PointCloudDistanceFieldGenerator::Generate(ptCloud, dfSettings);
+				const auto endSerial = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffSerial = endSerial - startSerial;
+				serialTiming += timeDiffSerial.count();
+			}
+			serialTiming /= nTimings;
+			const auto& dims = serialDF.Dimensions();
+			std::cout << "Dimensions: " << dims.Nx << " x " << dims.Ny << " x " << dims.Nz << "\n";
+			std::cout << "NThreads = 1: " << serialTiming << " s\n";
+
+			for (const auto& nThreads : threadCounts)
+			{
+				dfSettings.NThreads = nThreads;
+				double parallelTiming = 0.0;
+				double maxDifference = 0.0;
+				for (size_t j = 0; j < nTimings; j++)
+				{
+					const auto startParallel = std::chrono::high_resolution_clock::now();
+					const auto parallelDF = SDF::PointCloudDistanceFieldGenerator::Generate(ptCloud, dfSettings);
+					const auto endParallel = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiffParallel = endParallel - startParallel;
+					parallelTiming += timeDiffParallel.count();
+					maxDifference = std::max(maxDifference, Geometry::ComputeMaxAbsoluteValueDifference(serialDF, parallelDF));
+				}
+				parallelTiming /= nTimings;
+
+				std::cout << "NThreads = " << nThreads << ": " << parallelTiming << " s, speedup: " << serialTiming / parallelTiming
+					<< ", max |serial - parallel| = " << maxDifference << (maxDifference <= maxAllowedDifference ? " (OK)" : " (EXCEEDS TOLERANCE!)") << "\n";
+			}
+		}
+	} // endif performParallelFastSweepBenchmark
+
+	if (performSparseDistanceFieldBenchmark)
+	{
+		const std::vector<std::string> sparseFieldMeshNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nSamplePts = 100000;
+
+		for (const auto& meshName : sparseFieldMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			const SDF::DistanceFieldSettings sdfSettings{
+				cellSize,
+				1.0f,
+				0.2, // a finite truncation is needed for a narrow band
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::None,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::Octree
+			};
+
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+
+			std::cout << "==================================================================\n";
+			std::cout << "Sparse distance field benchmark: " << meshName << ", " << nVoxelsPerMinDimension << " voxels per min dimension\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			const auto startDense = std::chrono::high_resolution_clock::now();
+			const auto denseSDF = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+			const auto endDense = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffDense = endDense - startDense;
+
+			const auto startSparse = std::chrono::high_resolution_clock::now();
+			const auto sparseSDF = SDF::DistanceFieldGenerator::GenerateSparse(meshAdapter, sdfSettings);
+			const auto endSparse = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffSparse = endSparse - startSparse;
+
+			const auto& dims = denseSDF.Dimensions();
+			const size_t denseMemory = denseSDF.Values().size() * sizeof(double) + denseSDF.FrozenValues().size() / 8;
+			std::cout << "Dimensions: " << dims.Nx << " x " << dims.Ny << " x " << dims.Nz << "\n";
+			std::cout << "Dense:  " << timeDiffDense.count() << " s, " << static_cast<double>(denseMemory) / 1e6 << " MB\n";
+			std::cout << "Sparse: " << timeDiffSparse.count() << " s, " << static_cast<double>(sparseSDF.MemoryUsage()) / 1e6 << " MB ("
+				<< sparseSDF.NAllocatedBlocks() << " allocated blocks)\n";
+			std::cout << "max |dense - sparse| (voxels): " << Geometry::ComputeMaxAbsoluteValueDifference(denseSDF, sparseSDF.ToDense()) << "\n";
+
+			// compare sampled values & gradients at random points within the field box
+			const auto denseNegGradient = Geometry::ComputeNormalizedNegativeGradient(denseSDF);
+			const auto& fieldBox = denseSDF.Box();
+			std::mt19937 rng(1);
+			std::uniform_real_distribution<float> unif(0.0f, 1.0f);
+			double maxValueDifference = 0.0;
+			double maxGradientDifference = 0.0;
+			for (size_t i = 0; i < nSamplePts; i++)
+			{
+				const pmp::vec3 samplePt{
+					fieldBox.min()[0] + unif(rng) * (fieldBox.max()[0] - fieldBox.min()[0]),
+					fieldBox.min()[1] + unif(rng) * (fieldBox.max()[1] - fieldBox.min()[1]),
+					fieldBox.min()[2] + unif(rng) * (fieldBox.max()[2] - fieldBox.min()[2])
+				};
+				maxValueDifference = std::max(maxValueDifference, std::abs(
+					Geometry::TrilinearInterpolateScalarValue(samplePt, denseSDF) - Geometry::TrilinearInterpolateScalarValue(samplePt, sparseSDF)));
+				maxGradientDifference = std::max(maxGradientDifference, static_cast<double>(pmp::norm(
+					Geometry::TrilinearInterpolateVectorValue(samplePt, denseNegGradient) - Geometry::TrilinearInterpolateNormalizedNegativeGradient(samplePt, sparseSDF))));
+			}
+			std::cout << "max |dense - sparse| (" << nSamplePts << " sampled values): " << maxValueDifference << ", (sampled gradients): " << maxGradientDifference << "\n";
+		}
+	} // endif performSparseDistanceFieldBenchmark
+
+	if (performDistanceFieldBatchBenchmark)
+	{
+		const std::vector<std::string> batchMeshNames{
+			"armadillo",
+			"blub",
+			"bunny",
+			"maxPlanck",
+			"nefertiti",
+			"ogre",
+			"spot"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 40;
+		const std::vector<unsigned int> threadCounts{ 1, 2, 4, 8 };
+
+		std::vector<std::unique_ptr<Geometry::MeshAdapter>> meshAdapters{};
+		std::vector<const Geometry::MeshAdapter*> meshAdapterPtrs{};
+		std::vector<SDF::DistanceFieldSettings> sdfSettings{};
+		for (const auto& meshName : batchMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			sdfSettings.push_back({
+				cellSize,
+				1.0f,
+				DBL_MAX,
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::None,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::Octree
+			});
+			meshAdapters.emplace_back(std::make_unique<Geometry::PMPSurfaceMeshAdapter>(std::make_shared<pmp::SurfaceMesh>(mesh)));
+			meshAdapterPtrs.push_back(meshAdapters.back().get());
+		}
+
+		std::cout << "==================================================================\n";
+		std::cout << "Distance field batch benchmark: " << batchMeshNames.size() << " meshes, " << nVoxelsPerMinDimension << " voxels per min dimension\n";
+		std::cout << "------------------------------------------------------------------\n";
+
+		// sequential reference
+		std::vector<Geometry::ScalarGrid> sequentialSDFs{};
+		const auto startSequential = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < meshAdapterPtrs.size(); i++)
+			sequentialSDFs.emplace_back(SDF::DistanceFieldGenerator::Generate(*meshAdapterPtrs[i], sdfSettings[i]));
+		const auto endSequential = std::chrono::high_resolution_clock::now();
+		const std::chrono::duration<double> timeDiffSequential = endSequential - startSequential;
+		std::cout << "Sequential Generate: " << timeDiffSequential.count() << " s\n";
+
+		for (const auto& nThreads : threadCounts)
+		{
+			const auto startBatch = std::chrono::high_resolution_clock::now();
+			const auto batchSDFs = SDF::DistanceFieldGenerator::GenerateBatch(meshAdapterPtrs, sdfSettings, nThreads);
+			const auto endBatch = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffBatch = endBatch - startBatch;
+
+			bool identical = true;
+			for (size_t i = 0; i < batchSDFs.size(); i++)
+				identical = identical && (batchSDFs[i] == sequentialSDFs[i]);
+
+			std::cout << "GenerateBatch, nThreads = " << nThreads << ": " << timeDiffBatch.count() << " s, speedup: " << timeDiffSequential.count() / timeDiffBatch.count()
+				<< (identical ? " (identical)" : " (DIFFERS FROM SEQUENTIAL!)") << "\n";
+		}
+	} // endif performDistanceFieldBatchBenchmark
+	if (performSinglePrecisionDistanceFieldBenchmark)
+	{
+		const std::vector<std::string> singlePrecisionMeshNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nSamplePts = 100000;
+
+		for (const auto& meshName : singlePrecisionMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			const SDF::DistanceFieldSettings sdfSettings{
+				cellSize,
+				1.0f,
+				DBL_MAX,
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::VoxelFloodFill,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::Octree
+			};
+
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+
+			std::cout << "==================================================================\n";
+			std::cout << "Single precision distance field benchmark: " << meshName << ", " << nVoxelsPerMinDimension << " voxels per min dimension\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			const auto startDouble = std::chrono::high_resolution_clock::now();
+			auto sdf = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+			const auto endDouble = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffDouble = endDouble - startDouble;
+
+			const auto startFloat = std::chrono::high_resolution_clock::now();
+			auto sdfF = SDF::DistanceFieldGenerator::GenerateSinglePrecision(meshAdapter, sdfSettings);
+			const auto endFloat = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffFloat = endFloat - startFloat;
+
+			const auto& dims = sdf.Dimensions();
+			const size_t nVoxels = dims.Nx * dims.Ny * dims.Nz;
+			std::cout << "Dimensions: " << dims.Nx << " x " << dims.Ny << " x " << dims.Nz << "\n";
+			std::cout << "Generate (double):                " << timeDiffDouble.count() << " s, " << static_cast<double>(nVoxels * sizeof(double)) / 1e6 << " MB\n";
+			std::cout << "GenerateSinglePrecision (float):  " << timeDiffFloat.count() << " s, " << static_cast<double>(nVoxels * sizeof(float)) / 1e6 << " MB\n";
+			std::cout << "max |double - float| (voxels): " << Geometry::ComputeMaxAbsoluteValueDifference(sdf, Geometry::ScalarGrid(sdfF)) << "\n";
+
+			const auto startGradDouble = std::chrono::high_resolution_clock::now();
+			const auto negGradient = Geometry::ComputeNormalizedNegativeGradient(sdf);
+			const auto endGradDouble = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffGradDouble = endGradDouble - startGradDouble;
+
+			const auto startGradFloat = std::chrono::high_resolution_clock::now();
+			const auto negGradientF = Geometry::ComputeNormalizedNegativeGradient(sdfF);
+			const auto endGradFloat = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffGradFloat = endGradFloat - startGradFloat;
+			std::cout << "ComputeNormalizedNegativeGradient: double " << timeDiffGradDouble.count() << " s, float " << timeDiffGradFloat.count() << " s\n";
+
+			// compare sampled values & gradients at random points within the field box
+			const auto& fieldBox = sdf.Box();
+			std::mt19937 rng(1);
+			std::uniform_real_distribution<float> unif(0.0f, 1.0f);
+			std::vector<pmp::vec3> samplePts(nSamplePts);
+			for (auto& pt : samplePts)
+			{
+				pt = pmp::vec3{
+					fieldBox.min()[0] + unif(rng) * (fieldBox.max()[0] - fieldBox.min()[0]),
+					fieldBox.min()[1] + unif(rng) * (fieldBox.max()[1] - fieldBox.min()[1]),
+					fieldBox.min()[2] + unif(rng) * (fieldBox.max()[2] - fieldBox.min()[2])
+				};
+			}
+			double maxValueDifference = 0.0;
+			double maxGradientDifference = 0.0;
+			for (const auto& pt : samplePts)
+			{
+				maxValueDifference = std::max(maxValueDifference, std::abs(
+					Geometry::TrilinearInterpolateScalarValue(pt, sdf) - Geometry::TrilinearInterpolateScalarValue(pt, sdfF)));
+				maxGradientDifference = std::max(maxGradientDifference, static_cast<double>(pmp::norm(
+					Geometry::TrilinearInterpolateVectorValue(pt, negGradient) - Geometry::TrilinearInterpolateVectorValue(pt, negGradientF))));
+			}
+			std::cout << "max |double - float| (" << nSamplePts << " sampled values): " << maxValueDifference << ", (sampled gradients): " << maxGradientDifference << "\n";
+
+			const auto startBlurDouble = std::chrono::high_resolution_clock::now();
+			Geometry::ApplyNarrowGaussianBlur(sdf);
+			const auto endBlurDouble = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffBlurDouble = endBlurDouble - startBlurDouble;
+
+			const auto startBlurFloat = std::chrono::high_resolution_clock::now();
+			Geometry::ApplyNarrowGaussianBlur(sdfF);
+			const auto endBlurFloat = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffBlurFloat = endBlurFloat - startBlurFloat;
+			std::cout << "ApplyNarrowGaussianBlur: double " << timeDiffBlurDouble.count() << " s, float " << timeDiffBlurFloat.count() << " s\n";
+		}
+	} // endif performSinglePrecisionDistanceFieldBenchmark
+
+	if (performClosestTrianglePropagationBenchmark)
+	{
+		const std::vector<std::string> propagationMeshNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nSampleVoxels = 5000;
+		const std::vector<double> truncationFactors{ 0.05, 0.1, 0.2, 0.5 };
+
+		for (const auto& meshName : propagationMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+
+			// brute-force reference triangles
+			std::vector<std::vector<pmp::vec3>> meshTriangles{};
+			meshTriangles.reserve(mesh.n_faces());
+			for (const auto f : mesh.faces())
+			{
+				std::vector<pmp::vec3> triangle{};
+				for (const auto v : mesh.vertices(f))
+					triangle.push_back(mesh.position(v));
+				meshTriangles.push_back(triangle);
+			}
+
+			std::cout << "==================================================================\n";
+			std::cout << "Closest triangle propagation benchmark: " << meshName << ", " << nVoxelsPerMinDimension << " voxels per min dimension\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			for (const auto& truncationFactor : truncationFactors)
+			{
+				SDF::DistanceFieldSettings sdfSettings{
+					cellSize,
+					1.0f,
+					truncationFactor,
+					SDF::KDTreeSplitType::Center,
+					SDF::SignComputation::None,
+					SDF::BlurPostprocessingType::None,
+					SDF::PreprocessingType::Octree
+				};
+				const double truncationValue = truncationFactor * static_cast<double>(minSize) / 2.0;
+
+				sdfSettings.DistanceMethod = SDF::DistanceComputation::FastSweep;
+				const auto startSweep = std::chrono::high_resolution_clock::now();
+				const auto sweepSDF = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+				const auto endSweep = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffSweep = endSweep - startSweep;
+
+				sdfSettings.DistanceMethod = SDF::DistanceComputation::ClosestTrianglePropagation;
+				const auto startPropagation = std::chrono::high_resolution_clock::now();
+				const auto propagationSDF = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+				const auto endPropagation = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffPropagation = endPropagation - startPropagation;
+
+				// compare with exact distances of randomly sampled (non-frozen) voxels within the truncation band
+				const auto& dims = sweepSDF.Dimensions();
+				const auto& fieldOrig = sweepSDF.Box().min();
+				std::mt19937 rng(1);
+				size_t nBandVoxels = 0;
+				double sweepErrorSum = 0.0, sweepErrorMax = 0.0;
+				double propagationErrorSum = 0.0, propagationErrorMax = 0.0;
+				for (size_t i = 0; i < nSampleVoxels; i++)
+				{
+					const size_t ix = rng() % dims.Nx, iy = rng() % dims.Ny, iz = rng() % dims.Nz;
+					const size_t gridPos = dims.Nx * dims.Ny * iz + dims.Nx * iy + ix;
+					if (sweepSDF.FrozenValues()[gridPos])
+						continue;
+
+					const pmp::vec3 voxelCenter = fieldOrig + pmp::vec3(
+						static_cast<float>(ix) + 0.5f, static_cast<float>(iy) + 0.5f, static_cast<float>(iz) + 0.5f) * cellSize;
+					double exactDistSq = DBL_MAX;
+					for (const auto& triangle : meshTriangles)
+						exactDistSq = std::min(exactDistSq, Geometry::GetDistanceToTriangleSq(triangle, voxelCenter));
+					const double exactDist = std::sqrt(exactDistSq);
+					if (exactDist >= truncationValue)
+						continue;
+
+					nBandVoxels++;
+					const double sweepError = std::abs(sweepSDF.Values()[gridPos] - exactDist);
+					const double propagationError = std::abs(propagationSDF.Values()[gridPos] - exactDist);
+					sweepErrorSum += sweepError;
+					propagationErrorSum += propagationError;
+					sweepErrorMax = std::max(sweepErrorMax, sweepError);
+					propagationErrorMax = std::max(propagationErrorMax, propagationError);
+				}
+				const double nBandVoxelsDenom = static_cast<double>(std::max(nBandVoxels, size_t{ 1 }));
+
+				std::cout << "TruncationFactor " << truncationFactor << " (" << truncationValue / cellSize << " voxels), " << nBandVoxels << " sampled band voxels:\n";
+				std::cout << "    FastSweep:                  " << timeDiffSweep.count() << " s, mean |error| = " << sweepErrorSum / nBandVoxelsDenom << ", max |error| = " << sweepErrorMax << "\n";
+				std::cout << "    ClosestTrianglePropagation: " << timeDiffPropagation.count() << " s, mean |error| = " << propagationErrorSum / nBandVoxelsDenom << ", max |error| = " << propagationErrorMax << "\n";
+			}
+		}
+	} // endif performClosestTrianglePropagationBenchmark
+
+	if (performExactPointCloudDistanceFieldBenchmark)
+	{
+		const std::vector<std::string> meshForPtCloudNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nSampleVoxels = 5000;
+		const std::vector<double> truncationFactors{ 0.1, 0.5 };
+		const std::vector<unsigned int> threadCounts{ 1, 4, 16 };
+
+		for (const auto& meshName : meshForPtCloudNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto& ptCloud = mesh.positions();
+			const pmp::BoundingBox ptCloudBBox(ptCloud);
+			const auto ptCloudBBoxSize = ptCloudBBox.max() - ptCloudBBox.min();
+			const float minSize = std::min({ ptCloudBBoxSize[0], ptCloudBBoxSize[1], ptCloudBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+
+			std::cout << "==================================================================\n";
+			std::cout << "Exact point cloud distance field benchmark: " << meshName << " vertices, " << nVoxelsPerMinDimension << " voxels per min dimension\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			for (const auto& truncationFactor : truncationFactors)
+			{
+				SDF::PointCloudDistanceFieldSettings dfSettings{
+					cellSize,
+					1.0f,
+					truncationFactor,
+					SDF::BlurPostprocessingType::None
+				};
+				const double truncationValue = truncationFactor * static_cast<double>(minSize) / 2.0;
+				std::cout << "TruncationFactor " << truncationFactor << " (" << truncationValue / cellSize << " voxels):\n";
+
+				for (const auto& nThreads : threadCounts)
+				{
+					dfSettings.NThreads = nThreads;
+					dfSettings.DistanceMethod = SDF::PointCloudDistanceComputation::FastSweep;
+					const auto startSweep = std::chrono::high_resolution_clock::now();
+					const auto sweepDF = SDF::PointCloudDistanceFieldGenerator::Generate(ptCloud, dfSettings);
+					const auto endSweep = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiffSweep = endSweep - startSweep;
+
+					dfSettings.DistanceMethod = SDF::PointCloudDistanceComputation::ExactNearestPoint;
+					const auto startExact = std::chrono::high_resolution_clock::now();
+					const auto exactDF = SDF::PointCloudDistanceFieldGenerator::Generate(ptCloud, dfSettings);
+					const auto endExact = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiffExact = endExact - startExact;
+
+					// compare with brute-force nearest point distances of randomly sampled grid points within the truncation band
+					const auto& dims = sweepDF.Dimensions();
+					const auto& fieldOrig = sweepDF.Box().min();
+					std::mt19937 rng(1);
+					size_t nBandVoxels = 0;
+					double sweepErrorMax = 0.0, exactErrorMax = 0.0;
+					for (size_t i = 0; i < nSampleVoxels; i++)
+					{
+						const size_t ix = rng() % dims.Nx, iy = rng() % dims.Ny, iz = rng() % dims.Nz;
+						const pmp::dvec3 gridPt{ fieldOrig + pmp::vec3(static_cast<float>(ix), static_cast<float>(iy), static_cast<float>(iz)) * cellSize };
+						double nearestDistSq = DBL_MAX;
+						for (const auto& pt : ptCloud)
+							nearestDistSq = std::min(nearestDistSq, pmp::sqrnorm(gridPt - pmp::dvec3(pt)));
+						const double nearestDist = std::sqrt(nearestDistSq);
+						if (nearestDist >= truncationValue)
+							continue;
+
+						nBandVoxels++;
+						const size_t gridPos = dims.Nx * dims.Ny * iz + dims.Nx * iy + ix;
+						sweepErrorMax = std::max(sweepErrorMax, std::abs(sweepDF.Values()[gridPos] - nearestDist));
+						exactErrorMax = std::max(exactErrorMax, std::abs(exactDF.Values()[gridPos] - nearestDist));
+					}
+
+					std::cout << "    NThreads = " << nThreads << ": FastSweep " << timeDiffSweep.count() << " s (max |error| = " << sweepErrorMax
+						<< "), ExactNearestPoint " << timeDiffExact.count() << " s (max |error| = " << exactErrorMax << "), " << nBandVoxels << " sampled band voxels\n";
+				}
+			}
+		}
+	} // endif performExactPointCloudDistanceFieldBenchmark
+
+	if (performSeparableBlurBenchmark)
+	{
+		const std::vector<std::string> blurMeshNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 200;
+		const std::vector<unsigned int> threadCounts{ 1, 4, 16 };
+		const std::vector<std::pair<std::string, std::function<void(Geometry::ScalarGrid&, const unsigned int&)>>> blurs{
+			{ "NarrowAveraging", [](Geometry::ScalarGrid& g, const unsigned int& n) { Geometry::ApplyNarrowAveragingBlur(g, n); } },
+			{ "WideAveraging", [](Geometry::ScalarGrid& g, const unsigned int& n) { Geometry::ApplyWideAveragingBlur(g, n); } },
+			{ "NarrowGaussian", [](Geometry::ScalarGrid& g, const unsigned int& n) { Geometry::ApplyNarrowGaussianBlur(g, n); } },
+			{ "WideGaussian", [](Geometry::ScalarGrid& g, const unsigned int& n) { Geometry::ApplyWideGaussianBlur(g, n); } },
+			{ "Gaussian(sigma = 1.5)", [](Geometry::ScalarGrid& g, const unsigned int& n) { Geometry::ApplyGaussianBlur(g, 1.5, n); } }
+		};
+
+		for (const auto& meshName : blurMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+
+			const SDF::DistanceFieldSettings sdfSettings{
+				cellSize,
+				1.0f,
+				DBL_MAX,
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::VoxelFloodFill,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::Octree
+			};
+			const auto sdf = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+			const auto& dims = sdf.Dimensions();
+
+			std::cout << "==================================================================\n";
+			std::cout << "Separable blur benchmark: " << meshName << ", " << dims.Nx << " x " << dims.Ny << " x " << dims.Nz << " voxels\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			for (const auto& [blurName, blurFunction] : blurs)
+			{
+				std::cout << blurName << ":\n";
+				for (const auto& nThreads : threadCounts)
+				{
+					auto blurredSDF = sdf;
+					const auto startBlur = std::chrono::high_resolution_clock::now();
+					blurFunction(blurredSDF, nThreads);
+					const auto endBlur = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiff = endBlur - startBlur;
+					std::cout << "    NThreads = " << nThreads << ": " << timeDiff.count() << " s\n";
+				}
+			}
+		}
+	} // endif performSeparableBlurBenchmark
+
+	if (performCollisionKdTreeQueryBenchmark)
+	{
+		const std::vector<std::string> kdTreeQueryMeshNames{
+			"bunny",
+			"CaesarBust",
+			"ogre"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nQueries = 1000000;
+		const std::vector<std::pair<std::string, Geometry::SplitFunction>> splitFunctions{
+			{ "CenterSplitFunction", Geometry::CenterSplitFunction },
+			{ "SAHSplitFunction", Geometry::SAHSplitFunction }
+		};
+
+		for (const auto& meshName : kdTreeQueryMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+
+			// voxel-sized query boxes and +x rays (as in SDF preprocessing and sign computation)
+			std::mt19937 rng(1);
+			std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+			std::vector<pmp::vec3> queryPts(nQueries);
+			for (auto& pt : queryPts)
+				pt = meshBBox.min() + pmp::vec3(unitDist(rng) * meshBBoxSize[0], unitDist(rng) * meshBBoxSize[1], unitDist(rng) * meshBBoxSize[2]);
+
+			std::cout << "==================================================================\n";
+			std::cout << "CollisionKdTree query benchmark: " << meshName << ", " << mesh.n_faces() << " faces, " << nQueries << " queries\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			for (const auto& [splitName, splitFunction] : splitFunctions)
+			{
+				const auto startBuild = std::chrono::high_resolution_clock::now();
+				const Geometry::CollisionKdTree kdTree(meshAdapter, splitFunction);
+				const auto endBuild = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffBuild = endBuild - startBuild;
+
+				size_t nFoundTriangles = 0;
+				std::vector<unsigned int> foundTriangleIds{};
+				const auto startBoxQueries = std::chrono::high_resolution_clock::now();
+				for (const auto& pt : queryPts)
+				{
+					foundTriangleIds.clear();
+					kdTree.GetTrianglesInABox({ pt - pmp::vec3(0.5f * cellSize), pt + pmp::vec3(0.5f * cellSize) }, foundTriangleIds);
+					nFoundTriangles += foundTriangleIds.size();
+				}
+				const auto endBoxQueries = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffBoxQueries = endBoxQueries - startBoxQueries;
+
+				size_t nIntersectingBoxes = 0;
+				const auto startBoxTests = std::chrono::high_resolution_clock::now();
+				for (const auto& pt : queryPts)
+				{
+					if (kdTree.BoxIntersectsATriangle({ pt - pmp::vec3(0.5f * cellSize), pt + pmp::vec3(0.5f * cellSize) }))
+						nIntersectingBoxes++;
+				}
+				const auto endBoxTests = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffBoxTests = endBoxTests - startBoxTests;
+
+				size_t nRayHits = 0;
+				const auto startRayQueries = std::chrono::high_resolution_clock::now();
+				for (const auto& pt : queryPts)
+				{
+					Geometry::Ray ray(pt, pmp::vec3{ 1.0f, 0.0f, 0.0f });
+					nRayHits += kdTree.GetRayTriangleIntersectionCount(ray);
+				}
+				const auto endRayQueries = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffRayQueries = endRayQueries - startRayQueries;
+
+				std::cout << splitName << ": build " << timeDiffBuild.count() << " s, " << kdTree.NodeCount() << " nodes, " << kdTree.MemoryUsage() << " bytes\n";
+				std::cout << "    GetTrianglesInABox:              " << static_cast<double>(nQueries) / timeDiffBoxQueries.count() << " queries/s (" << nFoundTriangles << " triangles found)\n";
+				std::cout << "    BoxIntersectsATriangle:          " << static_cast<double>(nQueries) / timeDiffBoxTests.count() << " queries/s (" << nIntersectingBoxes << " intersecting boxes)\n";
+				std::cout << "    GetRayTriangleIntersectionCount: " << static_cast<double>(nQueries) / timeDiffRayQueries.count() << " queries/s (" << nRayHits << " hits)\n";
+			}
+		}
+	} // endif performCollisionKdTreeQueryBenchmark
+
+	if (performParallelKdTreeBuildBenchmark)
+	{
+		const std::vector<std::string> kdTreeBuildMeshNames{
+			"bunny",
+			"CaesarBust",
+			"ogre"
+		};
+
+		const std::vector<unsigned int> threadCounts{ 1, 2, 4, 8, 16 };
+		constexpr unsigned int nRuns = 5;
+		const std::vector<std::pair<std::string, Geometry::SplitFunction>> splitFunctions{
+			{ "CenterSplitFunction", Geometry::CenterSplitFunction },
+			{ "SAHSplitFunction", Geometry::SAHSplitFunction }
+		};
+
+		for (const auto& meshName : kdTreeBuildMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+
+			std::cout << "==================================================================\n";
+			std::cout << "Parallel CollisionKdTree build benchmark: " << meshName << ", " << mesh.n_faces() << " faces, best of " << nRuns << " runs\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			for (const auto& [splitName, splitFunction] : splitFunctions)
+			{
+				std::cout << splitName << ":\n";
+				double serialBuildTime = 0.0;
+				for (const auto& nThreads : threadCounts)
+				{
+					double bestBuildTime = DBL_MAX;
+					size_t nNodes = 0;
+					for (unsigned int run = 0; run < nRuns; run++)
+					{
+						const auto startBuild = std::chrono::high_resolution_clock::now();
+						const Geometry::CollisionKdTree kdTree(meshAdapter, splitFunction, nThreads);
+						const auto endBuild = std::chrono::high_resolution_clock::now();
+						const std::chrono::duration<double> timeDiffBuild = endBuild - startBuild;
+						bestBuildTime = std::min(bestBuildTime, timeDiffBuild.count());
+						nNodes = kdTree.NodeCount();
+					}
+					if (nThreads == 1)
+						serialBuildTime = bestBuildTime;
+
+					std::cout << "    nThreads = " << nThreads << ": build " << bestBuildTime << " s (speedup " << serialBuildTime / bestBuildTime << "), " << nNodes << " nodes\n";
+				}
+			}
+		}
+	} // endif performParallelKdTreeBuildBenchmark
+
+	if (performClosestTriangleQueryBenchmark)
+	{
+		const std::vector<std::string> closestTriangleMeshNames{
+			"bunny",
+			"CaesarBust",
+			"ogre"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr unsigned int nThreads = 4;
+
+		for (const auto& meshName : closestTriangleMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+			const Geometry::CollisionKdTree kdTree(meshAdapter, Geometry::CenterSplitFunction);
+
+			// centers of the voxels intersecting the mesh (in grid order), as in SDF preprocessing
+			const auto Nx = static_cast<size_t>(std::ceil(meshBBoxSize[0] / cellSize));
+			const auto Ny = static_cast<size_t>(std::ceil(meshBBoxSize[1] / cellSize));
+			const auto Nz = static_cast<size_t>(std::ceil(meshBBoxSize[2] / cellSize));
+			std::vector<pmp::vec3> queryPts{};
+			for (size_t iz = 0; iz < Nz; iz++)
+			{
+				for (size_t iy = 0; iy < Ny; iy++)
+				{
+					for (size_t ix = 0; ix < Nx; ix++)
+					{
+						const pmp::vec3 voxelCenter = meshBBox.min() + pmp::vec3(
+							static_cast<float>(ix) + 0.5f, static_cast<float>(iy) + 0.5f, static_cast<float>(iz) + 0.5f) * cellSize;
+						if (kdTree.BoxIntersectsATriangle({ voxelCenter - pmp::vec3(0.5f * cellSize), voxelCenter + pmp::vec3(0.5f * cellSize) }))
+							queryPts.push_back(voxelCenter);
+					}
+				}
+			}
+			const size_t nQueries = queryPts.size();
+
+			std::cout << "==================================================================\n";
+			std::cout << "Closest triangle query benchmark: " << meshName << ", " << mesh.n_faces() << " faces, " << nQueries << " outline voxel centers\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			// the previous approach: distances to all triangles in the kd-tree leaves overlapping each voxel
+			const auto& vertexPositions = kdTree.VertexPositions();
+			const auto& triangles = kdTree.TriVertexIds();
+			std::vector<double> boxQueryDistSq(nQueries, DBL_MAX);
+			std::vector<unsigned int> voxelTriangleIds{};
+			std::vector triangle{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
+			const auto startBoxQueries = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < nQueries; i++)
+			{
+				voxelTriangleIds.clear();
+				kdTree.GetTrianglesInABox({ queryPts[i] - pmp::vec3(0.5f * cellSize), queryPts[i] + pmp::vec3(0.5f * cellSize) }, voxelTriangleIds);
+				for (const auto& triId : voxelTriangleIds)
+				{
+					triangle[0] = vertexPositions[triangles[triId].v0Id];
+					triangle[1] = vertexPositions[triangles[triId].v1Id];
+					triangle[2] = vertexPositions[triangles[triId].v2Id];
+					boxQueryDistSq[i] = std::min(boxQueryDistSq[i], Geometry::GetDistanceToTriangleSq(triangle, queryPts[i]));
+				}
+			}
+			const auto endBoxQueries = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffBoxQueries = endBoxQueries - startBoxQueries;
+
+			std::vector<double> closestDistSq(nQueries);
+			const auto startSingleQueries = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < nQueries; i++)
+				closestDistSq[i] = kdTree.FindClosestTriangle(queryPts[i], cellSize).DistanceSq;
+			const auto endSingleQueries = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffSingleQueries = endSingleQueries - startSingleQueries;
+
+			std::vector<Geometry::ClosestTriangleResult> batchResults{};
+			const auto startBatchQueries = std::chrono::high_resolution_clock::now();
+			kdTree.FindClosestTriangles(queryPts, batchResults, cellSize);
+			const auto endBatchQueries = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffBatchQueries = endBatchQueries - startBatchQueries;
+
+			std::vector<Geometry::ClosestTriangleResult> parallelBatchResults{};
+			const auto startParallelBatchQueries = std::chrono::high_resolution_clock::now();
+			kdTree.FindClosestTriangles(queryPts, parallelBatchResults, cellSize, nThreads);
+			const auto endParallelBatchQueries = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffParallelBatchQueries = endParallelBatchQueries - startParallelBatchQueries;
+
+			size_t nCloserThanBoxQuery = 0, nBatchMismatches = 0;
+			for (size_t i = 0; i < nQueries; i++)
+			{
+				if (closestDistSq[i] < boxQueryDistSq[i])
+					nCloserThanBoxQuery++;
+				if (batchResults[i].DistanceSq != closestDistSq[i] || parallelBatchResults[i].DistanceSq != closestDistSq[i])
+					nBatchMismatches++;
+			}
+
+			std::cout << "GetTrianglesInABox + GetDistanceToTriangleSq:  " << static_cast<double>(nQueries) / timeDiffBoxQueries.count() << " queries/s\n";
+			std::cout << "FindClosestTriangle:                           " << static_cast<double>(nQueries) / timeDiffSingleQueries.count() << " queries/s (" << nCloserThanBoxQuery << " closer than the box query result)\n";
+			std::cout << "FindClosestTriangles (1 thread):               " << static_cast<double>(nQueries) / timeDiffBatchQueries.count() << " queries/s\n";
+			std::cout << "FindClosestTriangles (" << nThreads << " threads):              " << static_cast<double>(nQueries) / timeDiffParallelBatchQueries.count() << " queries/s (" << nBatchMismatches << " distance mismatches)\n";
+		}
+	} // endif performClosestTriangleQueryBenchmark
+
+	if (performOutOfCoreDistanceFieldTest)
+	{
+		const std::vector<std::string> outOfCoreMeshNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nSlabLayers = 16;
+
+		for (const auto& meshName : outOfCoreMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			SDF::DistanceFieldSettings sdfSettings{
+				cellSize,
+				1.0f,
+				0.5,
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::RayFromAHoleFilledMesh,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::NoOctree
+			};
+			sdfSettings.NThreads = 4;
+
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+
+			std::cout << "==================================================================\n";
+			std::cout << "Out-of-core distance field test: " << meshName << ", " << nVoxelsPerMinDimension << " voxels per min dimension, " << nSlabLayers << " z-layers per slab\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			const auto startInCore = std::chrono::high_resolution_clock::now();
+			const auto sdf = SDF::DistanceFieldGenerator::GenerateSinglePrecision(meshAdapter, sdfSettings);
+			const auto endInCore = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffInCore = endInCore - startInCore;
+
+			const auto startOutOfCore = std::chrono::high_resolution_clock::now();
+			const auto mappedSdf = SDF::DistanceFieldGenerator::GenerateOutOfCore(meshAdapter, sdfSettings, dataOutPath + meshName + "_SDF.raw", nSlabLayers);
+			const auto endOutOfCore = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffOutOfCore = endOutOfCore - startOutOfCore;
+
+			const auto& dims = mappedSdf.Dimensions();
+			const float* mappedValues = mappedSdf.Values();
+			double maxAbsDiff = 0.0;
+			for (size_t i = 0; i < mappedSdf.NValues(); i++)
+				maxAbsDiff = std::max(maxAbsDiff, static_cast<double>(std::abs(mappedValues[i] - sdf.Values()[i])));
+
+			std::cout << "Dimensions: " << dims.Nx << " x " << dims.Ny << " x " << dims.Nz << "\n";
+			std::cout << "GenerateSinglePrecision:  " << timeDiffInCore.count() << " s\n";
+			std::cout << "GenerateOutOfCore:        " << timeDiffOutOfCore.count() << " s, max |difference|: " << maxAbsDiff << " (cell size " << cellSize << ")\n";
+		}
+	} // endif performOutOfCoreDistanceFieldTest
+
+	if (performNormalizedGradientKernelBenchmark)
+	{
+		const std::vector<std::string> gradientMeshNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 200;
+		constexpr double narrowBandHalfWidthInCells = 3.0;
+
+		for (const auto& meshName : gradientMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			SDF::DistanceFieldSettings sdfSettings{
+				cellSize,
+				1.0f,
+				DBL_MAX,
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::VoxelFloodFill,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::Octree
+			};
+			sdfSettings.NThreads = 0;
+
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+			const auto sdf = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+			const auto& dims = sdf.Dimensions();
+
+			std::cout << "==================================================================\n";
+			std::cout << "Normalized gradient kernel benchmark: " << meshName << ", " << dims.Nx << " x " << dims.Ny << " x " << dims.Nz << " voxels\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			const auto timeGradient = [](const std::string& label, const auto& computeGradient)
+			{
+				const auto start = std::chrono::high_resolution_clock::now();
+				auto gradient = computeGradient();
+				const auto end = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiff = end - start;
+				std::cout << label << timeDiff.count() << " s\n";
+				return gradient;
+			};
+
+			Geometry::NormalizedGradientSettings serialSettings{};
+			serialSettings.NThreads = 1;
+			const auto negGradSerial = timeGradient("double, 1 thread:          ", [&]() { return Geometry::ComputeNormalizedNegativeGradient<double>(sdf, serialSettings); });
+
+			Geometry::NormalizedGradientSettings parallelSettings{};
+			parallelSettings.NThreads = 0;
+			const auto negGradParallel = timeGradient("double, all threads:       ", [&]() { return Geometry::ComputeNormalizedNegativeGradient<double>(sdf, parallelSettings); });
+			const auto negGradFloat = timeGradient("float, all threads:        ", [&]() { return Geometry::ComputeNormalizedNegativeGradient<float>(sdf, parallelSettings); });
+
+			Geometry::NormalizedGradientSettings bandSettings{};
+			bandSettings.NThreads = 0;
+			bandSettings.NarrowBandHalfWidth = narrowBandHalfWidthInCells * static_cast<double>(cellSize);
+			const auto negGradBand = timeGradient("double, all threads, band: ", [&]() { return Geometry::ComputeNormalizedNegativeGradient<double>(sdf, bandSettings); });
+
+			double maxDiffParallel = 0.0, maxDiffFloat = 0.0, maxDiffBand = 0.0;
+			for (size_t i = 0; i < sdf.Values().size(); i++)
+			{
+				maxDiffParallel = std::max(maxDiffParallel, std::abs(negGradParallel.ValuesX()[i] - negGradSerial.ValuesX()[i]));
+				maxDiffFloat = std::max(maxDiffFloat, std::abs(static_cast<double>(negGradFloat.ValuesX()[i]) - negGradSerial.ValuesX()[i]));
+				if (std::abs(sdf.Values()[i]) <= bandSettings.NarrowBandHalfWidth)
+					maxDiffBand = std::max(maxDiffBand, std::abs(negGradBand.ValuesX()[i] - negGradSerial.ValuesX()[i]));
+			}
+			std::cout << "max |x-component difference| (parallel, float, band): " << maxDiffParallel << ", " << maxDiffFloat << ", " << maxDiffBand << "\n";
+		}
+
+		// voxels next to nan values and FLT_MAX sentinels (as in the gaps of narrow-band grids) must get zero gradients
+		Geometry::ScalarGridF invalidValuesGrid(1.0f, pmp::vec3{ 0.0f, 0.0f, 0.0f }, Geometry::GridDimensions{ 8, 8, 8 }, 1.0);
+		auto& invalidGridValues = invalidValuesGrid.Values();
+		for (size_t i = 0; i < invalidGridValues.size(); i++)
+			invalidGridValues[i] = static_cast<float>(i % 8); // a linear field with unit gradient in x
+		invalidGridValues[8 * 8 * 3 + 8 * 3 + 3] = std::numeric_limits<float>::quiet_NaN();
+		invalidGridValues[8 * 8 * 4 + 8 * 4 + 5] = FLT_MAX;
+		Geometry::NormalizedGradientSettings invalidValuesSettings{};
+		invalidValuesSettings.NarrowBandHalfWidth = 4.0; // the trimmed rows still visit the voxels next to the sentinel
+		for (const auto& settings : { Geometry::NormalizedGradientSettings{}, invalidValuesSettings })
+		{
+			const auto negGradF = Geometry::ComputeNormalizedNegativeGradient<float>(invalidValuesGrid, settings);
+			size_t nNonFiniteValues = 0;
+			for (size_t i = 0; i < invalidGridValues.size(); i++)
+			{
+				if (!std::isfinite(negGradF.ValuesX()[i]) || !std::isfinite(negGradF.ValuesY()[i]) || !std::isfinite(negGradF.ValuesZ()[i]))
+					nNonFiniteValues++;
+			}
+			const size_t nextToNaNPos = 8 * 8 * 3 + 8 * 3 + 4;
+			const size_t nextToSentinelPos = 8 * 8 * 4 + 8 * 4 + 4;
+			const bool areZero = negGradF.ValuesX()[nextToNaNPos] == 0.0f && negGradF.ValuesX()[nextToSentinelPos] == 0.0f;
+			std::cout << "nan/FLT_MAX neighborhood" << (settings.NarrowBandHalfWidth < DBL_MAX ? " (band)" : "") << ": " << nNonFiniteValues << " non-finite gradient values, "
+				<< "zero next to invalid values: " << (nNonFiniteValues == 0 && areZero ? "OK" : "FAILED!") << "\n";
+		}
+	} // endif performNormalizedGradientKernelBenchmark
+
+	if (performBatchInterpolationBenchmark)
+	{
+		const std::vector<std::string> interpolationMeshNames{
+			"bunny",
+			"CaesarBust"
+		};
+
+		constexpr unsigned int nVoxelsPerMinDimension = 100;
+		constexpr size_t nSamplePts = 1000000;
+
+		for (const auto& meshName : interpolationMeshNames)
+		{
+			pmp::SurfaceMesh mesh;
+			mesh.read(dataDirPath + meshName + ".obj");
+			const auto meshBBox = mesh.bounds();
+			const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+			const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+			const float cellSize = minSize / nVoxelsPerMinDimension;
+			SDF::DistanceFieldSettings sdfSettings{
+				cellSize,
+				1.0f,
+				DBL_MAX,
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::VoxelFloodFill,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::Octree
+			};
+			sdfSettings.NThreads = 0;
+
+			const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+			const auto sdf = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+			const auto negGradient = Geometry::ComputeNormalizedNegativeGradient(sdf);
+
+			const auto& fieldBox = sdf.Box();
+			std::mt19937 rng(1);
+			std::uniform_real_distribution<float> unif(0.0f, 1.0f);
+			std::vector<pmp::vec3> samplePts(nSamplePts);
+			for (auto& pt : samplePts)
+			{
+				pt = pmp::vec3{
+					fieldBox.min()[0] + unif(rng) * (fieldBox.max()[0] - fieldBox.min()[0]),
+					fieldBox.min()[1] + unif(rng) * (fieldBox.max()[1] - fieldBox.min()[1]),
+					fieldBox.min()[2] + unif(rng) * (fieldBox.max()[2] - fieldBox.min()[2])
+				};
+			}
+
+			std::cout << "==================================================================\n";
+			std::cout << "Batch trilinear interpolation benchmark: " << meshName << ", " << nSamplePts << " sample points\n";
+			std::cout << "------------------------------------------------------------------\n";
+
+			const auto startSingle = std::chrono::high_resolution_clock::now();
+			std::vector<double> singleValues(nSamplePts);
+			std::vector<pmp::dvec3> singleVectors(nSamplePts);
+			for (size_t i = 0; i < nSamplePts; i++)
+			{
+				singleValues[i] = Geometry::TrilinearInterpolateScalarValue(samplePts[i], sdf);
+				singleVectors[i] = Geometry::TrilinearInterpolateVectorValue(samplePts[i], negGradient);
+			}
+			const auto endSingle = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffSingle = endSingle - startSingle;
+
+			const auto startBatch = std::chrono::high_resolution_clock::now();
+			const auto batchValues = Geometry::TrilinearInterpolateScalarValues(samplePts, sdf);
+			const auto batchVectors = Geometry::TrilinearInterpolateVectorValues(samplePts, negGradient);
+			const auto endBatch = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffBatch = endBatch - startBatch;
+
+			const auto startParallel = std::chrono::high_resolution_clock::now();
+			const auto parallelValues = Geometry::TrilinearInterpolateScalarValues(samplePts, sdf, 0);
+			const auto parallelVectors = Geometry::TrilinearInterpolateVectorValues(samplePts, negGradient, 0);
+			const auto endParallel = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffParallel = endParallel - startParallel;
+
+			double maxValueDiff = 0.0, maxVectorDiff = 0.0;
+			for (size_t i = 0; i < nSamplePts; i++)
+			{
+				maxValueDiff = std::max(maxValueDiff, std::abs(singleValues[i] - parallelValues[i]));
+				maxVectorDiff = std::max(maxVectorDiff, static_cast<double>(pmp::norm(singleVectors[i] - parallelVectors[i])));
+			}
+
+			std::cout << "TrilinearInterpolate*Value (per point):       " << timeDiffSingle.count() << " s\n";
+			std::cout << "TrilinearInterpolate*Values (1 thread):       " << timeDiffBatch.count() << " s\n";
+			std::cout << "TrilinearInterpolate*Values (all threads):    " << timeDiffParallel.count() << " s\n";
+			std::cout << "max |per point - batch| (scalar, vector): " << maxValueDiff << ", " << maxVectorDiff << "\n";
+		}
+	} // endif performBatchInterpolationBenchmark
+
+	if (performImplicitSystemAssemblyBenchmark)
+	{
+		constexpr double tStep = 0.01;
+		for (const unsigned int subdiv : { 5u, 6u, 7u })
+		{
+			Geometry::IcoSphereBuilder ico({ subdiv, 1.0f });
+			ico.BuildBaseData();
+			ico.BuildPMPSurfaceMesh();
+			auto icoMesh = ico.GetPMPSurfaceMeshResult();
+			const auto NVertices = icoMesh.n_vertices();
+			std::cout << "IcoSphere subdiv " << subdiv << ", " << NVertices << " vertices:\n";
+
+			const auto getVertexSystemRow = [&](const pmp::Vertex& v)
+			{
+				const Eigen::Vector3d vertexRhs = icoMesh.position(v);
+				return ImplicitSystemRow{ vertexRhs, tStep, false };
+			};
+
+			// reference: triplets from pmp::laplace_implicit_voronoi
+			const auto startTriplets = std::chrono::high_resolution_clock::now();
+			SparseMatrix refSysMat(NVertices, NVertices);
+			Eigen::MatrixXd refSysRhs(NVertices, 3);
+			std::vector<Eigen::Triplet<double>> tripletList;
+			tripletList.reserve(static_cast<size_t>(NVertices) * 7);
+			for (const auto v : icoMesh.vertices())
+			{
+				const auto row = getVertexSystemRow(v);
+				refSysRhs.row(v.idx()) = row.Rhs;
+				const auto laplaceWeightInfo = pmp::laplace_implicit_voronoi(icoMesh, v);
+				tripletList.emplace_back(v.idx(), v.idx(), 1.0 + row.LaplacianWeight * static_cast<double>(laplaceWeightInfo.weightSum));
+				for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
+					tripletList.emplace_back(v.idx(), w.idx(), -1.0 * row.LaplacianWeight * static_cast<double>(weight));
+			}
+			refSysMat.setFromTriplets(tripletList.begin(), tripletList.end());
+			const auto endTriplets = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffTriplets = endTriplets - startTriplets;
+			std::cout << "    triplets + setFromTriplets:             " << timeDiffTriplets.count() << " s\n";
+
+			for (const unsigned int nThreads : { 1u, 0u })
+			{
+				CSRSparseMatrix sysMat;
+				Eigen::MatrixXd sysRhs;
+				const auto startAssembly = std::chrono::high_resolution_clock::now();
+				AssembleImplicitLaplacianSystem(icoMesh, MeshLaplacian::Voronoi, getVertexSystemRow, sysMat, sysRhs, nThreads);
+				const auto endAssembly = std::chrono::high_resolution_clock::now();
+				const std::chrono::duration<double> timeDiffAssembly = endAssembly - startAssembly;
+
+				const SparseMatrix sysMatDiff = SparseMatrix(sysMat) - refSysMat;
+				std::cout << "    AssembleImplicitLaplacianSystem (NThreads = " << nThreads << "): " << timeDiffAssembly.count() << " s, "
+					<< "|A - A_ref| = " << sysMatDiff.norm() << ", |b - b_ref| = " << (sysRhs - refSysRhs).norm() << "\n";
+			}
+		}
+	} // endif performImplicitSystemAssemblyBenchmark
+
+	if (performImplicitSystemSolverComparison)
+	{
+		constexpr unsigned int NSteps = 10;
+		const std::vector<std::pair<std::string, ImplicitSystemSolverType>> solverTypes{
+			{ "BiCGSTAB + IncompleteLUT", ImplicitSystemSolverType::BiCGSTAB_ILUT },
+			{ "CG + IncompleteCholesky", ImplicitSystemSolverType::CG_IncompleteCholesky },
+			{ "SimplicialLDLT", ImplicitSystemSolverType::SimplicialLDLT }
+		};
+
+		for (const unsigned int subdiv : { 5u, 6u })
+		{
+			std::cout << "IcoSphere subdiv " << subdiv << ", " << NSteps << " implicit MCF steps:\n";
+			Eigen::MatrixXd referenceResult;
+			for (const auto& [solverName, solverType] : solverTypes)
+			{
+				Geometry::IcoSphereBuilder ico({ subdiv, 1.0f });
+				ico.BuildBaseData();
+				ico.BuildPMPSurfaceMesh();
+				auto icoMesh = ico.GetPMPSurfaceMeshResult();
+				const auto NVertices = icoMesh.n_vertices();
+
+				ImplicitSystemSolver solver(solverType);
+				CSRSparseMatrix sysMat;
+				Eigen::MatrixXd sysRhs;
+				double solveTime = 0.0;
+				Eigen::Index nIterations = 0;
+				for (unsigned int ti = 1; ti <= NSteps; ti++)
+				{
+					const auto getVertexSystemRow = [&](const pmp::Vertex& v)
+					{
+						const Eigen::Vector3d vertexRhs = icoMesh.position(v);
+						return ImplicitSystemRow{ vertexRhs, 0.01, false };
+					};
+					if (IsSymmetricSolverType(solverType))
+						AssembleSymmetricImplicitLaplacianSystem(icoMesh, MeshLaplacian::Voronoi, getVertexSystemRow, sysMat, sysRhs);
+					else
+						AssembleImplicitLaplacianSystem(icoMesh, MeshLaplacian::Voronoi, getVertexSystemRow, sysMat, sysRhs);
+
+					Eigen::MatrixXd xGuess(NVertices, 3);
+					for (const auto v : icoMesh.vertices())
+						xGuess.row(v.idx()) = Eigen::Vector3d(icoMesh.position(v));
+
+					const auto startSolve = std::chrono::high_resolution_clock::now();
+					solver.Compute(sysMat, ti);
+					const Eigen::MatrixXd x = solver.Solve(sysRhs, xGuess);
+					const auto endSolve = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiffSolve = endSolve - startSolve;
+					solveTime += timeDiffSolve.count();
+					nIterations += solver.Iterations();
+					if (solver.Info() != Eigen::Success)
+					{
+						std::cout << "    " << solverName << ": " << InterpretSolverErrorCode(solver.Info()) << " in step " << ti << "\n";
+						break;
+					}
+
+					for (const auto v : icoMesh.vertices())
+						icoMesh.position(v) = pmp::Point(x(v.idx(), 0), x(v.idx(), 1), x(v.idx(), 2));
+				}
+
+				Eigen::MatrixXd result(NVertices, 3);
+				for (const auto v : icoMesh.vertices())
+					result.row(v.idx()) = Eigen::Vector3d(icoMesh.position(v));
+				if (referenceResult.size() == 0)
+					referenceResult = result;
+
+				std::cout << "    " << solverName << ": " << solveTime / NSteps << " s per step, "
+					<< static_cast<double>(nIterations) / NSteps << " iterations per step, max |x - x_BiCGSTAB| = "
+					<< (result - referenceResult).cwiseAbs().maxCoeff() << "\n";
+			}
+		}
+	} // endif performImplicitSystemSolverComparison
+
+	if (performPreconditionerRefreshBenchmark)
+	{
+		// BiCGSTAB + IncompleteLUT with the preconditioner reused between steps. The measured time per step is Compute + Solve,
+		// so it includes the ILUT factorization on the steps which refactorize.
+		// Without refreshes the iteration count grows as the system drifts away from the factorized one, so both short and long runs are measured.
+		Geometry::IcoSphereBuilder ico({ 6, 1.0f });
+		ico.BuildBaseData();
+		ico.BuildPMPSurfaceMesh();
+		const auto startMesh = ico.GetPMPSurfaceMeshResult();
+		const auto NVertices = startMesh.n_vertices();
+
+		for (const unsigned int NSteps : { 20u, 80u })
+		{
+			std::cout << "IcoSphere subdiv 6 (" << NVertices << " vertices), " << NSteps << " implicit steps with a varying laplacian weight:\n";
+			for (const unsigned int refreshStride : { 1u, 0u, 3u })
+			{
+				auto icoMesh = startMesh;
+				ImplicitSystemSolver solver(ImplicitSystemSolverType::BiCGSTAB_ILUT, refreshStride);
+				CSRSparseMatrix sysMat;
+				Eigen::MatrixXd sysRhs;
+				double solveTime = 0.0;
+				Eigen::Index nIterations = 0;
+				unsigned int nRefactorizations = 0;
+				for (unsigned int ti = 1; ti <= NSteps; ti++)
+				{
+					const auto getVertexSystemRow = [&](const pmp::Vertex& v)
+					{
+						const Eigen::Vector3d vertexRhs = icoMesh.position(v);
+						return ImplicitSystemRow{ vertexRhs, 0.002 * (1.0 + 0.5 * std::sin(0.1 * ti + v.idx())), false };
+					};
+					AssembleImplicitLaplacianSystem(icoMesh, MeshLaplacian::Voronoi, getVertexSystemRow, sysMat, sysRhs);
+
+					Eigen::MatrixXd xGuess(NVertices, 3);
+					for (const auto v : icoMesh.vertices())
+						xGuess.row(v.idx()) = Eigen::Vector3d(icoMesh.position(v));
+
+					const auto startSolve = std::chrono::high_resolution_clock::now();
+					solver.Compute(sysMat, ti);
+					const Eigen::MatrixXd x = solver.Solve(sysRhs, xGuess);
+					const auto endSolve = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiffSolve = endSolve - startSolve;
+					solveTime += timeDiffSolve.count();
+					nIterations += solver.Iterations();
+					nRefactorizations += solver.WasRefactorized() ? 1 : 0;
+					if (solver.Info() != Eigen::Success)
+					{
+						std::cout << "    refresh stride " << refreshStride << ": " << InterpretSolverErrorCode(solver.Info()) << " in step " << ti << "\n";
+						break;
+					}
+
+					for (const auto v : icoMesh.vertices())
+						icoMesh.position(v) = pmp::Point(x(v.idx(), 0), x(v.idx(), 1), x(v.idx(), 2));
+				}
+
+				std::cout << "    refresh stride " << refreshStride << ": " << solveTime / NSteps << " s per step (compute + solve), "
+					<< static_cast<double>(nIterations) / NSteps << " iterations per step, " << nRefactorizations << " factorizations\n";
+			}
+		}
+	} // endif performPreconditionerRefreshBenchmark
+
+	if (performMatrixFreeSolverBenchmark)
+	{
+		// a single implicit MCF step with small time steps (strongly diagonally dominant system)
+		const std::vector<std::pair<std::string, ImplicitSystemSolverType>> solverTypes{
+			{ "MatrixFreeJacobi", ImplicitSystemSolverType::MatrixFreeJacobi },
+			{ "MatrixFreeChebyshev", ImplicitSystemSolverType::MatrixFreeChebyshev }
+		};
+
+		Geometry::IcoSphereBuilder ico({ 6, 1.0f });
+		ico.BuildBaseData();
+		ico.BuildPMPSurfaceMesh();
+		const auto icoMesh = ico.GetPMPSurfaceMeshResult();
+		const auto NVertices = icoMesh.n_vertices();
+		Eigen::MatrixXd xGuess(NVertices, 3);
+		for (const auto v : icoMesh.vertices())
+			xGuess.row(v.idx()) = Eigen::Vector3d(icoMesh.position(v));
+
+		for (const double laplacianWeight : { 1e-5, 1e-4, 1e-3 })
+		{
+			std::cout << "IcoSphere subdiv 6, laplacian weight " << laplacianWeight << ":\n";
+			const auto getVertexSystemRow = [&](const pmp::Vertex& v)
+			{
+				const Eigen::Vector3d vertexRhs = icoMesh.position(v);
+				return ImplicitSystemRow{ vertexRhs, laplacianWeight, false };
+			};
+
+			for (const unsigned int nIterations : { 3u, 6u, 10u })
+			{
+				for (const auto& [solverName, solverType] : solverTypes)
+				{
+					const auto startMatrixFree = std::chrono::high_resolution_clock::now();
+					ImplicitSystemStencil sysStencil;
+					Eigen::MatrixXd sysRhs;
+					AssembleImplicitLaplacianStencil(icoMesh, MeshLaplacian::Voronoi, getVertexSystemRow, sysStencil, sysRhs, 0);
+					ImplicitSystemSolver solver(solverType, 0, nIterations, 0);
+					solver.Compute(sysStencil, 1);
+					const Eigen::MatrixXd x = solver.Solve(sysRhs, xGuess);
+					const auto endMatrixFree = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiffMatrixFree = endMatrixFree - startMatrixFree;
+					if (solver.Info() != Eigen::Success)
+					{
+						std::cout << "    " << solverName << ": " << InterpretSolverErrorCode(solver.Info()) << "\n";
+						continue;
+					}
+
+					// BiCGSTAB solving the assembled system to the residual reached by the matrix-free solver
+					const auto startBiCGSTAB = std::chrono::high_resolution_clock::now();
+					CSRSparseMatrix sysMat;
+					Eigen::MatrixXd sysMatRhs;
+					AssembleImplicitLaplacianSystem(icoMesh, MeshLaplacian::Voronoi, getVertexSystemRow, sysMat, sysMatRhs, 0);
+					Eigen::BiCGSTAB<CSRSparseMatrix, Eigen::IncompleteLUT<double>> bicgstab;
+					bicgstab.setTolerance(solver.Error());
+					bicgstab.compute(sysMat);
+					const Eigen::MatrixXd xBiCGSTAB = bicgstab.solveWithGuess(sysMatRhs, xGuess);
+					const auto endBiCGSTAB = std::chrono::high_resolution_clock::now();
+					const std::chrono::duration<double> timeDiffBiCGSTAB = endBiCGSTAB - startBiCGSTAB;
+
+					std::cout << "    " << solverName << " (" << nIterations << " iterations): residual " << solver.Error()
+						<< " in " << timeDiffMatrixFree.count() << " s, BiCGSTAB: residual "
+						<< (sysMatRhs - sysMat * xBiCGSTAB).norm() / sysMatRhs.norm() << " in " << timeDiffBiCGSTAB.count() << " s\n";
+				}
+			}
+		}
+	} // endif performMatrixFreeSolverBenchmark
+}
\ No newline at end of file
@@ -235,7 +235,7 @@ void SheetMembraneEvolver::Evolve()
 
 	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
 	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
+	CSRSparseMatrix sysMat(NVertices, NVertices);
 	Eigen::MatrixXd sysRhs(NVertices, 3);
 	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
 	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
@@ -247,7 +247,8 @@ void SheetMembraneEvolver::Evolve()
 	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
 	{
 		const Eigen::Vector3d downVec{ 0.0, 0.0, -1.0 };
-		for (const auto v : m_EvolvingSurface->vertices())
+		// rows are assembled concurrently, so the row function only reads the mesh and its properties.
+		const auto getVertexSystemRow = [&](const pmp::Vertex& v)
 		{
 			const auto vPosToUpdate = m_EvolvingSurface->position(v);
 
@@ -256,9 +257,7 @@ void SheetMembraneEvolver::Evolve()
 			{
 				// move boundary/feature vertices along downVec
 				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs + tStep * m_SheetSurfaceVelocity * downVec;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
+				return ImplicitSystemRow{ vertexRhs + tStep * m_SheetSurfaceVelocity * downVec, 0.0, true };
 			}
 
 			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
@@ -267,24 +266,19 @@ void SheetMembraneEvolver::Evolve()
 			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
 			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
 
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
+			Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
 			const float tanRedistWeight = m_EvolSettings.TangentialVelocityWeight * epsilonCtrlWeight;
 			if (tanRedistWeight > 0.0f)
 			{
 				// compute tangential velocity
 				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
+				vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 			}
 
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
+			return ImplicitSystemRow{ vertexRhs, tStep * epsilonCtrlWeight, false };
+		};
 
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
-		}
+		AssembleImplicitLaplacianSystem(*m_EvolvingSurface, m_EvolSettings.LaplacianType, getVertexSystemRow, sysMat, sysRhs, m_EvolSettings.NThreads);
 	};
 	// -----------------------------------------------------------------
 
@@ -338,7 +332,7 @@ void SheetMembraneEvolver::Evolve()
 		std::cout << "Solving linear system ... ";
 #endif
 		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
+		Eigen::BiCGSTAB<CSRSparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
 		Eigen::MatrixXd x = solver.solve(sysRhs);
 		if (solver.info() != Eigen::Success)
 		{
@@ -403,7 +397,9 @@ void SheetMembraneEvolver::Evolve()
 				minEdgeLength, maxEdgeLength, approxError,
 				m_EvolSettings.TopoParams.NRemeshingIters,
 				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
+				m_EvolSettings.TopoParams.UseBackProjection,
+				m_EvolSettings.NThreads,
+				m_EvolSettings.TopoParams.UseParallelCandidateEvaluation });
 			//remeshing.uniform_remeshing(targetEdgeLength);
 #if REPORT_EVOL_STEPS
 			std::cout << "done\n";
@@ -444,7 +440,7 @@ void SheetMembraneEvolver::Evolve()
 		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
 		{
 			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
+			sysMat = CSRSparseMatrix(NVertices, NVertices);
 			sysRhs = Eigen::MatrixXd(NVertices, 3);
 		}
 
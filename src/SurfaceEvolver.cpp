@@ -10,7 +10,9 @@
 #include "geometry/MeshAnalysis.h"
 
 //#include "ConversionUtils.h"
+#include <chrono>
 #include <fstream>
+#include <optional>
 
 // ================================================================================================
 
@@ -81,11 +83,21 @@ SurfaceEvolver::SurfaceEvolver(const Geometry::ScalarGrid& field, const float& f
 			pmp::voronoi_area_barycentric : pmp::voronoi_area);	
 }
 
+SurfaceEvolver::SurfaceEvolver(const Geometry::SparseScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings)
+	: m_EvolSettings(settings), m_SparseField(std::make_shared<Geometry::SparseScalarGrid>(field)), m_ExpansionFactor(fieldExpansionFactor)
+{
+	m_ImplicitLaplacianFunction =
+		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
+			pmp::laplace_implicit_barycentric : pmp::laplace_implicit_voronoi);
+	m_LaplacianAreaFunction =
+		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
+			pmp::voronoi_area_barycentric : pmp::voronoi_area);
+}
+
 // ================================================================================================
 
 void SurfaceEvolver::Preprocess()
 {
-	auto& field = *m_Field;
 
 	// build ico-sphere
 	const float icoSphereRadius = ICO_SPHERE_RADIUS_FACTOR * 
@@ -128,8 +140,16 @@ void SurfaceEvolver::Preprocess()
 	m_TransformToOriginal = inverse(transfMatrixFull);
 
 	(*m_EvolvingSurface) *= transfMatrixGeomScale; // ico sphere is already centered at (0,0,0).
-	field *= transfMatrixFull; // field needs to be moved to (0,0,0) and also scaled.
-	field *= static_cast<double>(scalingFactor); // scale also distance values.
+	if (m_SparseField)
+	{
+		(*m_SparseField) *= transfMatrixFull; // field needs to be moved to (0,0,0) and also scaled.
+		(*m_SparseField) *= static_cast<double>(scalingFactor); // scale also distance values.
+	}
+	else
+	{
+		(*m_Field) *= transfMatrixFull; // field needs to be moved to (0,0,0) and also scaled.
+		(*m_Field) *= static_cast<double>(scalingFactor); // scale also distance values.
+	}
 
 	// >>>>> Scaled geometry & field (use when debugging) <<<<<<
 	//ExportToVTI(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_scaledField", *m_Field);
@@ -173,45 +193,73 @@ void SurfaceEvolver::ExportSurface(const unsigned int& tId, const bool& isResult
 	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
 }
 
-void SurfaceEvolver::ComputeTriangleMetrics() const
+PostStepAnalysisSettings SurfaceEvolver::GetPostStepAnalysisSettings(const bool& isExported) const
 {
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
+	PostStepAnalysisSettings settings{};
+	settings.ComputeCoVolumes = isExported || REPORT_EVOL_STEPS || m_EvolSettings.TimeStepControl.UseAdaptiveTimeStep;
+	settings.ComputeDihedralAngles = isExported;
+	settings.ComputeCurvatures = isExported;
+	settings.PrincipalCurvatureFactor = m_EvolSettings.TopoParams.PrincipalCurvatureFactor;
+	settings.NThreads = m_EvolSettings.NThreads;
+	if (isExported)
 	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
-
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
-
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "SurfaceEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
+		settings.TriMetrics = m_EvolSettings.TriMetrics;
+		return settings;
 	}
+
+	// the next time step tests remeshing necessity by "v:equilateralJacobianCondition".
+	if (m_EvolSettings.DoRemeshing && std::ranges::find(m_EvolSettings.TriMetrics, "equilateralJacobianCondition") != m_EvolSettings.TriMetrics.end())
+		settings.TriMetrics = { "equilateralJacobianCondition" };
+	return settings;
 }
 
 // ================================================================================================
 
 void SurfaceEvolver::Evolve()
 {
-	if (!m_Field)
+	if (!m_Field && !m_SparseField)
 		throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field not set! Terminating!\n");
-	if (!m_Field->IsValid())
+	if ((m_Field && !m_Field->IsValid()) || (m_SparseField && !m_SparseField->IsValid()))
 		throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field is invalid! Terminating!\n");
 
-	const auto& field = *m_Field;
-
 	Preprocess();
 
 	if (!m_EvolvingSurface)
 		throw std::invalid_argument("SurfaceEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
 
 #if VERIFY_SOLUTION_WITHIN_BOUNDS
-	const auto& fieldBox = field.Box();
+	const auto& fieldBox = (m_SparseField ? m_SparseField->Box() : m_Field->Box());
 #endif
-	const auto fieldNegGradient = Geometry::ComputeNormalizedNegativeGradient(field);
+	// a sparse field's gradient is sampled on the fly, a dense field's gradient is precomputed.
+	const auto fieldNegGradient = (m_SparseField ? std::optional<Geometry::VectorGrid>{} : Geometry::ComputeNormalizedNegativeGradient(*m_Field));
+	// the fields are sampled at all vertex positions at once (indexed by vertex idx). A dense field is sampled in parallel batches.
+	const auto sampleDistances = [&](const std::vector<pmp::Point>& pts)
+	{
+		if (!m_SparseField)
+			return Geometry::TrilinearInterpolateScalarValues(pts, *m_Field, m_EvolSettings.NThreads);
+		std::vector<double> distances(pts.size());
+		for (size_t i = 0; i < pts.size(); i++)
+			distances[i] = Geometry::TrilinearInterpolateScalarValue(pts[i], *m_SparseField);
+		return distances;
+	};
+	const auto sampleNegGradients = [&](const std::vector<pmp::Point>& pts)
+	{
+		if (!m_SparseField)
+			return Geometry::TrilinearInterpolateVectorValues(pts, *fieldNegGradient, m_EvolSettings.NThreads);
+		std::vector<pmp::dvec3> negGradients(pts.size());
+		for (size_t i = 0; i < pts.size(); i++)
+			negGradients[i] = Geometry::TrilinearInterpolateNormalizedNegativeGradient(pts[i], *m_SparseField);
+		return negGradients;
+	};
 
 	const auto& NSteps = m_EvolSettings.NSteps;
 	auto tStep = m_EvolSettings.TimeStep;
+#if REPORT_EVOL_STEPS
+	double elapsedTime = 0.0; // evolution time (the sum of accepted time steps).
+#endif
+	std::optional<AdaptiveTimeStepController> tStepController{};
+	if (m_EvolSettings.TimeStepControl.UseAdaptiveTimeStep)
+		tStepController.emplace(m_EvolSettings.TimeStep, m_EvolSettings.TimeStepControl);
 
 	// ........ evaluate edge lengths for remeshing ....................
 	const auto subdiv = static_cast<float>(m_EvolSettings.IcoSphereSubdivisionLevel);
@@ -231,8 +279,11 @@ void SurfaceEvolver::Evolve()
 
 	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
 	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
+	CSRSparseMatrix sysMat(NVertices, NVertices);
+	ImplicitSystemStencil sysStencil{}; // replaces sysMat for matrix-free solver types.
 	Eigen::MatrixXd sysRhs(NVertices, 3);
+	ImplicitSystemSolver solver(m_EvolSettings.SolverType, m_EvolSettings.PreconditionerRefreshStride,
+		m_EvolSettings.NMatrixFreeIterations, m_EvolSettings.NThreads); // kept alive between time steps, so that the preconditioner can be reused.
 	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
 	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
 	auto vIsFeatureVal = m_EvolvingSurface->vertex_property<pmp::Scalar>("v:isFeature", -1.0f);
@@ -243,10 +294,10 @@ void SurfaceEvolver::Evolve()
 	// ----------- System fill function --------------------------------
 	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
 	{
-		std::vector<Eigen::Triplet<double>> tripletList;
-		tripletList.reserve(static_cast<size_t>(NVertices) * 6);  // Assuming an average of 6 entries per vertex
+		const auto vNegGradients = sampleNegGradients(m_EvolvingSurface->positions());
 
-		for (const auto v : m_EvolvingSurface->vertices())
+		// rows are assembled concurrently, so the row function only reads the mesh and its properties.
+		const auto getVertexSystemRow = [&](const pmp::Vertex& v)
 		{
 			const auto vPosToUpdate = m_EvolvingSurface->position(v);
 
@@ -255,43 +306,38 @@ void SurfaceEvolver::Evolve()
 			{
 				// freeze boundary/feature vertices
 				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				tripletList.emplace_back(Eigen::Triplet<double>(v.idx(), v.idx(), 1.0));
-				continue;
+				return ImplicitSystemRow{ vertexRhs, 0.0, true };
 			}
 
-			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
+			const auto& vNegGradDistanceToTarget = vNegGradients[v.idx()];
 			const auto vNormal = vNormalsProp[v]; // vertex unit normal
 
 			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
 			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
 
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
+			Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
 			const float tanRedistWeight = static_cast<double>(m_EvolSettings.TangentialVelocityWeight) * epsilonCtrlWeight;
 			if (tanRedistWeight > 0.0f)
 			{
 				// compute tangential velocity
 				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
+				vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 			}
 
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			tripletList.emplace_back(Eigen::Triplet<double>(v.idx(), v.idx(), 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum)));
-
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				tripletList.emplace_back(Eigen::Triplet<double>(v.idx(), w.idx(), -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight)));
-			}
-		}
+			return ImplicitSystemRow{ vertexRhs, tStep * epsilonCtrlWeight, false };
+		};
 
-		// After the loop
-		sysMat.setFromTriplets(tripletList.begin(), tripletList.end());
+		if (IsMatrixFreeSolverType(m_EvolSettings.SolverType))
+			AssembleImplicitLaplacianStencil(*m_EvolvingSurface, m_EvolSettings.LaplacianType, getVertexSystemRow, sysStencil, sysRhs, m_EvolSettings.NThreads);
+		else if (IsSymmetricSolverType(m_EvolSettings.SolverType))
+			AssembleSymmetricImplicitLaplacianSystem(*m_EvolvingSurface, m_EvolSettings.LaplacianType, getVertexSystemRow, sysMat, sysRhs, m_EvolSettings.NThreads);
+		else
+			AssembleImplicitLaplacianSystem(*m_EvolvingSurface, m_EvolSettings.LaplacianType, getVertexSystemRow, sysMat, sysRhs, m_EvolSettings.NThreads);
 	};
 	// -----------------------------------------------------------------
 
 	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+	auto coVolStats = AnalyzeMeshAfterTimeStep(*m_EvolvingSurface, m_LaplacianAreaFunction, GetPostStepAnalysisSettings(m_EvolSettings.ExportSurfacePerTimeStep || NSteps == 0));
 #if REPORT_EVOL_STEPS
 	std::ofstream fileOStreamMins(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMins.txt");
 	std::ofstream fileOStreamMeans(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMeans.txt");
@@ -302,16 +348,12 @@ void SurfaceEvolver::Evolve()
 	fileOStreamMaxes << coVolStats.Max << ", ";
 #endif
 	// set initial surface vertex properties
+	const auto vInitDistances = sampleDistances(m_EvolvingSurface->positions());
 	for (const auto v : m_EvolvingSurface->vertices())
 	{
-		const auto vPos = m_EvolvingSurface->position(v);
-		const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-		vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+		vDistance[v] = static_cast<pmp::Scalar>(vInitDistances[v.idx()]);
 		vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
 	}
-	Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-	Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface, m_EvolSettings.TopoParams.PrincipalCurvatureFactor);
-	ComputeTriangleMetrics();
 	if (m_EvolSettings.ExportSurfacePerTimeStep)
 		ExportSurface(0);
 
@@ -323,7 +365,7 @@ void SurfaceEvolver::Evolve()
 	for (unsigned int ti = 1; ti <= NSteps; ti++)
 	{
 #if REPORT_EVOL_STEPS
-		std::cout << "time step id: " << ti << "/" << NSteps << ", time: " << tStep * ti << " "
+		std::cout << "time step id: " << ti << "/" << NSteps << ", time: " << elapsedTime + tStep << " "
 		<< ", Procedure Name: " << m_EvolSettings.ProcedureName << "\n";
 		std::cout << "pmp::Normals::compute_vertex_normals ... ";
 #endif
@@ -334,25 +376,62 @@ void SurfaceEvolver::Evolve()
 		std::cout << "fillMatrixAndRHSTriplesFromMesh for " << NVertices << " vertices ... ";
 #endif
 
-		// prepare matrix & rhs
-		fillMatrixAndRHSTriplesFromMesh();
+		// a step with too large vertex displacements is repeated with the time step proposed by tStepController.
+		Eigen::MatrixXd x;
+		bool isStepAccepted = true;
+		do
+		{
+			// prepare matrix & rhs
+			fillMatrixAndRHSTriplesFromMesh();
+
+			// warm start from the current vertex positions
+			Eigen::MatrixXd xGuess(NVertices, 3);
+			for (const auto v : m_EvolvingSurface->vertices())
+				xGuess.row(v.idx()) = Eigen::Vector3d(m_EvolvingSurface->position(v));
 
 #if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Solving linear system ... ";
+			std::cout << "done\n";
+			std::cout << "Solving linear system ... ";
+			const auto startSolve = std::chrono::high_resolution_clock::now();
 #endif
-		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
-		Eigen::MatrixXd x = solver.solve(sysRhs);
-		if (solver.info() != Eigen::Success)
-		{
-			const std::string msg = "\nSurfaceEvolver::Evolve: solver.info() != Eigen::Success for time step id: "
-				+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solver.info()) + "\n";
-			std::cerr << msg;
-			throw std::runtime_error(msg);
-		}
+			// solve
+			if (IsMatrixFreeSolverType(m_EvolSettings.SolverType))
+				solver.Compute(sysStencil, ti);
+			else
+				solver.Compute(sysMat, ti);
+			x = solver.Solve(sysRhs, xGuess);
+			if (solver.Info() != Eigen::Success)
+			{
+				const std::string msg = "\nSurfaceEvolver::Evolve: solver.info() != Eigen::Success for time step id: "
+					+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solver.Info()) + "\n";
+				std::cerr << msg;
+				throw std::runtime_error(msg);
+			}
+#if REPORT_EVOL_STEPS
+			const auto endSolve = std::chrono::high_resolution_clock::now();
+			const std::chrono::duration<double> timeDiffSolve = endSolve - startSolve;
+			std::cout << "done in " << timeDiffSolve.count() << " s (" << solver.Iterations() << " iterations, preconditioner "
+				<< (solver.WasRefactorized() ? "refactorized" : "reused") << (solver.UsedFallback() ? ", matrix-free fallback to BiCGSTAB_ILUT" : "") << ")\n";
+#endif
+
+			if (!tStepController)
+				break;
+
+			const double displacementRatio = ComputeMaxDisplacementRatio(*m_EvolvingSurface, x, m_EvolSettings.FieldIsoLevel, m_EvolSettings.NThreads);
+			isStepAccepted = tStepController->Update(displacementRatio);
+#if REPORT_EVOL_STEPS
+			std::cout << "displacement ratio: " << displacementRatio << (isStepAccepted ? ", step accepted" : ", step rejected")
+				<< ", time step adjustment: " << tStep << " -> " << tStepController->TimeStep() << "\n";
+#endif
+			if (!isStepAccepted)
+				tStep = tStepController->TimeStep();
+		} while (!isStepAccepted);
+#if REPORT_EVOL_STEPS
+		elapsedTime += tStep;
+#endif
+		if (tStepController)
+			tStep = tStepController->TimeStep();
 #if REPORT_EVOL_STEPS
-		std::cout << "done\n";
 		std::cout << "Updating vertex positions ... ";
 #endif
 
@@ -411,11 +490,25 @@ void SurfaceEvolver::Evolve()
 			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << minEdgeLength << ", maxEdgeLength: " << maxEdgeLength << ", approxError: " << approxError << ") ... ";
 #endif
 			pmp::Remeshing remeshing(*m_EvolvingSurface);
-			remeshing.adaptive_remeshing({
+			const pmp::AdaptiveRemeshingSettings remeshingSettings{
 				minEdgeLength, maxEdgeLength, approxError,
 				m_EvolSettings.TopoParams.NRemeshingIters,
 				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
+				m_EvolSettings.TopoParams.UseBackProjection,
+				m_EvolSettings.NThreads,
+				m_EvolSettings.TopoParams.UseParallelCandidateEvaluation };
+			if (m_EvolSettings.TopoParams.UseLocalRemeshing)
+			{
+				const auto degradedVertices = CollectVerticesForRemeshing(*m_EvolvingSurface);
+#if REPORT_EVOL_STEPS
+				std::cout << "local remeshing around " << degradedVertices.size() << " vertices ... ";
+#endif
+				remeshing.local_adaptive_remeshing(remeshingSettings, degradedVertices, m_EvolSettings.TopoParams.NLocalRemeshingRings);
+			}
+			else
+			{
+				remeshing.adaptive_remeshing(remeshingSettings);
+			}
 #if REPORT_EVOL_STEPS
 			std::cout << "done\n";
 #endif
@@ -435,6 +528,8 @@ void SurfaceEvolver::Evolve()
 			std::cout << "time step adjustment: " << tStep << " -> ";
 #endif
 			tStep *= pow(m_EvolSettings.TopoParams.EdgeLengthDecayFactor, 2);
+			if (tStepController)
+				tStepController->Scale(pow(m_EvolSettings.TopoParams.EdgeLengthDecayFactor, 2));
 #if REPORT_EVOL_STEPS
 			std::cout << tStep << ".\n";
 			std::cout << "AdvectionMultiplier adjustment: " << m_EvolSettings.ADParams.AdvectionMultiplier << " -> ";
@@ -449,7 +544,8 @@ void SurfaceEvolver::Evolve()
 
 		// --------------------------------------------------------------------
 
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+		// the last time step is fully analyzed for the result surface.
+		coVolStats = AnalyzeMeshAfterTimeStep(*m_EvolvingSurface, m_LaplacianAreaFunction, GetPostStepAnalysisSettings(m_EvolSettings.ExportSurfacePerTimeStep || ti == NSteps));
 
 #if REPORT_EVOL_STEPS
 		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
@@ -458,16 +554,12 @@ void SurfaceEvolver::Evolve()
 		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
 #endif
 		// set surface vertex properties
+		const auto vDistances = sampleDistances(m_EvolvingSurface->positions());
 		for (const auto v : m_EvolvingSurface->vertices())
 		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-			vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+			vDistance[v] = static_cast<pmp::Scalar>(vDistances[v.idx()]);
 			vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
 		}
-		Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-		Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface, m_EvolSettings.TopoParams.PrincipalCurvatureFactor);
-		ComputeTriangleMetrics();
 
 		// one-time feature detection flag
 		if (!shouldDetectFeatures)
@@ -479,9 +571,8 @@ void SurfaceEvolver::Evolve()
 		// update linear system dims for next time step:
 		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
 		{
+			// sysMat and sysRhs are resized by the next assembly, and the changed pattern refactorizes the preconditioner.
 			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
-			sysRhs = Eigen::MatrixXd(NVertices, 3);
 		}
 
 #if REPORT_EVOL_STEPS
@@ -521,6 +612,7 @@ void ReportInput(const SurfaceEvolutionSettings& evolSettings, std::ostream& os)
 	os << "Target Name: " << evolSettings.ProcedureName << ",\n";
 	os << "NSteps: " << evolSettings.NSteps << ",\n";
 	os << "TimeStep: " << evolSettings.TimeStep << ",\n";
+	os << "Adaptive TimeStep: " << (evolSettings.TimeStepControl.UseAdaptiveTimeStep ? "true" : "false") << ",\n";
 	os << "FieldIsoLevel: " << evolSettings.FieldIsoLevel << ",\n";
 	os << "IcoSphereSubdivisionLevel: " << evolSettings.IcoSphereSubdivisionLevel << ",\n";
 	os << "......................................................................\n";
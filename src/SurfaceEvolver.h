@@ -4,6 +4,7 @@
 #include "pmp/algorithms/DifferentialGeometry.h"
 
 #include "geometry/Grid.h"
+#include "geometry/SparseGrid.h"
 
 #include "EvolverUtilsCommon.h"
 
@@ -40,6 +41,11 @@ struct SurfaceEvolutionSettings
 	bool IdentityForBoundaryVertices{ true }; //>! if true, boundary vertices give rise to: updated vertex = previous vertex.
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+	unsigned int NThreads{ 1 }; //>! the number of worker threads for the parallelized per-vertex stages of each time step. NThreads == 0 uses all hardware threads.
+	ImplicitSystemSolverType SolverType{ ImplicitSystemSolverType::BiCGSTAB_ILUT }; //>! formulation and solver of the linear system of each time step.
+	unsigned int PreconditionerRefreshStride{ 3 }; //>! if > 0, the solver's preconditioner is refactorized every PreconditionerRefreshStride steps. Otherwise only after a change of the system's sparsity pattern (or a failed solve). Refactorizing every step pays a full ILUT factorization per step, whereas a never refreshed ILUT lets the BiCGSTAB iteration count grow as the surface moves. Every 3 steps balances both.
+	unsigned int NMatrixFreeIterations{ 10 }; //>! the fixed number of iterations for ImplicitSystemSolverType::MatrixFreeJacobi and MatrixFreeChebyshev.
+	AdaptiveTimeStepSettings TimeStepControl{}; //>! adaptive time step control. If TimeStepControl.UseAdaptiveTimeStep == true, TimeStep is the initial time step.
 };
 
 /**
@@ -57,6 +63,16 @@ public:
 	 */
 	SurfaceEvolver(const Geometry::ScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings);
 
+	/**
+	 * \brief Constructor. Initialize with a given sparse (narrow-band) scalar field environment.
+	 * \param field                    pre-computed sparse scalar field environment.
+	 * \param fieldExpansionFactor     the factor by which target bounds are expanded (multiplying original bounds min dimension).
+	 * \param settings                 surface evolution settings.
+	 *
+	 * DISCLAIMER: The negative gradient of a sparse field is evaluated on the fly at vertex positions, i.e.: no dense gradient grid is allocated.
+	 */
+	SurfaceEvolver(const Geometry::SparseScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings);
+
 	/**
 	 * \brief Main functionality.
 	 */
@@ -107,15 +123,18 @@ private:
 	void ExportSurface(const unsigned int& tId, const bool& isResult = false, const bool& transformToOriginal = true) const;
 
 	/**
-	 * \brief Computes triangle metrics interpolated to vertices according to list m_EvolSettings.TriMetrics.
+	 * \brief Specifies the mesh properties computed after a time step by AnalyzeMeshAfterTimeStep.
+	 * \param isExported    if true, all properties (including the whole list m_EvolSettings.TriMetrics) are computed for the exported surface.
+	 * \return analysis settings. Without export, only the properties consumed by the next time step (or by REPORT_EVOL_STEPS) are computed.
 	 */
-	void ComputeTriangleMetrics() const;
+	[[nodiscard]] PostStepAnalysisSettings GetPostStepAnalysisSettings(const bool& isExported) const;
 
 	// ----------------------------------------------------------------
 
 	SurfaceEvolutionSettings m_EvolSettings{}; //>! settings.
 
 	std::shared_ptr<Geometry::ScalarGrid> m_Field{ nullptr }; //>! scalar field environment.
+	std::shared_ptr<Geometry::SparseScalarGrid> m_SparseField{ nullptr }; //>! sparse scalar field environment (used instead of m_Field if set).
 	std::shared_ptr<pmp::SurfaceMesh> m_EvolvingSurface{ nullptr }; //>! (stabilized) evolving surface.
 
 	float m_ExpansionFactor{ 0.0f }; //>! the factor by which target bounds are expanded (multiplying original bounds min dimension).
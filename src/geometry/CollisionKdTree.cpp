@@ -1,11 +1,15 @@
 #include "CollisionKdTree.h"
 
 #include "geometry/GeometryUtil.h"
+#include "utils/ParallelUtils.h"
 
 #include "pmp/algorithms/Triangulation.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <numeric>
-#include <stack>
+#include <type_traits>
 
 
 namespace Geometry
@@ -16,6 +20,12 @@ namespace Geometry
 	//! \brief maximum allowed depth of the CollisionKdTree.
 	constexpr unsigned int MAX_DEPTH = 20;
 
+	//! \brief the number of independent subtrees per worker thread, to be built serially as the top levels of a parallel kd-tree build.
+	constexpr size_t KD_TREE_SUBTREES_PER_THREAD = 8;
+
+	//! \brief nodes with at most this many triangles are not split further by the serial part of a parallel build, they are built as a single subtree.
+	constexpr size_t KD_TREE_PARALLEL_BUILD_CUTOFF = 1024;
+
 	/**
 	 * \brief Converts polygons from a mesh given by its adapter to triangles.
 	 * \param meshAdapter     Input mesh adapter.
@@ -44,7 +54,7 @@ namespace Geometry
 		}
 	}
 
-	CollisionKdTree::CollisionKdTree(const MeshAdapter& meshAdapter, const SplitFunction& spltFunc)
+	CollisionKdTree::CollisionKdTree(const MeshAdapter& meshAdapter, const SplitFunction& spltFunc, const unsigned int& nThreads)
 	{
 		auto bbox = meshAdapter.GetBounds();
 		bbox.expand(BOX_INFLATION, BOX_INFLATION, BOX_INFLATION);
@@ -58,20 +68,35 @@ namespace Geometry
 		const auto triIds = triMesh->GetPolyIndices();
 		const size_t nTriangles = triIds.size();
 		m_Triangles.reserve(nTriangles);
+		m_TriangleVertexData.Reserve(nTriangles);
 		for (const auto& tri : triIds)
 		{
 			m_Triangles.emplace_back(Triangle{ tri[0], tri[1], tri[2] });
+			m_TriangleVertexData.Add(m_VertexPositions[tri[0]], m_VertexPositions[tri[1]], m_VertexPositions[tri[2]]);
 		}
 
-		m_FindSplitAndClassify = spltFunc;
+		m_FindSplitPosition = spltFunc;
 
 		// generate index array to primitives
 		std::vector<unsigned int> triangleIds(m_Triangles.size());
 		std::iota(triangleIds.begin(), triangleIds.end(), 0);
 
-		m_Root = new Node();
-		m_NodeCount++;
-		BuildRecurse(m_Root, bbox, triangleIds, MAX_DEPTH);
+		m_RootBox = bbox;
+		const unsigned int nWorkers = Utils::GetWorkerThreadCount(nThreads);
+		if (nWorkers > 1 && nTriangles > KD_TREE_PARALLEL_BUILD_CUTOFF)
+		{
+			BuildParallel(bbox, std::move(triangleIds), nWorkers);
+			return;
+		}
+
+		BuildBuffers buffers{};
+		buffers.TriangleIds = std::move(triangleIds);
+		if (!BuildRecurse(bbox, 0, nTriangles, MAX_DEPTH, buffers))
+			buffers.Nodes.back() = FlatNode{}; // an empty root leaf is kept
+		m_Nodes = std::move(buffers.Nodes);
+		m_LeafTriangleIds = std::move(buffers.LeafTriangleIds);
+		m_Nodes.shrink_to_fit();
+		m_LeafTriangleIds.shrink_to_fit();
 	}
 
 	/**
@@ -132,35 +157,10 @@ namespace Geometry
 	}
 
 	// simple center split function
-	float CenterSplitFunction(const BoxSplitData& splitData, 
-		const std::vector<unsigned int>& facesIn, std::vector<unsigned int>& leftFacesOut, std::vector<unsigned int>& rightFacesOut)
+	std::optional<float> CenterSplitFunction(const BoxSplitData& splitData, [[maybe_unused]] const std::span<const unsigned int>& facesIn)
 	{
-		const size_t nFaces = facesIn.size();
-
 		const auto center = splitData.box->center();
-		const unsigned int axisId = splitData.axis;
-
-		const auto& vertices = splitData.kdTree->VertexPositions();
-		const auto& triVertexIds = splitData.kdTree->TriVertexIds();
-
-		const float splitPos = center[axisId];
-		leftFacesOut.reserve(nFaces);
-		rightFacesOut.reserve(nFaces);
-		for (const auto& fId : facesIn)
-		{
-			const float min = TriangleMin(triVertexIds[fId], vertices, axisId);
-			const float max = TriangleMax(triVertexIds[fId], vertices, axisId);
-
-			if (min <= splitPos)
-				leftFacesOut.emplace_back(fId);
-
-			if (max >= splitPos)
-				rightFacesOut.emplace_back(fId);
-		}
-		leftFacesOut.shrink_to_fit();
-		rightFacesOut.shrink_to_fit();
-
-		return splitPos;
+		return center[splitData.axis];
 	}
 
 	/// \brief default number of box sampling points
@@ -169,7 +169,7 @@ namespace Geometry
 	// TODO: fix this & add a version with intrinsics
 	// Fast kd-tree Construction with an Adaptive Error-Bounded Heuristic (Hunt, Mark, Stoll)
 	//
-	float AdaptiveSplitFunction(const BoxSplitData& splitData, const std::vector<unsigned int>& facesIn, std::vector<unsigned int>& leftFacesOut, std::vector<unsigned int>& rightFacesOut)
+	std::optional<float> AdaptiveSplitFunction(const BoxSplitData& splitData, const std::span<const unsigned int>& facesIn)
 	{
 		const auto nFaces = static_cast<unsigned int>(facesIn.size());
 		const auto& box = *splitData.box;
@@ -204,8 +204,8 @@ namespace Geometry
 
 		for (i = 0; i < nFaces; i++)
 		{
-			faceMins[i] = TriangleMin(triVertexIds[i], vertices, axisId);
-			faceMaxes[i] = TriangleMax(triVertexIds[i], vertices, axisId);
+			faceMins[i] = TriangleMin(triVertexIds[facesIn[i]], vertices, axisId);
+			faceMaxes[i] = TriangleMax(triVertexIds[facesIn[i]], vertices, axisId);
 
 			for (j = 1; j <= BOX_CUTS; j++) 
 			{
@@ -300,32 +300,87 @@ namespace Geometry
 
 		for (i = 1; i < 2 * BOX_CUTS; i++) 
 		{
-			if (cost[i] >= minCost)
+			// unused samples (zero) and boundary samples would yield an empty child box
+			if (cost[i] >= minCost || all_splt_L[i] <= a || all_splt_L[i] >= b)
 				continue;
 
 			minCost = cost[i];
 			bestSplit = all_splt_L[i];
 		}
 
-		// fill left and right arrays now that best split position is known:
-		leftFacesOut.reserve(nFaces);
-		rightFacesOut.reserve(nFaces);
-		for (i = 0; i < nFaces; i++)
+		return bestSplit;
+	}
+
+	/// \brief number of bins along the split axis for SAHSplitFunction.
+	constexpr unsigned int SAH_BIN_COUNT = 32;
+
+	/// \brief estimated cost of traversing an inner node (SAH).
+	constexpr float SAH_TRAVERSAL_COST = 1.0f;
+
+	/// \brief estimated cost of a single triangle intersection test relative to SAH_TRAVERSAL_COST (SAH).
+	constexpr float SAH_INTERSECTION_COST = 2.0f;
+
+	// Heuristics for Ray Tracing Using Space Subdivision (MacDonald, Booth)
+	// On building fast kd-Trees for Ray Tracing, and on doing that in O(N log N) (Wald, Havran)
+	//
+	std::optional<float> SAHSplitFunction(const BoxSplitData& splitData, const std::span<const unsigned int>& facesIn)
+	{
+		const size_t nFaces = facesIn.size();
+		const auto& box = *splitData.box;
+		const unsigned int axisId = splitData.axis;
+		const auto& vertices = splitData.kdTree->VertexPositions();
+		const auto& triVertexIds = splitData.kdTree->TriVertexIds();
+
+		const float a = box.min()[axisId];
+		const float b = box.max()[axisId];
+		const float binSize = (b - a) / static_cast<float>(SAH_BIN_COUNT);
+		const auto getBinId = [&](const float& pos)
 		{
-			min = faceMins[i];
-			max = faceMaxes[i];
+			const auto binId = static_cast<int>((pos - a) / binSize);
+			return static_cast<unsigned int>(std::clamp(binId, 0, static_cast<int>(SAH_BIN_COUNT) - 1));
+		};
 
-			if (min <= bestSplit) 
-			{
-				leftFacesOut.push_back(facesIn[i]);
-			}
-			if (max >= bestSplit) 
-			{
-				rightFacesOut.push_back(facesIn[i]);
-			}
+		// count the triangles starting and ending in each bin
+		std::array<unsigned int, SAH_BIN_COUNT> nStarts{};
+		std::array<unsigned int, SAH_BIN_COUNT> nEnds{};
+		for (const auto& fId : facesIn)
+		{
+			nStarts[getBinId(TriangleMin(triVertexIds[fId], vertices, axisId))]++;
+			nEnds[getBinId(TriangleMax(triVertexIds[fId], vertices, axisId))]++;
+		}
+
+		// remaining two dimensions of the child box candidates
+		const float boxDim0 = box.max()[(axisId + 1) % 3] - box.min()[(axisId + 1) % 3];
+		const float boxDim1 = box.max()[(axisId + 2) % 3] - box.min()[(axisId + 2) % 3];
+		const auto getSurfaceArea = [&](const float& axisDim)
+		{
+			return 2.0f * (axisDim * boxDim0 + axisDim * boxDim1 + boxDim0 * boxDim1);
+		};
+		const float invBoxArea = 1.0f / getSurfaceArea(b - a);
+
+		// cost(x) = C_trav + C_isect * (SA_L(x) * N_L(x) + SA_R(x) * N_R(x)) / SA
+		float bestSplit = 0.5f * (a + b);
+		float minCost = SAH_INTERSECTION_COST * static_cast<float>(nFaces); // cost of a leaf
+		bool splitFound = false;
+		size_t nLeft = 0;
+		size_t nRight = nFaces;
+		for (unsigned int i = 1; i < SAH_BIN_COUNT; i++)
+		{
+			nLeft += nStarts[i - 1];
+			nRight -= nEnds[i - 1];
+			const float splitPos = a + static_cast<float>(i) * binSize;
+			const float cost = SAH_TRAVERSAL_COST + SAH_INTERSECTION_COST * invBoxArea * (
+				getSurfaceArea(splitPos - a) * static_cast<float>(nLeft) + getSurfaceArea(b - splitPos) * static_cast<float>(nRight));
+			if (cost >= minCost)
+				continue;
+
+			minCost = cost;
+			bestSplit = splitPos;
+			splitFound = true;
 		}
-		leftFacesOut.shrink_to_fit();
-		rightFacesOut.shrink_to_fit();
+
+		if (!splitFound)
+			return {}; // no split pays off, the box becomes a leaf
 
 		return bestSplit;
 	}
@@ -352,23 +407,22 @@ namespace Geometry
 	 * \param triangleIds            indices of relevant triangles.
 	 * \param triangles              index triples for triangle vertices.
 	 * \param vertexPositions        actual vertex positions.
-	 * \return true if the imbalance is too high.
+	 * \param result                 the indices of triangles intersecting the box are appended to this vector.
+	 * \return the number of triangles intersecting the box.
 	 */
-	[[nodiscard]] std::vector<unsigned int> FilterTriangles(
-		const pmp::BoundingBox& box, const std::vector<unsigned int>& triangleIds, const Triangles& triangles, const std::vector<pmp::vec3>& vertexPositions)
+	size_t FilterTriangles(const pmp::BoundingBox& box, const std::span<const unsigned int>& triangleIds,
+		const Triangles& triangles, const std::vector<pmp::vec3>& vertexPositions, std::vector<unsigned int>& result)
 	{
 		const pmp::vec3 boxCenter = box.center();
 		const pmp::vec3 boxHalfSize = (box.max() - box.min()) * 0.5;
 
-		std::vector<unsigned int> result{};
-		result.reserve(triangleIds.size());
+		const size_t nPrevious = result.size();
+		std::vector triVertices{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
 		for (const auto& triId : triangleIds)
 		{
-			const std::vector triVertices{
-				vertexPositions[triangles[triId].v0Id],
-				vertexPositions[triangles[triId].v1Id],
-				vertexPositions[triangles[triId].v2Id]
-			};
+			triVertices[0] = vertexPositions[triangles[triId].v0Id];
+			triVertices[1] = vertexPositions[triangles[triId].v1Id];
+			triVertices[2] = vertexPositions[triangles[triId].v2Id];
 
 			if (!Geometry::TriangleIntersectsBox(triVertices, boxCenter, boxHalfSize))
 				continue;
@@ -376,8 +430,7 @@ namespace Geometry
 			result.emplace_back(triId);
 		}
 
-		result.shrink_to_fit();
-		return result;
+		return result.size() - nPrevious;
 	}
 
 	[[nodiscard]] pmp::BoundingBox GetChildBox(
@@ -397,160 +450,323 @@ namespace Geometry
 	//! minimum number of triangles for node
 	constexpr size_t MIN_NODE_TRIANGLE_COUNT = 2;
 
-	void CollisionKdTree::BuildRecurse(Node* node, const pmp::BoundingBox& box, const std::vector<unsigned int>& triangleIds, unsigned int remainingDepth)
+	bool CollisionKdTree::BuildRecurse(const pmp::BoundingBox& box, const size_t& idsBegin, const size_t& idsEnd, unsigned int remainingDepth,
+		BuildBuffers& buffers, std::vector<SubtreeTask>* subtreeTasks, unsigned int remainingTopLevels) const
 	{
-		assert(node != nullptr);
 		assert(!box.is_empty());
-		/*if (box.is_empty())
+		assert(idsBegin <= idsEnd && idsEnd <= buffers.TriangleIds.size());
+		auto& nodes = buffers.Nodes;
+		auto& ids = buffers.TriangleIds;
+		const auto nodeId = static_cast<unsigned int>(nodes.size());
+		nodes.emplace_back();
+		const size_t nTriangles = idsEnd - idsBegin;
+
+		if (subtreeTasks && (remainingTopLevels == 0 || nTriangles <= KD_TREE_PARALLEL_BUILD_CUTOFF))
 		{
-		    // TODO: fix adaptive resampling!
-			std::cout << "CollisionKdTree::BuildRecurse: empty box!\n";
-		}*/
+			// a placeholder leaf for a subtree built later
+			nodes[nodeId].FirstTriangle = static_cast<unsigned int>(subtreeTasks->size());
+			nodes[nodeId].Bits = FlatNode::LEAF_AXIS | FlatNode::SUBTREE_BIT;
+			subtreeTasks->push_back({ box, std::vector(ids.begin() + idsBegin, ids.begin() + idsEnd), remainingDepth });
+			return true;
+		}
 
-		node->box = box;
+		const auto makeLeaf = [&]()
+		{
+			const auto firstTriangle = static_cast<unsigned int>(buffers.LeafTriangleIds.size());
+			const size_t nLeafTriangles = FilterTriangles(box, { ids.data() + idsBegin, nTriangles }, m_Triangles, m_VertexPositions, buffers.LeafTriangleIds);
+			assert(nLeafTriangles <= FlatNode::MAX_PAYLOAD);
+			nodes[nodeId].FirstTriangle = firstTriangle;
+			nodes[nodeId].Bits = FlatNode::LEAF_AXIS | (static_cast<unsigned int>(nLeafTriangles) << FlatNode::PAYLOAD_SHIFT);
+			return nLeafTriangles > 0;
+		};
+
+		if (remainingDepth == 0 || nTriangles <= MIN_NODE_TRIANGLE_COUNT)
+			return makeLeaf();
 
-		if (remainingDepth == 0 || triangleIds.size() <= MIN_NODE_TRIANGLE_COUNT)
+		const auto axisPreference = GetSplitAxisPreference(box);
+		const auto splitPositionOpt = m_FindSplitPosition({ this, &box, axisPreference }, { ids.data() + idsBegin, nTriangles });
+		if (!splitPositionOpt.has_value())
+			return makeLeaf();
+		const float splitPosition = *splitPositionOpt;
+
+		// classify the triangles: the first pass only counts them
+		size_t nLeft = 0, nRight = 0;
+		for (size_t i = idsBegin; i < idsEnd; i++)
 		{
-			node->triangleIds = FilterTriangles(box, triangleIds, m_Triangles, m_VertexPositions);
-			return;
+			if (TriangleMin(m_Triangles[ids[i]], m_VertexPositions, axisPreference) <= splitPosition) nLeft++;
+			if (TriangleMax(m_Triangles[ids[i]], m_VertexPositions, axisPreference) >= splitPosition) nRight++;
 		}
 
-		const auto axisPreference = GetSplitAxisPreference(box);
+		if (ShouldStopBranching(nLeft, nRight, nTriangles))
+			return makeLeaf();
 
-		std::vector<unsigned int> leftTriangleIds{};
-		std::vector<unsigned int> rightTriangleIds{};
-		node->splitPosition = m_FindSplitAndClassify({ this, &box, axisPreference }, triangleIds, leftTriangleIds, rightTriangleIds);
+		// the second pass appends the right triangle ids behind all ids in use, and compacts the left triangle ids in place (preserving their order)
+		const size_t rightBegin = ids.size();
+		size_t leftEnd = idsBegin;
+		for (size_t i = idsBegin; i < idsEnd; i++)
+		{
+			const unsigned int triId = ids[i];
+			if (TriangleMax(m_Triangles[triId], m_VertexPositions, axisPreference) >= splitPosition) ids.push_back(triId);
+			if (TriangleMin(m_Triangles[triId], m_VertexPositions, axisPreference) <= splitPosition) ids[leftEnd++] = triId;
+		}
+		assert(leftEnd == idsBegin + nLeft && ids.size() == rightBegin + nRight);
 
-		if (ShouldStopBranching(leftTriangleIds.size(), rightTriangleIds.size(), triangleIds.size()))
+		const unsigned int remainingChildTopLevels = remainingTopLevels > 0 ? remainingTopLevels - 1 : 0;
+
+		// empty child leaves are removed
+		unsigned int nodeBits = axisPreference;
+		if (nLeft > 0)
 		{
-			node->triangleIds = FilterTriangles(box, triangleIds, m_Triangles, m_VertexPositions);
-			return;
+			const auto leftBox = GetChildBox(box, splitPosition, axisPreference, true);
+			if (BuildRecurse(leftBox, idsBegin, leftEnd, remainingDepth - 1, buffers, subtreeTasks, remainingChildTopLevels))
+				nodeBits |= FlatNode::LEFT_CHILD_BIT;
+			else
+				nodes.pop_back();
 		}
 
-		if (!leftTriangleIds.empty())
+		if (nRight > 0)
 		{
-			const auto leftBox = GetChildBox(box, node->splitPosition, axisPreference, true);
-			node->left_child = new Node();
-			m_NodeCount++;
-			BuildRecurse(node->left_child, leftBox, leftTriangleIds, remainingDepth - 1);
+			const auto rightChildId = static_cast<unsigned int>(nodes.size());
+			assert(rightChildId <= FlatNode::MAX_PAYLOAD);
+			const auto rightBox = GetChildBox(box, splitPosition, axisPreference, false);
+			if (BuildRecurse(rightBox, rightBegin, rightBegin + nRight, remainingDepth - 1, buffers, subtreeTasks, remainingChildTopLevels))
+				nodeBits |= FlatNode::RIGHT_CHILD_BIT | (rightChildId << FlatNode::PAYLOAD_SHIFT);
+			else
+				nodes.pop_back();
+		}
+		ids.resize(rightBegin); // the right triangle ids are no longer needed
 
-			if (node->left_child->triangleIds.empty() &&
-				node->left_child->left_child == nullptr && node->left_child->right_child == nullptr)
-			{
-				node->left_child = nullptr;
-				m_NodeCount--;
-			}
+		if (!(nodeBits & (FlatNode::LEFT_CHILD_BIT | FlatNode::RIGHT_CHILD_BIT)))
+		{
+			nodes[nodeId] = FlatNode{}; // an empty leaf
+			return false;
 		}
 
-		if (!rightTriangleIds.empty())
+		nodes[nodeId].SplitPosition = splitPosition;
+		nodes[nodeId].Bits = nodeBits;
+		return true;
+	}
+
+	void CollisionKdTree::BuildParallel(const pmp::BoundingBox& box, std::vector<unsigned int>&& triangleIds, const unsigned int& nThreads)
+	{
+		// the top levels yield up to 2^topLevels subtrees (fewer where they reach the cutoff or become leaves)
+		unsigned int topLevels = 0;
+		while ((size_t{ 1 } << topLevels) < KD_TREE_SUBTREES_PER_THREAD * nThreads && topLevels < MAX_DEPTH)
+			topLevels++;
+
+		const size_t nTriangles = triangleIds.size();
+		BuildBuffers topBuffers{};
+		topBuffers.TriangleIds = std::move(triangleIds);
+		std::vector<SubtreeTask> subtreeTasks{};
+		if (!BuildRecurse(box, 0, nTriangles, MAX_DEPTH, topBuffers, &subtreeTasks, topLevels))
+			topBuffers.Nodes.back() = FlatNode{};
+		topBuffers.TriangleIds = {};
+
+		std::vector<BuildBuffers> subtreeBuffers(subtreeTasks.size());
+		std::vector<char> subtreeNonEmpty(subtreeTasks.size(), 0);
+		Utils::ParallelForEachIndex(0, subtreeTasks.size(), nThreads, [&](const size_t taskId, [[maybe_unused]] const unsigned int threadId)
 		{
-			const auto rightBox = GetChildBox(box, node->splitPosition, axisPreference, false);
-			node->right_child = new Node();
-			m_NodeCount++;
-			BuildRecurse(node->right_child, rightBox, rightTriangleIds, remainingDepth - 1);
+			auto& task = subtreeTasks[taskId];
+			auto& buffers = subtreeBuffers[taskId];
+			const size_t nTaskTriangles = task.TriangleIds.size();
+			buffers.TriangleIds = std::move(task.TriangleIds);
+			subtreeNonEmpty[taskId] = BuildRecurse(task.Box, 0, nTaskTriangles, task.RemainingDepth, buffers) ? 1 : 0;
+			buffers.TriangleIds = {};
+		});
+
+		m_Nodes.reserve(std::transform_reduce(subtreeBuffers.begin(), subtreeBuffers.end(), topBuffers.Nodes.size(), std::plus{},
+			[](const BuildBuffers& buffers) { return buffers.Nodes.size(); }));
+		m_LeafTriangleIds.reserve(std::transform_reduce(subtreeBuffers.begin(), subtreeBuffers.end(), topBuffers.LeafTriangleIds.size(), std::plus{},
+			[](const BuildBuffers& buffers) { return buffers.LeafTriangleIds.size(); }));
+		if (!AppendTopLevelNode(topBuffers, 0, subtreeBuffers, subtreeNonEmpty))
+			m_Nodes.back() = FlatNode{}; // an empty root leaf is kept
+	}
 
-			if (node->right_child->triangleIds.empty() &&
-				node->right_child->left_child == nullptr && node->right_child->right_child == nullptr)
+	bool CollisionKdTree::AppendTopLevelNode(const BuildBuffers& topBuffers, const unsigned int& topNodeId,
+		const std::vector<BuildBuffers>& subtreeBuffers, const std::vector<char>& subtreeNonEmpty)
+	{
+		const auto& topNode = topBuffers.Nodes[topNodeId];
+		const auto nodeId = static_cast<unsigned int>(m_Nodes.size());
+
+		if (topNode.IsALeaf() && (topNode.Bits & FlatNode::SUBTREE_BIT))
+		{
+			// relocate the subtree: the indices of its right children and leaf triangles are offset
+			const auto& subtree = subtreeBuffers[topNode.FirstTriangle];
+			const unsigned int leafOffset = static_cast<unsigned int>(m_LeafTriangleIds.size());
+			for (auto node : subtree.Nodes)
 			{
-				node->right_child = nullptr;
-				m_NodeCount--;
+				if (node.IsALeaf())
+					node.FirstTriangle += leafOffset;
+				else if (node.HasRightChild())
+				{
+					assert(node.Payload() + nodeId <= FlatNode::MAX_PAYLOAD);
+					node.Bits += nodeId << FlatNode::PAYLOAD_SHIFT;
+				}
+				m_Nodes.push_back(node);
 			}
+			m_LeafTriangleIds.insert(m_LeafTriangleIds.end(), subtree.LeafTriangleIds.begin(), subtree.LeafTriangleIds.end());
+			return subtreeNonEmpty[topNode.FirstTriangle];
 		}
-	}
 
-	/**
-	 * \brief Computes the average stack height for a binary search tree from node count.
-	 * \param nNodes     number of nodes in a binary tree.
-	 * \return average stack height.
-	 *
-	 * Flajolet, Odlyzko - The Average Height of Binary Trees and Other Simple Trees, Journal of Computer and System Sciences, 25, 171-213 (1982).
-	 */
-	[[nodiscard]] size_t GetAverageStackHeight(const size_t& nNodes)
-	{
-		return std::round(2.0 * sqrt(M_PI * nNodes));
+		m_Nodes.push_back(topNode);
+		if (topNode.IsALeaf())
+		{
+			const auto leafTriangleIds = std::span(topBuffers.LeafTriangleIds.data() + topNode.FirstTriangle, topNode.Payload());
+			m_Nodes[nodeId].FirstTriangle = static_cast<unsigned int>(m_LeafTriangleIds.size());
+			m_LeafTriangleIds.insert(m_LeafTriangleIds.end(), leafTriangleIds.begin(), leafTriangleIds.end());
+			return !leafTriangleIds.empty();
+		}
+
+		// children of the top levels are never empty leaves, except for empty subtrees
+		unsigned int nodeBits = topNode.Axis();
+		if (topNode.HasLeftChild())
+		{
+			if (AppendTopLevelNode(topBuffers, topNodeId + 1, subtreeBuffers, subtreeNonEmpty))
+				nodeBits |= FlatNode::LEFT_CHILD_BIT;
+			else
+				m_Nodes.pop_back();
+		}
+
+		if (topNode.HasRightChild())
+		{
+			const auto rightChildId = static_cast<unsigned int>(m_Nodes.size());
+			assert(rightChildId <= FlatNode::MAX_PAYLOAD);
+			if (AppendTopLevelNode(topBuffers, topNode.Payload(), subtreeBuffers, subtreeNonEmpty))
+				nodeBits |= FlatNode::RIGHT_CHILD_BIT | (rightChildId << FlatNode::PAYLOAD_SHIFT);
+			else
+				m_Nodes.pop_back();
+		}
+
+		if (!(nodeBits & (FlatNode::LEFT_CHILD_BIT | FlatNode::RIGHT_CHILD_BIT)))
+		{
+			m_Nodes[nodeId] = FlatNode{}; // an empty leaf
+			return false;
+		}
+
+		m_Nodes[nodeId].Bits = nodeBits;
+		return true;
 	}
 
-	/**/
-	void CollisionKdTree::GetTrianglesInABox_Stackless(const pmp::BoundingBox& box, std::vector<unsigned int>& foundTriangleIds) const
+	/// \brief the maximum number of items on a traversal stack (each popped node pushes at most two children, at most one pending sibling remains per depth level).
+	constexpr size_t NODE_STACK_SIZE = 2 * static_cast<size_t>(MAX_DEPTH) + 2;
+
+	/// \brief a traversal stack item: a node index with the node's box. Trivially constructible, so that a local stack array is not initialized for each query.
+	struct NodeStackItem
 	{
-		assert(foundTriangleIds.empty());
+		unsigned int NodeId;
+		pmp::vec3 BoxMin;
+		pmp::vec3 BoxMax;
 
-		foundTriangleIds.reserve(m_Triangles.size());
-		const size_t expectedStackHeight = GetAverageStackHeight(m_NodeCount);
-		std::vector<Node*> nodeStack{};
-		nodeStack.reserve(expectedStackHeight);
-		nodeStack.emplace_back(m_Root);
+		[[nodiscard]] pmp::BoundingBox Box() const
+		{
+			return { BoxMin, BoxMax };
+		}
+	};
+	static_assert(std::is_trivially_default_constructible_v<NodeStackItem>);
+
+	template <typename LeafFunction>
+	bool CollisionKdTree::VisitLeavesIntersectingBox(const pmp::BoundingBox& box, const LeafFunction& leafFunc) const
+	{
+		// A child box is its parent box inflated by BOX_INFLATION with one face moved to the split plane. So once a box intersects
+		// a (non-root) node box, it intersects each child box except possibly along the split axis, and node boxes are not needed.
+		std::array<unsigned int, NODE_STACK_SIZE> nodeStack;
+		size_t stackSize = 0;
+		nodeStack[stackSize++] = 0;
 
-		while(!nodeStack.empty())
+		while (stackSize > 0)
 		{
-			Node* currentNode = nodeStack[nodeStack.size() - 1];
-			nodeStack.erase(std::prev(nodeStack.end()));
+			const unsigned int nodeId = nodeStack[--stackSize];
+			const FlatNode& node = m_Nodes[nodeId];
 
-			if (currentNode->IsALeaf())
+			if (node.IsALeaf())
 			{
-				for (const auto& triId : currentNode->triangleIds)
-					foundTriangleIds.emplace_back(triId);
+				if (leafFunc(LeafTriangleIds(node)))
+					return true;
 
 				continue;
 			}
 
-			if (currentNode->left_child)
+			const unsigned int axis = node.Axis();
+			const bool isRoot = (nodeId == 0); // the root box itself is not tested
+			assert(stackSize + 2 <= NODE_STACK_SIZE);
+			if (node.HasLeftChild())
 			{
-				if (box.Intersects(currentNode->left_child->box))
-					nodeStack.emplace_back(currentNode->left_child);
+				const bool intersectsLeft = isRoot ?
+					box.Intersects(GetChildBox(m_RootBox, node.SplitPosition, axis, true)) :
+					box.min()[axis] <= node.SplitPosition + BOX_INFLATION;
+				if (intersectsLeft)
+					nodeStack[stackSize++] = nodeId + 1;
 			}
 
-			if (currentNode->right_child)
+			if (node.HasRightChild())
 			{
-				if (box.Intersects(currentNode->right_child->box))
-					nodeStack.emplace_back(currentNode->right_child);
+				const bool intersectsRight = isRoot ?
+					box.Intersects(GetChildBox(m_RootBox, node.SplitPosition, axis, false)) :
+					box.max()[axis] >= node.SplitPosition - BOX_INFLATION;
+				if (intersectsRight)
+					nodeStack[stackSize++] = node.Payload();
 			}
 		}
 
-		foundTriangleIds.shrink_to_fit();
+		return false;
 	}
 
-	void CollisionKdTree::GetTrianglesInABox(const pmp::BoundingBox& box, std::vector<unsigned int>& foundTriangleIds) const
+	template <typename LeafFunction>
+	void CollisionKdTree::VisitLeavesIntersectingRay(Geometry::Ray& ray, const LeafFunction& leafFunc) const
 	{
-		assert(foundTriangleIds.empty());
+		if (!Geometry::RayIntersectsABox(ray, m_RootBox))
+			return;
 
-		foundTriangleIds.reserve(m_Triangles.size());
-		std::stack<Node*> nodeStack{};
-		nodeStack.push(m_Root);
+		std::array<NodeStackItem, NODE_STACK_SIZE> nodeStack;
+		size_t stackSize = 0;
+		nodeStack[stackSize++] = { 0, m_RootBox.min(), m_RootBox.max() };
 
-		while (!nodeStack.empty())
+		while (stackSize > 0)
 		{
-			const Node* currentNode = nodeStack.top();
-			nodeStack.pop();
+			const auto& stackItem = nodeStack[--stackSize];
+			const unsigned int nodeId = stackItem.NodeId;
+			const auto nodeBox = stackItem.Box();
+			const FlatNode& node = m_Nodes[nodeId];
 
-			if (currentNode->IsALeaf())
+			if (node.IsALeaf())
 			{
-				for (const auto& triId : currentNode->triangleIds)
-					foundTriangleIds.emplace_back(triId);
-
+				leafFunc(LeafTriangleIds(node));
 				continue;
 			}
 
-			if (currentNode->left_child)
+			// node is not a leaf
+
+			assert(stackSize + 2 <= NODE_STACK_SIZE);
+			if (node.HasLeftChild())
 			{
-				assert(!currentNode->left_child->box.is_empty());
-				if (box.Intersects(currentNode->left_child->box))
-				{
-					nodeStack.push(currentNode->left_child);
-				}
+				const auto leftBox = GetChildBox(nodeBox, node.SplitPosition, node.Axis(), true);
+				if (Geometry::RayIntersectsABox(ray, leftBox))
+					nodeStack[stackSize++] = { nodeId + 1, leftBox.min(), leftBox.max() };
 			}
 
-			if (currentNode->right_child)
+			if (node.HasRightChild())
 			{
-				assert(!currentNode->right_child->box.is_empty());
-				if (box.Intersects(currentNode->right_child->box))
-				{
-					nodeStack.push(currentNode->right_child);	
-				}
+				const auto rightBox = GetChildBox(nodeBox, node.SplitPosition, node.Axis(), false);
+				if (Geometry::RayIntersectsABox(ray, rightBox))
+					nodeStack[stackSize++] = { node.Payload(), rightBox.min(), rightBox.max() };
 			}
 		}
+	}
+
+	void CollisionKdTree::GetTrianglesInABox_Stackless(const pmp::BoundingBox& box, std::vector<unsigned int>& foundTriangleIds) const
+	{
+		GetTrianglesInABox(box, foundTriangleIds);
+	}
 
-		foundTriangleIds.shrink_to_fit();
+	void CollisionKdTree::GetTrianglesInABox(const pmp::BoundingBox& box, std::vector<unsigned int>& foundTriangleIds) const
+	{
+		assert(foundTriangleIds.empty());
+
+		VisitLeavesIntersectingBox(box, [&](const std::span<const unsigned int>& leafTriangleIds)
+		{
+			foundTriangleIds.insert(foundTriangleIds.end(), leafTriangleIds.begin(), leafTriangleIds.end());
+			return false;
+		});
 	}
 
 	bool CollisionKdTree::BoxIntersectsATriangle(const pmp::BoundingBox& box) const
@@ -562,226 +778,260 @@ namespace Geometry
 			0.5f * (box.max()[2] - box.min()[2])
 		};
 		std::vector triVerts{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
-		std::stack<Node*> nodeStack{};
-		nodeStack.push(m_Root);
 
-		while (!nodeStack.empty())
+		return VisitLeavesIntersectingBox(box, [&](const std::span<const unsigned int>& leafTriangleIds)
+		{
+			for (const auto& triId : leafTriangleIds)
+			{
+				triVerts[0] = m_VertexPositions[m_Triangles[triId].v0Id];
+				triVerts[1] = m_VertexPositions[m_Triangles[triId].v1Id];
+				triVerts[2] = m_VertexPositions[m_Triangles[triId].v2Id];
+				if (Geometry::TriangleIntersectsBox(triVerts, center, halfSize))
+					return true;
+			}
+			return false;
+		});
+	}
+
+	bool CollisionKdTree::BoxIntersectsATriangle_Stackless(const pmp::BoundingBox& box) const
+	{
+		return BoxIntersectsATriangle(box);
+	}
+
+	bool CollisionKdTree::RayIntersectsATriangle(Geometry::Ray& ray) const
+	{
+		std::vector triVerts{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
+
+		// node boxes are not needed, the children are selected by the ray parameter of the split plane
+		std::array<unsigned int, NODE_STACK_SIZE> nodeStack;
+		size_t stackSize = 0;
+		nodeStack[stackSize++] = 0;
+
+		while (stackSize > 0) 
 		{
-			const Node* currentNode = nodeStack.top();
-			nodeStack.pop();
+			const unsigned int nodeId = nodeStack[--stackSize];
+			const FlatNode& node = m_Nodes[nodeId];
 
-			if (currentNode->IsALeaf())
+			if (node.IsALeaf())
 			{
-				for (const auto& triId : currentNode->triangleIds)
+				for (const auto& triId : LeafTriangleIds(node))
 				{
 					triVerts[0] = m_VertexPositions[m_Triangles[triId].v0Id];
 					triVerts[1] = m_VertexPositions[m_Triangles[triId].v1Id];
 					triVerts[2] = m_VertexPositions[m_Triangles[triId].v2Id];
-					if (Geometry::TriangleIntersectsBox(triVerts, center, halfSize))
+					if (Geometry::RayIntersectsTriangle(ray, triVerts))
 						return true;
 				}
 
 				continue;
 			}
 
-			if (currentNode->left_child)
+			const unsigned int axis = node.Axis();
+			const float splitPosition = node.SplitPosition;
+			const float startPos = ray.StartPt[axis];
+
+			// the near child contains the ray start (a start on the split plane belongs to the child the ray heads to)
+			const bool leftIsNear = startPos < splitPosition || (startPos == splitPosition && ray.Direction[axis] < 0.0f);
+			bool visitNear = true;
+			bool visitFar = false;
+			if (ray.Direction[axis] != 0.0f)
 			{
-				assert(!currentNode->left_child->box.is_empty());
-				if (box.Intersects(currentNode->left_child->box))
-				{
-					nodeStack.push(currentNode->left_child);
-				}
+				// the ray is on the near side for t < t_split, and on the far side for t > t_split
+				const float t_split = (splitPosition - startPos) * ray.InvDirection[axis];
+				visitNear = t_split <= 0.0f || ray.ParamMin <= t_split;
+				visitFar = t_split > 0.0f && ray.ParamMax >= t_split;
 			}
+			else if (startPos == splitPosition)
+			{
+				visitFar = true; // the ray lies within the split plane
+			}
+
+			const bool hasNearNode = leftIsNear ? node.HasLeftChild() : node.HasRightChild();
+			const bool hasFarNode = leftIsNear ? node.HasRightChild() : node.HasLeftChild();
+			const unsigned int leftChildId = nodeId + 1;
+			const unsigned int rightChildId = node.Payload();
 
-			if (currentNode->right_child)
+			assert(stackSize + 2 <= NODE_STACK_SIZE);
+			if (hasFarNode && visitFar)
 			{
-				assert(!currentNode->right_child->box.is_empty());
-				if (box.Intersects(currentNode->right_child->box))
-				{
-					nodeStack.push(currentNode->right_child);
-				}
+				nodeStack[stackSize++] = leftIsNear ? rightChildId : leftChildId;
+			}
+			if (hasNearNode && visitNear)
+			{
+				nodeStack[stackSize++] = leftIsNear ? leftChildId : rightChildId;
 			}
 		}
-
 		return false;
 	}
 
-	bool CollisionKdTree::BoxIntersectsATriangle_Stackless(const pmp::BoundingBox& box) const
+	unsigned int CollisionKdTree::GetRayTriangleIntersectionCount(Geometry::Ray& ray) const
 	{
-		const auto center = box.center();
-		const pmp::vec3 halfSize{
-			0.5f * (box.max()[0] - box.min()[0]),
-			0.5f * (box.max()[1] - box.min()[1]),
-			0.5f * (box.max()[2] - box.min()[2])
-		};
+		unsigned int hitCount = 0;
 		std::vector triVerts{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
-		const size_t expectedStackHeight = GetAverageStackHeight(m_NodeCount);
-		std::vector<Node*> nodeStack{};
-		nodeStack.reserve(expectedStackHeight);
-		nodeStack.emplace_back(m_Root);
-
-		while (!nodeStack.empty())
+		VisitLeavesIntersectingRay(ray, [&](const std::span<const unsigned int>& leafTriangleIds)
 		{
-			Node* currentNode = nodeStack[nodeStack.size() - 1];
-			nodeStack.erase(std::prev(nodeStack.end()));
-
-			if (currentNode->IsALeaf())
+			for (const auto& triId : leafTriangleIds)
 			{
-				for (const auto& triId : currentNode->triangleIds)
+				triVerts[0] = m_VertexPositions[m_Triangles[triId].v0Id];
+				triVerts[1] = m_VertexPositions[m_Triangles[triId].v1Id];
+				triVerts[2] = m_VertexPositions[m_Triangles[triId].v2Id];
+				if (Geometry::RayIntersectsTriangle(ray, triVerts))
 				{
-					triVerts[0] = m_VertexPositions[m_Triangles[triId].v0Id];
-					triVerts[1] = m_VertexPositions[m_Triangles[triId].v1Id];
-					triVerts[2] = m_VertexPositions[m_Triangles[triId].v2Id];
-					if (Geometry::TriangleIntersectsBox(triVerts, center, halfSize))
-						return true;
+					hitCount++;
 				}
-
-				continue;
 			}
+		});
 
-			if (currentNode->left_child)
-			{
-				assert(!currentNode->left_child->box.is_empty());
-				if (box.Intersects(currentNode->left_child->box))
-				{
-					nodeStack.emplace_back(currentNode->left_child);
-				}
-			}
+		return hitCount;
+	}
+
+	void CollisionKdTree::GetRayTriangleIntersectionParams(Geometry::Ray& ray, std::vector<float>& hitParams) const
+	{
+		hitParams.clear();
 
-			if (currentNode->right_child)
+		// triangles straddling multiple leaves are referenced by each of them, so hits are collected with their triangle ids
+		std::vector<std::pair<unsigned int, float>> hits{};
+		std::vector triVerts{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
+		VisitLeavesIntersectingRay(ray, [&](const std::span<const unsigned int>& leafTriangleIds)
+		{
+			for (const auto& triId : leafTriangleIds)
 			{
-				assert(!currentNode->right_child->box.is_empty());
-				if (box.Intersects(currentNode->right_child->box))
+				triVerts[0] = m_VertexPositions[m_Triangles[triId].v0Id];
+				triVerts[1] = m_VertexPositions[m_Triangles[triId].v1Id];
+				triVerts[2] = m_VertexPositions[m_Triangles[triId].v2Id];
+				if (Geometry::RayIntersectsTriangle(ray, triVerts))
 				{
-					nodeStack.emplace_back(currentNode->right_child);
+					hits.emplace_back(triId, ray.HitParam);
 				}
 			}
-		}
-
-		return false;
+		});
+
+		// each intersected triangle is reported once
+		std::ranges::sort(hits);
+		const auto [dupFirst, dupLast] = std::ranges::unique(hits, {}, &std::pair<unsigned int, float>::first);
+		hits.erase(dupFirst, dupLast);
+		hitParams.reserve(hits.size());
+		for (const auto& [triId, param] : hits)
+			hitParams.push_back(param);
 	}
 
-	bool CollisionKdTree::RayIntersectsATriangle(Geometry::Ray& ray) const
+	/// \brief a closest triangle traversal stack item: a node index with the per-axis distances from the query point to the node's cell (see RefineClosestTriangle).
+	struct DistanceStackItem
 	{
-		Node* nearNode = nullptr;
-		Node* farNode = nullptr;
-		float t_split;
-		bool leftIsNear, force_near, force_far, t_splitAtInfinity;
-		std::vector triVerts{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
-
-		std::stack<Node*> stack = {};
-		stack.push(m_Root);
+		unsigned int NodeId;
+		float DistanceSq;
+		pmp::vec3 AxisDistances;
+	};
+	static_assert(std::is_trivially_default_constructible_v<DistanceStackItem>);
 
-		while (!stack.empty()) 
+	void CollisionKdTree::RefineClosestTriangle(const pmp::vec3& point, unsigned int& closestTriId, double& closestDistSq) const
+	{
+		// The split planes partition the root box into (uninflated) cells, and the closest point of a triangle lies in a cell whose leaf
+		// references the triangle. So a node whose cell is farther than the closest triangle found so far cannot contain a closer triangle point.
+		// The cell distance is updated per axis: the near child keeps its parent's distances, and the far child's distance along the split axis
+		// grows to the distance from the split plane.
+		// Nodes as far as the closest triangle are still visited, so that the smallest index among equally distant triangles is found
+		// regardless of the initial closest triangle (e.g.: a warm start from a previous query).
+		std::array<DistanceStackItem, NODE_STACK_SIZE> nodeStack;
+		size_t stackSize = 0;
+		pmp::vec3 rootDistances;
+		for (unsigned int i = 0; i < 3; i++)
+			rootDistances[i] = std::max({ m_RootBox.min()[i] - point[i], 0.0f, point[i] - m_RootBox.max()[i] });
+		nodeStack[stackSize++] = { 0, sqrnorm(rootDistances), rootDistances };
+
+		while (stackSize > 0)
 		{
-			Node* currentNode = stack.top();
-			stack.pop();
+			const auto item = nodeStack[--stackSize];
+			if (static_cast<double>(item.DistanceSq) > closestDistSq)
+				continue;
 
-			if (currentNode->IsALeaf())
+			const auto& node = m_Nodes[item.NodeId];
+			if (node.IsALeaf())
 			{
-				for (const auto& triId : currentNode->triangleIds)
+				for (const auto& triId : LeafTriangleIds(node))
 				{
-					triVerts[0] = m_VertexPositions[m_Triangles[triId].v0Id];
-					triVerts[1] = m_VertexPositions[m_Triangles[triId].v1Id];
-					triVerts[2] = m_VertexPositions[m_Triangles[triId].v2Id];
-					if (Geometry::RayIntersectsTriangle(ray, triVerts))
-						return true;
-				}
+					const double distSq = GetDistanceToTriangleSq(m_TriangleVertexData, triId, point);
+					// ties are broken by the smallest triangle index (a triangle exactly at the max distance is not accepted)
+					if (distSq > closestDistSq || (distSq == closestDistSq && (closestTriId == NO_CLOSEST_TRIANGLE_ID || triId >= closestTriId)))
+						continue;
 
+					closestDistSq = distSq;
+					closestTriId = triId;
+				}
 				continue;
 			}
 
-			leftIsNear = ray.StartPt[currentNode->axis] < currentNode->splitPosition;
-			nearNode = currentNode->left_child;
-			farNode = currentNode->right_child;
-			if (!leftIsNear)
-			{
-				nearNode = currentNode->right_child;
-				farNode = currentNode->left_child;
-			}
+			const unsigned int axis = node.Axis();
+			const float split = node.SplitPosition;
+			const bool leftIsNear = point[axis] <= split;
+			const unsigned int nearChildId = leftIsNear ? (node.HasLeftChild() ? item.NodeId + 1 : 0) : (node.HasRightChild() ? node.Payload() : 0);
+			const unsigned int farChildId = leftIsNear ? (node.HasRightChild() ? node.Payload() : 0) : (node.HasLeftChild() ? item.NodeId + 1 : 0);
 
-			t_split = (currentNode->splitPosition - ray.StartPt[currentNode->axis]) * ray.InvDirection[currentNode->axis];
-			force_near = false;
-			force_far = false;
-			t_splitAtInfinity = t_split > FLT_MAX || t_split < -FLT_MAX;
-			if (t_splitAtInfinity) 
+			// the far child is pushed first, so that the near child is visited first
+			if (farChildId > 0)
 			{
-				if (ray.StartPt[currentNode->axis] <= currentNode->splitPosition &&
-					ray.StartPt[currentNode->axis] >= currentNode->box.min()[currentNode->axis])
-				{
-					if (leftIsNear) force_near = true;
-					else force_far = true;
-				}
-				if (ray.StartPt[currentNode->axis] >= currentNode->splitPosition &&
-					ray.StartPt[currentNode->axis] <= currentNode->box.max()[currentNode->axis])
+				DistanceStackItem farItem{ farChildId, 0.0f, item.AxisDistances };
+				farItem.AxisDistances[axis] = std::max(farItem.AxisDistances[axis], std::abs(point[axis] - split));
+				farItem.DistanceSq = sqrnorm(farItem.AxisDistances);
+				if (static_cast<double>(farItem.DistanceSq) <= closestDistSq)
 				{
-					if (leftIsNear) force_near = true;
-					else force_far = true;
+					assert(stackSize < NODE_STACK_SIZE);
+					nodeStack[stackSize++] = farItem;
 				}
 			}
-
-			if (farNode && ((!t_splitAtInfinity && ray.ParamMax >= t_split) || force_far))
-			{
-				stack.push(farNode);
-			}
-			if (nearNode && ((!t_splitAtInfinity && ray.ParamMin <= t_split) || force_near))
+			if (nearChildId > 0)
 			{
-				stack.push(nearNode);
+				assert(stackSize < NODE_STACK_SIZE);
+				nodeStack[stackSize++] = { nearChildId, item.DistanceSq, item.AxisDistances };
 			}
 		}
-		return false;
 	}
 
-	unsigned int CollisionKdTree::GetRayTriangleIntersectionCount(Geometry::Ray& ray) const
+	ClosestTriangleResult CollisionKdTree::FindClosestTriangle(const pmp::vec3& point, const double& maxDistance) const
 	{
-		unsigned int hitCount = 0;
-		if (!Geometry::RayIntersectsABox(ray, m_Root->box))
-			return hitCount;
+		ClosestTriangleResult result{};
+		result.DistanceSq = maxDistance < DBL_MAX ? maxDistance * maxDistance : DBL_MAX;
+		RefineClosestTriangle(point, result.TriangleId, result.DistanceSq);
+		if (result.TriangleId == NO_CLOSEST_TRIANGLE_ID)
+			return {};
 
-		std::vector triVerts{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
-		std::stack<Node*> stack = {};
-		stack.push(m_Root);
+		result.ClosestPoint = GetClosestPointOnTriangle(m_TriangleVertexData, result.TriangleId, point);
+		return result;
+	}
 
-		while (!stack.empty())
+	void CollisionKdTree::FindClosestTriangles(const std::vector<pmp::vec3>& points, std::vector<ClosestTriangleResult>& results,
+		const double& maxDistance, const unsigned int& nThreads) const
+	{
+		results.resize(points.size());
+		const double maxDistanceSq = maxDistance < DBL_MAX ? maxDistance * maxDistance : DBL_MAX;
+		Utils::ParallelForChunks(0, points.size(), nThreads, [&](const size_t start, const size_t end, [[maybe_unused]] const unsigned int threadId)
 		{
-			const Node* currentNode = stack.top();
-			stack.pop();
-
-			if (currentNode->IsALeaf())
+			unsigned int previousTriId = NO_CLOSEST_TRIANGLE_ID;
+			for (size_t i = start; i < end; i++)
 			{
-				for (const auto& triId : currentNode->triangleIds)
+				const auto& point = points[i];
+				unsigned int closestTriId = NO_CLOSEST_TRIANGLE_ID;
+				double closestDistSq = maxDistanceSq;
+				if (previousTriId != NO_CLOSEST_TRIANGLE_ID)
 				{
-					triVerts[0] = m_VertexPositions[m_Triangles[triId].v0Id];
-					triVerts[1] = m_VertexPositions[m_Triangles[triId].v1Id];
-					triVerts[2] = m_VertexPositions[m_Triangles[triId].v2Id];
-					if (Geometry::RayIntersectsTriangle(ray, triVerts))
+					const double previousDistSq = GetDistanceToTriangleSq(m_TriangleVertexData, previousTriId, point);
+					if (previousDistSq < closestDistSq)
 					{
-						hitCount++;
+						closestDistSq = previousDistSq;
+						closestTriId = previousTriId;
 					}
 				}
-				continue;
-			}
-
-			// currentNode is not a leaf
-
-			if (currentNode->left_child)
-			{
-				if (Geometry::RayIntersectsABox(ray, currentNode->left_child->box))
-				{
-					stack.push(currentNode->left_child);
-				}				
-			}
+				RefineClosestTriangle(point, closestTriId, closestDistSq);
 
-			if (currentNode->right_child)
-			{
-				if (Geometry::RayIntersectsABox(ray, currentNode->right_child->box))
+				if (closestTriId == NO_CLOSEST_TRIANGLE_ID)
 				{
-					stack.push(currentNode->right_child);
-				}				
+					results[i] = ClosestTriangleResult{};
+					continue;
+				}
+				results[i] = { closestTriId, GetClosestPointOnTriangle(m_TriangleVertexData, closestTriId, point), closestDistSq };
+				previousTriId = closestTriId;
 			}
-		}
-
-		return hitCount;
+		});
 	}
 
 } // namespace SDF
\ No newline at end of file
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "GeometryUtil.h"
 #include "MeshAdapter.h"
 
+#include <cfloat>
+#include <climits>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace Geometry
@@ -15,7 +20,7 @@ namespace Geometry
 	 */
 	struct BoxSplitData
 	{
-		CollisionKdTree* kdTree{ nullptr };
+		const CollisionKdTree* kdTree{ nullptr };
 		const pmp::BoundingBox* box{ nullptr };
 		unsigned int axis{0};
 	};
@@ -32,29 +37,56 @@ namespace Geometry
 
 	using Triangles = std::vector<Triangle>;
 
-	// function used to find split position and fill child primitive buffers.
-	using SplitFunction = std::function<float(
-		const BoxSplitData&,               // data of box to be split
-		const std::vector<unsigned int>&,  // input face ids 
-		std::vector<unsigned int>&,        // output left face ids
-		std::vector<unsigned int>&)>;      // output right face ids
+	/// \brief triangle index of a closest triangle query which found no triangle.
+	constexpr unsigned int NO_CLOSEST_TRIANGLE_ID = UINT_MAX;
+
+	/**
+	 * \brief a result of a closest triangle query.
+	 */
+	struct ClosestTriangleResult
+	{
+		unsigned int TriangleId{ NO_CLOSEST_TRIANGLE_ID }; //>! index of the closest triangle (NO_CLOSEST_TRIANGLE_ID if no triangle is within the query's max distance).
+		pmp::vec3 ClosestPoint{};                          //>! the point of the closest triangle closest to the query point.
+		double DistanceSq{ DBL_MAX };                      //>! squared distance from the query point to ClosestPoint.
+	};
+
+	// function used to find the split position of a box (std::nullopt if the box should become a leaf).
+	// The tree itself partitions the faces: faces with min <= split go to the left child, and faces with max >= split to the right child.
+	using SplitFunction = std::function<std::optional<float>(
+		const BoxSplitData&,                    // data of box to be split
+		const std::span<const unsigned int>&)>; // input face ids
 
 	// ===================== Split functions ================================
 
-	[[nodiscard]] float CenterSplitFunction(const BoxSplitData& splitData,
-		const std::vector<unsigned int>& facesIn, std::vector<unsigned int>& leftFacesOut, std::vector<unsigned int>& rightFacesOut);
+	[[nodiscard]] std::optional<float> CenterSplitFunction(const BoxSplitData& splitData, const std::span<const unsigned int>& facesIn);
 
-	[[nodiscard]] float AdaptiveSplitFunction(const BoxSplitData& splitData,
-		const std::vector<unsigned int>& facesIn, std::vector<unsigned int>& leftFacesOut, std::vector<unsigned int>& rightFacesOut);
+	[[nodiscard]] std::optional<float> AdaptiveSplitFunction(const BoxSplitData& splitData, const std::span<const unsigned int>& facesIn);
+
+	/**
+	 * \brief A binned surface area heuristic (SAH) split function. Evaluates the SAH cost of SAH_BIN_COUNT - 1 candidate positions along the split axis.
+	 *        If no candidate is cheaper than intersecting all triangles of the box, std::nullopt is returned, so that the box becomes a leaf.
+	 */
+	[[nodiscard]] std::optional<float> SAHSplitFunction(const BoxSplitData& splitData, const std::span<const unsigned int>& facesIn);
 
 	// ======================================================================
 
-	//! \brief A k-d tree for collision detection with triangles
+	/**
+	 * \brief A k-d tree for collision detection with triangles.
+	 *        Nodes are stored in a single contiguous array of 8-byte items in depth-first order, and leaves refer to ranges of a single shared array of triangle ids.
+	 *        Node boxes are not stored, they are reconstructed from the split planes during traversal.
+	 */
 	class CollisionKdTree
 	{
 	public:
-        //! Construct with mesh.
-        CollisionKdTree(const MeshAdapter& meshAdapter, const SplitFunction& spltFunc);
+        /**
+         * \brief Constructor. Builds the tree for a given mesh.
+         * \param meshAdapter    input mesh adapter.
+         * \param spltFunc       split function.
+         * \param nThreads       the number of worker threads building the tree's subtrees. Zero means "use all hardware threads".
+         *
+         * DISCLAIMER: The parallel build produces the same tree (including the order of nodes and leaf triangle ids) as the serial build.
+         */
+        CollisionKdTree(const MeshAdapter& meshAdapter, const SplitFunction& spltFunc, const unsigned int& nThreads = 1);
 
 		// getters
 		[[nodiscard]] const std::vector<pmp::vec3>& VertexPositions() const
@@ -67,10 +99,29 @@ namespace Geometry
 			return m_Triangles;
 		}
 
+		/// \brief vertex data of all triangles (indexed as TriVertexIds()) for point-triangle distance evaluations.
+		[[nodiscard]] const TriangleSoA& TriangleVertexData() const
+		{
+			return m_TriangleVertexData;
+		}
+
+		[[nodiscard]] size_t NodeCount() const
+		{
+			return m_Nodes.size();
+		}
+
+		/// \brief memory footprint of the nodes and leaf triangle ids of this tree in bytes.
+		[[nodiscard]] size_t MemoryUsage() const
+		{
+			return m_Nodes.size() * sizeof(FlatNode) + m_LeafTriangleIds.size() * sizeof(unsigned int);
+		}
+
 		/**
 		 * \brief Fills a buffer of indices of triangles intersecting a given box.
 		 * \param box                  a box whose contents are to be queried.
 		 * \param foundTriangleIds     buffer to be filled.
+		 *
+		 * DISCLAIMER: foundTriangleIds is expected to be empty. Its capacity is kept, so a cleared buffer can be reused for repeated queries.
 		 */
 		void GetTrianglesInABox(const pmp::BoundingBox& box, std::vector<unsigned int>& foundTriangleIds) const;
 
@@ -78,6 +129,8 @@ namespace Geometry
 		 * \brief A stackless approach to fill a buffer of indices of triangles intersecting a given box.
 		 * \param box                  a box whose contents are to be queried.
 		 * \param foundTriangleIds     buffer to be filled.
+		 *
+		 * DISCLAIMER: With the flattened node layout, both variants share the same traversal with a fixed-size local node stack.
 		 */
 		void GetTrianglesInABox_Stackless(const pmp::BoundingBox& box, std::vector<unsigned int>& foundTriangleIds) const;
 
@@ -92,6 +145,8 @@ namespace Geometry
 		 * \brief A stackless approach for performing an intersection test between a given box and any triangle.
 		 * \param box    a box to be queried.
 		 * \return true if an intersection was detected.
+		 *
+		 * DISCLAIMER: With the flattened node layout, both variants share the same traversal with a fixed-size local node stack.
 		 */
 		[[nodiscard]] bool BoxIntersectsATriangle_Stackless(const pmp::BoundingBox& box) const;
 
@@ -109,47 +164,176 @@ namespace Geometry
          */
         [[nodiscard]] unsigned int GetRayTriangleIntersectionCount(Geometry::Ray& ray) const;
 
+        /**
+         * \brief Collects the ray parameters of all intersections between a given ray and triangles in this kd-tree.
+         *        A single traversal serves a whole scanline of coherent rays: every start point along the ray counts the hits with a greater parameter.
+         * \param ray          intersecting ray.
+         * \param hitParams    buffer to be filled with unsorted hit parameters, one per intersected triangle.
+         *
+         * DISCLAIMER: hitParams is cleared first, its capacity is kept, so the buffer can be reused for repeated queries.
+         *             Unlike GetRayTriangleIntersectionCount, a triangle referenced by multiple leaves is reported only once.
+         */
+        void GetRayTriangleIntersectionParams(Geometry::Ray& ray, std::vector<float>& hitParams) const;
+
+        /**
+         * \brief Finds the triangle closest to a given point by a branch-and-bound traversal: the nearer child is visited first,
+         *        and nodes whose boxes are farther than the closest triangle found so far are skipped.
+         * \param point          query point.
+         * \param maxDistance    only triangles closer than this distance are searched for.
+         * \return the closest triangle with its closest point (TriangleId == NO_CLOSEST_TRIANGLE_ID if no triangle is closer than maxDistance).
+         */
+        [[nodiscard]] ClosestTriangleResult FindClosestTriangle(const pmp::vec3& point, const double& maxDistance = DBL_MAX) const;
+
+        /**
+         * \brief Finds the closest triangles for a batch of query points. The points are split into contiguous chunks processed on nThreads worker threads,
+         *        and each query starts from the distance to the previous point's closest triangle, which prunes most nodes for spatially coherent batches (e.g.: voxel rows).
+         * \param points         query points.
+         * \param results        buffer to be filled with a result per query point.
+         * \param maxDistance    only triangles closer than this distance are searched for.
+         * \param nThreads       the number of worker threads. Zero means "use all hardware threads".
+         *
+         * DISCLAIMER: The results are identical to those of FindClosestTriangle for any nThreads: among equally distant triangles, the one with the smallest index is chosen.
+         */
+        void FindClosestTriangles(const std::vector<pmp::vec3>& points, std::vector<ClosestTriangleResult>& results,
+            const double& maxDistance = DBL_MAX, const unsigned int& nThreads = 1) const;
+
 	private:
 
-		/// \brief a node object of this tree.
-		struct Node
+		/// \brief a compact node of this tree. The left child of an inner node (if present) directly follows it in m_Nodes.
+		struct FlatNode
 		{
-			Node() = default;
+			static constexpr unsigned int AXIS_MASK = 0b11;
+			static constexpr unsigned int LEAF_AXIS = 0b11;
+			static constexpr unsigned int LEFT_CHILD_BIT = 0b100;
+			static constexpr unsigned int RIGHT_CHILD_BIT = 0b1000;
+			static constexpr unsigned int SUBTREE_BIT = 0b100; //>! marks a leaf standing for a subtree (only within the top levels of a parallel build).
+			static constexpr unsigned int PAYLOAD_SHIFT = 4;
+			static constexpr unsigned int MAX_PAYLOAD = UINT_MAX >> PAYLOAD_SHIFT;
 
-            ~Node()
-            {
-                delete left_child;
-                delete right_child;
-            }
+			union
+			{
+				float SplitPosition{ 0.0f }; //>! split position along the split axis (inner nodes).
+				unsigned int FirstTriangle;  //>! offset of the leaf's triangle ids in m_LeafTriangleIds (leaves).
+			};
+			unsigned int Bits{ LEAF_AXIS }; //>! bits 0-1: split axis (LEAF_AXIS for leaves), bit 2: left child flag, bit 3: right child flag, bits 4-31: right child index (inner nodes) or triangle count (leaves).
 
 			[[nodiscard]] bool IsALeaf() const
-            {
-				return (left_child == nullptr && right_child == nullptr);
-            }
-
-			unsigned int axis{0};
-			float splitPosition{ 0.0f };
-			pmp::BoundingBox box{};
-			std::vector<unsigned int> triangleIds{};
-            Node* left_child{ nullptr };
-            Node* right_child{ nullptr };
+			{
+				return (Bits & AXIS_MASK) == LEAF_AXIS;
+			}
+
+			[[nodiscard]] unsigned int Axis() const
+			{
+				return Bits & AXIS_MASK;
+			}
+
+			[[nodiscard]] bool HasLeftChild() const
+			{
+				return Bits & LEFT_CHILD_BIT;
+			}
+
+			[[nodiscard]] bool HasRightChild() const
+			{
+				return Bits & RIGHT_CHILD_BIT;
+			}
+
+			/// \brief right child index of an inner node, or triangle count of a leaf.
+			[[nodiscard]] unsigned int Payload() const
+			{
+				return Bits >> PAYLOAD_SHIFT;
+			}
 		};
+		static_assert(sizeof(FlatNode) == 8);
 
-        /**
-		 * \brief The recursive part of building this KD tree.
-		 * \param node             node to be initialized.
-		 * \param box              bounding box of the node to be initialized.
-		 * \param triangleIds      indices of triangles to construct node from.
-		 * \param remainingDepth   depth remaining for node construction.
+		/// \brief output and working buffers of a (sub)tree build.
+		struct BuildBuffers
+		{
+			std::vector<FlatNode> Nodes{}; //>! nodes in depth-first order, right child indices are relative to the first node.
+			std::vector<unsigned int> LeafTriangleIds{}; //>! triangle ids of all leaves.
+			std::vector<unsigned int> TriangleIds{}; //>! triangle ids of the nodes being built. Each node compacts its left child's ids in place, and appends its right child's ids.
+		};
+
+		/// \brief a subtree to be built by a worker thread of a parallel build.
+		struct SubtreeTask
+		{
+			pmp::BoundingBox Box{};
+			std::vector<unsigned int> TriangleIds{};
+			unsigned int RemainingDepth{ 0 };
+		};
+
+		/**
+		 * \brief The recursive part of building this KD tree. Appends the node and its subtree to buffers.Nodes.
+		 * \param box                 bounding box of the node to be initialized.
+		 * \param idsBegin            start of the node's triangle ids in buffers.TriangleIds.
+		 * \param idsEnd              end of the node's triangle ids in buffers.TriangleIds.
+		 * \param remainingDepth      depth remaining for node construction.
+		 * \param buffers             build buffers.
+		 * \param subtreeTasks        if not null, nodes at remainingTopLevels == 0 (or with at most KD_TREE_PARALLEL_BUILD_CUTOFF triangles) are not built, but collected as subtree tasks.
+		 * \param remainingTopLevels  the number of levels remaining until subtree tasks are collected.
+		 * \return false if the node is an empty leaf (the last item of buffers.Nodes), which can be removed by the caller.
+		 */
+		[[nodiscard]] bool BuildRecurse(const pmp::BoundingBox& box, const size_t& idsBegin, const size_t& idsEnd, unsigned int remainingDepth,
+			BuildBuffers& buffers, std::vector<SubtreeTask>* subtreeTasks = nullptr, unsigned int remainingTopLevels = 0) const;
+
+		/**
+		 * \brief Builds this KD tree by building its top levels serially, and the resulting subtrees on nThreads worker threads.
+		 * \param box             bounding box of the root node.
+		 * \param triangleIds     indices of all triangles.
+		 * \param nThreads        the number of worker threads.
+		 */
+		void BuildParallel(const pmp::BoundingBox& box, std::vector<unsigned int>&& triangleIds, const unsigned int& nThreads);
+
+		/**
+		 * \brief Appends a node of the serially built top levels with its subtree (including the subtrees built in parallel) to m_Nodes.
+		 * \param topBuffers          build buffers of the top levels.
+		 * \param topNodeId           index of the node in topBuffers.Nodes.
+		 * \param subtreeBuffers      build buffers of the subtrees.
+		 * \param subtreeNonEmpty     flags of non-empty subtrees.
+		 * \return false if the node is an empty leaf (the last item of m_Nodes), which can be removed by the caller.
 		 */
-        void BuildRecurse(Node* node, const pmp::BoundingBox& box, const std::vector<unsigned int>& triangleIds, unsigned int remainingDepth);
+		[[nodiscard]] bool AppendTopLevelNode(const BuildBuffers& topBuffers, const unsigned int& topNodeId,
+			const std::vector<BuildBuffers>& subtreeBuffers, const std::vector<char>& subtreeNonEmpty);
 
-        Node* m_Root{ nullptr };
+		/**
+		 * \brief Searches for a triangle closer to a given point than the closest triangle found so far.
+		 * \param point            query point.
+		 * \param closestTriId     index of the closest triangle found so far (updated).
+		 * \param closestDistSq    squared distance to the closest triangle found so far, or the squared max distance (updated).
+		 *
+		 * DISCLAIMER: Among equally distant triangles, the one with the smallest index is chosen, so the result does not depend on the initial closestTriId.
+		 */
+		void RefineClosestTriangle(const pmp::vec3& point, unsigned int& closestTriId, double& closestDistSq) const;
+
+		/// \brief triangle ids of a leaf node.
+		[[nodiscard]] std::span<const unsigned int> LeafTriangleIds(const FlatNode& leaf) const
+		{
+			return { m_LeafTriangleIds.data() + leaf.FirstTriangle, leaf.Payload() };
+		}
+
+		/**
+		 * \brief Visits the leaves whose boxes intersect a given box.
+		 * \param box         query box.
+		 * \param leafFunc    functor taking the leaf's triangle ids, returns true if the traversal should stop.
+		 * \return true if the traversal was stopped by leafFunc.
+		 */
+		template <typename LeafFunction>
+		bool VisitLeavesIntersectingBox(const pmp::BoundingBox& box, const LeafFunction& leafFunc) const;
+
+		/**
+		 * \brief Visits the leaves whose boxes are intersected by a given ray.
+		 * \param ray         query ray.
+		 * \param leafFunc    functor taking the leaf's triangle ids.
+		 */
+		template <typename LeafFunction>
+		void VisitLeavesIntersectingRay(Geometry::Ray& ray, const LeafFunction& leafFunc) const;
 
-        size_t m_NodeCount{0};
+		pmp::BoundingBox m_RootBox{};
+		std::vector<FlatNode> m_Nodes{}; //>! nodes in depth-first order, m_Nodes[0] is the root.
+		std::vector<unsigned int> m_LeafTriangleIds{}; //>! triangle ids of all leaves.
 
-		SplitFunction m_FindSplitAndClassify{};
+		SplitFunction m_FindSplitPosition{};
 		std::vector<pmp::vec3> m_VertexPositions{};
 		std::vector<Triangle> m_Triangles{};
+		TriangleSoA m_TriangleVertexData{};
 	};
 }
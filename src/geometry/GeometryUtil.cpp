@@ -31,23 +31,23 @@ namespace Geometry
 	                             dest[1] = alpha * v[1]; \
 	                             dest[2] = alpha * v[2];
 
-	double GetDistanceToTriangleSq(const std::vector<pmp::vec3>& vertices, const pmp::vec3& point)
+	/**
+	 * \brief Finds the barycentric parameters of the point of a triangle closest to a given point.
+	 * \param a00      dot(edge0, edge0).
+	 * \param a01      dot(edge0, edge1).
+	 * \param a11      dot(edge1, edge1).
+	 * \param b0       -dot(point - v0, edge0).
+	 * \param b1       -dot(point - v0, edge1).
+	 * \param t0       parameter along edge0 (output).
+	 * \param t1       parameter along edge1 (output).
+	 */
+	void GetClosestTriangleParams(const double& a00, const double& a01, const double& a11, const double& b0, const double& b1, double& t0, double& t1)
 	{
-		assert(vertices.size() == 3); // only vertex triples allowed
-
-		pmp::vec3 diff = point - vertices[0];
-		pmp::vec3 edge0 = vertices[1] - vertices[0];
-		pmp::vec3 edge1 = vertices[2] - vertices[0];
-		const double a00 = DOT(edge0, edge0);
-		const double a01 = DOT(edge0, edge1);
-		const double a11 = DOT(edge1, edge1);
-		const double b0 = -DOT(diff, edge0);
-		const double b1 = -DOT(diff, edge1);
 		constexpr double zero = 0.0;
 		constexpr double one = 1.0;
 		const double det = a00 * a11 - a01 * a01;
-		double t0 = a01 * b1 - a11 * b0;
-		double t1 = a01 * b0 - a00 * b1;
+		t0 = a01 * b1 - a11 * b0;
+		t1 = a01 * b0 - a00 * b1;
 
 		if (t0 + t1 <= det) {
 			if (t0 < zero) {
@@ -183,6 +183,22 @@ namespace Geometry
 				}
 			}
 		}
+	}
+
+	double GetDistanceToTriangleSq(const std::vector<pmp::vec3>& vertices, const pmp::vec3& point)
+	{
+		assert(vertices.size() == 3); // only vertex triples allowed
+
+		pmp::vec3 diff = point - vertices[0];
+		pmp::vec3 edge0 = vertices[1] - vertices[0];
+		pmp::vec3 edge1 = vertices[2] - vertices[0];
+		const double a00 = DOT(edge0, edge0);
+		const double a01 = DOT(edge0, edge1);
+		const double a11 = DOT(edge1, edge1);
+		const double b0 = -DOT(diff, edge0);
+		const double b1 = -DOT(diff, edge1);
+		double t0, t1;
+		GetClosestTriangleParams(a00, a01, a11, b0, b1, t0, t1);
 
 		pmp::vec3 closest = vertices[0] + t0 * edge0 + t1 * edge1;
 		SUB(diff, point, closest);
@@ -190,6 +206,57 @@ namespace Geometry
 		return DOT(diff, diff);
 	}
 
+	void TriangleSoA::Reserve(const size_t& nTriangles)
+	{
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			V0[i].reserve(nTriangles);
+			Edge0[i].reserve(nTriangles);
+			Edge1[i].reserve(nTriangles);
+		}
+		Edge00.reserve(nTriangles);
+		Edge01.reserve(nTriangles);
+		Edge11.reserve(nTriangles);
+	}
+
+	void TriangleSoA::Add(const pmp::vec3& v0, const pmp::vec3& v1, const pmp::vec3& v2)
+	{
+		const pmp::vec3 edge0 = v1 - v0;
+		const pmp::vec3 edge1 = v2 - v0;
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			V0[i].push_back(v0[i]);
+			Edge0[i].push_back(edge0[i]);
+			Edge1[i].push_back(edge1[i]);
+		}
+		Edge00.push_back(DOT(edge0, edge0));
+		Edge01.push_back(DOT(edge0, edge1));
+		Edge11.push_back(DOT(edge1, edge1));
+	}
+
+	pmp::vec3 GetClosestPointOnTriangle(const TriangleSoA& triangles, const size_t& triId, const pmp::vec3& point)
+	{
+		assert(triId < triangles.Size());
+		const pmp::vec3 v0{ triangles.V0[0][triId], triangles.V0[1][triId], triangles.V0[2][triId] };
+		const pmp::vec3 edge0{ triangles.Edge0[0][triId], triangles.Edge0[1][triId], triangles.Edge0[2][triId] };
+		const pmp::vec3 edge1{ triangles.Edge1[0][triId], triangles.Edge1[1][triId], triangles.Edge1[2][triId] };
+		const pmp::vec3 diff = point - v0;
+		const double b0 = -DOT(diff, edge0);
+		const double b1 = -DOT(diff, edge1);
+		double t0, t1;
+		GetClosestTriangleParams(triangles.Edge00[triId], triangles.Edge01[triId], triangles.Edge11[triId], b0, b1, t0, t1);
+
+		return v0 + t0 * edge0 + t1 * edge1;
+	}
+
+	double GetDistanceToTriangleSq(const TriangleSoA& triangles, const size_t& triId, const pmp::vec3& point)
+	{
+		pmp::vec3 diff = GetClosestPointOnTriangle(triangles, triId, point);
+		SUB(diff, point, diff);
+
+		return DOT(diff, diff);
+	}
+
 	/**
 	 * \brief Utility to compute intersection between plane (defined by normal and ref point) and a box (defined only by its max point).
 	 * \param normal     plane normal.
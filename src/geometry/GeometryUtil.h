@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include "pmp/MatVec.h"
 
@@ -25,6 +26,57 @@ namespace Geometry
 	 */
 	[[nodiscard]] double GetDistanceToTriangleSq(const std::vector<pmp::vec3>& vertices, const pmp::vec3& point);
 
+	/**
+	 * \brief Vertex data of a set of triangles in a structure-of-arrays layout for repeated point-triangle distance evaluations.
+	 *        Each triangle is stored as its first vertex and the two edge vectors leaving it, together with the edges' dot products.
+	 */
+	struct TriangleSoA
+	{
+		std::vector<float> V0[3];    //>! coordinates of the first vertices.
+		std::vector<float> Edge0[3]; //>! coordinates of edges v1 - v0.
+		std::vector<float> Edge1[3]; //>! coordinates of edges v2 - v0.
+		std::vector<float> Edge00;   //>! dot(Edge0, Edge0).
+		std::vector<float> Edge01;   //>! dot(Edge0, Edge1).
+		std::vector<float> Edge11;   //>! dot(Edge1, Edge1).
+
+		/// \brief reserves memory for nTriangles triangles.
+		void Reserve(const size_t& nTriangles);
+
+		/// \brief appends a triangle given by its vertices.
+		void Add(const pmp::vec3& v0, const pmp::vec3& v1, const pmp::vec3& v2);
+
+		[[nodiscard]] size_t Size() const
+		{
+			return Edge00.size();
+		}
+
+		/// \brief memory footprint of the triangle data in bytes.
+		[[nodiscard]] size_t MemoryUsage() const
+		{
+			return 12 * Size() * sizeof(float);
+		}
+	};
+
+	/**
+	 * \brief Computes the squared distance from point to a triangle stored in a TriangleSoA.
+	 * \param triangles    triangle data.
+	 * \param triId        index of the triangle in triangles.
+	 * \param point        point from which the distance is to be computed.
+	 * \return squared distance from point to triangle.
+	 *
+	 * DISCLAIMER: The result is identical to GetDistanceToTriangleSq for the triangle's vertex list, and no heap memory is used.
+	 */
+	[[nodiscard]] double GetDistanceToTriangleSq(const TriangleSoA& triangles, const size_t& triId, const pmp::vec3& point);
+
+	/**
+	 * \brief Computes the point of a triangle stored in a TriangleSoA closest to a given point.
+	 * \param triangles    triangle data.
+	 * \param triId        index of the triangle in triangles.
+	 * \param point        point to be projected onto the triangle.
+	 * \return the closest point of the triangle.
+	 */
+	[[nodiscard]] pmp::vec3 GetClosestPointOnTriangle(const TriangleSoA& triangles, const size_t& triId, const pmp::vec3& point);
+
 	/**
 	 * \brief An intersection test between a triangle and a box.
 	 * \param vertices     list of (three) vertices of a triangle.
@@ -2,65 +2,66 @@
 
 namespace Geometry
 {
-	ScalarGrid::ScalarGrid(const float& cellSize, const pmp::BoundingBox& box)
-		: m_CellSize(cellSize)
+	GridDimensions SnapBoxToGlobalGrid(const float& cellSize, const pmp::BoundingBox& box, pmp::BoundingBox& snappedBox)
 	{
 		// compute global grid bounds
-		const int nXMinus = std::floor(box.min()[0] / m_CellSize);
-		const int nXPlus = std::ceil(box.max()[0] / m_CellSize);
+		const int nXMinus = std::floor(box.min()[0] / cellSize);
+		const int nXPlus = std::ceil(box.max()[0] / cellSize);
 
-		const int nYMinus = std::floor(box.min()[1] / m_CellSize);
-		const int nYPlus = std::ceil(box.max()[1] / m_CellSize);
+		const int nYMinus = std::floor(box.min()[1] / cellSize);
+		const int nYPlus = std::ceil(box.max()[1] / cellSize);
 
-		const int nZMinus = std::floor(box.min()[2] / m_CellSize);
-		const int nZPlus = std::ceil(box.max()[2] / m_CellSize);
+		const int nZMinus = std::floor(box.min()[2] / cellSize);
+		const int nZPlus = std::ceil(box.max()[2] / cellSize);
 
 		// adjust box
-		const auto minVec = pmp::vec3(nXMinus, nYMinus, nZMinus) * m_CellSize;
-		const auto maxVec = pmp::vec3(nXPlus, nYPlus, nZPlus) * m_CellSize;
-		m_Box = pmp::BoundingBox(minVec, maxVec);
+		const auto minVec = pmp::vec3(nXMinus, nYMinus, nZMinus) * cellSize;
+		const auto maxVec = pmp::vec3(nXPlus, nYPlus, nZPlus) * cellSize;
+		snappedBox = pmp::BoundingBox(minVec, maxVec);
 
-		m_Dimensions = GridDimensions{
+		return GridDimensions{
 			static_cast<size_t>(nXPlus - nXMinus),
 			static_cast<size_t>(nYPlus - nYMinus),
 			static_cast<size_t>(nZPlus - nZMinus)
 		};
+	}
+
+	template <typename T>
+	BasicScalarGrid<T>::BasicScalarGrid(const float& cellSize, const pmp::BoundingBox& box)
+		: m_CellSize(cellSize)
+	{
+		m_Dimensions = SnapBoxToGlobalGrid(m_CellSize, box, m_Box);
 
 		const size_t nValues = m_Dimensions.Nx * m_Dimensions.Ny * m_Dimensions.Nz;
-		m_Values = std::vector(nValues, DEFAULT_SCALAR_GRID_INIT_VAL);
+		m_Values = std::vector(nValues, static_cast<T>(DEFAULT_SCALAR_GRID_INIT_VAL));
 		m_FrozenValues = std::vector(nValues, false);
 	}
 
-	ScalarGrid::ScalarGrid(const float& cellSize, const pmp::BoundingBox& box, const double& initVal)
+	template <typename T>
+	BasicScalarGrid<T>::BasicScalarGrid(const float& cellSize, const pmp::BoundingBox& box, const double& initVal)
 		: m_CellSize(cellSize)
 	{
-		// compute global grid bounds
-		const int nXMinus = std::floor(box.min()[0] / m_CellSize);
-		const int nXPlus = std::ceil(box.max()[0] / m_CellSize);
-
-		const int nYMinus = std::floor(box.min()[1] / m_CellSize);
-		const int nYPlus = std::ceil(box.max()[1] / m_CellSize);
-
-		const int nZMinus = std::floor(box.min()[2] / m_CellSize);
-		const int nZPlus = std::ceil(box.max()[2] / m_CellSize);
+		m_Dimensions = SnapBoxToGlobalGrid(m_CellSize, box, m_Box);
 
-		// adjust box
-		const auto maxVec = pmp::vec3(nXPlus, nYPlus, nZPlus) * m_CellSize;
-		const auto minVec = pmp::vec3(nXMinus, nYMinus, nZMinus) * m_CellSize;
-		m_Box = pmp::BoundingBox(minVec, maxVec);
+		const size_t nValues = m_Dimensions.Nx * m_Dimensions.Ny * m_Dimensions.Nz;
+		m_Values = std::vector(nValues, static_cast<T>(initVal));
+		m_FrozenValues = std::vector(nValues, false);
+	}
 
-		m_Dimensions = GridDimensions{
-			static_cast<size_t>(nXPlus - nXMinus),
-			static_cast<size_t>(nYPlus - nYMinus),
-			static_cast<size_t>(nZPlus - nZMinus)
-		};
+	template <typename T>
+	BasicScalarGrid<T>::BasicScalarGrid(const float& cellSize, const pmp::vec3& origin, const GridDimensions& dims, const double& initVal)
+		: m_Dimensions(dims), m_CellSize(cellSize)
+	{
+		const auto maxVec = origin + pmp::vec3(static_cast<float>(dims.Nx), static_cast<float>(dims.Ny), static_cast<float>(dims.Nz)) * cellSize;
+		m_Box = pmp::BoundingBox(origin, maxVec);
 
 		const size_t nValues = m_Dimensions.Nx * m_Dimensions.Ny * m_Dimensions.Nz;
-		m_Values = std::vector(nValues, initVal);
+		m_Values = std::vector(nValues, static_cast<T>(initVal));
 		m_FrozenValues = std::vector(nValues, false);
 	}
 
-	bool ScalarGrid::operator==(const ScalarGrid& other) const
+	template <typename T>
+	bool BasicScalarGrid<T>::operator==(const BasicScalarGrid<T>& other) const
 	{
 		if (m_Values.size() != other.m_Values.size())
 			return false;
@@ -68,7 +69,8 @@ namespace Geometry
 		return memcmp(&m_Values.front(), &other.m_Values.front(), sizeof(m_Values[0]) * m_Values.size()) == 0;
 	}
 
-	bool ScalarGrid::operator!=(const ScalarGrid& other) const
+	template <typename T>
+	bool BasicScalarGrid<T>::operator!=(const BasicScalarGrid<T>& other) const
 	{
 		if (m_Values.size() != other.m_Values.size())
 			return true;
@@ -76,14 +78,16 @@ namespace Geometry
 		return memcmp(&m_Values.front(), &other.m_Values.front(), sizeof(m_Values[0]) * m_Values.size()) != 0;
 	}
 
-	ScalarGrid& ScalarGrid::operator*=(const double& scalar)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator*=(const double& scalar)
 	{
 		for (auto& val : m_Values)
 			val = scalar * val;
 		return *this;
 	}
 
-	ScalarGrid& ScalarGrid::operator*=(const ScalarGrid& other)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator*=(const BasicScalarGrid<T>& other)
 	{
 		if (m_Values.size() == other.m_Values.size())
 		{
@@ -91,12 +95,13 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_Values.size(); i++)
+		for (size_t i = 0; i < m_Values.size(); i++)
 			m_Values[i] *= other.m_Values[i];
 		return *this;
 	}
 
-	ScalarGrid& ScalarGrid::operator/=(const double& scalar)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator/=(const double& scalar)
 	{
 		if (scalar == 0.0)
 		{
@@ -109,7 +114,8 @@ namespace Geometry
 		return *this;
 	}
 
-	ScalarGrid& ScalarGrid::operator/=(const ScalarGrid& other)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator/=(const BasicScalarGrid<T>& other)
 	{
 		if (m_Values.size() == other.m_Values.size())
 		{
@@ -117,7 +123,7 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_Values.size(); i++)
+		for (size_t i = 0; i < m_Values.size(); i++)
 		{
 			assert(other.m_Values[i] != 0.0);
 			m_Values[i] /= other.m_Values[i];
@@ -125,14 +131,16 @@ namespace Geometry
 		return *this;
 	}
 
-	ScalarGrid& ScalarGrid::operator+=(const double& scalar)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator+=(const double& scalar)
 	{
 		for (auto& val : m_Values)
 			val += scalar;
 		return *this;
 	}
 
-	ScalarGrid& ScalarGrid::operator+=(const ScalarGrid& other)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator+=(const BasicScalarGrid<T>& other)
 	{
 		if (m_Values.size() == other.m_Values.size())
 		{
@@ -140,19 +148,21 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_Values.size(); i++)
+		for (size_t i = 0; i < m_Values.size(); i++)
 			m_Values[i] += other.m_Values[i];
 		return *this;
 	}
 
-	ScalarGrid& ScalarGrid::operator-=(const double& scalar)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator-=(const double& scalar)
 	{
 		for (auto& val : m_Values)
 			val -= scalar;
 		return *this;
 	}
 
-	ScalarGrid& ScalarGrid::operator-=(const ScalarGrid& other)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator-=(const BasicScalarGrid<T>& other)
 	{
 		if (m_Values.size() == other.m_Values.size())
 		{
@@ -160,68 +170,77 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_Values.size(); i++)
+		for (size_t i = 0; i < m_Values.size(); i++)
 			m_Values[i] -= other.m_Values[i];
 		return *this;
 	}
 
-	ScalarGrid ScalarGrid::operator*(const double& scalar) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator*(const double& scalar) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result *= scalar;
 		return result;
 	}
 
-	ScalarGrid ScalarGrid::operator*(const ScalarGrid& other) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator*(const BasicScalarGrid<T>& other) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result *= other;
 		return result;
 	}
 
-	ScalarGrid ScalarGrid::operator/(const double& scalar) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator/(const double& scalar) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result /= scalar;
 		return result;
 	}
 
-	ScalarGrid ScalarGrid::operator/(const ScalarGrid& other) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator/(const BasicScalarGrid<T>& other) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result /= other;
 		return result;
 	}
 
-	ScalarGrid ScalarGrid::operator+(const double& scalar) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator+(const double& scalar) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result += scalar;
 		return result;
 	}
 
-	ScalarGrid ScalarGrid::operator+(const ScalarGrid& other) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator+(const BasicScalarGrid<T>& other) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result += other;
 		return result;
 	}
 
-	ScalarGrid ScalarGrid::operator-(const double& scalar) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator-(const double& scalar) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result -= scalar;
 		return result;
 	}
 
-	ScalarGrid ScalarGrid::operator-(const ScalarGrid& other) const
+	template <typename T>
+	BasicScalarGrid<T> BasicScalarGrid<T>::operator-(const BasicScalarGrid<T>& other) const
 	{
-		ScalarGrid result(*this);
+		BasicScalarGrid<T> result(*this);
 		result -= other;
 		return result;
 	}
 
-	ScalarGrid& ScalarGrid::operator*=(const pmp::mat4& mat)
+	template <typename T>
+	BasicScalarGrid<T>& BasicScalarGrid<T>::operator*=(const pmp::mat4& mat)
 	{
 		// assuming mat is a uniform scaling + translation matrix only.
 		m_CellSize *= mat(0, 0);
@@ -229,7 +248,8 @@ namespace Geometry
 		return *this;
 	}
 
-	bool ScalarGrid::IsValid() const
+	template <typename T>
+	bool BasicScalarGrid<T>::IsValid() const
 	{
 		if (m_CellSize <= 0.0f)
 			return false;
@@ -243,79 +263,45 @@ namespace Geometry
 		return m_Dimensions.Valid();
 	}
 
-	VectorGrid::VectorGrid(const ScalarGrid& scalarGrid)
+	template <typename T>
+	BasicVectorGrid<T>::BasicVectorGrid(const BasicScalarGrid<T>& scalarGrid)
 		: m_Box(scalarGrid.Box()), m_Dimensions(scalarGrid.Dimensions()), m_CellSize(scalarGrid.CellSize())
 	{
 		const size_t nValues = m_Dimensions.Nx * m_Dimensions.Ny * m_Dimensions.Nz;
-		m_ValuesX = std::vector(nValues, DEFAULT_VECTOR_GRID_INIT_VAL);
-		m_ValuesY = std::vector(nValues, DEFAULT_VECTOR_GRID_INIT_VAL);
-		m_ValuesZ = std::vector(nValues, DEFAULT_VECTOR_GRID_INIT_VAL);
+		m_ValuesX = std::vector(nValues, static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL));
+		m_ValuesY = std::vector(nValues, static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL));
+		m_ValuesZ = std::vector(nValues, static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL));
 		m_FrozenValues = std::vector(nValues, false);
 	}
 
-	VectorGrid::VectorGrid(const float& cellSize, const pmp::BoundingBox& box)
+	template <typename T>
+	BasicVectorGrid<T>::BasicVectorGrid(const float& cellSize, const pmp::BoundingBox& box)
 		: m_CellSize(cellSize)
 	{
-		// compute global grid bounds
-		const int nXMinus = std::floor(box.min()[0] / m_CellSize);
-		const int nXPlus = std::ceil(box.max()[0] / m_CellSize);
-
-		const int nYMinus = std::floor(box.min()[1] / m_CellSize);
-		const int nYPlus = std::ceil(box.max()[1] / m_CellSize);
-
-		const int nZMinus = std::floor(box.min()[2] / m_CellSize);
-		const int nZPlus = std::ceil(box.max()[2] / m_CellSize);
-
-		// adjust box
-		const auto minVec = pmp::vec3(nXMinus, nYMinus, nZMinus) * m_CellSize;
-		const auto maxVec = pmp::vec3(nXPlus, nYPlus, nZPlus) * m_CellSize;
-		m_Box = pmp::BoundingBox(minVec, maxVec);
-
-		m_Dimensions = GridDimensions{
-			static_cast<size_t>(nXPlus - nXMinus),
-			static_cast<size_t>(nYPlus - nYMinus),
-			static_cast<size_t>(nZPlus - nZMinus)
-		};
+		m_Dimensions = SnapBoxToGlobalGrid(m_CellSize, box, m_Box);
 
 		const size_t nValues = m_Dimensions.Nx * m_Dimensions.Ny * m_Dimensions.Nz;
-		m_ValuesX = std::vector(nValues, DEFAULT_VECTOR_GRID_INIT_VAL);
-		m_ValuesY = std::vector(nValues, DEFAULT_VECTOR_GRID_INIT_VAL);
-		m_ValuesZ = std::vector(nValues, DEFAULT_VECTOR_GRID_INIT_VAL);
+		m_ValuesX = std::vector(nValues, static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL));
+		m_ValuesY = std::vector(nValues, static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL));
+		m_ValuesZ = std::vector(nValues, static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL));
 		m_FrozenValues = std::vector(nValues, false);
 	}
 
-	VectorGrid::VectorGrid(const float& cellSize, const pmp::BoundingBox& box, const pmp::vec3& initVal)
+	template <typename T>
+	BasicVectorGrid<T>::BasicVectorGrid(const float& cellSize, const pmp::BoundingBox& box, const pmp::vec3& initVal)
 		: m_CellSize(cellSize)
 	{
-		// compute global grid bounds
-		const int nXMinus = std::floor(box.min()[0] / m_CellSize);
-		const int nXPlus = std::ceil(box.max()[0] / m_CellSize);
-
-		const int nYMinus = std::floor(box.min()[1] / m_CellSize);
-		const int nYPlus = std::ceil(box.max()[1] / m_CellSize);
-
-		const int nZMinus = std::floor(box.min()[2] / m_CellSize);
-		const int nZPlus = std::ceil(box.max()[2] / m_CellSize);
-
-		// adjust box
-		const auto maxVec = pmp::vec3(nXPlus, nYPlus, nZPlus) * m_CellSize;
-		const auto minVec = pmp::vec3(nXMinus, nYMinus, nZMinus) * m_CellSize;
-		m_Box = pmp::BoundingBox(minVec, maxVec);
-
-		m_Dimensions = GridDimensions{
-			static_cast<size_t>(nXPlus - nXMinus),
-			static_cast<size_t>(nYPlus - nYMinus),
-			static_cast<size_t>(nZPlus - nZMinus)
-		};
+		m_Dimensions = SnapBoxToGlobalGrid(m_CellSize, box, m_Box);
 
 		const size_t nValues = m_Dimensions.Nx * m_Dimensions.Ny * m_Dimensions.Nz;
-		m_ValuesX = std::vector(nValues, static_cast<double>(initVal[0]));
-		m_ValuesY = std::vector(nValues, static_cast<double>(initVal[1]));
-		m_ValuesZ = std::vector(nValues, static_cast<double>(initVal[2]));
+		m_ValuesX = std::vector(nValues, static_cast<T>(initVal[0]));
+		m_ValuesY = std::vector(nValues, static_cast<T>(initVal[1]));
+		m_ValuesZ = std::vector(nValues, static_cast<T>(initVal[2]));
 		m_FrozenValues = std::vector(nValues, false);
 	}
 
-	bool VectorGrid::operator==(const VectorGrid& other) const
+	template <typename T>
+	bool BasicVectorGrid<T>::operator==(const BasicVectorGrid<T>& other) const
 	{
 		if (m_ValuesX.size() != other.m_ValuesX.size())
 			return false;
@@ -326,7 +312,8 @@ namespace Geometry
 			(memcmp(&m_ValuesX.front(), &other.m_ValuesZ.front(), sizeof(m_ValuesZ[0]) * m_ValuesZ.size()) == 0);
 	}
 
-	bool VectorGrid::operator!=(const VectorGrid& other) const
+	template <typename T>
+	bool BasicVectorGrid<T>::operator!=(const BasicVectorGrid<T>& other) const
 	{
 		if (m_ValuesX.size() != other.m_ValuesX.size())
 			return true;
@@ -337,9 +324,10 @@ namespace Geometry
 			(memcmp(&m_ValuesX.front(), &other.m_ValuesZ.front(), sizeof(m_ValuesZ[0]) * m_ValuesZ.size()) != 0);
 	}
 
-	VectorGrid& VectorGrid::operator*=(const double& scalar)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator*=(const double& scalar)
 	{
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			m_ValuesX[i] *= scalar;
 			m_ValuesY[i] *= scalar;
@@ -348,7 +336,8 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid& VectorGrid::operator*=(const VectorGrid& other)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator*=(const BasicVectorGrid<T>& other)
 	{
 		if (m_ValuesX.size() != other.m_ValuesX.size())
 		{
@@ -356,7 +345,7 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			m_ValuesX[i] *= other.m_ValuesX[i];
 			m_ValuesY[i] *= other.m_ValuesY[i];
@@ -365,7 +354,8 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid& VectorGrid::operator/=(const double& scalar)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator/=(const double& scalar)
 	{
 		if (scalar == 0.0)
 		{
@@ -373,7 +363,7 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			m_ValuesX[i] /= scalar;
 			m_ValuesY[i] /= scalar;
@@ -382,7 +372,8 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid& VectorGrid::operator/=(const VectorGrid& other)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator/=(const BasicVectorGrid<T>& other)
 	{
 		if (m_ValuesX.size() == other.m_ValuesX.size())
 		{
@@ -390,7 +381,7 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			assert(other.m_ValuesX[i] != 0.0);
 			m_ValuesX[i] /= other.m_ValuesX[i];
@@ -402,9 +393,10 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid& VectorGrid::operator+=(const double& scalar)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator+=(const double& scalar)
 	{
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			m_ValuesX[i] *= scalar;
 			m_ValuesY[i] *= scalar;
@@ -413,7 +405,8 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid& VectorGrid::operator+=(const VectorGrid& other)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator+=(const BasicVectorGrid<T>& other)
 	{
 		if (m_ValuesX.size() == other.m_ValuesX.size())
 		{
@@ -421,7 +414,7 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			m_ValuesX[i] += other.m_ValuesX[i];
 			m_ValuesY[i] += other.m_ValuesY[i];
@@ -430,9 +423,10 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid& VectorGrid::operator-=(const double& scalar)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator-=(const double& scalar)
 	{
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			m_ValuesX[i] -= scalar;
 			m_ValuesY[i] -= scalar;
@@ -441,7 +435,8 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid& VectorGrid::operator-=(const VectorGrid& other)
+	template <typename T>
+	BasicVectorGrid<T>& BasicVectorGrid<T>::operator-=(const BasicVectorGrid<T>& other)
 	{
 		if (m_ValuesX.size() == other.m_ValuesX.size())
 		{
@@ -449,7 +444,7 @@ namespace Geometry
 			return *this;
 		}
 
-		for (unsigned int i = 0; i < m_ValuesX.size(); i++)
+		for (size_t i = 0; i < m_ValuesX.size(); i++)
 		{
 			m_ValuesX[i] -= other.m_ValuesX[i];
 			m_ValuesY[i] -= other.m_ValuesY[i];
@@ -458,63 +453,72 @@ namespace Geometry
 		return *this;
 	}
 
-	VectorGrid VectorGrid::operator*(const double& scalar) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator*(const double& scalar) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result *= scalar;
 		return result;
 	}
 
-	VectorGrid VectorGrid::operator*(const VectorGrid& other) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator*(const BasicVectorGrid<T>& other) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result *= other;
 		return result;
 	}
 
-	VectorGrid VectorGrid::operator/(const double& scalar) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator/(const double& scalar) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result /= scalar;
 		return result;
 	}
 
-	VectorGrid VectorGrid::operator/(const VectorGrid& other) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator/(const BasicVectorGrid<T>& other) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result /= other;
 		return result;
 	}
 
-	VectorGrid VectorGrid::operator+(const double& scalar) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator+(const double& scalar) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result += scalar;
 		return result;
 	}
 
-	VectorGrid VectorGrid::operator+(const VectorGrid& other) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator+(const BasicVectorGrid<T>& other) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result += other;
 		return result;
 	}
 
-	VectorGrid VectorGrid::operator-(const double& scalar) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator-(const double& scalar) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result -= scalar;
 		return result;
 	}
 
-	VectorGrid VectorGrid::operator-(const VectorGrid& other) const
+	template <typename T>
+	BasicVectorGrid<T> BasicVectorGrid<T>::operator-(const BasicVectorGrid<T>& other) const
 	{
-		VectorGrid result(*this);
+		BasicVectorGrid<T> result(*this);
 		result -= other;
 		return result;
 	}
 
-	bool VectorGrid::IsValid() const
+	template <typename T>
+	bool BasicVectorGrid<T>::IsValid() const
 	{
 		if (m_CellSize <= 0.0f)
 			return false;
@@ -537,4 +541,11 @@ namespace Geometry
 		return m_Dimensions.Valid();
 	}
 
+	// ====== Explicit instantiations for the supported value types ======================
+
+	template class BasicScalarGrid<double>;
+	template class BasicScalarGrid<float>;
+	template class BasicVectorGrid<double>;
+	template class BasicVectorGrid<float>;
+
 } // namespace Geometry
@@ -25,13 +25,48 @@ namespace Geometry
 		}
 	};
 
-	/// \brief A 3D grid object containing scalar values and additional flags for individual voxels.
-	class ScalarGrid
+	/**
+	 * \brief Snaps a box to the global grid of voxels of given size (whose vertices are integer multiples of cellSize).
+	 * \param cellSize      size of a single voxel.
+	 * \param box           box to be snapped.
+	 * \param snappedBox    the smallest box of the global grid containing box.
+	 * \return voxel dimensions of snappedBox.
+	 */
+	[[nodiscard]] GridDimensions SnapBoxToGlobalGrid(const float& cellSize, const pmp::BoundingBox& box, pmp::BoundingBox& snappedBox);
+
+	/**
+	 * \brief A 3D grid object containing scalar values and additional flags for individual voxels.
+	 * \tparam T    value type of the grid's voxels (double or float).
+	 */
+	template <typename T>
+	class BasicScalarGrid
 	{
 	public:
-		ScalarGrid(const float& cellSize, const pmp::BoundingBox& box);
+		using ValueType = T;
 
-		ScalarGrid(const float& cellSize, const pmp::BoundingBox& box, const double& initVal);
+		BasicScalarGrid(const float& cellSize, const pmp::BoundingBox& box);
+
+		BasicScalarGrid(const float& cellSize, const pmp::BoundingBox& box, const double& initVal);
+
+		/**
+		 * \brief Constructor. Creates a grid of given dimensions starting at origin (the box is not snapped to the global grid).
+		 * \param cellSize    size of a single voxel.
+		 * \param origin      minimum corner of the grid's box.
+		 * \param dims        voxel dimensions of the grid.
+		 * \param initVal     initial value of all voxels.
+		 */
+		BasicScalarGrid(const float& cellSize, const pmp::vec3& origin, const GridDimensions& dims, const double& initVal);
+
+		/**
+		 * \brief Constructor. Converts a grid with a different value type.
+		 * \param other      grid to convert.
+		 */
+		template <typename U>
+		explicit BasicScalarGrid(const BasicScalarGrid<U>& other)
+			: m_Box(other.Box()), m_Dimensions(other.Dimensions()), m_CellSize(other.CellSize()),
+			m_Values(other.Values().begin(), other.Values().end()), m_FrozenValues(other.FrozenValues())
+		{
+		}
 
 		// ====== Getters ======================
 
@@ -65,12 +100,12 @@ namespace Geometry
 			return m_CellSize;
 		}
 
-		std::vector<double>& Values()
+		std::vector<T>& Values()
 		{
 			return m_Values;
 		}
 
-		[[nodiscard]] const std::vector<double>& Values() const
+		[[nodiscard]] const std::vector<T>& Values() const
 		{
 			return m_Values;
 		}
@@ -87,26 +122,26 @@ namespace Geometry
 
 		// ====== Operators ======================
 
-		bool operator==(const ScalarGrid& other) const;
-		bool operator!=(const ScalarGrid& other) const;
-		ScalarGrid& operator*= (const double& scalar);
-		ScalarGrid& operator*= (const ScalarGrid& other);
-		ScalarGrid& operator/= (const double& scalar);
-		ScalarGrid& operator/= (const ScalarGrid& other);
-		ScalarGrid& operator+= (const double& scalar);
-		ScalarGrid& operator+= (const ScalarGrid& other);
-		ScalarGrid& operator-= (const double& scalar);
-		ScalarGrid& operator-= (const ScalarGrid& other);
-		ScalarGrid operator* (const double& scalar) const;
-		ScalarGrid operator* (const ScalarGrid& other) const;
-		ScalarGrid operator/ (const double& scalar) const;
-		ScalarGrid operator/ (const ScalarGrid& other) const;
-		ScalarGrid operator+ (const double& scalar) const;
-		ScalarGrid operator+ (const ScalarGrid& other) const;
-		ScalarGrid operator- (const double& scalar) const;
-		ScalarGrid operator- (const ScalarGrid& other) const;
-
-		ScalarGrid& operator*= (const pmp::mat4& mat);
+		bool operator==(const BasicScalarGrid& other) const;
+		bool operator!=(const BasicScalarGrid& other) const;
+		BasicScalarGrid& operator*= (const double& scalar);
+		BasicScalarGrid& operator*= (const BasicScalarGrid& other);
+		BasicScalarGrid& operator/= (const double& scalar);
+		BasicScalarGrid& operator/= (const BasicScalarGrid& other);
+		BasicScalarGrid& operator+= (const double& scalar);
+		BasicScalarGrid& operator+= (const BasicScalarGrid& other);
+		BasicScalarGrid& operator-= (const double& scalar);
+		BasicScalarGrid& operator-= (const BasicScalarGrid& other);
+		BasicScalarGrid operator* (const double& scalar) const;
+		BasicScalarGrid operator* (const BasicScalarGrid& other) const;
+		BasicScalarGrid operator/ (const double& scalar) const;
+		BasicScalarGrid operator/ (const BasicScalarGrid& other) const;
+		BasicScalarGrid operator+ (const double& scalar) const;
+		BasicScalarGrid operator+ (const BasicScalarGrid& other) const;
+		BasicScalarGrid operator- (const double& scalar) const;
+		BasicScalarGrid operator- (const BasicScalarGrid& other) const;
+
+		BasicScalarGrid& operator*= (const pmp::mat4& mat);
 
 		// ====== Validity ======================
 
@@ -116,23 +151,48 @@ namespace Geometry
 		pmp::BoundingBox m_Box{};
 		GridDimensions m_Dimensions{};
 		float m_CellSize{};
-		std::vector<double> m_Values{};
+		std::vector<T> m_Values{};
 		std::vector<bool> m_FrozenValues{};
 	};
 
-	/// \brief A 3D grid object containing vector values and additional flags for individual voxels.
-	class VectorGrid
+	/// \brief double precision scalar grid.
+	using ScalarGrid = BasicScalarGrid<double>;
+	/// \brief single precision scalar grid (half the memory footprint of ScalarGrid).
+	using ScalarGridF = BasicScalarGrid<float>;
+
+	/**
+	 * \brief A 3D grid object containing vector values and additional flags for individual voxels.
+	 * \tparam T    value type of the grid's voxel components (double or float).
+	 */
+	template <typename T>
+	class BasicVectorGrid
 	{
 	public:
+		using ValueType = T;
+
 		/**
 		 * \brief Constructor. Initializes from a scalar grid with default initialization vector value.
 		 * \param scalarGrid      scalar grid to initialize from.
 		 */
-		explicit VectorGrid(const ScalarGrid& scalarGrid);
+		explicit BasicVectorGrid(const BasicScalarGrid<T>& scalarGrid);
 
-		VectorGrid(const float& cellSize, const pmp::BoundingBox& box);
+		/**
+		 * \brief Constructor. Initializes from a scalar grid with a different value type with default initialization vector value.
+		 * \param scalarGrid      scalar grid to initialize from.
+		 */
+		template <typename U>
+		explicit BasicVectorGrid(const BasicScalarGrid<U>& scalarGrid)
+			: m_Box(scalarGrid.Box()), m_Dimensions(scalarGrid.Dimensions()), m_CellSize(scalarGrid.CellSize()),
+			m_ValuesX(scalarGrid.Values().size(), static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL)),
+			m_ValuesY(scalarGrid.Values().size(), static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL)),
+			m_ValuesZ(scalarGrid.Values().size(), static_cast<T>(DEFAULT_VECTOR_GRID_INIT_VAL)),
+			m_FrozenValues(scalarGrid.Values().size(), false)
+		{
+		}
+
+		BasicVectorGrid(const float& cellSize, const pmp::BoundingBox& box);
 
-		VectorGrid(const float& cellSize, const pmp::BoundingBox& box, const pmp::vec3& initVal);
+		BasicVectorGrid(const float& cellSize, const pmp::BoundingBox& box, const pmp::vec3& initVal);
 
 		// ====== Getters ======================
 
@@ -166,32 +226,32 @@ namespace Geometry
 			return m_CellSize;
 		}
 
-		std::vector<double>& ValuesX()
+		std::vector<T>& ValuesX()
 		{
 			return m_ValuesX;
 		}
 
-		[[nodiscard]] const std::vector<double>& ValuesX() const
+		[[nodiscard]] const std::vector<T>& ValuesX() const
 		{
 			return m_ValuesX;
 		}
 
-		std::vector<double>& ValuesY()
+		std::vector<T>& ValuesY()
 		{
 			return m_ValuesY;
 		}
 
-		[[nodiscard]] const std::vector<double>& ValuesY() const
+		[[nodiscard]] const std::vector<T>& ValuesY() const
 		{
 			return m_ValuesY;
 		}
 
-		std::vector<double>& ValuesZ()
+		std::vector<T>& ValuesZ()
 		{
 			return m_ValuesZ;
 		}
 
-		[[nodiscard]] const std::vector<double>& ValuesZ() const
+		[[nodiscard]] const std::vector<T>& ValuesZ() const
 		{
 			return m_ValuesZ;
 		}
@@ -208,24 +268,24 @@ namespace Geometry
 
 		// ====== Operators ======================
 
-		bool operator==(const VectorGrid& other) const;
-		bool operator!=(const VectorGrid& other) const;
-		VectorGrid& operator*= (const double& scalar);
-		VectorGrid& operator*= (const VectorGrid& other);
-		VectorGrid& operator/= (const double& scalar);
-		VectorGrid& operator/= (const VectorGrid& other);
-		VectorGrid& operator+= (const double& scalar);
-		VectorGrid& operator+= (const VectorGrid& other);
-		VectorGrid& operator-= (const double& scalar);
-		VectorGrid& operator-= (const VectorGrid& other);
-		VectorGrid operator* (const double& scalar) const;
-		VectorGrid operator* (const VectorGrid& other) const;
-		VectorGrid operator/ (const double& scalar) const;
-		VectorGrid operator/ (const VectorGrid& other) const;
-		VectorGrid operator+ (const double& scalar) const;
-		VectorGrid operator+ (const VectorGrid& other) const;
-		VectorGrid operator- (const double& scalar) const;
-		VectorGrid operator- (const VectorGrid& other) const;
+		bool operator==(const BasicVectorGrid& other) const;
+		bool operator!=(const BasicVectorGrid& other) const;
+		BasicVectorGrid& operator*= (const double& scalar);
+		BasicVectorGrid& operator*= (const BasicVectorGrid& other);
+		BasicVectorGrid& operator/= (const double& scalar);
+		BasicVectorGrid& operator/= (const BasicVectorGrid& other);
+		BasicVectorGrid& operator+= (const double& scalar);
+		BasicVectorGrid& operator+= (const BasicVectorGrid& other);
+		BasicVectorGrid& operator-= (const double& scalar);
+		BasicVectorGrid& operator-= (const BasicVectorGrid& other);
+		BasicVectorGrid operator* (const double& scalar) const;
+		BasicVectorGrid operator* (const BasicVectorGrid& other) const;
+		BasicVectorGrid operator/ (const double& scalar) const;
+		BasicVectorGrid operator/ (const BasicVectorGrid& other) const;
+		BasicVectorGrid operator+ (const double& scalar) const;
+		BasicVectorGrid operator+ (const BasicVectorGrid& other) const;
+		BasicVectorGrid operator- (const double& scalar) const;
+		BasicVectorGrid operator- (const BasicVectorGrid& other) const;
 
 		// ====== Validity ======================
 
@@ -236,11 +296,16 @@ namespace Geometry
 		GridDimensions m_Dimensions{};
 		float m_CellSize{};
 
-		std::vector<double> m_ValuesX{};
-		std::vector<double> m_ValuesY{};
-		std::vector<double> m_ValuesZ{};
+		std::vector<T> m_ValuesX{};
+		std::vector<T> m_ValuesY{};
+		std::vector<T> m_ValuesZ{};
 
 		std::vector<bool> m_FrozenValues{};
 	};
-	
+
+	/// \brief double precision vector grid.
+	using VectorGrid = BasicVectorGrid<double>;
+	/// \brief single precision vector grid (half the memory footprint of VectorGrid).
+	using VectorGridF = BasicVectorGrid<float>;
+
 } // namespace Geometry
\ No newline at end of file
@@ -3,6 +3,12 @@
 #include "pmp/SurfaceMesh.h"
 #include "pmp/algorithms/BarycentricCoordinates.h"
 #include "pmp/algorithms/TriangleKdTree.h"
+#include "utils/ParallelUtils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 namespace Geometry
 {
@@ -11,15 +17,15 @@ namespace Geometry
 	/// \brief constant for kernel radius of a "wide" kernel.
 	constexpr unsigned int WIDE_KERNEL_RADIUS = 2;
 
-	/// \brief a blur kernel value wrapper.
+	/// \brief a separable blur kernel value wrapper. The 3D kernel is the product of the same 1D kernel along each axis.
 	struct BlurKernel
 	{
-		std::vector<double> KernelValues{};
+		std::vector<double> KernelValues{}; //>! 1D kernel weights (2 * Radius + 1 values summing up to 1).
 		unsigned int Radius;
 	};
 
 	/**
-	 * \brief Computes an averaging kernel for a voxel grid with a given radius.
+	 * \brief Computes a (separable) averaging kernel for a voxel grid with a given radius.
 	 * \param radius     number of voxels (in each axis direction) by which the kernel reaches beyond the central voxel.
 	 * \return a kernel with radius and values.
 	 */
@@ -27,96 +33,181 @@ namespace Geometry
 	{
 		assert(radius > 0);
 		const unsigned int nCellsAxis = (2 * radius + 1);
-		const unsigned int size = nCellsAxis * nCellsAxis * nCellsAxis;
-		const double voxWeight = 1.0 / size;
-		return { std::vector(size, voxWeight), radius };
+		const double voxWeight = 1.0 / nCellsAxis;
+		return { std::vector(nCellsAxis, voxWeight), radius };
 	}
 
 	/**
-	 * \brief Universal internal procedure for applying a blur kernel onto a ScalarGrid.
-	 * \param grid      input grid.
-	 * \param kernel    blur kernel to be applied.
+	 * \brief Computes a (separable) Gaussian kernel for a voxel grid with a given radius.
+	 * \param radius     number of voxels (in each axis direction) by which the kernel reaches beyond the central voxel.
+	 * \param sigma      standard deviation of the Gaussian in voxels.
+	 * \return a kernel with radius and values.
 	 */
-	void ApplyBlurKernelInternal(ScalarGrid& grid, const BlurKernel& kernel)
+	[[nodiscard]] BlurKernel GetGaussianKernel(const unsigned int& radius, const double& sigma)
 	{
+		assert(radius > 0 && sigma > 0.0);
+		const unsigned int nCellsAxis = (2 * radius + 1);
+		auto resultVals = std::vector(nCellsAxis, 0.0);
+		double wSum = 0.0;
+
+		// direct integration of the kernel over each voxel using error function (erf).
+		// 3D gaussians are independent G(x,y,z) = G(x) G(y) G(z) and so are their integrals, so a 1D kernel is sufficient.
+		for (unsigned int i = 0; i <= 2 * radius; i++)
+		{
+			const double x0 = static_cast<double>(i) - 0.5 - radius;
+			const double x1 = static_cast<double>(i) + 0.5 - radius;
+			const double voxIntegral = 0.5 * (erf(x1 / (M_SQRT2 * sigma)) - erf(x0 / (M_SQRT2 * sigma)));
+			resultVals[i] = voxIntegral;
+			wSum += voxIntegral;
+		}
+
+		// normalize
+		for (auto& val : resultVals)
+			val /= wSum;
+
+		return { resultVals, radius };
+	}
+
+	/**
+	 * \brief Applies a 1D kernel along x to each voxel row of a scalar grid (in place).
+	 *        Each row is copied into a buffer padded by its boundary values, so the weighted sums run over contiguous (vectorizable) x-ranges.
+	 * \param grid        input grid.
+	 * \param kernel      1D blur kernel.
+	 * \param nThreads    the number of worker threads (z-slabs).
+	 */
+	template <typename T>
+	void ApplyBlurKernelAlongX(BasicScalarGrid<T>& grid, const BlurKernel& kernel, const unsigned int& nThreads)
+	{
+		const auto& [Nx, Ny, Nz] = grid.Dimensions();
+		const size_t rad = kernel.Radius;
 		const auto& kernelVals = kernel.KernelValues;
-		const int rad = static_cast<int>(kernel.Radius);
-		const auto& values = grid.Values();
-		auto resultFieldValues = values;
-		const auto& dims = grid.Dimensions();
-		const int Nx = static_cast<int>(dims.Nx), Ny = static_cast<int>(dims.Ny), Nz = static_cast<int>(dims.Nz);
+		auto& values = grid.Values();
 
-		const int nKernelCellsAxis = 2 * rad + 1;
-		const int nKernelCellsAxisSq = nKernelCellsAxis * nKernelCellsAxis;
-		const auto applyKernelToVoxel = [&](const int& ix, const int& iy, const int& iz)
+		Utils::ParallelForChunks(0, Nz, nThreads, [&](const size_t izStart, const size_t izEnd, [[maybe_unused]] const unsigned int threadId)
 		{
-			double weightedSum = 0.0;
-			for (int i = -rad; i <= rad; i++)
+			std::vector<double> paddedRow(Nx + 2 * rad);
+			std::vector<double> blurredRow(Nx);
+			for (size_t iz = izStart; iz < izEnd; iz++)
 			{
-				for (int j = -rad; j <= rad; j++)
+				for (size_t iy = 0; iy < Ny; iy++)
 				{
-					for (int k = -rad; k <= rad; k++)
+					T* row = values.data() + Nx * Ny * iz + Nx * iy;
+					for (size_t ix = 0; ix < Nx; ix++)
+						paddedRow[rad + ix] = row[ix];
+					for (size_t k = 0; k < rad; k++)
 					{
-						// =========== x-indices =====================
-						int iKernX = nKernelCellsAxis + i, iGridX = ix + i;
-						// ...... x-index bounds adjustment .....
-						if (iGridX < 0)
-						{
-							iGridX = 0; iKernX = 0;
-						}
-						else if (iGridX > Nx - 1)
-						{
-							iGridX = Nx - 1; iKernX = nKernelCellsAxis - 1;
-						}
-
-						// =========== y-indices =====================
-						int iKernY = nKernelCellsAxis + j, iGridY = iy + j;
-						// ...... y-index bounds adjustment .....
-						if (iGridY < 0)
-						{
-							iGridY = 0; iKernY = 0;
-						}
-						else if (iGridY > Ny - 1)
-						{
-							iGridY = Ny - 1; iKernY = nKernelCellsAxis - 1;
-						}
-
-						// =========== z-indices =====================
-						int iKernZ = nKernelCellsAxis + k, iGridZ = iz + k;
-						// ...... y-index bounds adjustment .....
-						if (iGridZ < 0)
-						{
-							iGridZ = 0; iKernZ = 0;
-						}
-						else if (iGridZ > Nz - 1)
-						{
-							iGridZ = Nz - 1; iKernZ = nKernelCellsAxis - 1;
-						}
-
-						const unsigned int kernelGridPos = nKernelCellsAxisSq * iKernZ + nKernelCellsAxis * iKernY + iKernX;
-						const unsigned int blurredGridPos = Nx * Ny * iGridZ + Nx * iGridY + iGridX;
+						paddedRow[k] = row[0];
+						paddedRow[rad + Nx + k] = row[Nx - 1];
+					}
 
-						weightedSum += values[blurredGridPos] * kernelVals[kernelGridPos];
+					std::fill(blurredRow.begin(), blurredRow.end(), 0.0);
+					for (size_t k = 0; k <= 2 * rad; k++)
+					{
+						const double weight = kernelVals[k];
+						const double* shiftedRow = paddedRow.data() + k;
+						for (size_t ix = 0; ix < Nx; ix++)
+							blurredRow[ix] += weight * shiftedRow[ix];
 					}
+
+					for (size_t ix = 0; ix < Nx; ix++)
+						row[ix] = static_cast<T>(blurredRow[ix]);
 				}
 			}
-			resultFieldValues[Nx * Ny * iz + Nx * iy + ix] = weightedSum;
+		});
+	}
+
+	/**
+	 * \brief Applies a 1D kernel across a sequence of voxel rows (i.e.: along y or z), in place.
+	 *        The original values of the rows within the kernel's reach are kept in a ring buffer of 2 * radius + 1 rows, so no copy of the grid is needed.
+	 * \param firstRow       pointer to the first value of the first row.
+	 * \param rowStride      offset between the first values of consecutive rows.
+	 * \param nRows          number of rows.
+	 * \param rowLength      number of values of each row.
+	 * \param kernel         1D blur kernel.
+	 * \param ringBuffer     buffer for (2 * radius + 1) * rowLength original values.
+	 * \param blurredRow     buffer for rowLength blurred values.
+	 */
+	template <typename T>
+	void ApplyBlurKernelAcrossRows(T* firstRow, const size_t& rowStride, const size_t& nRows, const size_t& rowLength,
+		const BlurKernel& kernel, std::vector<double>& ringBuffer, std::vector<double>& blurredRow)
+	{
+		const size_t rad = kernel.Radius;
+		const size_t nRingRows = 2 * rad + 1;
+		const auto& kernelVals = kernel.KernelValues;
+		const auto loadRow = [&](const size_t& rowId)
+		{
+			const T* row = firstRow + rowId * rowStride;
+			double* ringRow = ringBuffer.data() + (rowId % nRingRows) * rowLength;
+			for (size_t i = 0; i < rowLength; i++)
+				ringRow[i] = row[i];
 		};
 
-		// apply kernel for each voxel;
-		for (int iz = 0; iz < Nz; iz++)
+		for (size_t rowId = 0; rowId < std::min(rad, nRows); rowId++)
+			loadRow(rowId);
+
+		for (size_t rowId = 0; rowId < nRows; rowId++)
 		{
-			for (int iy = 0; iy < Ny; iy++)
+			// row rowId + rad replaces row rowId - rad - 1 which is no longer needed
+			if (rowId + rad < nRows)
+				loadRow(rowId + rad);
+
+			std::fill(blurredRow.begin(), blurredRow.end(), 0.0);
+			for (size_t k = 0; k < nRingRows; k++)
 			{
-				for (int ix = 0; ix < Nx; ix++)
-				{
-					applyKernelToVoxel(ix, iy, iz);
-				}
+				// rows beyond the boundaries are replaced by the boundary rows
+				const size_t srcRowId = std::min(rowId + k > rad ? rowId + k - rad : 0, nRows - 1);
+				const double weight = kernelVals[k];
+				const double* ringRow = ringBuffer.data() + (srcRowId % nRingRows) * rowLength;
+				for (size_t i = 0; i < rowLength; i++)
+					blurredRow[i] += weight * ringRow[i];
 			}
+
+			T* row = firstRow + rowId * rowStride;
+			for (size_t i = 0; i < rowLength; i++)
+				row[i] = static_cast<T>(blurredRow[i]);
 		}
 	}
 
-	void NegateGridSubVolume(ScalarGrid& grid, const pmp::BoundingBox& subBox)
+	/**
+	 * \brief Universal internal procedure for applying a separable blur kernel onto a scalar grid.
+	 *        The 1D kernel is applied along x, y, and z in three in-place passes. The x and y passes are parallelized over z-slabs,
+	 *        and the z pass over y-slabs. Values beyond the grid boundaries are replaced by the boundary values.
+	 * \param grid        input grid.
+	 * \param kernel      blur kernel to be applied.
+	 * \param nThreads    the number of worker threads.
+	 */
+	template <typename T>
+	void ApplyBlurKernelInternal(BasicScalarGrid<T>& grid, const BlurKernel& kernel, const unsigned int& nThreads)
+	{
+		assert(kernel.KernelValues.size() == 2 * kernel.Radius + 1);
+		const auto& [Nx, Ny, Nz] = grid.Dimensions();
+		if (Nx == 0 || Ny == 0 || Nz == 0)
+			return;
+
+		const size_t nRingValues = (2 * static_cast<size_t>(kernel.Radius) + 1) * Nx;
+		auto& values = grid.Values();
+
+		ApplyBlurKernelAlongX(grid, kernel, nThreads);
+
+		Utils::ParallelForChunks(0, Nz, nThreads, [&](const size_t izStart, const size_t izEnd, [[maybe_unused]] const unsigned int threadId)
+		{
+			std::vector<double> ringBuffer(nRingValues);
+			std::vector<double> blurredRow(Nx);
+			for (size_t iz = izStart; iz < izEnd; iz++)
+				ApplyBlurKernelAcrossRows(values.data() + Nx * Ny * iz, Nx, Ny, Nx, kernel, ringBuffer, blurredRow);
+		});
+
+		Utils::ParallelForChunks(0, Ny, nThreads, [&](const size_t iyStart, const size_t iyEnd, [[maybe_unused]] const unsigned int threadId)
+		{
+			std::vector<double> ringBuffer(nRingValues);
+			std::vector<double> blurredRow(Nx);
+			for (size_t iy = iyStart; iy < iyEnd; iy++)
+				ApplyBlurKernelAcrossRows(values.data() + Nx * iy, Nx * Ny, Nz, Nx, kernel, ringBuffer, blurredRow);
+		});
+	}
+
+	template <typename T>
+	void NegateGridSubVolume(BasicScalarGrid<T>& grid, const pmp::BoundingBox& subBox)
 	{
 		const auto& gridBox = grid.Box();
 		const auto dMin = subBox.min() - gridBox.min();
@@ -126,109 +217,68 @@ namespace Geometry
 
 		// compute sub-grid bounds
 		const auto& cellSize = grid.CellSize();
-		const unsigned int iXStart = std::floor(dMin[0] / cellSize);
-		const unsigned int iYStart = std::floor(dMin[1] / cellSize);
-		const unsigned int iZStart = std::floor(dMin[2] / cellSize);
+		const auto iXStart = static_cast<size_t>(std::floor(dMin[0] / cellSize));
+		const auto iYStart = static_cast<size_t>(std::floor(dMin[1] / cellSize));
+		const auto iZStart = static_cast<size_t>(std::floor(dMin[2] / cellSize));
 
-		const unsigned int iXEnd = std::ceil(dMax[0] / cellSize);
-		const unsigned int iYEnd = std::ceil(dMax[1] / cellSize);
-		const unsigned int iZEnd = std::ceil(dMax[2] / cellSize);
+		const auto iXEnd = static_cast<size_t>(std::ceil(dMax[0] / cellSize));
+		const auto iYEnd = static_cast<size_t>(std::ceil(dMax[1] / cellSize));
+		const auto iZEnd = static_cast<size_t>(std::ceil(dMax[2] / cellSize));
 		const auto& dims = grid.Dimensions();
 		auto& values = grid.Values();
 		
-		for (unsigned int iz = iZStart; iz < iZEnd; iz++)
+		for (size_t iz = iZStart; iz < iZEnd; iz++)
 		{
-			for (unsigned int iy = iYStart; iy < iYEnd; iy++)
+			for (size_t iy = iYStart; iy < iYEnd; iy++)
 			{
-				for (unsigned int ix = iXStart; ix < iXEnd; ix++)
+				for (size_t ix = iXStart; ix < iXEnd; ix++)
 				{
-					const unsigned int gridPos = dims.Nx * dims.Ny * iz + dims.Nx * iy + ix;
+					const size_t gridPos = dims.Nx * dims.Ny * iz + dims.Nx * iy + ix;
 					values[gridPos] *= -1.0;
 				}
 			}
 		}
 	}
 
-	void ApplyNarrowAveragingBlur(ScalarGrid& grid)
+	template <typename T>
+	void ApplyNarrowAveragingBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads)
     {
-		constexpr int rad = static_cast<int>(NARROW_KERNEL_RADIUS);
-		const auto kernel = GetAveragingKernel(rad);
-		ApplyBlurKernelInternal(grid, kernel);
+		const auto kernel = GetAveragingKernel(NARROW_KERNEL_RADIUS);
+		ApplyBlurKernelInternal(grid, kernel, nThreads);
     }
 
-    void ApplyWideAveragingBlur(ScalarGrid& grid)
+	template <typename T>
+	void ApplyWideAveragingBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads)
     {
-		constexpr int rad = static_cast<int>(WIDE_KERNEL_RADIUS);
-		const auto kernel = GetAveragingKernel(rad);
-		ApplyBlurKernelInternal(grid, kernel);
+		const auto kernel = GetAveragingKernel(WIDE_KERNEL_RADIUS);
+		ApplyBlurKernelInternal(grid, kernel, nThreads);
     }
 
-	/**
-	 * \brief Computes a Gaussian kernel for a voxel grid with a given radius.
-	 * \param radius     number of voxels (in each axis direction) by which the kernel reaches beyond the central voxel.
-	 * \return a kernel with radius and values.
-	 */
-	[[nodiscard]] BlurKernel GetGaussianKernel(const unsigned int& radius)
-	{
-		assert(radius > 0);
-		const unsigned int nCellsAxis = (2 * radius + 1);
-		const unsigned int size = nCellsAxis * nCellsAxis * nCellsAxis;
-		const unsigned int nCellsAxisSq = nCellsAxis * nCellsAxis;
-		auto resultVals = std::vector(size, 0.0);
-
-		const double sigma = radius / 3.0;
-		double wSum = 0.0;
-
-		// direct integration of the kernel using error function (erf)
-		for (unsigned int i = 0; i <= 2 * radius; i++) 
-		{
-			for (unsigned int j = 0; j <= 2 * radius; j++) 
-			{
-				for (unsigned int k = 0; k <= 2 * radius; k++)
-				{
-					const double x0 = static_cast<double>(2 * i - 1) * 0.5 - radius;
-					const double x1 = static_cast<double>(2 * i + 1) * 0.5 - radius;
-
-					const double y0 = static_cast<double>(2 * j - 1) * 0.5 - radius;
-					const double y1 = static_cast<double>(2 * j + 1) * 0.5 - radius;
-
-					const double z0 = static_cast<double>(2 * k - 1) * 0.5 - radius;
-					const double z1 = static_cast<double>(2 * k + 1) * 0.5 - radius;
-
-					// 3D gaussians are independent G(x,y,z) = G(x) G(y) G(z) and so are their integrals
-					const double voxIntegral = 0.25 * 
-						(erf(x1 / (M_SQRT2 * sigma)) - erf(x0 / (M_SQRT2 * sigma))) *
-						(erf(y1 / (M_SQRT2 * sigma)) - erf(y0 / (M_SQRT2 * sigma))) * 
-						(erf(z1 / (M_SQRT2 * sigma)) - erf(z0 / (M_SQRT2 * sigma)));
-
-					const unsigned int id = i * nCellsAxisSq + j * nCellsAxis + k;
-					resultVals[id] = voxIntegral;
-					wSum += voxIntegral;					
-				}
-			}
-		}
-
-		// normalize
-		for (auto& val : resultVals)
-			val /= wSum;
-
-		return {resultVals, radius };
-	}
-
-    void ApplyNarrowGaussianBlur(ScalarGrid& grid)
+	template <typename T>
+	void ApplyNarrowGaussianBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads)
     {
-		constexpr int rad = static_cast<int>(NARROW_KERNEL_RADIUS);
-		const auto kernel = GetGaussianKernel(rad);
-		ApplyBlurKernelInternal(grid, kernel);
+		const auto kernel = GetGaussianKernel(NARROW_KERNEL_RADIUS, NARROW_KERNEL_RADIUS / 3.0);
+		ApplyBlurKernelInternal(grid, kernel, nThreads);
     }
 
-    void ApplyWideGaussianBlur(ScalarGrid& grid)
+	template <typename T>
+	void ApplyWideGaussianBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads)
     {
-		constexpr int rad = static_cast<int>(WIDE_KERNEL_RADIUS);
-		const auto kernel = GetGaussianKernel(rad);
-		ApplyBlurKernelInternal(grid, kernel);
+		const auto kernel = GetGaussianKernel(WIDE_KERNEL_RADIUS, WIDE_KERNEL_RADIUS / 3.0);
+		ApplyBlurKernelInternal(grid, kernel, nThreads);
     }
 
+	template <typename T>
+	void ApplyGaussianBlur(BasicScalarGrid<T>& grid, const double& sigma, const unsigned int& nThreads)
+	{
+		if (sigma <= 0.0)
+			throw std::invalid_argument("Geometry::ApplyGaussianBlur: sigma <= 0!\n");
+
+		const auto radius = static_cast<unsigned int>(std::ceil(3.0 * sigma));
+		const auto kernel = GetGaussianKernel(radius, sigma);
+		ApplyBlurKernelInternal(grid, kernel, nThreads);
+	}
+
 	/// \brief a validation helper for scalar grid values. Also increments nanCount and infCount if encountering nan or inf.
 	[[nodiscard]] bool IsGridValueValid(const double& val, size_t& nanCount, size_t& infCount)
 	{
@@ -265,9 +315,9 @@ namespace Geometry
 
 	/// \brief a boundary validation helper for scalar grid values.
 	[[nodiscard]] bool IsABoundaryCell(
-		const int& gridPosPrevX, const int& gridPosNextX,
-		const int& gridPosPrevY, const int& gridPosNextY,
-		const int& gridPosPrevZ, const int& gridPosNextZ, const size_t& gridSize)
+		const int64_t& gridPosPrevX, const int64_t& gridPosNextX,
+		const int64_t& gridPosPrevY, const int64_t& gridPosNextY,
+		const int64_t& gridPosPrevZ, const int64_t& gridPosNextZ, const size_t& gridSize)
 	{
 		if (gridPosPrevX < 0)
 			return true;
@@ -278,13 +328,13 @@ namespace Geometry
 		if (gridPosPrevZ < 0)
 			return true;
 
-		if (gridPosNextX >= static_cast<int>(gridSize))
+		if (gridPosNextX >= static_cast<int64_t>(gridSize))
 			return true;
 
-		if (gridPosNextY >= static_cast<int>(gridSize))
+		if (gridPosNextY >= static_cast<int64_t>(gridSize))
 			return true;
 
-		if (gridPosNextZ >= static_cast<int>(gridSize))
+		if (gridPosNextZ >= static_cast<int64_t>(gridSize))
 			return true;
 
 		return false;
@@ -299,33 +349,33 @@ namespace Geometry
 		const auto nValues = values.size();
 		const auto& dim = grid.Dimensions();
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const auto Nx = static_cast<int64_t>(dim.Nx);
+		const auto Ny = static_cast<int64_t>(dim.Ny);
+		const auto Nz = static_cast<int64_t>(dim.Nz);
 
 		std::cout << "----------------------------------------------------------\n";
 		std::cout << "RepairScalarGrid: repairing scalar grid...\n";
 
-		for (unsigned int iz = 0; iz < Nz; iz++) 
+		for (int64_t iz = 0; iz < Nz; iz++) 
 		{
-			for (unsigned int iy = 0; iy < Ny; iy++) 
+			for (int64_t iy = 0; iy < Ny; iy++) 
 			{
-				for (unsigned int ix = 0; ix < Nx; ix++)
+				for (int64_t ix = 0; ix < Nx; ix++)
 				{
-					const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
+					const int64_t gridPos = Nx * Ny * iz + Nx * iy + ix;
 
 					if (IsGridValueValid(values[gridPos], nanCount, infCount))
 						continue;
 
 					// check neighbors
-					const int gridPosPrevX = Nx * Ny * iz + Nx * iy + (ix - 1);
-					const int gridPosNextX = Nx * Ny * iz + Nx * iy + (ix + 1);
+					const int64_t gridPosPrevX = Nx * Ny * iz + Nx * iy + (ix - 1);
+					const int64_t gridPosNextX = Nx * Ny * iz + Nx * iy + (ix + 1);
 
-					const int gridPosPrevY = Nx * Ny * iz + Nx * (iy - 1) + ix;
-					const int gridPosNextY = Nx * Ny * iz + Nx * (iy + 1) + ix;
+					const int64_t gridPosPrevY = Nx * Ny * iz + Nx * (iy - 1) + ix;
+					const int64_t gridPosNextY = Nx * Ny * iz + Nx * (iy + 1) + ix;
 
-					const int gridPosPrevZ = Nx * Ny * (iz - 1) + Nx * iy + ix;
-					const int gridPosNextZ = Nx * Ny * (iz + 1) + Nx * iy + ix;
+					const int64_t gridPosPrevZ = Nx * Ny * (iz - 1) + Nx * iy + ix;
+					const int64_t gridPosNextZ = Nx * Ny * (iz + 1) + Nx * iy + ix;
 
 					if (IsABoundaryCell(gridPosPrevX, gridPosNextX, gridPosPrevY, gridPosNextY, gridPosPrevZ, gridPosNextZ, nValues))
 					{
@@ -382,6 +432,25 @@ namespace Geometry
 		}
 	}
 
+	double ComputeMaxAbsoluteValueDifference(const ScalarGrid& grid1, const ScalarGrid& grid2)
+	{
+		const auto& values1 = grid1.Values();
+		const auto& values2 = grid2.Values();
+		if (values1.size() != values2.size())
+		{
+			std::cerr << "ComputeMaxAbsoluteValueDifference: grid1.Values().size() != grid2.Values().size()!\n";
+			return DBL_MAX;
+		}
+
+		double maxAbsDiff = 0.0;
+		for (size_t i = 0; i < values1.size(); i++)
+		{
+			const double absDiff = std::abs(values1[i] - values2[i]);
+			if (absDiff > maxAbsDiff) maxAbsDiff = absDiff;
+		}
+		return maxAbsDiff;
+	}
+
 	/// \brief if true, additional checks will be performed before writing gradient values.
 #define EXPECT_INVALID_VALUES false
 
@@ -394,9 +463,9 @@ namespace Geometry
 		const auto cellSize = static_cast<double>(result.CellSize());
 		const auto& dim = result.Dimensions();
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
+		const size_t Nz = dim.Nz;
 
 		const auto& gridValues = scalarGrid.Values();
 
@@ -404,20 +473,20 @@ namespace Geometry
 		auto& gradValsY = result.ValuesY();
 		auto& gradValsZ = result.ValuesZ();
 
-		for (unsigned int iz = 1; iz < Nz - 1; iz++) {
-			for (unsigned int iy = 1; iy < Ny - 1; iy++) {
-				for (unsigned int ix = 1; ix < Nx - 1; ix++) {
+		for (size_t iz = 1; iz < Nz - 1; iz++) {
+			for (size_t iy = 1; iy < Ny - 1; iy++) {
+				for (size_t ix = 1; ix < Nx - 1; ix++) {
 
-					const unsigned int gridPosPrevX = Nx * Ny * iz + Nx * iy + (ix - 1);
-					const unsigned int gridPosNextX = Nx * Ny * iz + Nx * iy + (ix + 1);
+					const size_t gridPosPrevX = Nx * Ny * iz + Nx * iy + (ix - 1);
+					const size_t gridPosNextX = Nx * Ny * iz + Nx * iy + (ix + 1);
 
-					const unsigned int gridPosPrevY = Nx * Ny * iz + Nx * (iy - 1) + ix;
-					const unsigned int gridPosNextY = Nx * Ny * iz + Nx * (iy + 1) + ix;
+					const size_t gridPosPrevY = Nx * Ny * iz + Nx * (iy - 1) + ix;
+					const size_t gridPosNextY = Nx * Ny * iz + Nx * (iy + 1) + ix;
 
-					const unsigned int gridPosPrevZ = Nx * Ny * (iz - 1) + Nx * iy + ix;
-					const unsigned int gridPosNextZ = Nx * Ny * (iz + 1) + Nx * iy + ix;
+					const size_t gridPosPrevZ = Nx * Ny * (iz - 1) + Nx * iy + ix;
+					const size_t gridPosNextZ = Nx * Ny * (iz + 1) + Nx * iy + ix;
 
-					const unsigned int gradPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t gradPos = Nx * Ny * iz + Nx * iy + ix;
 
 					// central difference for non-boundary voxels
 					const double grad_x = (gridValues[gridPosNextX] - gridValues[gridPosPrevX]) / (2.0 * cellSize);
@@ -458,9 +527,9 @@ namespace Geometry
 		const auto cellSize = static_cast<double>(result.CellSize());
 		const auto& dim = result.Dimensions();
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
+		const size_t Nz = dim.Nz;
 
 		const auto& gridValues = scalarGrid.Values();
 
@@ -468,20 +537,20 @@ namespace Geometry
 		auto& gradValsY = result.ValuesY();
 		auto& gradValsZ = result.ValuesZ();
 
-		for (unsigned int iz = 1; iz < Nz - 1; iz++) {
-			for (unsigned int iy = 1; iy < Ny - 1; iy++) {
-				for (unsigned int ix = 1; ix < Nx - 1; ix++) {
+		for (size_t iz = 1; iz < Nz - 1; iz++) {
+			for (size_t iy = 1; iy < Ny - 1; iy++) {
+				for (size_t ix = 1; ix < Nx - 1; ix++) {
 
-					const unsigned int gridPosPrevX = Nx * Ny * iz + Nx * iy + (ix - 1);
-					const unsigned int gridPosNextX = Nx * Ny * iz + Nx * iy + (ix + 1);
+					const size_t gridPosPrevX = Nx * Ny * iz + Nx * iy + (ix - 1);
+					const size_t gridPosNextX = Nx * Ny * iz + Nx * iy + (ix + 1);
 
-					const unsigned int gridPosPrevY = Nx * Ny * iz + Nx * (iy - 1) + ix;
-					const unsigned int gridPosNextY = Nx * Ny * iz + Nx * (iy + 1) + ix;
+					const size_t gridPosPrevY = Nx * Ny * iz + Nx * (iy - 1) + ix;
+					const size_t gridPosNextY = Nx * Ny * iz + Nx * (iy + 1) + ix;
 
-					const unsigned int gridPosPrevZ = Nx * Ny * (iz - 1) + Nx * iy + ix;
-					const unsigned int gridPosNextZ = Nx * Ny * (iz + 1) + Nx * iy + ix;
+					const size_t gridPosPrevZ = Nx * Ny * (iz - 1) + Nx * iy + ix;
+					const size_t gridPosNextZ = Nx * Ny * (iz + 1) + Nx * iy + ix;
 
-					const unsigned int gradPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t gradPos = Nx * Ny * iz + Nx * iy + ix;
 
 					// central difference for non-boundary voxels
 					const double grad_x = (gridValues[gridPosNextX] - gridValues[gridPosPrevX]) / (2.0 * cellSize);
@@ -517,70 +586,104 @@ namespace Geometry
 		return result;
 	}
 
-	VectorGrid ComputeNormalizedNegativeGradient(const ScalarGrid& scalarGrid)
+	template <typename T>
+	BasicVectorGrid<T> ComputeNormalizedNegativeGradient(const BasicScalarGrid<T>& scalarGrid)
 	{
-		if (!scalarGrid.IsValid())
-			throw std::invalid_argument("ComputeGradient: scalarGrid to be processed is invalid!\n");
-
-		VectorGrid result(scalarGrid);
-		const auto cellSize = static_cast<double>(result.CellSize());
-		const auto& dim = result.Dimensions();
-
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
-
-		const auto& gridValues = scalarGrid.Values();
-
-		auto& gradValsX = result.ValuesX();
-		auto& gradValsY = result.ValuesY();
-		auto& gradValsZ = result.ValuesZ();
-
-		for (unsigned int iz = 1; iz < Nz - 1; iz++) {
-			for (unsigned int iy = 1; iy < Ny - 1; iy++) {
-				for (unsigned int ix = 1; ix < Nx - 1; ix++) {
-
-					const unsigned int gridPosPrevX = Nx * Ny * iz + Nx * iy + (ix - 1);
-					const unsigned int gridPosNextX = Nx * Ny * iz + Nx * iy + (ix + 1);
-
-					const unsigned int gridPosPrevY = Nx * Ny * iz + Nx * (iy - 1) + ix;
-					const unsigned int gridPosNextY = Nx * Ny * iz + Nx * (iy + 1) + ix;
-
-					const unsigned int gridPosPrevZ = Nx * Ny * (iz - 1) + Nx * iy + ix;
-					const unsigned int gridPosNextZ = Nx * Ny * (iz + 1) + Nx * iy + ix;
+		return ComputeNormalizedNegativeGradient<T>(scalarGrid, NormalizedGradientSettings{});
+	}
 
-					const unsigned int gradPos = Nx * Ny * iz + Nx * iy + ix;
+	template <typename TOut, typename T>
+	BasicVectorGrid<TOut> ComputeNormalizedNegativeGradient(const BasicScalarGrid<T>& scalarGrid, const NormalizedGradientSettings& settings)
+	{
+		if (!scalarGrid.IsValid())
+			throw std::invalid_argument("ComputeNormalizedNegativeGradient: scalarGrid to be processed is invalid!\n");
+		if (settings.NarrowBandHalfWidth < 0.0)
+			throw std::invalid_argument("ComputeNormalizedNegativeGradient: settings.NarrowBandHalfWidth < 0!\n");
+
+		// the differences are evaluated in the wider of the two precisions
+		using CompType = std::conditional_t<(sizeof(T) > sizeof(TOut)), T, TOut>;
+
+		BasicVectorGrid<TOut> result(scalarGrid);
+		const auto& [Nx, Ny, Nz] = result.Dimensions();
+		if (Nx < 3 || Ny < 3 || Nz < 3)
+			return result; // no interior voxels
+
+		const size_t layerSize = Nx * Ny;
+		const auto invTwoCellSize = static_cast<CompType>(1.0 / (2.0 * static_cast<double>(result.CellSize())));
+		const auto normEpsilon = static_cast<CompType>(NORM_EPSILON);
+		constexpr auto maxNorm = std::numeric_limits<CompType>::max();
+
+		const bool useNarrowBand = (settings.NarrowBandHalfWidth < DBL_MAX);
+		const auto isoLevel = static_cast<CompType>(settings.NarrowBandIsoLevel);
+		const auto bandHalfWidth = static_cast<CompType>(std::min(settings.NarrowBandHalfWidth, static_cast<double>(std::numeric_limits<CompType>::max())));
+		const auto isInBand = [&](const T& val)
+		{
+			return std::abs(static_cast<CompType>(val) - isoLevel) <= bandHalfWidth;
+		};
 
-					// central difference for non-boundary voxels
-					const double grad_x = (gridValues[gridPosNextX] - gridValues[gridPosPrevX]) / (2.0 * cellSize);
-					const double grad_y = (gridValues[gridPosNextY] - gridValues[gridPosPrevY]) / (2.0 * cellSize);
-					const double grad_z = (gridValues[gridPosNextZ] - gridValues[gridPosPrevZ]) / (2.0 * cellSize);
+		const T* gridValues = scalarGrid.Values().data();
+		TOut* gradValsX = result.ValuesX().data();
+		TOut* gradValsY = result.ValuesY().data();
+		TOut* gradValsZ = result.ValuesZ().data();
 
-#if EXPECT_INVALID_VALUES
-					if (std::isnan(grad_x) || std::isinf(grad_x) ||
-						std::isnan(grad_y) || std::isinf(grad_y) ||
-						std::isnan(grad_y) || std::isinf(grad_z))
+		const unsigned int nWorkers = Utils::GetWorkerThreadCount(settings.NThreads);
+		Utils::ParallelForChunks(1, Nz - 1, nWorkers, [&](const size_t izStart, const size_t izEnd, [[maybe_unused]] const unsigned int threadId)
+		{
+			for (size_t iz = izStart; iz < izEnd; iz++)
+			{
+				for (size_t iy = 1; iy < Ny - 1; iy++)
+				{
+					const size_t rowPos = layerSize * iz + Nx * iy;
+					size_t ixStart = 1, ixEnd = Nx - 1;
+					if (useNarrowBand)
 					{
-						const std::string msg = "ComputeNormalizedNegativeGradient: nans or infs encountered for cell " + std::to_string(gradPos) + "! Setting value to zero.\n";
-						assert(false);
-						std::cerr << msg;
-						continue;
+						// restrict the row to the span of its voxels within the band
+						while (ixStart < ixEnd && !isInBand(gridValues[rowPos + ixStart]))
+							ixStart++;
+						while (ixEnd > ixStart && !isInBand(gridValues[rowPos + ixEnd - 1]))
+							ixEnd--;
 					}
-#endif
 
-					const double norm = -1.0 * sqrt(grad_x * grad_x + grad_y * grad_y + grad_z * grad_z);
+					const T* row = gridValues + rowPos;
+					const T* rowPrevY = row - Nx;
+					const T* rowNextY = row + Nx;
+					const T* rowPrevZ = row - layerSize;
+					const T* rowNextZ = row + layerSize;
+					TOut* rowGradX = gradValsX + rowPos;
+					TOut* rowGradY = gradValsY + rowPos;
+					TOut* rowGradZ = gradValsZ + rowPos;
+
+					// contiguous branch-free inner loop (auto-vectorized)
+					for (size_t ix = ixStart; ix < ixEnd; ix++)
+					{
+						// central difference for non-boundary voxels
+						const CompType grad_x = (static_cast<CompType>(row[ix + 1]) - static_cast<CompType>(row[ix - 1])) * invTwoCellSize;
+						const CompType grad_y = (static_cast<CompType>(rowNextY[ix]) - static_cast<CompType>(rowPrevY[ix])) * invTwoCellSize;
+						const CompType grad_z = (static_cast<CompType>(rowNextZ[ix]) - static_cast<CompType>(rowPrevZ[ix])) * invTwoCellSize;
+						const CompType norm = std::sqrt(grad_x * grad_x + grad_y * grad_y + grad_z * grad_z);
 
-					assert(!std::isnan(norm) && !std::isinf(norm));
+#if EXPECT_INVALID_VALUES
+						if (!std::isfinite(norm))
+						{
+							const std::string msg = "ComputeNormalizedNegativeGradient: nans or infs encountered for cell " + std::to_string(rowPos + ix) + "! Setting value to zero.\n";
+							assert(false);
+							std::cerr << msg;
+						}
+#endif
 
-					if (norm > -NORM_EPSILON)
-						continue; // keep zero init val
+						// voxels outside the band, and voxels with a vanishing or non-finite gradient (e.g.: next to FLT_MAX sentinels) are set to zero.
+						// The components are selected rather than multiplied by zero, because nan * 0 and inf * 0 are nan.
+						// (norm <= maxNorm) is std::isfinite(norm) for a non-negative norm, and the non-short-circuit & keep the loop free of branches.
+						const bool isValid = (norm <= maxNorm) & (norm >= normEpsilon) & (!useNarrowBand | isInBand(row[ix]));
+						const CompType negInvNorm = static_cast<CompType>(-1.0) / norm;
 
-					gradValsX[gradPos] = grad_x / norm;
-					gradValsY[gradPos] = grad_y / norm;
-					gradValsZ[gradPos] = grad_z / norm;
+						rowGradX[ix] = static_cast<TOut>(isValid ? grad_x * negInvNorm : static_cast<CompType>(0.0));
+						rowGradY[ix] = static_cast<TOut>(isValid ? grad_y * negInvNorm : static_cast<CompType>(0.0));
+						rowGradZ[ix] = static_cast<TOut>(isValid ? grad_z * negInvNorm : static_cast<CompType>(0.0));
+					}
 				}
 			}
-		}
+		});
 
 		return result;
 	}
@@ -612,7 +715,8 @@ namespace Geometry
 	 *
 	 * DISCLAIMER: For samplePt outside of grid.Box(), the values are clamped to boundary values.
 	 */
-	[[nodiscard]] SurroundingScalarCells GetSurroundingCells(const pmp::vec3& samplePt, const ScalarGrid& grid)
+	template <typename T>
+	[[nodiscard]] SurroundingScalarCells GetSurroundingCells(const pmp::vec3& samplePt, const BasicScalarGrid<T>& grid)
 	{
 		const auto& [Nx, Ny, Nz] = grid.Dimensions();
 		const auto& boxMin = grid.Box().min();
@@ -652,10 +756,14 @@ namespace Geometry
 		};
 	}
 
-	double TrilinearInterpolateScalarValue(const pmp::vec3& samplePt, const ScalarGrid& grid)
+	/**
+	 * \brief Trilinearly interpolates surrounding cell values of a sampled point.
+	 * \param samplePt        point where the grid is sampled.
+	 * \param surrCellVals    surrounding scalar cells of samplePt.
+	 * \return interpolated value.
+	 */
+	[[nodiscard]] double InterpolateSurroundingCells(const pmp::vec3& samplePt, const SurroundingScalarCells& surrCellVals)
 	{
-		assert(grid.IsValid() && grid.CellSize() > 0.0f);
-		const auto surrCellVals = GetSurroundingCells(samplePt, grid);
 		const auto x = static_cast<double>(samplePt[0]), y = static_cast<double>(samplePt[1]), z = static_cast<double>(samplePt[2]);
 		// cell min
 		const auto x0 = static_cast<double>(surrCellVals.MinPt[0]), y0 = static_cast<double>(surrCellVals.MinPt[1]), z0 = static_cast<double>(surrCellVals.MinPt[2]);
@@ -701,6 +809,14 @@ namespace Geometry
 		return a0 + a1 * x + a2 * y + a3 * z + a4 * x * y + a5 * x * z + a6 * y * z + a7 * x * y * z;
 	}
 
+	template <typename T>
+	double TrilinearInterpolateScalarValue(const pmp::vec3& samplePt, const BasicScalarGrid<T>& grid)
+	{
+		assert(grid.IsValid() && grid.CellSize() > 0.0f);
+		const auto surrCellVals = GetSurroundingCells(samplePt, grid);
+		return InterpolateSurroundingCells(samplePt, surrCellVals);
+	}
+
 	/// \brief A wrapper for grid interpolation vector values
 	struct SurroundingVectorCells
 	{
@@ -725,7 +841,8 @@ namespace Geometry
 	 *
 	 * DISCLAIMER: For samplePt outside of grid.Box(), the values are clamped to boundary values.
 	 */
-	[[nodiscard]] SurroundingVectorCells GetSurroundingCells(const pmp::vec3& samplePt, const VectorGrid& grid)
+	template <typename T>
+	[[nodiscard]] SurroundingVectorCells GetSurroundingCells(const pmp::vec3& samplePt, const BasicVectorGrid<T>& grid)
 	{
 		const auto& [Nx, Ny, Nz] = grid.Dimensions();
 		const auto& boxMin = grid.Box().min();
@@ -774,10 +891,14 @@ namespace Geometry
 		};
 	}
 
-	pmp::dvec3 TrilinearInterpolateVectorValue(const pmp::vec3& samplePt, const VectorGrid& grid)
+	/**
+	 * \brief Trilinearly interpolates surrounding cell vector values of a sampled point.
+	 * \param samplePt        point where the grid is sampled.
+	 * \param surrCellVals    surrounding vector cells of samplePt.
+	 * \return interpolated vector value.
+	 */
+	[[nodiscard]] pmp::dvec3 InterpolateSurroundingCells(const pmp::vec3& samplePt, const SurroundingVectorCells& surrCellVals)
 	{
-		assert(grid.IsValid() && grid.CellSize() > 0.0f);
-		const auto surrCellVals = GetSurroundingCells(samplePt, grid);
 		const auto x = static_cast<double>(samplePt[0]), y = static_cast<double>(samplePt[1]), z = static_cast<double>(samplePt[2]);
 		// cell min
 		const auto x0 = static_cast<double>(surrCellVals.MinPt[0]), y0 = static_cast<double>(surrCellVals.MinPt[1]), z0 = static_cast<double>(surrCellVals.MinPt[2]);
@@ -833,6 +954,252 @@ namespace Geometry
 		);
 	}
 
+	template <typename T>
+	pmp::dvec3 TrilinearInterpolateVectorValue(const pmp::vec3& samplePt, const BasicVectorGrid<T>& grid)
+	{
+		assert(grid.IsValid() && grid.CellSize() > 0.0f);
+		const auto surrCellVals = GetSurroundingCells(samplePt, grid);
+		return InterpolateSurroundingCells(samplePt, surrCellVals);
+	}
+
+	/// \brief the number of sample points whose cell indices and local coordinates are computed at once by the batch interpolation.
+	constexpr size_t INTERPOLATION_BATCH_SIZE = 64;
+
+	/// \brief cell indices and local cell coordinates of a batch of sample points (structure of arrays).
+	struct CellSampleBatch
+	{
+		size_t Id000[INTERPOLATION_BATCH_SIZE]; //>! index of the min corner voxel of the sampled cell.
+		size_t OffsetX[INTERPOLATION_BATCH_SIZE]; //>! index offset of the max corner voxel in x-direction (zero if clamped).
+		size_t OffsetY[INTERPOLATION_BATCH_SIZE]; //>! index offset of the max corner voxel in y-direction (zero if clamped).
+		size_t OffsetZ[INTERPOLATION_BATCH_SIZE]; //>! index offset of the max corner voxel in z-direction (zero if clamped).
+		double Tx[INTERPOLATION_BATCH_SIZE]; //>! local x-coordinate of the sample point within the cell.
+		double Ty[INTERPOLATION_BATCH_SIZE]; //>! local y-coordinate of the sample point within the cell.
+		double Tz[INTERPOLATION_BATCH_SIZE]; //>! local z-coordinate of the sample point within the cell.
+	};
+
+	/**
+	 * \brief Fills the cell indices and local coordinates of a batch of sample points.
+	 * \param samplePts    pointer to the first sample point of the batch.
+	 * \param nPts         the number of points in the batch (at most INTERPOLATION_BATCH_SIZE).
+	 * \param grid         sampled grid (BasicScalarGrid or BasicVectorGrid).
+	 * \param batch        filled batch.
+	 */
+	template <typename GridType>
+	void FillCellSampleBatch(const pmp::vec3* samplePts, const size_t& nPts, const GridType& grid, CellSampleBatch& batch)
+	{
+		const auto& [Nx, Ny, Nz] = grid.Dimensions();
+		const auto& boxMin = grid.Box().min();
+		const float cellSize = grid.CellSize();
+		const double invCellSize = 1.0 / static_cast<double>(cellSize);
+		const auto cellId = [&](const float& coord, const float& minCoord, const size_t& n)
+		{
+			return std::clamp(static_cast<int64_t>(std::floor((coord - minCoord) / cellSize)), int64_t{ 0 }, static_cast<int64_t>(n) - 1);
+		};
+
+		for (size_t i = 0; i < nPts; i++)
+		{
+			const auto& pt = samplePts[i];
+			const auto ix = cellId(pt[0], boxMin[0], Nx);
+			const auto iy = cellId(pt[1], boxMin[1], Ny);
+			const auto iz = cellId(pt[2], boxMin[2], Nz);
+
+			batch.Id000[i] = Nx * Ny * static_cast<size_t>(iz) + Nx * static_cast<size_t>(iy) + static_cast<size_t>(ix);
+			batch.OffsetX[i] = (static_cast<size_t>(ix) + 1 < Nx ? 1 : 0);
+			batch.OffsetY[i] = (static_cast<size_t>(iy) + 1 < Ny ? Nx : 0);
+			batch.OffsetZ[i] = (static_cast<size_t>(iz) + 1 < Nz ? Nx * Ny : 0);
+			batch.Tx[i] = (static_cast<double>(pt[0]) - static_cast<double>(boxMin[0] + static_cast<float>(ix) * cellSize)) * invCellSize;
+			batch.Ty[i] = (static_cast<double>(pt[1]) - static_cast<double>(boxMin[1] + static_cast<float>(iy) * cellSize)) * invCellSize;
+			batch.Tz[i] = (static_cast<double>(pt[2]) - static_cast<double>(boxMin[2] + static_cast<float>(iz) * cellSize)) * invCellSize;
+		}
+	}
+
+	/**
+	 * \brief Trilinearly interpolates a single component of grid values for a batch of sample points as three nested lerps.
+	 * \param values       component values of the grid.
+	 * \param batch        cell indices and local coordinates of the sample points.
+	 * \param nPts         the number of points in the batch.
+	 * \param result       pointer to the first interpolated value.
+	 */
+	template <typename T>
+	void InterpolateCellSampleBatch(const T* values, const CellSampleBatch& batch, const size_t& nPts, double* result)
+	{
+		const auto lerp = [](const double& a, const double& b, const double& t) { return a + t * (b - a); };
+		for (size_t i = 0; i < nPts; i++)
+		{
+			const size_t i000 = batch.Id000[i];
+			const size_t i100 = i000 + batch.OffsetX[i];
+			const size_t i010 = i000 + batch.OffsetY[i];
+			const size_t i110 = i010 + batch.OffsetX[i];
+			const size_t i001 = i000 + batch.OffsetZ[i];
+			const size_t i101 = i100 + batch.OffsetZ[i];
+			const size_t i011 = i010 + batch.OffsetZ[i];
+			const size_t i111 = i110 + batch.OffsetZ[i];
+
+			const double c00 = lerp(static_cast<double>(values[i000]), static_cast<double>(values[i100]), batch.Tx[i]);
+			const double c10 = lerp(static_cast<double>(values[i010]), static_cast<double>(values[i110]), batch.Tx[i]);
+			const double c01 = lerp(static_cast<double>(values[i001]), static_cast<double>(values[i101]), batch.Tx[i]);
+			const double c11 = lerp(static_cast<double>(values[i011]), static_cast<double>(values[i111]), batch.Tx[i]);
+			result[i] = lerp(lerp(c00, c10, batch.Ty[i]), lerp(c01, c11, batch.Ty[i]), batch.Tz[i]);
+		}
+	}
+
+	template <typename T>
+	std::vector<double> TrilinearInterpolateScalarValues(const std::span<const pmp::vec3>& samplePts, const BasicScalarGrid<T>& grid, const unsigned int& nThreads)
+	{
+		if (!grid.IsValid() || grid.CellSize() <= 0.0f)
+			throw std::invalid_argument("TrilinearInterpolateScalarValues: grid is invalid!\n");
+
+		std::vector<double> result(samplePts.size());
+		const unsigned int nWorkers = Utils::GetWorkerThreadCount(nThreads);
+		Utils::ParallelForChunks(0, samplePts.size(), nWorkers, [&](const size_t start, const size_t end, [[maybe_unused]] const unsigned int threadId)
+		{
+			CellSampleBatch batch;
+			for (size_t batchStart = start; batchStart < end; batchStart += INTERPOLATION_BATCH_SIZE)
+			{
+				const size_t nBatchPts = std::min(INTERPOLATION_BATCH_SIZE, end - batchStart);
+				FillCellSampleBatch(samplePts.data() + batchStart, nBatchPts, grid, batch);
+				InterpolateCellSampleBatch(grid.Values().data(), batch, nBatchPts, result.data() + batchStart);
+			}
+		});
+		return result;
+	}
+
+	template <typename T>
+	std::vector<pmp::dvec3> TrilinearInterpolateVectorValues(const std::span<const pmp::vec3>& samplePts, const BasicVectorGrid<T>& grid, const unsigned int& nThreads)
+	{
+		if (!grid.IsValid() || grid.CellSize() <= 0.0f)
+			throw std::invalid_argument("TrilinearInterpolateVectorValues: grid is invalid!\n");
+
+		std::vector<pmp::dvec3> result(samplePts.size());
+		const unsigned int nWorkers = Utils::GetWorkerThreadCount(nThreads);
+		Utils::ParallelForChunks(0, samplePts.size(), nWorkers, [&](const size_t start, const size_t end, [[maybe_unused]] const unsigned int threadId)
+		{
+			CellSampleBatch batch;
+			double batchValuesX[INTERPOLATION_BATCH_SIZE], batchValuesY[INTERPOLATION_BATCH_SIZE], batchValuesZ[INTERPOLATION_BATCH_SIZE];
+			for (size_t batchStart = start; batchStart < end; batchStart += INTERPOLATION_BATCH_SIZE)
+			{
+				const size_t nBatchPts = std::min(INTERPOLATION_BATCH_SIZE, end - batchStart);
+				FillCellSampleBatch(samplePts.data() + batchStart, nBatchPts, grid, batch);
+				InterpolateCellSampleBatch(grid.ValuesX().data(), batch, nBatchPts, batchValuesX);
+				InterpolateCellSampleBatch(grid.ValuesY().data(), batch, nBatchPts, batchValuesY);
+				InterpolateCellSampleBatch(grid.ValuesZ().data(), batch, nBatchPts, batchValuesZ);
+				for (size_t i = 0; i < nBatchPts; i++)
+					result[batchStart + i] = pmp::dvec3(batchValuesX[i], batchValuesY[i], batchValuesZ[i]);
+			}
+		});
+		return result;
+	}
+
+	/// \brief a voxel index triple { ix, iy, iz } of the min corner of a sampled cell, and of its max corner (clamped to grid dimensions).
+	struct SurroundingCellIndices
+	{
+		size_t ix{ 0 }, iy{ 0 }, iz{ 0 };
+		size_t ix1{ 0 }, iy1{ 0 }, iz1{ 0 };
+	};
+
+	/**
+	 * \brief Computes the voxel indices of the cell containing samplePt in a sparse grid.
+	 * \param samplePt    point where the grid is sampled.
+	 * \param grid        sampled sparse grid.
+	 * \return surrounding cell indices.
+	 *
+	 * DISCLAIMER: For samplePt outside of grid.Box(), the indices are clamped to boundary voxels.
+	 */
+	[[nodiscard]] SurroundingCellIndices GetSurroundingCellIndices(const pmp::vec3& samplePt, const SparseScalarGrid& grid)
+	{
+		const auto& [Nx, Ny, Nz] = grid.Dimensions();
+		const auto& boxMin = grid.Box().min();
+		const float cellSize = grid.CellSize();
+
+		const auto ix = std::max(std::min(static_cast<size_t>(std::floor((samplePt[0] - boxMin[0]) / cellSize)), Nx - 1), ZERO_CELL_ID);
+		const auto iy = std::max(std::min(static_cast<size_t>(std::floor((samplePt[1] - boxMin[1]) / cellSize)), Ny - 1), ZERO_CELL_ID);
+		const auto iz = std::max(std::min(static_cast<size_t>(std::floor((samplePt[2] - boxMin[2]) / cellSize)), Nz - 1), ZERO_CELL_ID);
+
+		return { ix, iy, iz, std::min(ix + 1, Nx - 1), std::min(iy + 1, Ny - 1), std::min(iz + 1, Nz - 1) };
+	}
+
+	/// \brief computes the min and max corner points of the cell with min corner voxel (ix, iy, iz).
+	[[nodiscard]] std::pair<pmp::vec3, pmp::vec3> GetCellCorners(const SurroundingCellIndices& ids, const SparseScalarGrid& grid)
+	{
+		const auto& boxMin = grid.Box().min();
+		const float cellSize = grid.CellSize();
+		return {
+			pmp::vec3{
+				boxMin[0] + static_cast<float>(ids.ix) * cellSize,
+				boxMin[1] + static_cast<float>(ids.iy) * cellSize,
+				boxMin[2] + static_cast<float>(ids.iz) * cellSize
+			},
+			pmp::vec3{
+				boxMin[0] + static_cast<float>(ids.ix + 1) * cellSize,
+				boxMin[1] + static_cast<float>(ids.iy + 1) * cellSize,
+				boxMin[2] + static_cast<float>(ids.iz + 1) * cellSize
+			}
+		};
+	}
+
+	double TrilinearInterpolateScalarValue(const pmp::vec3& samplePt, const SparseScalarGrid& grid)
+	{
+		assert(grid.IsValid() && grid.CellSize() > 0.0f);
+		const auto ids = GetSurroundingCellIndices(samplePt, grid);
+		const auto [minPt, maxPt] = GetCellCorners(ids, grid);
+		const SurroundingScalarCells surrCellVals{
+			minPt, maxPt,
+			grid.Value(ids.ix, ids.iy, ids.iz), grid.Value(ids.ix1, ids.iy, ids.iz),
+			grid.Value(ids.ix, ids.iy1, ids.iz), grid.Value(ids.ix1, ids.iy1, ids.iz),
+			grid.Value(ids.ix, ids.iy, ids.iz1), grid.Value(ids.ix1, ids.iy, ids.iz1),
+			grid.Value(ids.ix, ids.iy1, ids.iz1), grid.Value(ids.ix1, ids.iy1, ids.iz1)
+		};
+		return InterpolateSurroundingCells(samplePt, surrCellVals);
+	}
+
+	/**
+	 * \brief Computes the normalized negative gradient of a sparse scalar grid at voxel (ix, iy, iz) the same way as ComputeNormalizedNegativeGradient.
+	 * \param grid          sparse scalar grid.
+	 * \param ix, iy, iz    voxel index.
+	 * \return normalized negative gradient vector (zero for boundary voxels and for vanishing gradients).
+	 */
+	[[nodiscard]] pmp::dvec3 ComputeVoxelNormalizedNegativeGradient(const SparseScalarGrid& grid, const size_t& ix, const size_t& iy, const size_t& iz)
+	{
+		const auto& [Nx, Ny, Nz] = grid.Dimensions();
+		if (ix == 0 || iy == 0 || iz == 0 || ix >= Nx - 1 || iy >= Ny - 1 || iz >= Nz - 1)
+			return pmp::dvec3(DEFAULT_VECTOR_GRID_INIT_VAL);
+
+		const auto cellSize = static_cast<double>(grid.CellSize());
+
+		// central difference for non-boundary voxels
+		const double grad_x = (grid.Value(ix + 1, iy, iz) - grid.Value(ix - 1, iy, iz)) / (2.0 * cellSize);
+		const double grad_y = (grid.Value(ix, iy + 1, iz) - grid.Value(ix, iy - 1, iz)) / (2.0 * cellSize);
+		const double grad_z = (grid.Value(ix, iy, iz + 1) - grid.Value(ix, iy, iz - 1)) / (2.0 * cellSize);
+
+		const double norm = -1.0 * sqrt(grad_x * grad_x + grad_y * grad_y + grad_z * grad_z);
+
+		assert(!std::isnan(norm) && !std::isinf(norm));
+
+		if (norm > -NORM_EPSILON)
+			return pmp::dvec3(DEFAULT_VECTOR_GRID_INIT_VAL);
+
+		return pmp::dvec3{ grad_x / norm, grad_y / norm, grad_z / norm };
+	}
+
+	pmp::dvec3 TrilinearInterpolateNormalizedNegativeGradient(const pmp::vec3& samplePt, const SparseScalarGrid& grid)
+	{
+		assert(grid.IsValid() && grid.CellSize() > 0.0f);
+		const auto ids = GetSurroundingCellIndices(samplePt, grid);
+		const auto [minPt, maxPt] = GetCellCorners(ids, grid);
+		const SurroundingVectorCells surrCellVals{
+			minPt, maxPt,
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix, ids.iy, ids.iz),
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix1, ids.iy, ids.iz),
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix, ids.iy1, ids.iz),
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix1, ids.iy1, ids.iz),
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix, ids.iy, ids.iz1),
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix1, ids.iy, ids.iz1),
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix, ids.iy1, ids.iz1),
+			ComputeVoxelNormalizedNegativeGradient(grid, ids.ix1, ids.iy1, ids.iz1)
+		};
+		return InterpolateSurroundingCells(samplePt, surrCellVals);
+	}
+
 	void ComputeInteriorExteriorSignFromMeshNormals(ScalarGrid& grid, const pmp::SurfaceMesh& mesh)
 	{
 		if (!mesh.has_vertex_property("v:normal"))
@@ -856,13 +1223,13 @@ namespace Geometry
 		const auto& orig = grid.Box().min();
 		const float cellSize = grid.CellSize();
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
+		const size_t Nz = dim.Nz;
 
-		const unsigned int progressStep = Nz / 10;
+		const size_t progressStep = Nz / 10;
 
-		for (unsigned int iz = 0; iz < Nz; iz++)
+		for (size_t iz = 0; iz < Nz; iz++)
 		{
 			// ----------------------------------
 			if (iz % progressStep == 0)
@@ -872,9 +1239,9 @@ namespace Geometry
 			}
 			// ----------------------------------
 
-			for (unsigned int iy = 0; iy < Ny; iy++)
+			for (size_t iy = 0; iy < Ny; iy++)
 			{
-				for (unsigned int ix = 0; ix < Nx; ix++)
+				for (size_t ix = 0; ix < Nx; ix++)
 				{
 					const auto gridPt = pmp::Point{
 						orig[0] + static_cast<float>(ix) * cellSize,
@@ -915,7 +1282,7 @@ namespace Geometry
 					assert(!std::isnan(n[0]));
 					const auto dotProd = static_cast<double>(dot(n, gridPt - nearestPt));
 
-					const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
 					values[gridPos] = (dotProd > 0.0 ? 1.0 : -1.0);
 				}
 			}
@@ -950,17 +1317,17 @@ namespace Geometry
 		const auto& orig = grid.Box().min();
 		const float cellSize = grid.CellSize();
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
+		const size_t Nz = dim.Nz;
 
 		pmp::Point gridPt{};		
 		pmp::Point n; // interpolated normal
 		pmp::Point b; // closest pt on triangle
 
-		const unsigned int progressStep = Nz / 10;
+		const size_t progressStep = Nz / 10;
 
-		for (unsigned int iz = 0; iz < Nz; iz++)
+		for (size_t iz = 0; iz < Nz; iz++)
 		{
 			// ----------------------------------
 			if (iz % progressStep == 0)
@@ -970,9 +1337,9 @@ namespace Geometry
 			}
 			// ----------------------------------
 
-			for (unsigned int iy = 0; iy < Ny; iy++)
+			for (size_t iy = 0; iy < Ny; iy++)
 			{
-				for (unsigned int ix = 0; ix < Nx; ix++)
+				for (size_t ix = 0; ix < Nx; ix++)
 				{
 					gridPt[0] = orig[0] + static_cast<float>(ix) * cellSize;
 					gridPt[1] = orig[1] + static_cast<float>(iy) * cellSize;
@@ -1009,7 +1376,7 @@ namespace Geometry
 					const auto vecToMesh = gridPt - nearestPt;
 					const auto dotProd = static_cast<double>(dot(n, vecToMesh));
 
-					const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
 					values[gridPos] = sgn(dotProd) * norm(vecToMesh);
 				}
 			}
@@ -1084,23 +1451,23 @@ namespace Geometry
 
 		const auto trueROI = grid.Box().Intersect(roi);
 
-		const auto ixMin = static_cast<unsigned int>(std::floor((trueROI.min()[0] - orig[0]) / cellSize));
-		const auto iyMin = static_cast<unsigned int>(std::floor((trueROI.min()[1] - orig[1]) / cellSize));
-		const auto izMin = static_cast<unsigned int>(std::floor((trueROI.min()[2] - orig[2]) / cellSize));
+		const auto ixMin = static_cast<size_t>(std::floor((trueROI.min()[0] - orig[0]) / cellSize));
+		const auto iyMin = static_cast<size_t>(std::floor((trueROI.min()[1] - orig[1]) / cellSize));
+		const auto izMin = static_cast<size_t>(std::floor((trueROI.min()[2] - orig[2]) / cellSize));
 
-		const auto ixMax = static_cast<unsigned int>(std::floor((trueROI.max()[0] - orig[0]) / cellSize));
-		const auto iyMax = static_cast<unsigned int>(std::floor((trueROI.max()[1] - orig[1]) / cellSize));
-		const auto izMax = static_cast<unsigned int>(std::floor((trueROI.max()[2] - orig[2]) / cellSize));
+		const auto ixMax = static_cast<size_t>(std::floor((trueROI.max()[0] - orig[0]) / cellSize));
+		const auto iyMax = static_cast<size_t>(std::floor((trueROI.max()[1] - orig[1]) / cellSize));
+		const auto izMax = static_cast<size_t>(std::floor((trueROI.max()[2] - orig[2]) / cellSize));
 		assert(ixMax <= dim.Nx); assert(iyMax <= dim.Ny); assert(izMax <= dim.Nz);
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
 
-		for (unsigned int iz = izMin; iz < izMax; iz++)
+		for (size_t iz = izMin; iz < izMax; iz++)
 		{
-			for (unsigned int iy = iyMin; iy < iyMax; iy++)
+			for (size_t iy = iyMin; iy < iyMax; iy++)
 			{
-				for (unsigned int ix = ixMin; ix < ixMax; ix++)
+				for (size_t ix = ixMin; ix < ixMax; ix++)
 				{
 					const auto gridPt = pmp::Point{
 						orig[0] + static_cast<float>(ix) * cellSize,
@@ -1112,7 +1479,7 @@ namespace Geometry
 					// Source: [Section III. from Ryan Geiss http://www.geisswerks.com/ryan/BLOBS/blobs.html]
 					const double val = (distSq < DECAY_POLYNOMIAL_ZERO_LVL_SQUARED ? (distSq * distSq - distSq + 0.25): 0.0);
 
-					const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
 					values[gridPos] = params.BoolOpFunction(values[gridPos], val);
 				}
 			}
@@ -1153,15 +1520,15 @@ namespace Geometry
 			return; // nothing happens
 		}
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
+		const size_t Nz = dim.Nz;
 
-		for (unsigned int iz = 0; iz < Nz; iz++)
+		for (size_t iz = 0; iz < Nz; iz++)
 		{
-			for (unsigned int iy = 0; iy < Ny; iy++)
+			for (size_t iy = 0; iy < Ny; iy++)
 			{
-				for (unsigned int ix = 0; ix < Nx; ix++)
+				for (size_t ix = 0; ix < Nx; ix++)
 				{
 					const auto gridPt = pmp::Point{
 						orig[0] + static_cast<float>(ix) * cellSize,
@@ -1171,7 +1538,7 @@ namespace Geometry
 					const auto posVect = gridPt - position;
 					const auto posVectClamped = pmp::vec3{ posVect[0], posVect[1], posVect[2] - std::clamp<float>(posVect[2], 0.0f, height + radius) };
 					const auto dist = static_cast<double>(norm(posVectClamped)) - static_cast<double>(radius);
-					const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
 					values[gridPos] = params.BoolOpFunction(values[gridPos], dist);
 				}
 			}
@@ -1214,13 +1581,13 @@ namespace Geometry
 			return; // nothing happens
 		}
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
+		const size_t Nz = dim.Nz;
 
-		for (unsigned int iz = 0; iz < Nz; iz++) {
-			for (unsigned int iy = 0; iy < Ny; iy++) {
-				for (unsigned int ix = 0; ix < Nx; ix++) {
+		for (size_t iz = 0; iz < Nz; iz++) {
+			for (size_t iy = 0; iy < Ny; iy++) {
+				for (size_t ix = 0; ix < Nx; ix++) {
 					const auto gridPt = pmp::Point{
 						orig[0] + static_cast<float>(ix) * cellSize,
 						orig[1] + static_cast<float>(iy) * cellSize,
@@ -1232,7 +1599,7 @@ namespace Geometry
 					const float len = sqrt(posVect[0] * posVect[0] + posVect[1] * posVect[1]) - ringRadius;
 					const auto dist = static_cast<double>(sqrt(len * len + posVect[2] * posVect[2]) - tubeRadius);
 
-					const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
 					values[gridPos] = params.BoolOpFunction(values[gridPos], dist);
 				}
 			}
@@ -1250,15 +1617,15 @@ namespace Geometry
 		const auto& dim = result.Dimensions();
 		const auto& newOrigin = result.Box().min();
 
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const auto Nz = static_cast<unsigned int>(dim.Nz);
+		const size_t Nx = dim.Nx;
+		const size_t Ny = dim.Ny;
+		const size_t Nz = dim.Nz;
 
-		for (unsigned int iz = 0; iz < Nz; iz++)
+		for (size_t iz = 0; iz < Nz; iz++)
 		{
-			for (unsigned int iy = 0; iy < Ny; iy++)
+			for (size_t iy = 0; iy < Ny; iy++)
 			{
-				for (unsigned int ix = 0; ix < Nx; ix++)
+				for (size_t ix = 0; ix < Nx; ix++)
 				{
 					const auto newGridPt = pmp::Point{
 						newOrigin[0] + static_cast<float>(ix) * newCellSize,
@@ -1266,7 +1633,7 @@ namespace Geometry
 						newOrigin[2] + static_cast<float>(iz) * newCellSize
 					};
 
-					const unsigned int newGridPos = Nx * Ny * iz + Nx * iy + ix;
+					const size_t newGridPos = Nx * Ny * iz + Nx * iy + ix;
 					values[newGridPos] = TrilinearInterpolateScalarValue(newGridPt, origGrid);
 				}
 			}
@@ -1275,4 +1642,36 @@ namespace Geometry
 		return result;
 	}
 
+	// ====== Explicit instantiations for the supported grid value types ======================
+
+	template void NegateGridSubVolume(ScalarGrid&, const pmp::BoundingBox&);
+	template void NegateGridSubVolume(ScalarGridF&, const pmp::BoundingBox&);
+
+	template void ApplyNarrowAveragingBlur(ScalarGrid&, const unsigned int&);
+	template void ApplyNarrowAveragingBlur(ScalarGridF&, const unsigned int&);
+	template void ApplyWideAveragingBlur(ScalarGrid&, const unsigned int&);
+	template void ApplyWideAveragingBlur(ScalarGridF&, const unsigned int&);
+	template void ApplyNarrowGaussianBlur(ScalarGrid&, const unsigned int&);
+	template void ApplyNarrowGaussianBlur(ScalarGridF&, const unsigned int&);
+	template void ApplyWideGaussianBlur(ScalarGrid&, const unsigned int&);
+	template void ApplyWideGaussianBlur(ScalarGridF&, const unsigned int&);
+	template void ApplyGaussianBlur(ScalarGrid&, const double&, const unsigned int&);
+	template void ApplyGaussianBlur(ScalarGridF&, const double&, const unsigned int&);
+
+	template VectorGrid ComputeNormalizedNegativeGradient(const ScalarGrid&);
+	template VectorGridF ComputeNormalizedNegativeGradient(const ScalarGridF&);
+	template VectorGrid ComputeNormalizedNegativeGradient<double>(const ScalarGrid&, const NormalizedGradientSettings&);
+	template VectorGridF ComputeNormalizedNegativeGradient<float>(const ScalarGrid&, const NormalizedGradientSettings&);
+	template VectorGrid ComputeNormalizedNegativeGradient<double>(const ScalarGridF&, const NormalizedGradientSettings&);
+	template VectorGridF ComputeNormalizedNegativeGradient<float>(const ScalarGridF&, const NormalizedGradientSettings&);
+
+	template double TrilinearInterpolateScalarValue(const pmp::vec3&, const ScalarGrid&);
+	template double TrilinearInterpolateScalarValue(const pmp::vec3&, const ScalarGridF&);
+	template pmp::dvec3 TrilinearInterpolateVectorValue(const pmp::vec3&, const VectorGrid&);
+	template pmp::dvec3 TrilinearInterpolateVectorValue(const pmp::vec3&, const VectorGridF&);
+	template std::vector<double> TrilinearInterpolateScalarValues(const std::span<const pmp::vec3>&, const ScalarGrid&, const unsigned int&);
+	template std::vector<double> TrilinearInterpolateScalarValues(const std::span<const pmp::vec3>&, const ScalarGridF&, const unsigned int&);
+	template std::vector<pmp::dvec3> TrilinearInterpolateVectorValues(const std::span<const pmp::vec3>&, const VectorGrid&, const unsigned int&);
+	template std::vector<pmp::dvec3> TrilinearInterpolateVectorValues(const std::span<const pmp::vec3>&, const VectorGridF&, const unsigned int&);
+
 } // namespace Geometry
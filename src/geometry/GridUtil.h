@@ -1,6 +1,10 @@
 # pragma once
 
 #include "Grid.h"
+#include "SparseGrid.h"
+
+#include <cfloat>
+#include <span>
 
 namespace pmp
 {
@@ -13,7 +17,8 @@ namespace Geometry
 	 * \brief Negate the values of a scalar grid.
 	 * \param grid    input scalar grid.
 	 */
-	inline void NegateGrid(ScalarGrid& grid)
+	template <typename T>
+	void NegateGrid(BasicScalarGrid<T>& grid)
 	{
 		if (!grid.IsValid())
 			return;
@@ -25,31 +30,51 @@ namespace Geometry
 	 * \param grid        input scalar grid.
 	 * \param subBox      box which should be the sub-box of the grid's box.
 	 */
-	void NegateGridSubVolume(ScalarGrid& grid, const pmp::BoundingBox& subBox);
+	template <typename T>
+	void NegateGridSubVolume(BasicScalarGrid<T>& grid, const pmp::BoundingBox& subBox);
 
 	/**
-	 * \brief Apply a 3x3x3 averaging kernel onto a given grid
-	 * \param grid    input grid.
+	 * \brief Apply a 3x3x3 averaging kernel onto a given grid (as three separable 1D passes).
+	 * \param grid        input grid.
+	 * \param nThreads    the number of worker threads. Zero means "use all hardware threads".
 	 */
-	void ApplyNarrowAveragingBlur(ScalarGrid& grid);
+	template <typename T>
+	void ApplyNarrowAveragingBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads = 1);
 
 	/**
-	 * \brief Apply a 5x5x5 averaging kernel onto a given grid
-	 * \param grid    input grid.
+	 * \brief Apply a 5x5x5 averaging kernel onto a given grid (as three separable 1D passes).
+	 * \param grid        input grid.
+	 * \param nThreads    the number of worker threads. Zero means "use all hardware threads".
 	 */
-	void ApplyWideAveragingBlur(ScalarGrid& grid);
+	template <typename T>
+	void ApplyWideAveragingBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads = 1);
 
 	/**
-	 * \brief Apply a 3x3x3 Gaussian kernel onto a given grid
-	 * \param grid    input grid.
+	 * \brief Apply a 3x3x3 Gaussian kernel onto a given grid (as three separable 1D passes).
+	 * \param grid        input grid.
+	 * \param nThreads    the number of worker threads. Zero means "use all hardware threads".
 	 */
-	void ApplyNarrowGaussianBlur(ScalarGrid& grid);
+	template <typename T>
+	void ApplyNarrowGaussianBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads = 1);
 
 	/**
-	 * \brief Apply a 5x5x5 Gaussian kernel onto a given grid
-	 * \param grid    input grid.
+	 * \brief Apply a 5x5x5 Gaussian kernel onto a given grid (as three separable 1D passes).
+	 * \param grid        input grid.
+	 * \param nThreads    the number of worker threads. Zero means "use all hardware threads".
 	 */
-	void ApplyWideGaussianBlur(ScalarGrid& grid);
+	template <typename T>
+	void ApplyWideGaussianBlur(BasicScalarGrid<T>& grid, const unsigned int& nThreads = 1);
+
+	/**
+	 * \brief Apply a Gaussian kernel with a given standard deviation onto a given grid (as three separable 1D passes).
+	 *        The kernel reaches ceil(3 * sigma) voxels beyond the central voxel.
+	 * \param grid        input grid.
+	 * \param sigma       standard deviation of the Gaussian in voxels.
+	 * \param nThreads    the number of worker threads. Zero means "use all hardware threads".
+	 * \throw std::invalid_argument if sigma <= 0.
+	 */
+	template <typename T>
+	void ApplyGaussianBlur(BasicScalarGrid<T>& grid, const double& sigma, const unsigned int& nThreads = 1);
 
 	/**
 	 * \brief Looks for nans and infinities in the grid, if the cell neighbors have valid values, averaged value is written for an invalid cell. Otherwise the cell value is set to default init value.
@@ -63,6 +88,14 @@ namespace Geometry
 	 */
 	void NormalizeScalarGridValues(ScalarGrid& grid);
 
+	/**
+	 * \brief Computes the maximum absolute difference between the values of two scalar grids.
+	 * \param grid1    first grid.
+	 * \param grid2    second grid.
+	 * \return max |grid1 - grid2| over all voxels, or DBL_MAX if the grids have different sizes.
+	 */
+	[[nodiscard]] double ComputeMaxAbsoluteValueDifference(const ScalarGrid& grid1, const ScalarGrid& grid2);
+
 	/**
 	 * \brief Computes a gradient from a given scalar grid.
 	 * \param scalarGrid     input grid.
@@ -88,7 +121,34 @@ namespace Geometry
 	 *
 	 * DISCLAIMER: This function uses central difference for approximating partial derivatives of scalarGrid values. Boundary voxels are skipped and contain default vector values.
 	 */
-	[[nodiscard]] VectorGrid ComputeNormalizedNegativeGradient(const ScalarGrid& scalarGrid);
+	template <typename T>
+	[[nodiscard]] BasicVectorGrid<T> ComputeNormalizedNegativeGradient(const BasicScalarGrid<T>& scalarGrid);
+
+	/**
+	 * \brief A parameter container for the computation of a normalized negative gradient.
+	 * \struct NormalizedGradientSettings
+	 */
+	struct NormalizedGradientSettings
+	{
+		unsigned int NThreads{ 1 }; //>! the number of worker threads (z-slabs of the grid). NThreads == 0 uses all hardware threads.
+		double NarrowBandIsoLevel{ 0.0 }; //>! iso-level around which the narrow band is centered.
+		double NarrowBandHalfWidth{ DBL_MAX }; //>! the gradient is only computed for voxels with |value - NarrowBandIsoLevel| <= NarrowBandHalfWidth.
+	};
+
+	/**
+	 * \brief Computes a normalized negative gradient from a given scalar grid with a fused multithreaded central difference + normalization kernel.
+	 * \tparam TOut          value type of the resulting vector grid (e.g.: float for half the memory footprint of a double grid).
+	 * \tparam T             value type of the input scalar grid.
+	 * \param scalarGrid     input grid.
+	 * \param settings       settings for the computation.
+	 * \return normalized negative gradient field.
+	 * \throw std::invalid_argument if scalarGrid is invalid, or if settings.NarrowBandHalfWidth < 0.
+	 *
+	 * DISCLAIMER: This function uses central difference for approximating partial derivatives of scalarGrid values. Boundary voxels, voxels outside the narrow band,
+	 *             and voxels with a vanishing gradient contain default vector values. The differences are evaluated in the wider of the precisions T and TOut.
+	 */
+	template <typename TOut, typename T>
+	[[nodiscard]] BasicVectorGrid<TOut> ComputeNormalizedNegativeGradient(const BasicScalarGrid<T>& scalarGrid, const NormalizedGradientSettings& settings);
 
 	/**
 	 * \brief Trilinearly interpolates from the surrounding cell values of a sampled point.
@@ -98,7 +158,8 @@ namespace Geometry
 	 *
 	 * DISCLAIMER: For samplePt outside of grid.Box(), the values are clamped to boundary values.
 	 */
-	[[nodiscard]] double TrilinearInterpolateScalarValue(const pmp::vec3& samplePt, const ScalarGrid& grid);
+	template <typename T>
+	[[nodiscard]] double TrilinearInterpolateScalarValue(const pmp::vec3& samplePt, const BasicScalarGrid<T>& grid);
 
 	/**
 	 * \brief Trilinearly interpolates from the surrounding cell vector values of a sampled point.
@@ -108,7 +169,59 @@ namespace Geometry
 	 *
 	 * DISCLAIMER: For samplePt outside of grid.Box(), the values are clamped to boundary values.
 	 */
-	[[nodiscard]] pmp::dvec3 TrilinearInterpolateVectorValue(const pmp::vec3& samplePt, const VectorGrid& grid);
+	template <typename T>
+	[[nodiscard]] pmp::dvec3 TrilinearInterpolateVectorValue(const pmp::vec3& samplePt, const BasicVectorGrid<T>& grid);
+
+	/**
+	 * \brief Trilinearly interpolates grid values at a batch of sampled points.
+	 * \param samplePts   points where the grid is sampled (e.g.: vertex positions of a mesh).
+	 * \param grid        interpolated scalar grid.
+	 * \param nThreads    the number of worker threads. Zero means "use all hardware threads".
+	 * \return interpolated values (one per sample point).
+	 * \throw std::invalid_argument if grid is invalid.
+	 *
+	 * DISCLAIMER: The points are processed in fixed-size batches of cell indices and local coordinates, and interpolated with three nested lerps.
+	 *             For samplePt within grid.Box() the values equal TrilinearInterpolateScalarValue(samplePt, grid) up to round-off.
+	 *             For samplePt outside of grid.Box(), the cell indices are clamped to boundary voxels.
+	 */
+	template <typename T>
+	[[nodiscard]] std::vector<double> TrilinearInterpolateScalarValues(const std::span<const pmp::vec3>& samplePts, const BasicScalarGrid<T>& grid, const unsigned int& nThreads = 1);
+
+	/**
+	 * \brief Trilinearly interpolates grid vector values at a batch of sampled points.
+	 * \param samplePts   points where the grid is sampled (e.g.: vertex positions of a mesh).
+	 * \param grid        interpolated vector grid.
+	 * \param nThreads    the number of worker threads. Zero means "use all hardware threads".
+	 * \return interpolated vector values (one per sample point).
+	 * \throw std::invalid_argument if grid is invalid.
+	 *
+	 * DISCLAIMER: For samplePt within grid.Box() the values equal TrilinearInterpolateVectorValue(samplePt, grid) up to round-off.
+	 *             For samplePt outside of grid.Box(), the cell indices are clamped to boundary voxels.
+	 */
+	template <typename T>
+	[[nodiscard]] std::vector<pmp::dvec3> TrilinearInterpolateVectorValues(const std::span<const pmp::vec3>& samplePts, const BasicVectorGrid<T>& grid, const unsigned int& nThreads = 1);
+
+	/**
+	 * \brief Trilinearly interpolates from the surrounding cell values of a sampled point in a sparse grid.
+	 * \param samplePt    point where the grid is sampled.
+	 * \param grid        interpolated sparse scalar grid.
+	 * \return interpolated value.
+	 *
+	 * DISCLAIMER: For samplePt outside of grid.Box(), the values are clamped to boundary values. Voxels of unallocated blocks have the background value.
+	 */
+	[[nodiscard]] double TrilinearInterpolateScalarValue(const pmp::vec3& samplePt, const SparseScalarGrid& grid);
+
+	/**
+	 * \brief Trilinearly interpolates the normalized negative gradient of a sparse grid at a sampled point.
+	 *        The gradient is evaluated only at the 8 surrounding voxels, so the result equals sampling ComputeNormalizedNegativeGradient(grid.ToDense())
+	 *        without allocating a dense vector grid.
+	 * \param samplePt    point where the grid is sampled.
+	 * \param grid        sparse scalar grid.
+	 * \return interpolated normalized negative gradient.
+	 *
+	 * DISCLAIMER: For samplePt outside of grid.Box(), the values are clamped to boundary values.
+	 */
+	[[nodiscard]] pmp::dvec3 TrilinearInterpolateNormalizedNegativeGradient(const pmp::vec3& samplePt, const SparseScalarGrid& grid);
 
 	/**
 	 * \brief Computes sign values (-1 or 1) for each grid point using mesh normals.
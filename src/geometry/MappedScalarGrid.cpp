@@ -0,0 +1,87 @@
+#include "MappedScalarGrid.h"
+
+#include "utils/WritableFileMappingWrapper.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Geometry
+{
+	template <typename T>
+	BasicMappedScalarGrid<T>::BasicMappedScalarGrid(const std::string& filePath, const float& cellSize, const pmp::BoundingBox& box, const double& initVal)
+		: m_CellSize(cellSize)
+	{
+		m_Dimensions = SnapBoxToGlobalGrid(m_CellSize, box, m_Box);
+		m_FileMapping = std::make_unique<Utils::WritableFileMappingWrapper>(filePath, NValues() * sizeof(T));
+		if (!m_FileMapping->IsValid())
+			throw std::runtime_error("BasicMappedScalarGrid::BasicMappedScalarGrid: failed to map file " + filePath + "!\n");
+
+		std::fill_n(Values(), NValues(), static_cast<T>(initVal));
+	}
+
+	template <typename T>
+	BasicMappedScalarGrid<T>::~BasicMappedScalarGrid() = default;
+
+	template <typename T>
+	BasicMappedScalarGrid<T>::BasicMappedScalarGrid(BasicMappedScalarGrid&& other) noexcept = default;
+
+	template <typename T>
+	BasicMappedScalarGrid<T>& BasicMappedScalarGrid<T>::operator=(BasicMappedScalarGrid&& other) noexcept = default;
+
+	template <typename T>
+	T* BasicMappedScalarGrid<T>::Values()
+	{
+		return reinterpret_cast<T*>(m_FileMapping->GetFileMemory());
+	}
+
+	template <typename T>
+	const T* BasicMappedScalarGrid<T>::Values() const
+	{
+		return reinterpret_cast<const T*>(m_FileMapping->GetFileMemory());
+	}
+
+	template <typename T>
+	void BasicMappedScalarGrid<T>::Flush() const
+	{
+		m_FileMapping->Flush();
+	}
+
+	template <typename T>
+	BasicScalarGrid<T> BasicMappedScalarGrid<T>::CreateSlab(const size_t& izStart, const size_t& izEnd, const double& initVal) const
+	{
+		if (izStart >= izEnd || izEnd > m_Dimensions.Nz)
+			throw std::invalid_argument("BasicMappedScalarGrid::CreateSlab: invalid z-layer range [izStart, izEnd)!\n");
+
+		const pmp::vec3 slabOrigin{ m_Box.min()[0], m_Box.min()[1], m_Box.min()[2] + static_cast<float>(izStart) * m_CellSize };
+		return BasicScalarGrid<T>(m_CellSize, slabOrigin, GridDimensions{ m_Dimensions.Nx, m_Dimensions.Ny, izEnd - izStart }, initVal);
+	}
+
+	template <typename T>
+	BasicScalarGrid<T> BasicMappedScalarGrid<T>::ReadSlab(const size_t& izStart, const size_t& izEnd) const
+	{
+		auto slab = CreateSlab(izStart, izEnd, DEFAULT_SCALAR_GRID_INIT_VAL);
+		const size_t layerSize = m_Dimensions.Nx * m_Dimensions.Ny;
+		std::memcpy(slab.Values().data(), Values() + layerSize * izStart, layerSize * (izEnd - izStart) * sizeof(T));
+		return slab;
+	}
+
+	template <typename T>
+	void BasicMappedScalarGrid<T>::WriteSlab(const BasicScalarGrid<T>& slab, const size_t& izSlabStart, const size_t& izStart, const size_t& izEnd)
+	{
+		const auto& slabDims = slab.Dimensions();
+		if (slabDims.Nx != m_Dimensions.Nx || slabDims.Ny != m_Dimensions.Ny)
+			throw std::invalid_argument("BasicMappedScalarGrid::WriteSlab: slab.Dimensions() do not match the xy-dimensions of this grid!\n");
+		if (izStart >= izEnd || izStart < izSlabStart || izEnd > izSlabStart + slabDims.Nz || izEnd > m_Dimensions.Nz)
+			throw std::invalid_argument("BasicMappedScalarGrid::WriteSlab: z-layers [izStart, izEnd) are not covered by the slab!\n");
+
+		const size_t layerSize = m_Dimensions.Nx * m_Dimensions.Ny;
+		std::memcpy(Values() + layerSize * izStart, slab.Values().data() + layerSize * (izStart - izSlabStart), layerSize * (izEnd - izStart) * sizeof(T));
+	}
+
+	// ====== Explicit instantiations for the supported value types ======================
+
+	template class BasicMappedScalarGrid<double>;
+	template class BasicMappedScalarGrid<float>;
+
+} // namespace Geometry
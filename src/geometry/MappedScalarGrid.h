@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Grid.h"
+
+#include <memory>
+#include <string>
+
+namespace Utils
+{
+	class WritableFileMappingWrapper;
+}
+
+namespace Geometry
+{
+	/**
+	 * \brief An out-of-core 3D grid of scalar values stored in a memory-mapped file, for fields which do not fit in RAM.
+	 *        The voxel layout (Box, Dimensions, CellSize) is identical to BasicScalarGrid<T> constructed from the same cellSize and box,
+	 *        and the file holds the raw values in the same order (ix + Nx * iy + Nx * Ny * iz). The grid is processed in z-slabs:
+	 *        a slab of consecutive z-layers is copied into an in-core BasicScalarGrid<T>, processed, and written back.
+	 * \tparam T    value type of the grid's voxels (double or float).
+	 *
+	 * DISCLAIMER: Only the values are stored. Voxel flags (e.g.: BasicScalarGrid::FrozenValues()) exist only within the in-core slabs.
+	 */
+	template <typename T>
+	class BasicMappedScalarGrid
+	{
+	public:
+		using ValueType = T;
+
+		/**
+		 * \brief Constructor. Creates the file backing the grid values, and initializes all values to initVal.
+		 * \param filePath    path of the file backing the grid values (an existing file is overwritten).
+		 * \param cellSize    size of a single voxel.
+		 * \param box         bounding box of the grid (will be adjusted to be aligned with cellSize).
+		 * \param initVal     initial value of all voxels.
+		 * \throw std::runtime_error if the file mapping could not be created.
+		 */
+		BasicMappedScalarGrid(const std::string& filePath, const float& cellSize, const pmp::BoundingBox& box, const double& initVal);
+
+		~BasicMappedScalarGrid();
+
+		BasicMappedScalarGrid(BasicMappedScalarGrid&& other) noexcept;
+		BasicMappedScalarGrid& operator=(BasicMappedScalarGrid&& other) noexcept;
+
+		// ====== Getters ======================
+
+		[[nodiscard]] const pmp::BoundingBox& Box() const
+		{
+			return m_Box;
+		}
+
+		[[nodiscard]] const GridDimensions& Dimensions() const
+		{
+			return m_Dimensions;
+		}
+
+		[[nodiscard]] const float& CellSize() const
+		{
+			return m_CellSize;
+		}
+
+		/// \brief the number of voxels of this grid.
+		[[nodiscard]] size_t NValues() const
+		{
+			return m_Dimensions.Nx * m_Dimensions.Ny * m_Dimensions.Nz;
+		}
+
+		/// \brief mapped voxel values. Pages of the file are loaded on access.
+		[[nodiscard]] T* Values();
+
+		[[nodiscard]] const T* Values() const;
+
+		// ====== Slab access ======================
+
+		/**
+		 * \brief Creates an in-core grid covering z-layers [izStart, izEnd) of this grid without reading the mapped values.
+		 * \param izStart     first z-layer of the slab.
+		 * \param izEnd       end of the slab's z-layers (exclusive).
+		 * \param initVal     initial value of the slab's voxels.
+		 * \return the slab grid.
+		 * \throw std::invalid_argument if [izStart, izEnd) is empty or exceeds Dimensions().Nz.
+		 */
+		[[nodiscard]] BasicScalarGrid<T> CreateSlab(const size_t& izStart, const size_t& izEnd, const double& initVal) const;
+
+		/**
+		 * \brief Copies z-layers [izStart, izEnd) of this grid into an in-core grid.
+		 * \param izStart     first z-layer of the slab.
+		 * \param izEnd       end of the slab's z-layers (exclusive).
+		 * \return the slab grid.
+		 * \throw std::invalid_argument if [izStart, izEnd) is empty or exceeds Dimensions().Nz.
+		 */
+		[[nodiscard]] BasicScalarGrid<T> ReadSlab(const size_t& izStart, const size_t& izEnd) const;
+
+		/**
+		 * \brief Writes z-layers [izStart, izEnd) of this grid from an in-core slab grid whose first z-layer is z-layer izSlabStart of this grid.
+		 * \param slab          slab grid (e.g.: from CreateSlab(izSlabStart, ...)).
+		 * \param izSlabStart   z-layer of this grid corresponding to the slab's first z-layer.
+		 * \param izStart       first written z-layer.
+		 * \param izEnd         end of the written z-layers (exclusive).
+		 * \throw std::invalid_argument if the slab's Nx, Ny differ from this grid, or if the written layers are not covered by the slab.
+		 *
+		 * DISCLAIMER: The halo layers of the slab (outside of [izStart, izEnd)) are not written, so overlapping slabs can be processed independently.
+		 */
+		void WriteSlab(const BasicScalarGrid<T>& slab, const size_t& izSlabStart, const size_t& izStart, const size_t& izEnd);
+
+		/// \brief Writes all modified values back to the file.
+		void Flush() const;
+
+	private:
+		pmp::BoundingBox m_Box{};
+		GridDimensions m_Dimensions{};
+		float m_CellSize{};
+		std::unique_ptr<Utils::WritableFileMappingWrapper> m_FileMapping{ nullptr }; //>! mapping of the file backing the grid values.
+	};
+
+	/// \brief double precision out-of-core scalar grid.
+	using MappedScalarGrid = BasicMappedScalarGrid<double>;
+	/// \brief single precision out-of-core scalar grid (half the file size of MappedScalarGrid).
+	using MappedScalarGridF = BasicMappedScalarGrid<float>;
+
+} // namespace Geometry
@@ -268,11 +268,8 @@ namespace Geometry
 		return sqrt(valReal * valReal + valImag * valImag);
 	}
 
-	using FaceMetricFunction = std::function<float(const pmp::SurfaceMesh&, const pmp::Face&)>;
 	//using VertexMetricFunction = std::function<float(const pmp::SurfaceMesh&, const pmp::Vertex&)>;
 
-	constexpr float METRIC_MAX_VAL = 1e+12;
-
 	/**
 	 * \brief Computes interpolated triangle metric for each mesh vertex & stores it as vertex property.
 	 * \param mesh         input mesh to be analyzed.
@@ -366,6 +363,26 @@ namespace Geometry
 		return {};
 	}
 
+	FaceMetricFunction IdentifyFaceMetricFunction(const std::string& metricName)
+	{
+		if (metricName == "minAngle")
+			return GetMinAngleOfTriangle;
+
+		if (metricName == "maxAngle")
+			return GetMaxAngleOfTriangle;
+
+		if (metricName == "jacobianConditionNumber")
+			return GetConditionNumberOfTriangleJacobian;
+
+		if (metricName == "equilateralJacobianCondition")
+			return GetConditionNumberOfEquilateralTriangleJacobian;
+
+		if (metricName == "stiffnessMatrixConditioning")
+			return ComputeStiffnessMatrixConditioningForTriangle;
+
+		return {};
+	}
+
 	void ComputeEdgeDihedralAngles(pmp::SurfaceMesh& mesh)
 	{
 		auto eProp = mesh.edge_property<pmp::Scalar>("e:dihedralAngle", 2.0f * M_PI);
@@ -524,6 +541,23 @@ namespace Geometry
 		return { {{minDistVal, maxDistVal}, histogram} };
 	}
 
+	/// \brief Computes the maximum of distance field values trilinearly interpolated at the given points (std::numeric_limits<double>::lowest() if there are none).
+	[[nodiscard]] static double ComputeMaxInterpolatedDistance(const std::span<const pmp::Point>& points, const ScalarGrid& df)
+	{
+		const auto distances = TrilinearInterpolateScalarValues(points, df);
+		return distances.empty() ? std::numeric_limits<double>::lowest() : *std::ranges::max_element(distances);
+	}
+
+	/// \brief Collects the positions of the (non-deleted) vertices of a mesh.
+	[[nodiscard]] static std::vector<pmp::Point> GetVertexPositions(const pmp::SurfaceMesh& mesh)
+	{
+		std::vector<pmp::Point> positions;
+		positions.reserve(mesh.n_vertices());
+		for (const auto v : mesh.vertices())
+			positions.push_back(mesh.position(v));
+		return positions;
+	}
+
 	std::optional<double> ComputeMeshToPointCloudHausdorffDistance(const pmp::SurfaceMesh& mesh, const std::vector<pmp::Point>& ptCloud, const unsigned int& nVoxelsPerMinDimension)
 	{
 		if (mesh.n_vertices() == 0 || ptCloud.empty())
@@ -561,23 +595,11 @@ namespace Geometry
 		const PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
 		const auto meshDf = SDF::DistanceFieldGenerator::Generate(meshAdapter, meshDfSettings);
 
-		double maxDistMeshToPointCloud = std::numeric_limits<double>::lowest();
-		double maxDistPointCloudToMesh = std::numeric_limits<double>::lowest();
-
 		// Mesh to Point Cloud: Compute max distance using the distance field
-		for (const auto v : mesh.vertices())
-		{
-			const auto vPos = mesh.position(v);
-			const double vDistanceToPointCloud = TrilinearInterpolateScalarValue(vPos, ptCloudDf);
-			maxDistMeshToPointCloud = std::max(maxDistMeshToPointCloud, vDistanceToPointCloud);
-		}
+		const double maxDistMeshToPointCloud = ComputeMaxInterpolatedDistance(GetVertexPositions(mesh), ptCloudDf);
 
 		// Point Cloud to Mesh: Compute max distance using the distance field
-		for (const auto& p : ptCloud)
-		{
-			const double pDistanceToMesh = TrilinearInterpolateScalarValue(p, meshDf);
-			maxDistPointCloudToMesh = std::max(maxDistPointCloudToMesh, pDistanceToMesh);
-		}
+		const double maxDistPointCloudToMesh = ComputeMaxInterpolatedDistance(ptCloud, meshDf);
 
 		// Compute Hausdorff Distance as the maximum of these two distances
 		return std::max(maxDistMeshToPointCloud, maxDistPointCloudToMesh);
@@ -607,23 +629,11 @@ namespace Geometry
 		const PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
 		const auto meshDf = SDF::DistanceFieldGenerator::Generate(meshAdapter, meshDfSettings);
 
-		double maxDistMeshToPointCloud = std::numeric_limits<double>::lowest();
-		double maxDistPointCloudToMesh = std::numeric_limits<double>::lowest();
-
 		// Mesh to Point Cloud: Compute max distance using the distance field
-		for (const auto v : mesh.vertices())
-		{
-			const auto vPos = mesh.position(v);
-			const double vDistanceToPointCloud = TrilinearInterpolateScalarValue(vPos, ptCloudDf);
-			maxDistMeshToPointCloud = std::max(maxDistMeshToPointCloud, vDistanceToPointCloud);
-		}
+		const double maxDistMeshToPointCloud = ComputeMaxInterpolatedDistance(GetVertexPositions(mesh), ptCloudDf);
 
 		// Point Cloud to Mesh: Compute max distance using the distance field
-		for (const auto& p : ptCloud)
-		{
-			const double pDistanceToMesh = TrilinearInterpolateScalarValue(p, meshDf);
-			maxDistPointCloudToMesh = std::max(maxDistPointCloudToMesh, pDistanceToMesh);
-		}
+		const double maxDistPointCloudToMesh = ComputeMaxInterpolatedDistance(ptCloud, meshDf);
 
 		// Compute Hausdorff Distance as the maximum of these two distances
 		return std::max(maxDistMeshToPointCloud, maxDistPointCloudToMesh);
@@ -653,24 +663,11 @@ namespace Geometry
 		const PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
 		const auto meshDf = SDF::DistanceFieldGenerator::Generate(meshAdapter, meshDfSettings);
 
-		double maxDistMeshToRefMesh = std::numeric_limits<double>::lowest();
-		double maxDistRefMeshToMesh = std::numeric_limits<double>::lowest();
-
 		// Mesh to Ref Mesh: Compute max distance using the distance field
-		for (const auto v : mesh.vertices())
-		{
-			const auto vPos = mesh.position(v);
-			const double vDistanceToRefMesh = TrilinearInterpolateScalarValue(vPos, refMeshDf);
-			maxDistMeshToRefMesh = std::max(maxDistMeshToRefMesh, vDistanceToRefMesh);
-		}
+		const double maxDistMeshToRefMesh = ComputeMaxInterpolatedDistance(GetVertexPositions(mesh), refMeshDf);
 
 		// Ref Mesh to Mesh: Compute max distance using the distance field
-		for (const auto v : refMesh.vertices())
-		{
-			const auto vPos = refMesh.position(v);
-			const double pDistanceToMesh = TrilinearInterpolateScalarValue(vPos, meshDf);
-			maxDistRefMeshToMesh = std::max(maxDistRefMeshToMesh, pDistanceToMesh);
-		}
+		const double maxDistRefMeshToMesh = ComputeMaxInterpolatedDistance(GetVertexPositions(refMesh), meshDf);
 
 		// Compute Hausdorff Distance as the maximum of these two distances
 		return std::max(maxDistMeshToRefMesh, maxDistRefMeshToMesh);
@@ -700,22 +697,11 @@ namespace Geometry
 		};
 		const auto meshDf = SDF::DistanceFieldGenerator::Generate(meshAdapter, meshDfSettings);
 
-		double maxDistMeshToRefMesh = std::numeric_limits<double>::lowest();
-		double maxDistRefMeshToMesh = std::numeric_limits<double>::lowest();
-
 		// Mesh to Ref Mesh: Compute max distance using the distance field
-		for (const auto& v : mesh.Vertices)
-		{
-			const double vDistanceToRefMesh = TrilinearInterpolateScalarValue(v, refMeshDf);
-			maxDistMeshToRefMesh = std::max(maxDistMeshToRefMesh, vDistanceToRefMesh);
-		}
+		const double maxDistMeshToRefMesh = ComputeMaxInterpolatedDistance(mesh.Vertices, refMeshDf);
 
 		// Ref Mesh to Mesh: Compute max distance using the distance field
-		for (const auto& v : refMesh.Vertices)
-		{
-			const double pDistanceToMesh = TrilinearInterpolateScalarValue(v, meshDf);
-			maxDistRefMeshToMesh = std::max(maxDistRefMeshToMesh, pDistanceToMesh);
-		}
+		const double maxDistRefMeshToMesh = ComputeMaxInterpolatedDistance(refMesh.Vertices, meshDf);
 
 		// Compute Hausdorff Distance as the maximum of these two distances
 		return std::max(maxDistMeshToRefMesh, maxDistRefMeshToMesh);
@@ -9,7 +9,8 @@
 namespace Geometry
 {
 	// forward declarations
-	class ScalarGrid;
+	template <typename T> class BasicScalarGrid;
+	using ScalarGrid = BasicScalarGrid<double>;
 
 	/// \brief Computes minimum internal angle per triangle averaged for each vertex over adjacent triangles
 	///        & stores the values as vertex scalar data.
@@ -45,6 +46,15 @@ namespace Geometry
 	/// \brief provides a metric function for a given metricName.
 	[[nodiscard]] TriMetricFunction IdentifyMetricFunction(const std::string& metricName);
 
+	/// \brief triangle metric evaluation function for a single face (negative values mark invalid triangles).
+	using FaceMetricFunction = std::function<float(const pmp::SurfaceMesh&, const pmp::Face&)>;
+
+	/// \brief triangle metric values larger than this bound are skipped when averaging them for vertices.
+	constexpr float METRIC_MAX_VAL = 1e+12;
+
+	/// \brief provides the per-face function of a metric with a given metricName (whose vertex averages are computed by IdentifyMetricFunction(metricName)).
+	[[nodiscard]] FaceMetricFunction IdentifyFaceMetricFunction(const std::string& metricName);
+
 	/// \brief Computes dihedral angle for mesh vertices, averaged from mesh edges.
 	void ComputeEdgeDihedralAngles(pmp::SurfaceMesh& mesh);
 
@@ -0,0 +1,178 @@
+#include "SparseGrid.h"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace Geometry
+{
+	SparseScalarGrid::SparseScalarGrid(const float& cellSize, const pmp::BoundingBox& box, const double& backgroundVal)
+		: m_CellSize(cellSize), m_BackgroundValue(backgroundVal)
+	{
+		m_Dimensions = SnapBoxToGlobalGrid(m_CellSize, box, m_Box);
+
+		m_BlockDimensions = GridDimensions{
+			(m_Dimensions.Nx + SPARSE_BLOCK_DIM - 1) / SPARSE_BLOCK_DIM,
+			(m_Dimensions.Ny + SPARSE_BLOCK_DIM - 1) / SPARSE_BLOCK_DIM,
+			(m_Dimensions.Nz + SPARSE_BLOCK_DIM - 1) / SPARSE_BLOCK_DIM
+		};
+
+		m_BlockSlots = std::vector(m_BlockDimensions.Nx * m_BlockDimensions.Ny * m_BlockDimensions.Nz, UNALLOCATED_BLOCK_SLOT);
+	}
+
+	SparseScalarGrid::SparseScalarGrid(const ScalarGrid& denseGrid, const double& backgroundVal)
+		: m_Box(denseGrid.Box()), m_Dimensions(denseGrid.Dimensions()), m_CellSize(denseGrid.CellSize()), m_BackgroundValue(backgroundVal)
+	{
+		if (!denseGrid.IsValid())
+			throw std::invalid_argument("SparseScalarGrid::SparseScalarGrid: denseGrid is invalid!\n");
+
+		m_BlockDimensions = GridDimensions{
+			(m_Dimensions.Nx + SPARSE_BLOCK_DIM - 1) / SPARSE_BLOCK_DIM,
+			(m_Dimensions.Ny + SPARSE_BLOCK_DIM - 1) / SPARSE_BLOCK_DIM,
+			(m_Dimensions.Nz + SPARSE_BLOCK_DIM - 1) / SPARSE_BLOCK_DIM
+		};
+		m_BlockSlots = std::vector(m_BlockDimensions.Nx * m_BlockDimensions.Ny * m_BlockDimensions.Nz, UNALLOCATED_BLOCK_SLOT);
+
+		const auto& [Nx, Ny, Nz] = m_Dimensions;
+		const auto& values = denseGrid.Values();
+		const auto& frozenFlags = denseGrid.FrozenValues();
+		for (size_t iz = 0; iz < Nz; iz++)
+		{
+			for (size_t iy = 0; iy < Ny; iy++)
+			{
+				for (size_t ix = 0; ix < Nx; ix++)
+				{
+					const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
+					if (!frozenFlags[gridPos] && values[gridPos] >= m_BackgroundValue)
+						continue;
+
+					SetValue(ix, iy, iz, values[gridPos]);
+					SetFrozen(ix, iy, iz, frozenFlags[gridPos]);
+				}
+			}
+		}
+	}
+
+	void SparseScalarGrid::SetValue(const size_t& ix, const size_t& iy, const size_t& iz, const double& value)
+	{
+		const size_t slot = GetOrAllocateBlockSlot(ix / SPARSE_BLOCK_DIM, iy / SPARSE_BLOCK_DIM, iz / SPARSE_BLOCK_DIM);
+		m_BlockValues[slot * SPARSE_BLOCK_SIZE + VoxelIdInBlock(ix, iy, iz)] = value;
+	}
+
+	void SparseScalarGrid::SetFrozen(const size_t& ix, const size_t& iy, const size_t& iz, const bool& frozen)
+	{
+		const size_t slot = GetOrAllocateBlockSlot(ix / SPARSE_BLOCK_DIM, iy / SPARSE_BLOCK_DIM, iz / SPARSE_BLOCK_DIM);
+		m_BlockFrozenValues[slot * SPARSE_BLOCK_SIZE + VoxelIdInBlock(ix, iy, iz)] = frozen;
+	}
+
+	void SparseScalarGrid::AllocateBlock(const size_t& bx, const size_t& by, const size_t& bz)
+	{
+		[[maybe_unused]] const auto slot = GetOrAllocateBlockSlot(bx, by, bz);
+	}
+
+	size_t SparseScalarGrid::GetOrAllocateBlockSlot(const size_t& bx, const size_t& by, const size_t& bz)
+	{
+		assert(bx < m_BlockDimensions.Nx && by < m_BlockDimensions.Ny && bz < m_BlockDimensions.Nz);
+		auto& slot = m_BlockSlots[BlockId(bx, by, bz)];
+		if (slot != UNALLOCATED_BLOCK_SLOT)
+			return static_cast<size_t>(slot);
+
+		slot = static_cast<int64_t>(NAllocatedBlocks());
+		m_BlockValues.resize(m_BlockValues.size() + SPARSE_BLOCK_SIZE, m_BackgroundValue);
+		m_BlockFrozenValues.resize(m_BlockFrozenValues.size() + SPARSE_BLOCK_SIZE, false);
+		return static_cast<size_t>(slot);
+	}
+
+	void SparseScalarGrid::DilateAllocatedBlocks(const unsigned int& nBlockLayers)
+	{
+		if (nBlockLayers == 0)
+			return;
+
+		const auto& [NBx, NBy, NBz] = m_BlockDimensions;
+		const std::vector<int64_t> origBlockSlots = m_BlockSlots;
+		const auto nLayers = static_cast<size_t>(nBlockLayers);
+		for (size_t bz = 0; bz < NBz; bz++)
+		{
+			for (size_t by = 0; by < NBy; by++)
+			{
+				for (size_t bx = 0; bx < NBx; bx++)
+				{
+					if (origBlockSlots[BlockId(bx, by, bz)] == UNALLOCATED_BLOCK_SLOT)
+						continue;
+
+					const size_t bzMin = (bz > nLayers ? bz - nLayers : 0), bzMax = std::min(bz + nLayers, NBz - 1);
+					const size_t byMin = (by > nLayers ? by - nLayers : 0), byMax = std::min(by + nLayers, NBy - 1);
+					const size_t bxMin = (bx > nLayers ? bx - nLayers : 0), bxMax = std::min(bx + nLayers, NBx - 1);
+					for (size_t nbz = bzMin; nbz <= bzMax; nbz++)
+						for (size_t nby = byMin; nby <= byMax; nby++)
+							for (size_t nbx = bxMin; nbx <= bxMax; nbx++)
+								AllocateBlock(nbx, nby, nbz);
+				}
+			}
+		}
+	}
+
+	size_t SparseScalarGrid::MemoryUsage() const
+	{
+		return m_BlockSlots.size() * sizeof(int64_t) +
+			m_BlockValues.size() * sizeof(double) +
+			m_BlockFrozenValues.size() / 8;
+	}
+
+	ScalarGrid SparseScalarGrid::ToDense() const
+	{
+		ScalarGrid result(m_CellSize, m_Box, m_BackgroundValue);
+		// enforce the exact voxel layout of this grid (the box may have been transformed after construction).
+		result.Box() = m_Box;
+		result.Dimensions() = m_Dimensions;
+
+		const auto& [Nx, Ny, Nz] = m_Dimensions;
+		auto& values = result.Values();
+		auto& frozenFlags = result.FrozenValues();
+		values.assign(Nx * Ny * Nz, m_BackgroundValue);
+		frozenFlags.assign(Nx * Ny * Nz, false);
+		for (size_t iz = 0; iz < Nz; iz++)
+		{
+			for (size_t iy = 0; iy < Ny; iy++)
+			{
+				for (size_t ix = 0; ix < Nx; ix++)
+				{
+					const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
+					values[gridPos] = Value(ix, iy, iz);
+					frozenFlags[gridPos] = IsFrozen(ix, iy, iz);
+				}
+			}
+		}
+		return result;
+	}
+
+	SparseScalarGrid& SparseScalarGrid::operator*=(const double& scalar)
+	{
+		for (auto& val : m_BlockValues)
+			val *= scalar;
+		m_BackgroundValue *= scalar;
+		return *this;
+	}
+
+	SparseScalarGrid& SparseScalarGrid::operator*=(const pmp::mat4& mat)
+	{
+		// assuming mat is a uniform scaling + translation matrix only.
+		m_CellSize *= mat(0, 0);
+		m_Box *= mat;
+		return *this;
+	}
+
+	bool SparseScalarGrid::IsValid() const
+	{
+		if (m_CellSize <= 0.0f)
+			return false;
+
+		if (m_Box.is_empty())
+			return false;
+
+		if (m_BlockSlots.empty())
+			return false;
+
+		return m_Dimensions.Valid();
+	}
+
+} // namespace Geometry
\ No newline at end of file
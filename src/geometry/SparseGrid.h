@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Grid.h"
+
+#include <vector>
+
+namespace Geometry
+{
+	/// \brief number of voxels along each axis of a single sparse grid block.
+	constexpr size_t SPARSE_BLOCK_DIM = 8;
+	/// \brief number of voxels of a single sparse grid block.
+	constexpr size_t SPARSE_BLOCK_SIZE = SPARSE_BLOCK_DIM * SPARSE_BLOCK_DIM * SPARSE_BLOCK_DIM;
+	/// \brief slot index of a block which has not been allocated.
+	constexpr int64_t UNALLOCATED_BLOCK_SLOT = -1;
+
+	/**
+	 * \brief A 3D grid object containing scalar values stored in blocks of SPARSE_BLOCK_DIM^3 voxels.
+	 *        Only blocks containing "active" voxels (e.g.: a narrow band around a surface) are allocated.
+	 *        All voxels of unallocated blocks have the grid's background value.
+	 *
+	 * DISCLAIMER: The voxel layout (Box, Dimensions, CellSize) is identical to ScalarGrid constructed from the same cellSize and box,
+	 *             so that a SparseScalarGrid can be converted to a dense ScalarGrid and back.
+	 */
+	class SparseScalarGrid
+	{
+	public:
+		/**
+		 * \brief Constructor. No blocks are allocated.
+		 * \param cellSize         size of a single voxel.
+		 * \param box              bounding box of the grid (will be adjusted to be aligned with cellSize).
+		 * \param backgroundVal    value of voxels in unallocated blocks.
+		 */
+		SparseScalarGrid(const float& cellSize, const pmp::BoundingBox& box, const double& backgroundVal);
+
+		/**
+		 * \brief Constructor. Converts a dense scalar grid, allocating only blocks with at least one frozen voxel, or a voxel value below backgroundVal.
+		 * \param denseGrid        dense scalar grid to convert.
+		 * \param backgroundVal    value of voxels in unallocated blocks.
+		 */
+		SparseScalarGrid(const ScalarGrid& denseGrid, const double& backgroundVal);
+
+		// ====== Getters ======================
+
+		[[nodiscard]] const pmp::BoundingBox& Box() const
+		{
+			return m_Box;
+		}
+
+		[[nodiscard]] const GridDimensions& Dimensions() const
+		{
+			return m_Dimensions;
+		}
+
+		/// \brief dimensions of the grid in blocks.
+		[[nodiscard]] const GridDimensions& BlockDimensions() const
+		{
+			return m_BlockDimensions;
+		}
+
+		[[nodiscard]] const float& CellSize() const
+		{
+			return m_CellSize;
+		}
+
+		[[nodiscard]] const double& BackgroundValue() const
+		{
+			return m_BackgroundValue;
+		}
+
+		// ====== Voxel access ======================
+
+		/// \brief value of voxel (ix, iy, iz). Returns background value for voxels of unallocated blocks.
+		[[nodiscard]] double Value(const size_t& ix, const size_t& iy, const size_t& iz) const
+		{
+			const int64_t slot = m_BlockSlots[BlockId(ix / SPARSE_BLOCK_DIM, iy / SPARSE_BLOCK_DIM, iz / SPARSE_BLOCK_DIM)];
+			if (slot == UNALLOCATED_BLOCK_SLOT)
+				return m_BackgroundValue;
+			return m_BlockValues[static_cast<size_t>(slot) * SPARSE_BLOCK_SIZE + VoxelIdInBlock(ix, iy, iz)];
+		}
+
+		/// \brief sets the value of voxel (ix, iy, iz), allocating its block if needed.
+		void SetValue(const size_t& ix, const size_t& iy, const size_t& iz, const double& value);
+
+		/// \brief frozen flag of voxel (ix, iy, iz). Voxels of unallocated blocks are not frozen.
+		[[nodiscard]] bool IsFrozen(const size_t& ix, const size_t& iy, const size_t& iz) const
+		{
+			const int64_t slot = m_BlockSlots[BlockId(ix / SPARSE_BLOCK_DIM, iy / SPARSE_BLOCK_DIM, iz / SPARSE_BLOCK_DIM)];
+			if (slot == UNALLOCATED_BLOCK_SLOT)
+				return false;
+			return m_BlockFrozenValues[static_cast<size_t>(slot) * SPARSE_BLOCK_SIZE + VoxelIdInBlock(ix, iy, iz)];
+		}
+
+		/// \brief sets the frozen flag of voxel (ix, iy, iz), allocating its block if needed.
+		void SetFrozen(const size_t& ix, const size_t& iy, const size_t& iz, const bool& frozen);
+
+		// ====== Blocks ======================
+
+		[[nodiscard]] bool IsBlockAllocated(const size_t& bx, const size_t& by, const size_t& bz) const
+		{
+			return m_BlockSlots[BlockId(bx, by, bz)] != UNALLOCATED_BLOCK_SLOT;
+		}
+
+		/// \brief allocates block (bx, by, bz) filled with background value (if it is not allocated already).
+		void AllocateBlock(const size_t& bx, const size_t& by, const size_t& bz);
+
+		/**
+		 * \brief Allocates all blocks within nBlockLayers (in each axis direction, i.e.: a cubical neighborhood) of the currently allocated blocks.
+		 * \param nBlockLayers    number of dilation layers.
+		 */
+		void DilateAllocatedBlocks(const unsigned int& nBlockLayers);
+
+		[[nodiscard]] size_t NAllocatedBlocks() const
+		{
+			return m_BlockValues.size() / SPARSE_BLOCK_SIZE;
+		}
+
+		/// \brief approximate memory footprint of this grid's voxel data in bytes.
+		[[nodiscard]] size_t MemoryUsage() const;
+
+		// ====== Conversion ======================
+
+		/// \brief converts this grid to a dense ScalarGrid with background value in voxels of unallocated blocks.
+		[[nodiscard]] ScalarGrid ToDense() const;
+
+		// ====== Operators ======================
+
+		/// \brief scales all values (including the background value).
+		SparseScalarGrid& operator*= (const double& scalar);
+
+		SparseScalarGrid& operator*= (const pmp::mat4& mat);
+
+		// ====== Validity ======================
+
+		[[nodiscard]] bool IsValid() const;
+
+	private:
+		[[nodiscard]] size_t BlockId(const size_t& bx, const size_t& by, const size_t& bz) const
+		{
+			return m_BlockDimensions.Nx * m_BlockDimensions.Ny * bz + m_BlockDimensions.Nx * by + bx;
+		}
+
+		[[nodiscard]] static size_t VoxelIdInBlock(const size_t& ix, const size_t& iy, const size_t& iz)
+		{
+			return SPARSE_BLOCK_DIM * SPARSE_BLOCK_DIM * (iz % SPARSE_BLOCK_DIM) + SPARSE_BLOCK_DIM * (iy % SPARSE_BLOCK_DIM) + (ix % SPARSE_BLOCK_DIM);
+		}
+
+		/// \brief returns the slot of block (bx, by, bz) in m_BlockValues, allocating the block if needed.
+		size_t GetOrAllocateBlockSlot(const size_t& bx, const size_t& by, const size_t& bz);
+
+		pmp::BoundingBox m_Box{};
+		GridDimensions m_Dimensions{};
+		GridDimensions m_BlockDimensions{};
+		float m_CellSize{};
+		double m_BackgroundValue{ DEFAULT_SCALAR_GRID_INIT_VAL };
+
+		std::vector<int64_t> m_BlockSlots{}; //>! slot of each block in m_BlockValues, or UNALLOCATED_BLOCK_SLOT.
+		std::vector<double> m_BlockValues{}; //>! values of allocated blocks, SPARSE_BLOCK_SIZE per block.
+		std::vector<bool> m_BlockFrozenValues{}; //>! frozen flags of allocated blocks, SPARSE_BLOCK_SIZE per block.
+	};
+
+} // namespace Geometry
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "VoxelBitMask.h"
+
+#include "utils/ParallelUtils.h"
+
+#include <stdexcept>
+
+namespace Geometry
+{
+	VoxelBitMask::VoxelBitMask(const GridDimensions& dims)
+		: m_Dimensions(dims), m_WordsPerRow((dims.Nx + VOXEL_MASK_WORD_BITS - 1) / VOXEL_MASK_WORD_BITS)
+	{
+		m_Words = std::vector<uint64_t>(m_WordsPerRow * dims.Ny * dims.Nz, 0);
+	}
+
+	VoxelBitMask::VoxelBitMask(const std::vector<bool>& flags, const GridDimensions& dims, const bool& invert)
+		: VoxelBitMask(dims)
+	{
+		const auto& [Nx, Ny, Nz] = dims;
+		if (flags.size() != Nx * Ny * Nz)
+			throw std::invalid_argument("VoxelBitMask::VoxelBitMask: flags.size() != Nx * Ny * Nz!\n");
+
+		for (size_t iz = 0; iz < Nz; iz++)
+		{
+			for (size_t iy = 0; iy < Ny; iy++)
+			{
+				uint64_t* row = Row(iy, iz);
+				const size_t rowStart = Nx * Ny * iz + Nx * iy;
+				for (size_t ix = 0; ix < Nx; ix++)
+				{
+					if (flags[rowStart + ix] != invert)
+						row[ix / VOXEL_MASK_WORD_BITS] |= (uint64_t{ 1 } << (ix % VOXEL_MASK_WORD_BITS));
+				}
+			}
+		}
+	}
+
+	namespace
+	{
+		/**
+		 * \brief Extends the set bits of a word toward higher bits through the runs of passable bits containing them (Kogge-Stone occluded fill).
+		 * \param filled      filled bits.
+		 * \param passable    passable bits.
+		 * \return the extended filled bits.
+		 */
+		[[nodiscard]] uint64_t FillWordUp(uint64_t filled, uint64_t passable)
+		{
+			filled &= passable;
+			filled |= passable & (filled << 1); passable &= (passable << 1);
+			filled |= passable & (filled << 2); passable &= (passable << 2);
+			filled |= passable & (filled << 4); passable &= (passable << 4);
+			filled |= passable & (filled << 8); passable &= (passable << 8);
+			filled |= passable & (filled << 16); passable &= (passable << 16);
+			filled |= passable & (filled << 32);
+			return filled;
+		}
+
+		/// \brief Extends the set bits of a word toward lower bits through the runs of passable bits containing them.
+		[[nodiscard]] uint64_t FillWordDown(uint64_t filled, uint64_t passable)
+		{
+			filled &= passable;
+			filled |= passable & (filled >> 1); passable &= (passable >> 1);
+			filled |= passable & (filled >> 2); passable &= (passable >> 2);
+			filled |= passable & (filled >> 4); passable &= (passable >> 4);
+			filled |= passable & (filled >> 8); passable &= (passable >> 8);
+			filled |= passable & (filled >> 16); passable &= (passable >> 16);
+			filled |= passable & (filled >> 32);
+			return filled;
+		}
+
+		/**
+		 * \brief Fills all runs of passable voxels of a row which contain a filled voxel.
+		 * \param filledRow      filled words of the row.
+		 * \param passableRow    passable words of the row.
+		 * \param nWords         number of words per row.
+		 */
+		void FillRow(uint64_t* filledRow, const uint64_t* passableRow, const size_t& nWords)
+		{
+			constexpr uint64_t lowestBit = 1;
+			constexpr uint64_t highestBit = uint64_t{ 1 } << (VOXEL_MASK_WORD_BITS - 1);
+
+			// a forward pass extends runs toward +x, carrying into the next word
+			uint64_t carry = 0;
+			for (size_t w = 0; w < nWords; w++)
+			{
+				filledRow[w] = FillWordUp(filledRow[w] | (carry & passableRow[w]), passableRow[w]);
+				carry = (filledRow[w] & highestBit) ? lowestBit : 0;
+			}
+
+			// a backward pass extends runs toward -x, carrying into the previous word
+			carry = 0;
+			for (size_t w = nWords; w-- > 0;)
+			{
+				filledRow[w] = FillWordDown(filledRow[w] | (carry & passableRow[w]), passableRow[w]);
+				carry = (filledRow[w] & lowestBit) ? highestBit : 0;
+			}
+		}
+
+		/**
+		 * \brief Seeds a neighbor row with the filled voxels of a row.
+		 * \param filledRow            filled words of the row.
+		 * \param neighborFilledRow    filled words of the neighbor row.
+		 * \param neighborPassableRow  passable words of the neighbor row.
+		 * \param nWords               number of words per row.
+		 * \return true if the neighbor row received a new filled voxel.
+		 */
+		[[nodiscard]] bool SeedNeighborRow(const uint64_t* filledRow, uint64_t* neighborFilledRow, const uint64_t* neighborPassableRow, const size_t& nWords)
+		{
+			bool seeded = false;
+			for (size_t w = 0; w < nWords; w++)
+			{
+				const uint64_t newBits = filledRow[w] & neighborPassableRow[w] & ~neighborFilledRow[w];
+				if (!newBits)
+					continue;
+
+				neighborFilledRow[w] |= newBits;
+				seeded = true;
+			}
+			return seeded;
+		}
+
+	} // anonymous namespace
+
+	VoxelBitMask FloodFillConnectedVoxels(const VoxelBitMask& passable, const size_t& ix, const size_t& iy, const size_t& iz, const unsigned int& nThreads)
+	{
+		const auto& [Nx, Ny, Nz] = passable.Dimensions();
+		VoxelBitMask filled(passable.Dimensions());
+		if (ix >= Nx || iy >= Ny || iz >= Nz || !passable.Get(ix, iy, iz))
+			return filled;
+
+		filled.Set(ix, iy, iz);
+		const size_t nWords = passable.WordsPerRow();
+
+		// rows waiting to be filled (dirty rows are either on a slab's row stack, or seeded from a neighbor slab).
+		// chars (unlike bit-packed bools) can be written concurrently by the threads owning the rows.
+		std::vector<char> dirtyRows(Ny * Nz, 0);
+		dirtyRows[Ny * iz + iy] = 1;
+
+		// z-slab bounds
+		const size_t nSlabs = std::min(static_cast<size_t>(Utils::GetWorkerThreadCount(nThreads)), Nz);
+		std::vector<size_t> slabStarts(nSlabs + 1, 0);
+		for (size_t s = 0; s < nSlabs; s++)
+			slabStarts[s + 1] = slabStarts[s] + Nz / nSlabs + (s < Nz % nSlabs ? 1 : 0);
+
+		const auto fillSlab = [&](const size_t slabId, [[maybe_unused]] const unsigned int threadId)
+		{
+			const size_t izStart = slabStarts[slabId];
+			const size_t izEnd = slabStarts[slabId + 1];
+			std::vector<size_t> rowStack{};
+			for (size_t rowId = Ny * izStart; rowId < Ny * izEnd; rowId++)
+			{
+				if (dirtyRows[rowId])
+					rowStack.push_back(rowId);
+			}
+
+			const auto seedRow = [&](const uint64_t* filledRow, const size_t& nby, const size_t& nbz)
+			{
+				if (!SeedNeighborRow(filledRow, filled.Row(nby, nbz), passable.Row(nby, nbz), nWords))
+					return;
+
+				const size_t nbRowId = Ny * nbz + nby;
+				if (dirtyRows[nbRowId])
+					return; // already on the stack
+
+				dirtyRows[nbRowId] = 1;
+				rowStack.push_back(nbRowId);
+			};
+
+			while (!rowStack.empty())
+			{
+				const size_t rowId = rowStack.back();
+				rowStack.pop_back();
+				dirtyRows[rowId] = 0;
+
+				const size_t ry = rowId % Ny;
+				const size_t rz = rowId / Ny;
+				uint64_t* filledRow = filled.Row(ry, rz);
+				FillRow(filledRow, passable.Row(ry, rz), nWords);
+
+				if (ry > 0) seedRow(filledRow, ry - 1, rz);
+				if (ry < Ny - 1) seedRow(filledRow, ry + 1, rz);
+				// rows beyond the slab are seeded after all slabs are filled
+				if (rz > izStart) seedRow(filledRow, ry, rz - 1);
+				if (rz < izEnd - 1) seedRow(filledRow, ry, rz + 1);
+			}
+		};
+
+		bool slabBoundarySeeded = true;
+		while (slabBoundarySeeded)
+		{
+			Utils::ParallelForEachIndex(0, nSlabs, static_cast<unsigned int>(nSlabs), fillSlab);
+
+			// exchange the filled voxels across slab boundaries
+			slabBoundarySeeded = false;
+			for (size_t s = 1; s < nSlabs; s++)
+			{
+				const size_t izBelow = slabStarts[s] - 1;
+				const size_t izAbove = slabStarts[s];
+				for (size_t ry = 0; ry < Ny; ry++)
+				{
+					if (SeedNeighborRow(filled.Row(ry, izBelow), filled.Row(ry, izAbove), passable.Row(ry, izAbove), nWords))
+					{
+						dirtyRows[Ny * izAbove + ry] = 1;
+						slabBoundarySeeded = true;
+					}
+					if (SeedNeighborRow(filled.Row(ry, izAbove), filled.Row(ry, izBelow), passable.Row(ry, izBelow), nWords))
+					{
+						dirtyRows[Ny * izBelow + ry] = 1;
+						slabBoundarySeeded = true;
+					}
+				}
+			}
+		}
+
+		return filled;
+	}
+
+} // namespace Geometry
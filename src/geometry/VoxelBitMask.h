@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Grid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Geometry
+{
+	/// \brief number of voxel flags stored in a single word of VoxelBitMask.
+	constexpr size_t VOXEL_MASK_WORD_BITS = 64;
+
+	/**
+	 * \brief A bit-packed 3D mask of voxel flags stored in 64-bit words.
+	 *        Each voxel row (fixed iy, iz) starts at a new word, so that whole rows can be processed word-by-word,
+	 *        and different rows can be written concurrently without sharing any word.
+	 */
+	class VoxelBitMask
+	{
+	public:
+		/**
+		 * \brief Constructor. All flags are cleared.
+		 * \param dims    voxel dimensions of the mask.
+		 */
+		explicit VoxelBitMask(const GridDimensions& dims);
+
+		/**
+		 * \brief Constructor. Packs the given voxel flags (e.g.: ScalarGrid::FrozenValues()).
+		 * \param flags     voxel flags in the grid layout (ix + Nx * iy + Nx * Ny * iz).
+		 * \param dims      voxel dimensions of flags.
+		 * \param invert    if true, the mask stores negated flags.
+		 * \throw std::invalid_argument if flags.size() does not match dims.
+		 */
+		VoxelBitMask(const std::vector<bool>& flags, const GridDimensions& dims, const bool& invert = false);
+
+		// ====== Getters ======================
+
+		[[nodiscard]] const GridDimensions& Dimensions() const
+		{
+			return m_Dimensions;
+		}
+
+		/// \brief number of 64-bit words per voxel row.
+		[[nodiscard]] size_t WordsPerRow() const
+		{
+			return m_WordsPerRow;
+		}
+
+		/// \brief pointer to the first word of voxel row (iy, iz).
+		[[nodiscard]] uint64_t* Row(const size_t& iy, const size_t& iz)
+		{
+			return m_Words.data() + RowId(iy, iz) * m_WordsPerRow;
+		}
+
+		[[nodiscard]] const uint64_t* Row(const size_t& iy, const size_t& iz) const
+		{
+			return m_Words.data() + RowId(iy, iz) * m_WordsPerRow;
+		}
+
+		// ====== Voxel access ======================
+
+		[[nodiscard]] bool Get(const size_t& ix, const size_t& iy, const size_t& iz) const
+		{
+			return (Row(iy, iz)[ix / VOXEL_MASK_WORD_BITS] >> (ix % VOXEL_MASK_WORD_BITS)) & 1;
+		}
+
+		void Set(const size_t& ix, const size_t& iy, const size_t& iz)
+		{
+			Row(iy, iz)[ix / VOXEL_MASK_WORD_BITS] |= (uint64_t{ 1 } << (ix % VOXEL_MASK_WORD_BITS));
+		}
+
+		/// \brief memory footprint of this mask in bytes.
+		[[nodiscard]] size_t MemoryUsage() const
+		{
+			return m_Words.size() * sizeof(uint64_t);
+		}
+
+	private:
+		[[nodiscard]] size_t RowId(const size_t& iy, const size_t& iz) const
+		{
+			return m_Dimensions.Ny * iz + iy;
+		}
+
+		GridDimensions m_Dimensions{};
+		size_t m_WordsPerRow{ 0 };
+		std::vector<uint64_t> m_Words{}; //>! flags of all rows, the padding bits beyond Nx are always zero.
+	};
+
+	/**
+	 * \brief Computes the set of voxels connected (via face neighbors) to a seed voxel through passable voxels.
+	 *        Uses a scanline fill: runs of passable voxels are filled word-by-word along x, and rows seed their y and z neighbor rows.
+	 *        The grid is split into z-slabs filled concurrently, which exchange their boundary rows until no slab receives a new seed.
+	 * \param passable      mask of passable voxels.
+	 * \param ix, iy, iz    seed voxel index (should be passable, otherwise the result is empty).
+	 * \param nThreads      the number of worker threads (z-slabs). Zero means "use all hardware threads".
+	 * \return mask of the voxels connected to the seed voxel.
+	 *
+	 * DISCLAIMER: The memory used besides the resulting mask is bounded by a row stack and a dirty flag per voxel row.
+	 */
+	[[nodiscard]] VoxelBitMask FloodFillConnectedVoxels(const VoxelBitMask& passable, const size_t& ix, const size_t& iy, const size_t& iz, const unsigned int& nThreads);
+
+} // namespace Geometry
@@ -15,8 +15,39 @@
 #include "pmp/algorithms/DifferentialGeometry.h"
 #include "pmp/Timer.h"
 
+#include "utils/ParallelUtils.h"
+
 namespace pmp {
 
+namespace {
+
+// Evaluates the candidate for each index of [0, n) on n_threads threads, and
+// returns the valid candidates ordered by index (for any number of threads).
+template <typename Candidate, typename Evaluate>
+std::vector<Candidate> collect_candidates(size_t n, unsigned int n_threads,
+                                          const Evaluate& evaluate)
+{
+    std::vector<std::vector<Candidate>> chunk_candidates(
+        Utils::GetWorkerThreadCount(n_threads));
+    Utils::ParallelForChunks(0, n, n_threads,
+        [&](size_t chunk_start, size_t chunk_end, unsigned int thread_id)
+        {
+            for (size_t i = chunk_start; i < chunk_end; ++i)
+            {
+                const Candidate c = evaluate(i);
+                if (c.is_valid())
+                    chunk_candidates[thread_id].push_back(c);
+            }
+        });
+
+    std::vector<Candidate> candidates;
+    for (const auto& chunk : chunk_candidates)
+        candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+    return candidates;
+}
+
+} // namespace
+
 Remeshing::Remeshing(SurfaceMesh& mesh)
     : mesh_(mesh), refmesh_(nullptr), kd_tree_(nullptr)
 {
@@ -45,7 +76,7 @@ void Remeshing::uniform_remeshing(Scalar edge_length, unsigned int iterations,
     {
         split_long_edges();
 
-        Normals::compute_vertex_normals(mesh_);
+        update_vertex_normals();
 
         collapse_short_edges();
 
@@ -66,6 +97,8 @@ void Remeshing::adaptive_remeshing(const AdaptiveRemeshingSettings& settings, co
     max_edge_length_ = settings.MaxEdgeLength;
     approx_error_ = settings.ApproxError;
     use_projection_ = settings.UseProjection;
+    n_threads_ = settings.NThreads;
+    parallel_candidate_evaluation_ = settings.ParallelCandidateEvaluation;
 
     preprocessing();
 
@@ -73,7 +106,7 @@ void Remeshing::adaptive_remeshing(const AdaptiveRemeshingSettings& settings, co
     {
         split_long_edges();
 
-        Normals::compute_vertex_normals(mesh_);
+        update_vertex_normals();
 
         collapse_short_edges();
 
@@ -101,6 +134,56 @@ void Remeshing::convex_hull_adaptive_remeshing(const AdaptiveRemeshingSettings&
     convex_hull_postprocessing();
 }
 
+void Remeshing::local_adaptive_remeshing(const AdaptiveRemeshingSettings& settings,
+                                         const std::vector<Vertex>& seeds,
+                                         unsigned int n_rings)
+{
+    if (seeds.empty())
+        return;
+
+    uniform_ = false;
+    local_ = true;
+    min_edge_length_ = settings.MinEdgeLength;
+    max_edge_length_ = settings.MaxEdgeLength;
+    approx_error_ = settings.ApproxError;
+    use_projection_ = settings.UseProjection;
+    n_threads_ = settings.NThreads;
+    parallel_candidate_evaluation_ = settings.ParallelCandidateEvaluation;
+
+    local_preprocessing(seeds, n_rings);
+
+    for (unsigned int i = 0; i < settings.NRemeshingIterations; ++i)
+    {
+        split_long_edges();
+
+        update_vertex_normals();
+
+        collapse_short_edges();
+
+        flip_edges();
+
+        tangential_smoothing(settings.NTangentialSmoothingIters);
+    }
+
+    remove_caps();
+
+    // the one-rings of locked vertices adjacent to the region might have changed
+    for (auto v : mesh_.vertices())
+    {
+        if (vlocked_[v])
+            continue;
+
+        for (auto vv : mesh_.vertices(v))
+        {
+            if (vlocked_[vv])
+                vnormal_[vv] = Normals::compute_vertex_normal(mesh_, vv);
+        }
+    }
+
+    postprocessing();
+    local_ = false;
+}
+
 
 void Remeshing::preprocessing()
 {
@@ -171,102 +254,262 @@ void Remeshing::preprocessing()
     }
     else
     {
-        // compute curvature for all mesh vertices, using cotan or Cohen-Steiner
-        // don't use two-ring neighborhood, since we otherwise compute
-        // curvature over sharp features edges, leading to high curvatures.
-        // prefer tensor analysis over cotan-Laplace, since the former is more
-        // robust and gives better results on the boundary.
-        Curvature curv(mesh_);
-        curv.analyze_tensor(1);
+        compute_adaptive_sizing(mesh_, vsizing_);
+    }
 
-        // use vsizing_ to store/smooth curvatures to avoid another vertex property
+    if (use_projection_)
+    {
+        // build reference mesh
+        refmesh_ = std::make_shared<SurfaceMesh>();
+        refmesh_->assign(mesh_);
+        Normals::compute_vertex_normals(*refmesh_);
+        refpoints_ = refmesh_->vertex_property<Point>("v:point");
+        refnormals_ = refmesh_->vertex_property<Point>("v:normal");
 
-        // curvature values for feature vertices and boundary vertices
-        // are not meaningful. mark them as negative values.
-        for (auto v : mesh_.vertices())
+        // copy sizing field from mesh_
+        refsizing_ = refmesh_->add_vertex_property<Scalar>("v:sizing");
+        for (auto v : refmesh_->vertices())
         {
-            if (mesh_.is_boundary(v) || (vfeature_ && vfeature_[v]))
-                vsizing_[v] = -1.0;
-            else
-                vsizing_[v] = curv.max_abs_curvature(v);
+            refsizing_[v] = vsizing_[v];
         }
 
-        // curvature values might be noisy. smooth them.
-        // don't consider feature vertices' curvatures.
-        // don't consider boundary vertices' curvatures.
-        // do this for two iterations, to propagate curvatures
-        // from non-feature regions to feature vertices.
-        for (int iters = 0; iters < 2; ++iters)
+        // build kd-tree
+        kd_tree_ = std::make_unique<TriangleKdTree>(refmesh_, 0);
+    }
+}
+
+void Remeshing::compute_adaptive_sizing(SurfaceMesh& mesh,
+                                        VertexProperty<Scalar>& sizing) const
+{
+    auto vfeature = mesh.get_vertex_property<bool>("v:feature");
+
+    // compute curvature for all mesh vertices, using cotan or Cohen-Steiner
+    // don't use two-ring neighborhood, since we otherwise compute
+    // curvature over sharp features edges, leading to high curvatures.
+    // prefer tensor analysis over cotan-Laplace, since the former is more
+    // robust and gives better results on the boundary.
+    Curvature curv(mesh);
+    curv.analyze_tensor(1);
+
+    // use sizing to store/smooth curvatures to avoid another vertex property
+
+    // curvature values for feature vertices and boundary vertices
+    // are not meaningful. mark them as negative values.
+    for (auto v : mesh.vertices())
+    {
+        if (mesh.is_boundary(v) || (vfeature && vfeature[v]))
+            sizing[v] = -1.0;
+        else
+            sizing[v] = curv.max_abs_curvature(v);
+    }
+
+    // curvature values might be noisy. smooth them.
+    // don't consider feature vertices' curvatures.
+    // don't consider boundary vertices' curvatures.
+    // do this for two iterations, to propagate curvatures
+    // from non-feature regions to feature vertices.
+    for (int iters = 0; iters < 2; ++iters)
+    {
+        for (auto v : mesh.vertices())
         {
-            for (auto v : mesh_.vertices())
-            {
-                Scalar w, ww = 0.0;
-                Scalar c, cc = 0.0;
+            Scalar w, ww = 0.0;
+            Scalar c, cc = 0.0;
 
-                for (auto h : mesh_.halfedges(v))
+            for (auto h : mesh.halfedges(v))
+            {
+                c = sizing[mesh.to_vertex(h)];
+                if (c > 0.0)
                 {
-                    c = vsizing_[mesh_.to_vertex(h)];
-                    if (c > 0.0)
-                    {
-                        w = std::max(0.0, cotan_weight(mesh_, mesh_.edge(h)));
-                        ww += w;
-                        cc += w * c;
-                    }
+                    w = std::max(0.0, cotan_weight(mesh, mesh.edge(h)));
+                    ww += w;
+                    cc += w * c;
                 }
-
-                if (ww)
-                    cc /= ww;
-                vsizing_[v] = cc;
             }
+
+            if (ww)
+                cc /= ww;
+            sizing[v] = cc;
         }
+    }
 
-        // now convert per-vertex curvature into target edge length
-        for (auto v : mesh_.vertices())
+    // now convert per-vertex curvature into target edge length
+    for (auto v : mesh.vertices())
+    {
+        Scalar c = sizing[v];
+
+        // get edge length from curvature
+        const Scalar r = 1.0 / c;
+        const Scalar e = approx_error_;
+        Scalar h;
+        if (e < r)
+        {
+            // see mathworld: "circle segment" and "equilateral triangle"
+            //h = sqrt(2.0*r*e-e*e) * 3.0 / sqrt(3.0);
+            h = sqrt(6.0 * e * r - 3.0 * e * e); // simplified...
+        }
+        else
         {
-            Scalar c = vsizing_[v];
+            // this does not really make sense
+            h = e * 3.0 / sqrt(3.0);
+        }
 
-            // get edge length from curvature
-            const Scalar r = 1.0 / c;
-            const Scalar e = approx_error_;
-            Scalar h;
-            if (e < r)
-            {
-                // see mathworld: "circle segment" and "equilateral triangle"
-                //h = sqrt(2.0*r*e-e*e) * 3.0 / sqrt(3.0);
-                h = sqrt(6.0 * e * r - 3.0 * e * e); // simplified...
-            }
-            else
-            {
-                // this does not really make sense
-                h = e * 3.0 / sqrt(3.0);
-            }
+        // clamp to min. and max. edge length
+        if (h < min_edge_length_)
+            h = min_edge_length_;
+        else if (h > max_edge_length_)
+            h = max_edge_length_;
+
+        // store target edge length
+        sizing[v] = h;
+    }
+}
+void Remeshing::local_preprocessing(const std::vector<Vertex>& seeds,
+                                    unsigned int n_rings)
+{
+    // properties
+    if (!vfeature_)
+        vfeature_ = mesh_.vertex_property<bool>("v:feature", false);
+    if (!efeature_)
+        efeature_ = mesh_.edge_property<bool>("e:feature", false);
+    if (!vlocked_)
+        vlocked_ = mesh_.add_vertex_property<bool>("v:locked", false);
+    if (!elocked_)
+        elocked_ = mesh_.add_edge_property<bool>("e:locked", false);
+    if (!vsizing_)
+        vsizing_ = mesh_.add_vertex_property<Scalar>("v:sizing");
+
+    // The sizing field is evaluated on a submesh around the region, and it is
+    // needed up to two rings beyond the region (neighbors of region vertices
+    // and faces which region vertices are projected to). The curvature tensor,
+    // its smoothing, and the two in-place smoothing iterations of the sizing
+    // field spread the effects of the submesh boundary by at most seven rings.
+    const int region_depth = static_cast<int>(n_rings);
+    const int reference_depth = region_depth + 9;
+
+    // ring depths of vertices around the seeds (breadth-first search)
+    auto vdepth = mesh_.add_vertex_property<int>("v:depth", -1);
+    std::vector<Vertex> reference_vertices;
+    for (auto v : seeds)
+    {
+        if (mesh_.is_deleted(v) || vdepth[v] == 0)
+            continue;
 
-            // clamp to min. and max. edge length
-            if (h < min_edge_length_)
-                h = min_edge_length_;
-            else if (h > max_edge_length_)
-                h = max_edge_length_;
+        vdepth[v] = 0;
+        reference_vertices.push_back(v);
+    }
+    for (size_t i = 0; i < reference_vertices.size(); ++i)
+    {
+        const auto v = reference_vertices[i];
+        if (vdepth[v] == reference_depth)
+            continue;
+
+        for (auto vv : mesh_.vertices(v))
+        {
+            if (vdepth[vv] >= 0)
+                continue;
 
-            // store target edge length
-            vsizing_[v] = h;
+            vdepth[vv] = vdepth[v] + 1;
+            reference_vertices.push_back(vv);
         }
     }
 
-    if (use_projection_)
+    // lock vertices outside of the region, and edges with a locked vertex
+    for (auto v : mesh_.vertices())
     {
-        // build reference mesh
+        vlocked_[v] = (vdepth[v] < 0 || vdepth[v] > region_depth);
+    }
+    for (auto e : mesh_.edges())
+    {
+        elocked_[e] = (vlocked_[mesh_.vertex(e, 0)] ||
+                       vlocked_[mesh_.vertex(e, 1)]);
+    }
+
+    // lock feature corners
+    for (auto v : reference_vertices)
+    {
+        if (vdepth[v] <= region_depth && vfeature_[v])
+        {
+            int c = 0;
+            for (auto h : mesh_.halfedges(v))
+                if (efeature_[mesh_.edge(h)])
+                    ++c;
+
+            if (c != 2)
+                vlocked_[v] = true;
+        }
+    }
+
+    // reference submesh: all faces incident to vertices below the reference depth.
+    // Vertices and faces keep their order from mesh_, so that the in-place smoothing
+    // iterations of the sizing field visit them in the same order.
+    std::sort(reference_vertices.begin(), reference_vertices.end());
+    std::vector<Face> reference_faces;
+    for (auto v : reference_vertices)
+    {
+        if (vdepth[v] == reference_depth)
+            continue;
+
+        for (auto f : mesh_.faces(v))
+            reference_faces.push_back(f);
+    }
+    std::sort(reference_faces.begin(), reference_faces.end());
+    reference_faces.erase(std::unique(reference_faces.begin(), reference_faces.end()), reference_faces.end());
+
+    auto vreference = mesh_.add_vertex_property<Vertex>("v:reference");
+    refmesh_ = std::make_shared<SurfaceMesh>();
+    auto reffeature = refmesh_->vertex_property<bool>("v:feature", false);
+    for (auto v : reference_vertices)
+    {
+        vreference[v] = refmesh_->add_vertex(points_[v]);
+        reffeature[vreference[v]] = vfeature_[v];
+    }
+    try
+    {
+        for (auto f : reference_faces)
+        {
+            auto fv = mesh_.vertices(f);
+            const auto v0 = vreference[*fv];
+            const auto v1 = vreference[*(++fv)];
+            const auto v2 = vreference[*(++fv)];
+            refmesh_->add_triangle(v0, v1, v2);
+        }
+    }
+    catch (const TopologyException&)
+    {
+        // the faces around the region do not form a valid submesh
+        refmesh_ = nullptr;
+    }
+
+    if (refmesh_)
+    {
+        refsizing_ = refmesh_->add_vertex_property<Scalar>("v:sizing");
+        compute_adaptive_sizing(*refmesh_, refsizing_);
+        for (auto v : reference_vertices)
+        {
+            vsizing_[v] = refsizing_[vreference[v]];
+        }
+    }
+    else
+    {
+        // fall back to the sizing field and the reference of the whole mesh
+        compute_adaptive_sizing(mesh_, vsizing_);
         refmesh_ = std::make_shared<SurfaceMesh>();
         refmesh_->assign(mesh_);
-        Normals::compute_vertex_normals(*refmesh_);
-        refpoints_ = refmesh_->vertex_property<Point>("v:point");
-        refnormals_ = refmesh_->vertex_property<Point>("v:normal");
-
-        // copy sizing field from mesh_
         refsizing_ = refmesh_->add_vertex_property<Scalar>("v:sizing");
         for (auto v : refmesh_->vertices())
         {
             refsizing_[v] = vsizing_[v];
         }
+    }
+
+    mesh_.remove_vertex_property(vreference);
+    mesh_.remove_vertex_property(vdepth);
+
+    if (use_projection_)
+    {
+        Normals::compute_vertex_normals(*refmesh_);
+        refpoints_ = refmesh_->vertex_property<Point>("v:point");
+        refnormals_ = refmesh_->vertex_property<Point>("v:normal");
 
         // build kd-tree
         kd_tree_ = std::make_unique<TriangleKdTree>(refmesh_, 0);
@@ -275,6 +518,10 @@ void Remeshing::preprocessing()
 
 void Remeshing::postprocessing()
 {
+    // collapsed elements are collected only once in local remeshing
+    if (local_)
+        mesh_.garbage_collection();
+
     // remove properties
     mesh_.remove_vertex_property(vlocked_);
     mesh_.remove_edge_property(elocked_);
@@ -402,6 +649,12 @@ void Remeshing::project_to_reference(Vertex v)
 
 void Remeshing::split_long_edges(unsigned int nIterations)
 {
+    if (parallel_candidate_evaluation_)
+    {
+        batched_split_long_edges(nIterations);
+        return;
+    }
+
     Vertex vnew, v0, v1;
     Edge enew;
     bool ok, is_feature, is_boundary;
@@ -433,8 +686,8 @@ void Remeshing::split_long_edges(unsigned int nIterations)
 
                 if (is_feature)
                 {
-                    enew = is_boundary ? Edge(mesh_.n_edges() - 2)
-                                       : Edge(mesh_.n_edges() - 3);
+                    enew = is_boundary ? Edge(mesh_.edges_size() - 2)
+                                       : Edge(mesh_.edges_size() - 3);
                     efeature_[enew] = true;
                     vfeature_[vnew] = true;
                 }
@@ -451,11 +704,15 @@ void Remeshing::split_long_edges(unsigned int nIterations)
 
 void Remeshing::collapse_short_edges()
 {
-    Vertex v0, v1;
-    Halfedge h0, h1, h01, h10;
-    bool ok, b0, b1, l0, l1, f0, f1;
+    if (parallel_candidate_evaluation_)
+    {
+        batched_collapse_short_edges();
+        return;
+    }
+
+    Halfedge h;
+    bool ok;
     int i;
-    bool hcol01, hcol10;
 
     for (ok = false, i = 0; !ok && i < 10; ++i)
     {
@@ -463,139 +720,140 @@ void Remeshing::collapse_short_edges()
 
         for (auto e : mesh_.edges())
         {
-            if (!mesh_.is_deleted(e) && !elocked_[e])
+            h = collapse_candidate(e);
+            if (h.is_valid())
             {
-                h10 = mesh_.halfedge(e, 0);
-                h01 = mesh_.halfedge(e, 1);
-                v0 = mesh_.to_vertex(h10);
-                v1 = mesh_.to_vertex(h01);
+                mesh_.collapse(h);
+                ok = false;
+            }
+        }
+    }
 
-                if (is_too_short(v0, v1))
-                {
-                    // get status
-                    b0 = mesh_.is_boundary(v0);
-                    b1 = mesh_.is_boundary(v1);
-                    l0 = vlocked_[v0];
-                    l1 = vlocked_[v1];
-                    f0 = vfeature_[v0];
-                    f1 = vfeature_[v1];
-                    hcol01 = hcol10 = true;
-
-                    // boundary rules
-                    if (b0 && b1)
-                    {
-                        if (!mesh_.is_boundary(e))
-                            continue;
-                    }
-                    else if (b0)
-                        hcol01 = false;
-                    else if (b1)
-                        hcol10 = false;
-
-                    // locked rules
-                    if (l0 && l1)
-                        continue;
-                    else if (l0)
-                        hcol01 = false;
-                    else if (l1)
-                        hcol10 = false;
-
-                    // feature rules
-                    if (f0 && f1)
-                    {
-                        // edge must be feature
-                        if (!efeature_[e])
-                            continue;
-
-                        // the other two edges removed by collapse must not be features
-                        h0 = mesh_.prev_halfedge(h01);
-                        h1 = mesh_.next_halfedge(h10);
-                        if (efeature_[mesh_.edge(h0)] ||
-                            efeature_[mesh_.edge(h1)])
-                            hcol01 = false;
-                        // the other two edges removed by collapse must not be features
-                        h0 = mesh_.prev_halfedge(h10);
-                        h1 = mesh_.next_halfedge(h01);
-                        if (efeature_[mesh_.edge(h0)] ||
-                            efeature_[mesh_.edge(h1)])
-                            hcol10 = false;
-                    }
-                    else if (f0)
-                        hcol01 = false;
-                    else if (f1)
-                        hcol10 = false;
+    // local remeshing keeps the deleted elements until postprocessing
+    // to avoid compacting the whole mesh in every iteration.
+    if (!local_)
+        mesh_.garbage_collection();
+}
 
-                    // topological rules
-                    bool collapse_ok = mesh_.is_collapse_ok(h01);
+Halfedge Remeshing::collapse_candidate(Edge e) const
+{
+    Vertex v0, v1;
+    Halfedge h0, h1, h01, h10;
+    bool b0, b1, l0, l1, f0, f1;
+    bool hcol01, hcol10;
 
-                    if (hcol01)
-                        hcol01 = collapse_ok;
-                    if (hcol10)
-                        hcol10 = collapse_ok;
+    if (mesh_.is_deleted(e) || elocked_[e])
+        return Halfedge();
 
-                    // both collapses possible: collapse into vertex w/ higher valence
-                    if (hcol01 && hcol10)
-                    {
-                        if (mesh_.valence(v0) < mesh_.valence(v1))
-                            hcol10 = false;
-                        else
-                            hcol01 = false;
-                    }
+    h10 = mesh_.halfedge(e, 0);
+    h01 = mesh_.halfedge(e, 1);
+    v0 = mesh_.to_vertex(h10);
+    v1 = mesh_.to_vertex(h01);
 
-                    // try v1 -> v0
-                    if (hcol10)
-                    {
-                        // don't create too long edges
-                        for (auto vv : mesh_.vertices(v1))
-                        {
-                            if (is_too_long(v0, vv))
-                            {
-                                hcol10 = false;
-                                break;
-                            }
-                        }
-
-                        if (hcol10)
-                        {
-                            mesh_.collapse(h10);
-                            ok = false;
-                        }
-                    }
+    if (!is_too_short(v0, v1))
+        return Halfedge();
 
-                    // try v0 -> v1
-                    else if (hcol01)
-                    {
-                        // don't create too long edges
-                        for (auto vv : mesh_.vertices(v0))
-                        {
-                            if (is_too_long(v1, vv))
-                            {
-                                hcol01 = false;
-                                break;
-                            }
-                        }
-
-                        if (hcol01)
-                        {
-                            mesh_.collapse(h01);
-                            ok = false;
-                        }
-                    }
-                }
-            }
+    // get status
+    b0 = mesh_.is_boundary(v0);
+    b1 = mesh_.is_boundary(v1);
+    l0 = vlocked_[v0];
+    l1 = vlocked_[v1];
+    f0 = vfeature_[v0];
+    f1 = vfeature_[v1];
+    hcol01 = hcol10 = true;
+
+    // boundary rules
+    if (b0 && b1)
+    {
+        if (!mesh_.is_boundary(e))
+            return Halfedge();
+    }
+    else if (b0)
+        hcol01 = false;
+    else if (b1)
+        hcol10 = false;
+
+    // locked rules
+    if (l0 && l1)
+        return Halfedge();
+    else if (l0)
+        hcol01 = false;
+    else if (l1)
+        hcol10 = false;
+
+    // feature rules
+    if (f0 && f1)
+    {
+        // edge must be feature
+        if (!efeature_[e])
+            return Halfedge();
+
+        // the other two edges removed by collapse must not be features
+        h0 = mesh_.prev_halfedge(h01);
+        h1 = mesh_.next_halfedge(h10);
+        if (efeature_[mesh_.edge(h0)] || efeature_[mesh_.edge(h1)])
+            hcol01 = false;
+        // the other two edges removed by collapse must not be features
+        h0 = mesh_.prev_halfedge(h10);
+        h1 = mesh_.next_halfedge(h01);
+        if (efeature_[mesh_.edge(h0)] || efeature_[mesh_.edge(h1)])
+            hcol10 = false;
+    }
+    else if (f0)
+        hcol01 = false;
+    else if (f1)
+        hcol10 = false;
+
+    // topological rules
+    bool collapse_ok = mesh_.is_collapse_ok(h01);
+
+    if (hcol01)
+        hcol01 = collapse_ok;
+    if (hcol10)
+        hcol10 = collapse_ok;
+
+    // both collapses possible: collapse into vertex w/ higher valence
+    if (hcol01 && hcol10)
+    {
+        if (mesh_.valence(v0) < mesh_.valence(v1))
+            hcol10 = false;
+        else
+            hcol01 = false;
+    }
+
+    // try v1 -> v0
+    if (hcol10)
+    {
+        // don't create too long edges
+        for (auto vv : mesh_.vertices(v1))
+        {
+            if (is_too_long(v0, vv))
+                return Halfedge();
+        }
+
+        return h10;
+    }
+
+    // try v0 -> v1
+    if (hcol01)
+    {
+        // don't create too long edges
+        for (auto vv : mesh_.vertices(v0))
+        {
+            if (is_too_long(v1, vv))
+                return Halfedge();
         }
+
+        return h01;
     }
 
-    mesh_.garbage_collection();
+    return Halfedge();
 }
 
 void Remeshing::flip_edges()
 {
     Vertex v0, v1, v2, v3;
     Halfedge h;
-    int val0, val1, val2, val3;
-    int val_opt0, val_opt1, val_opt2, val_opt3;
-    int ve0, ve1, ve2, ve3, ve_before, ve_after;
     bool ok;
     int i;
 
@@ -606,13 +864,20 @@ void Remeshing::flip_edges()
         valence[v] = mesh_.valence(v);
     }
 
+    if (parallel_candidate_evaluation_)
+    {
+        batched_flip_edges(valence);
+        mesh_.remove_vertex_property(valence);
+        return;
+    }
+
     for (ok = false, i = 0; !ok && i < 10; ++i)
     {
         ok = true;
 
         for (auto e : mesh_.edges())
         {
-            if (!elocked_[e] && !efeature_[e])
+            if (is_flip_improving(e, valence))
             {
                 h = mesh_.halfedge(e, 0);
                 v0 = mesh_.to_vertex(h);
@@ -621,58 +886,12 @@ void Remeshing::flip_edges()
                 v1 = mesh_.to_vertex(h);
                 v3 = mesh_.to_vertex(mesh_.next_halfedge(h));
 
-                if (!vlocked_[v0] && !vlocked_[v1] && !vlocked_[v2] &&
-                    !vlocked_[v3])
-                {
-                    val0 = valence[v0];
-                    val1 = valence[v1];
-                    val2 = valence[v2];
-                    val3 = valence[v3];
-
-                    val_opt0 = (mesh_.is_boundary(v0) ? 4 : 6);
-                    val_opt1 = (mesh_.is_boundary(v1) ? 4 : 6);
-                    val_opt2 = (mesh_.is_boundary(v2) ? 4 : 6);
-                    val_opt3 = (mesh_.is_boundary(v3) ? 4 : 6);
-
-                    ve0 = (val0 - val_opt0);
-                    ve1 = (val1 - val_opt1);
-                    ve2 = (val2 - val_opt2);
-                    ve3 = (val3 - val_opt3);
-
-                    ve0 *= ve0;
-                    ve1 *= ve1;
-                    ve2 *= ve2;
-                    ve3 *= ve3;
-
-                    ve_before = ve0 + ve1 + ve2 + ve3;
-
-                    --val0;
-                    --val1;
-                    ++val2;
-                    ++val3;
-
-                    ve0 = (val0 - val_opt0);
-                    ve1 = (val1 - val_opt1);
-                    ve2 = (val2 - val_opt2);
-                    ve3 = (val3 - val_opt3);
-
-                    ve0 *= ve0;
-                    ve1 *= ve1;
-                    ve2 *= ve2;
-                    ve3 *= ve3;
-
-                    ve_after = ve0 + ve1 + ve2 + ve3;
-
-                    if (ve_before > ve_after && mesh_.is_flip_ok(e))
-                    {
-                        mesh_.flip(e);
-                        --valence[v0];
-                        --valence[v1];
-                        ++valence[v2];
-                        ++valence[v3];
-                        ok = false;
-                    }
-                }
+                mesh_.flip(e);
+                --valence[v0];
+                --valence[v1];
+                ++valence[v2];
+                ++valence[v3];
+                ok = false;
             }
         }
     }
@@ -680,127 +899,347 @@ void Remeshing::flip_edges()
     mesh_.remove_vertex_property(valence);
 }
 
-void Remeshing::tangential_smoothing(unsigned int iterations)
+bool Remeshing::is_flip_improving(Edge e, const VertexProperty<int>& valence) const
 {
-    Vertex v1, v2, v3, vv;
-    Edge e;
-    Scalar w, ww;
-    Point u, n, t, b;
+    Vertex v0, v1, v2, v3;
+    Halfedge h;
+    int val0, val1, val2, val3;
+    int val_opt0, val_opt1, val_opt2, val_opt3;
+    int ve0, ve1, ve2, ve3, ve_before, ve_after;
 
-    // add property
-    auto update = mesh_.add_vertex_property<Point>("v:update");
+    if (mesh_.is_deleted(e) || elocked_[e] || efeature_[e])
+        return false;
 
-    // project at the beginning to get valid sizing values and normal vectors
-    // for vertices introduced by splitting
-    if (use_projection_)
+    h = mesh_.halfedge(e, 0);
+    v0 = mesh_.to_vertex(h);
+    v2 = mesh_.to_vertex(mesh_.next_halfedge(h));
+    h = mesh_.halfedge(e, 1);
+    v1 = mesh_.to_vertex(h);
+    v3 = mesh_.to_vertex(mesh_.next_halfedge(h));
+
+    if (vlocked_[v0] || vlocked_[v1] || vlocked_[v2] || vlocked_[v3])
+        return false;
+
+    val0 = valence[v0];
+    val1 = valence[v1];
+    val2 = valence[v2];
+    val3 = valence[v3];
+
+    val_opt0 = (mesh_.is_boundary(v0) ? 4 : 6);
+    val_opt1 = (mesh_.is_boundary(v1) ? 4 : 6);
+    val_opt2 = (mesh_.is_boundary(v2) ? 4 : 6);
+    val_opt3 = (mesh_.is_boundary(v3) ? 4 : 6);
+
+    ve0 = (val0 - val_opt0);
+    ve1 = (val1 - val_opt1);
+    ve2 = (val2 - val_opt2);
+    ve3 = (val3 - val_opt3);
+
+    ve0 *= ve0;
+    ve1 *= ve1;
+    ve2 *= ve2;
+    ve3 *= ve3;
+
+    ve_before = ve0 + ve1 + ve2 + ve3;
+
+    --val0;
+    --val1;
+    ++val2;
+    ++val3;
+
+    ve0 = (val0 - val_opt0);
+    ve1 = (val1 - val_opt1);
+    ve2 = (val2 - val_opt2);
+    ve3 = (val3 - val_opt3);
+
+    ve0 *= ve0;
+    ve1 *= ve1;
+    ve2 *= ve2;
+    ve3 *= ve3;
+
+    ve_after = ve0 + ve1 + ve2 + ve3;
+
+    return ve_before > ve_after && mesh_.is_flip_ok(e);
+}
+
+void Remeshing::batched_split_long_edges(unsigned int nIterations)
+{
+    std::vector<Vertex> new_vertices;
+
+    for (unsigned int i = 0; i < nIterations; ++i)
     {
-        for (auto v : mesh_.vertices())
+        const auto candidates = collect_candidates<Edge>(
+            mesh_.edges_size(), n_threads_, [&](size_t idx)
+            {
+                const Edge e(static_cast<IndexType>(idx));
+                if (mesh_.is_deleted(e) || elocked_[e] ||
+                    !is_too_long(mesh_.vertex(e, 0), mesh_.vertex(e, 1)))
+                    return Edge();
+                return e;
+            });
+        if (candidates.empty())
+            break;
+
+        // splits of distinct edges do not interfere, so all candidates are split
+        new_vertices.clear();
+        for (auto e : candidates)
         {
-            if (!mesh_.is_boundary(v) && !vlocked_[v])
+            const Vertex v0 = mesh_.vertex(e, 0);
+            const Vertex v1 = mesh_.vertex(e, 1);
+            const bool is_feature = efeature_[e];
+            const bool is_boundary = mesh_.is_boundary(e);
+
+            const Vertex vnew = mesh_.add_vertex((points_[v0] + points_[v1]) * 0.5f);
+            mesh_.split(e, vnew);
+
+            // need sizing for adaptive refinement
+            vsizing_[vnew] = 0.5f * (vsizing_[v0] + vsizing_[v1]);
+
+            if (is_feature)
             {
-                project_to_reference(v);
+                const Edge enew = is_boundary ? Edge(mesh_.edges_size() - 2)
+                                              : Edge(mesh_.edges_size() - 3);
+                efeature_[enew] = true;
+                vfeature_[vnew] = true;
             }
+            new_vertices.push_back(vnew);
         }
+
+        // normals of all new vertices before any of them is projected
+        Utils::ParallelForChunks(0, new_vertices.size(), n_threads_,
+            [&](size_t chunk_start, size_t chunk_end, unsigned int)
+            {
+                for (size_t j = chunk_start; j < chunk_end; ++j)
+                    vnormal_[new_vertices[j]] = Normals::compute_vertex_normal(mesh_, new_vertices[j]);
+            });
+        Utils::ParallelForChunks(0, new_vertices.size(), n_threads_,
+            [&](size_t chunk_start, size_t chunk_end, unsigned int)
+            {
+                for (size_t j = chunk_start; j < chunk_end; ++j)
+                {
+                    if (!vfeature_[new_vertices[j]])
+                        project_to_reference(new_vertices[j]);
+                }
+            });
     }
+}
 
-    for (unsigned int iters = 0; iters < iterations; ++iters)
+void Remeshing::batched_collapse_short_edges()
+{
+    bool ok;
+    int i;
+
+    for (ok = false, i = 0; !ok && i < 10; ++i)
     {
-        for (auto v : mesh_.vertices())
+        ok = true;
+
+        const auto candidates = collect_candidates<Edge>(
+            mesh_.edges_size(), n_threads_, [&](size_t idx)
+            {
+                const Edge e(static_cast<IndexType>(idx));
+                return collapse_candidate(e).is_valid() ? e : Edge();
+            });
+
+        // the collapses are applied in edge order, and each candidate is tested
+        // again, because an earlier collapse may have changed its neighborhood.
+        for (auto e : candidates)
         {
-            if (!mesh_.is_boundary(v) && !vlocked_[v])
+            const Halfedge h = collapse_candidate(e);
+            if (h.is_valid())
             {
-                if (vfeature_[v])
-                {
-                    u = Point(0.0);
-                    t = Point(0.0);
-                    ww = 0;
-                    int c = 0;
+                mesh_.collapse(h);
+                ok = false;
+            }
+        }
+    }
 
-                    for (auto h : mesh_.halfedges(v))
-                    {
-                        if (efeature_[mesh_.edge(h)])
-                        {
-                            vv = mesh_.to_vertex(h);
-
-                            b = points_[v];
-                            b += points_[vv];
-                            b *= 0.5;
-
-                            w = distance(points_[v], points_[vv]) /
-                                (0.5 * (vsizing_[v] + vsizing_[vv]));
-                            ww += w;
-                            u += w * b;
-
-                            if (c == 0)
-                            {
-                                t += normalize(points_[vv] - points_[v]);
-                                ++c;
-                            }
-                            else
-                            {
-                                ++c;
-                                t -= normalize(points_[vv] - points_[v]);
-                            }
-                        }
-                    }
+    // local remeshing keeps the deleted elements until postprocessing
+    // to avoid compacting the whole mesh in every iteration.
+    if (!local_)
+        mesh_.garbage_collection();
+}
 
-                    assert(c == 2);
+void Remeshing::batched_flip_edges(VertexProperty<int>& valence)
+{
+    Vertex v0, v1, v2, v3;
+    Halfedge h;
+    bool ok;
+    int i;
 
-                    u *= (1.0 / ww);
-                    u -= points_[v];
-                    t = normalize(t);
-                    u = t * dot(u, t);
+    for (ok = false, i = 0; !ok && i < 10; ++i)
+    {
+        ok = true;
 
-                    update[v] = u;
-                }
-                else
+        const auto candidates = collect_candidates<Edge>(
+            mesh_.edges_size(), n_threads_, [&](size_t idx)
+            {
+                const Edge e(static_cast<IndexType>(idx));
+                return is_flip_improving(e, valence) ? e : Edge();
+            });
+
+        // the flips are applied in edge order, and each candidate is tested
+        // again, because an earlier flip may have changed the valences.
+        for (auto e : candidates)
+        {
+            if (!is_flip_improving(e, valence))
+                continue;
+
+            h = mesh_.halfedge(e, 0);
+            v0 = mesh_.to_vertex(h);
+            v2 = mesh_.to_vertex(mesh_.next_halfedge(h));
+            h = mesh_.halfedge(e, 1);
+            v1 = mesh_.to_vertex(h);
+            v3 = mesh_.to_vertex(mesh_.next_halfedge(h));
+
+            mesh_.flip(e);
+            --valence[v0];
+            --valence[v1];
+            ++valence[v2];
+            ++valence[v3];
+            ok = false;
+        }
+    }
+}
+
+void Remeshing::tangential_smoothing(unsigned int iterations)
+{
+    // add property
+    auto update = mesh_.add_vertex_property<Point>("v:update");
+
+    // project at the beginning to get valid sizing values and normal vectors
+    // for vertices introduced by splitting
+    if (use_projection_)
+    {
+        project_unlocked_vertices();
+    }
+
+    // the updates are evaluated from the positions of the previous iteration,
+    // so the result does not depend on the number of threads.
+    for (unsigned int iters = 0; iters < iterations; ++iters)
+    {
+        Utils::ParallelForChunks(0, mesh_.vertices_size(), n_threads_,
+            [&](size_t chunk_start, size_t chunk_end, unsigned int)
+            {
+                for (size_t i = chunk_start; i < chunk_end; ++i)
                 {
-                    Point p(0);
-                    try
-                    {
-                        p = minimize_squared_areas(v);
-                    }
-                    catch (SolverException&)
+                    const Vertex v(static_cast<IndexType>(i));
+                    if (!mesh_.is_deleted(v) && !mesh_.is_boundary(v) && !vlocked_[v])
                     {
-                        p = weighted_centroid(v);
+                        update[v] = tangential_update(v);
                     }
-                    u = p - mesh_.position(v);
-
-                    n = vnormal_[v];
-                    u -= n * dot(u, n);
-
-                    update[v] = u;
                 }
-            }
-        }
+            });
 
         // update vertex positions
-        for (auto v : mesh_.vertices())
-        {
-            if (!mesh_.is_boundary(v) && !vlocked_[v])
+        Utils::ParallelForChunks(0, mesh_.vertices_size(), n_threads_,
+            [&](size_t chunk_start, size_t chunk_end, unsigned int)
             {
-                points_[v] += update[v];
-            }
-        }
+                for (size_t i = chunk_start; i < chunk_end; ++i)
+                {
+                    const Vertex v(static_cast<IndexType>(i));
+                    if (!mesh_.is_deleted(v) && !mesh_.is_boundary(v) && !vlocked_[v])
+                    {
+                        points_[v] += update[v];
+                    }
+                }
+            });
 
         // update normal vectors (if not done so through projection)
-        Normals::compute_vertex_normals(mesh_);
+        update_vertex_normals();
     }
 
     // project at the end
     if (use_projection_)
     {
-        for (auto v : mesh_.vertices())
+        project_unlocked_vertices();
+    }
+
+    // remove property
+    mesh_.remove_vertex_property(update);
+}
+
+Point Remeshing::tangential_update(Vertex v)
+{
+    Vertex vv;
+    Scalar w, ww;
+    Point u, n, t, b;
+
+    if (vfeature_[v])
+    {
+        u = Point(0.0);
+        t = Point(0.0);
+        ww = 0;
+        int c = 0;
+
+        for (auto h : mesh_.halfedges(v))
         {
-            if (!mesh_.is_boundary(v) && !vlocked_[v])
+            if (efeature_[mesh_.edge(h)])
             {
-                project_to_reference(v);
+                vv = mesh_.to_vertex(h);
+
+                b = points_[v];
+                b += points_[vv];
+                b *= 0.5;
+
+                w = distance(points_[v], points_[vv]) /
+                    (0.5 * (vsizing_[v] + vsizing_[vv]));
+                ww += w;
+                u += w * b;
+
+                if (c == 0)
+                {
+                    t += normalize(points_[vv] - points_[v]);
+                    ++c;
+                }
+                else
+                {
+                    ++c;
+                    t -= normalize(points_[vv] - points_[v]);
+                }
             }
         }
+
+        assert(c == 2);
+
+        u *= (1.0 / ww);
+        u -= points_[v];
+        t = normalize(t);
+        u = t * dot(u, t);
+
+        return u;
     }
 
-    // remove property
-    mesh_.remove_vertex_property(update);
+    Point p(0);
+    try
+    {
+        p = minimize_squared_areas(v);
+    }
+    catch (SolverException&)
+    {
+        p = weighted_centroid(v);
+    }
+    u = p - mesh_.position(v);
+
+    n = vnormal_[v];
+    u -= n * dot(u, n);
+
+    return u;
+}
+
+void Remeshing::project_unlocked_vertices()
+{
+    Utils::ParallelForChunks(0, mesh_.vertices_size(), n_threads_,
+        [&](size_t chunk_start, size_t chunk_end, unsigned int)
+        {
+            for (size_t i = chunk_start; i < chunk_end; ++i)
+            {
+                const Vertex v(static_cast<IndexType>(i));
+                if (!mesh_.is_deleted(v) && !mesh_.is_boundary(v) && !vlocked_[v])
+                {
+                    project_to_reference(v);
+                }
+            }
+        });
 }
 
 void Remeshing::remove_caps()
@@ -859,6 +1298,23 @@ void Remeshing::remove_caps()
     }
 }
 
+void Remeshing::update_vertex_normals()
+{
+    // only the normals of unlocked vertices are used in local remeshing
+    Utils::ParallelForChunks(0, mesh_.vertices_size(), n_threads_,
+        [&](size_t chunk_start, size_t chunk_end, unsigned int)
+        {
+            for (size_t i = chunk_start; i < chunk_end; ++i)
+            {
+                const Vertex v(static_cast<IndexType>(i));
+                if (!mesh_.is_deleted(v) && !(local_ && vlocked_[v]))
+                {
+                    vnormal_[v] = Normals::compute_vertex_normal(mesh_, v);
+                }
+            }
+        });
+}
+
 Point Remeshing::minimize_squared_areas(Vertex v)
 {
     dmat3 A(0);
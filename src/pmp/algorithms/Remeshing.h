@@ -7,6 +7,7 @@
 #include "pmp/algorithms/TriangleKdTree.h"
 
 #include <memory>
+#include <vector>
 
 namespace pmp {
 /**
@@ -21,6 +22,8 @@ struct AdaptiveRemeshingSettings
     unsigned int NRemeshingIterations{ 10 };
     unsigned int NTangentialSmoothingIters{ 6 };
     bool UseProjection{ true };
+    unsigned int NThreads{ 1 }; //>! the number of worker threads for tangential smoothing, back-projection, and candidate evaluation. Zero means "use all hardware threads".
+    bool ParallelCandidateEvaluation{ false }; //>! if true, split, collapse, and flip candidates are evaluated in parallel. The edits themselves are applied serially in edge order after a repeated test, so an edge which only becomes a candidate after an earlier edit waits for the next pass.
 };
 
 //! \brief A class for uniform and adaptive surface remeshing.
@@ -53,8 +56,20 @@ public:
     //! \param settings      input settings.
     void convex_hull_adaptive_remeshing(const AdaptiveRemeshingSettings& settings);
 
+    //! \brief Perform adaptive remeshing restricted to the neighborhoods of seed vertices.
+    //! \details Vertices outside of the n_rings-ring neighborhoods of the seeds are locked.
+    //! The sizing field and the reference surface for back-projection are evaluated only
+    //! on a submesh around the remeshed region, so the cost scales with the size of the region.
+    //! \param settings      input settings.
+    //! \param seeds         vertices whose neighborhoods should be remeshed.
+    //! \param n_rings       the remeshed region consists of the seeds and their n_rings-ring neighborhoods.
+    void local_adaptive_remeshing(const AdaptiveRemeshingSettings& settings,
+                                  const std::vector<Vertex>& seeds,
+                                  unsigned int n_rings = 2);
+
 private:
     void preprocessing();
+    void local_preprocessing(const std::vector<Vertex>& seeds, unsigned int n_rings);
     void postprocessing();
     void convex_hull_preprocessing();
     void convex_hull_postprocessing();
@@ -62,9 +77,22 @@ private:
     void split_long_edges(unsigned int nIterations = 10);
     void collapse_short_edges();
     void flip_edges();
+
+    void batched_split_long_edges(unsigned int nIterations);
+    void batched_collapse_short_edges();
+    void batched_flip_edges(VertexProperty<int>& valence);
+
+    Halfedge collapse_candidate(Edge e) const;
+    bool is_flip_improving(Edge e, const VertexProperty<int>& valence) const;
     void tangential_smoothing(unsigned int iterations);
     void remove_caps();
 
+    Point tangential_update(Vertex v);
+    void project_unlocked_vertices();
+
+    void compute_adaptive_sizing(SurfaceMesh& mesh, VertexProperty<Scalar>& sizing) const;
+    void update_vertex_normals();
+
     Point minimize_squared_areas(Vertex v);
     Point weighted_centroid(Vertex v);
 
@@ -88,6 +116,9 @@ private:
     std::unique_ptr<TriangleKdTree> kd_tree_;
 
     bool uniform_;
+    bool local_{false};
+    unsigned int n_threads_{1};
+    bool parallel_candidate_evaluation_{false};
     Scalar target_edge_length_;
     Scalar min_edge_length_;
     Scalar max_edge_length_;
@@ -0,0 +1,233 @@
+#include "ClosestTrianglePropagation.h"
+
+#include "geometry/GeometryUtil.h"
+#include "utils/ParallelUtils.h"
+
+#include <climits>
+#include <cstdint>
+
+namespace SDF
+{
+	namespace
+	{
+		/// \brief closest triangle id of a voxel which has not been reached by the propagation yet.
+		constexpr unsigned int NO_CLOSEST_TRIANGLE = UINT_MAX;
+
+		/**
+		 * \brief Computes the squared distance from a point to a triangle of the kd-tree.
+		 * \param kdTree       kd-tree of the mesh.
+		 * \param triId        triangle index.
+		 * \param point        evaluated point.
+		 * \return squared distance from point to the triangle.
+		 */
+		[[nodiscard]] double GetDistanceToKdTreeTriangleSq(const Geometry::CollisionKdTree& kdTree, const unsigned int& triId, const pmp::vec3& point)
+		{
+			return Geometry::GetDistanceToTriangleSq(kdTree.TriangleVertexData(), triId, point);
+		}
+
+		/// \brief index bounds of a set of voxels.
+		struct VoxelIndexBounds
+		{
+			size_t Min[3]{ SIZE_MAX, SIZE_MAX, SIZE_MAX };
+			size_t Max[3]{ 0, 0, 0 };
+
+			void Add(const size_t& ix, const size_t& iy, const size_t& iz)
+			{
+				Min[0] = std::min(Min[0], ix); Max[0] = std::max(Max[0], ix);
+				Min[1] = std::min(Min[1], iy); Max[1] = std::max(Max[1], iy);
+				Min[2] = std::min(Min[2], iz); Max[2] = std::max(Max[2], iz);
+			}
+
+			void Add(const VoxelIndexBounds& other)
+			{
+				if (other.IsEmpty())
+					return;
+				Add(other.Min[0], other.Min[1], other.Min[2]);
+				Add(other.Max[0], other.Max[1], other.Max[2]);
+			}
+
+			[[nodiscard]] bool IsEmpty() const
+			{
+				return Min[0] > Max[0];
+			}
+		};
+
+		template <typename T>
+		void PropagateClosestTrianglesInternal(Geometry::BasicScalarGrid<T>& grid, const Geometry::CollisionKdTree& kdTree, const ClosestTrianglePropagationSettings& settings)
+		{
+			assert(grid.CellSize() > 0.0f);
+			assert(settings.TruncationValue > 0.0);
+
+			const auto& [Nx, Ny, Nz] = grid.Dimensions();
+			const auto& orig = grid.Box().min();
+			const float cellSize = grid.CellSize();
+			auto& gridVals = grid.Values();
+			const auto& gridFrozenVals = grid.FrozenValues();
+			const size_t nVoxels = Nx * Ny * Nz;
+
+			const auto voxelCenter = [&](const size_t& ix, const size_t& iy, const size_t& iz)
+			{
+				return pmp::vec3{
+					orig[0] + (static_cast<float>(ix) + 0.5f) * cellSize,
+					orig[1] + (static_cast<float>(iy) + 0.5f) * cellSize,
+					orig[2] + (static_cast<float>(iz) + 0.5f) * cellSize
+				};
+			};
+
+			// closest triangle ids are double-buffered (each pass reads its neighbors from the previous pass),
+			// while each voxel's squared distance to its closest triangle is only accessed by the thread owning the voxel.
+			std::vector<unsigned int> closestTriIds(nVoxels, NO_CLOSEST_TRIANGLE);
+			std::vector<double> closestDistSq(nVoxels, DBL_MAX);
+
+			// seed the frozen voxels with their closest triangle among the triangles intersecting the voxel
+			const unsigned int nWorkers = Utils::GetWorkerThreadCount(settings.NThreads);
+			std::vector<VoxelIndexBounds> threadSeedBounds(nWorkers);
+			Utils::ParallelForChunks(0, Nz, nWorkers, [&](const size_t izStart, const size_t izEnd, const unsigned int threadId)
+			{
+				auto& seedBounds = threadSeedBounds[threadId];
+				std::vector<unsigned int> voxelTriangleIds{};
+				for (size_t iz = izStart; iz < izEnd; iz++)
+				{
+					for (size_t iy = 0; iy < Ny; iy++)
+					{
+						for (size_t ix = 0; ix < Nx; ix++)
+						{
+							const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
+							if (!gridFrozenVals[gridPos])
+								continue;
+
+							seedBounds.Add(ix, iy, iz);
+							const auto center = voxelCenter(ix, iy, iz);
+							const pmp::BoundingBox voxelBox{ center - pmp::vec3(0.5f * cellSize), center + pmp::vec3(0.5f * cellSize) };
+							voxelTriangleIds.clear();
+							kdTree.GetTrianglesInABox(voxelBox, voxelTriangleIds);
+							for (const auto& triId : voxelTriangleIds)
+							{
+								const double distSq = GetDistanceToKdTreeTriangleSq(kdTree, triId, center);
+								if (distSq >= closestDistSq[gridPos])
+									continue;
+
+								closestDistSq[gridPos] = distSq;
+								closestTriIds[gridPos] = triId;
+							}
+						}
+					}
+				}
+			});
+
+			// the steps 2^k, ..., 2, 1 reach voxels up to 2^(k+1) - 1 voxels away, which should cover the truncation band.
+			const size_t maxDim = std::max({ Nx, Ny, Nz });
+			const double bandWidthInVoxels = std::min(settings.TruncationValue / static_cast<double>(cellSize), static_cast<double>(maxDim));
+			const auto bandRadius = static_cast<size_t>(std::ceil(bandWidthInVoxels)) + 1;
+			size_t initialStep = 1;
+			while (2 * initialStep <= bandRadius)
+				initialStep *= 2;
+
+			// voxels of the band lie within bandRadius from the seeds
+			VoxelIndexBounds bandBounds{};
+			for (const auto& seedBounds : threadSeedBounds)
+				bandBounds.Add(seedBounds);
+			if (bandBounds.IsEmpty())
+				return; // nothing to propagate
+
+			const size_t ixMin = bandBounds.Min[0] > bandRadius ? bandBounds.Min[0] - bandRadius : 0, ixMax = std::min(bandBounds.Max[0] + bandRadius, Nx - 1);
+			const size_t iyMin = bandBounds.Min[1] > bandRadius ? bandBounds.Min[1] - bandRadius : 0, iyMax = std::min(bandBounds.Max[1] + bandRadius, Ny - 1);
+			const size_t izMin = bandBounds.Min[2] > bandRadius ? bandBounds.Min[2] - bandRadius : 0, izMax = std::min(bandBounds.Max[2] + bandRadius, Nz - 1);
+
+			std::vector<size_t> steps{};
+			for (size_t step = initialStep; step > 0; step /= 2)
+				steps.push_back(step);
+			steps.push_back(1); // JFA+1: an extra pass fixes most of the jump flooding errors
+
+			const double sqrt3 = std::sqrt(3.0);
+			std::vector<unsigned int> nextClosestTriIds(closestTriIds);
+			for (const auto& step : steps)
+			{
+				// a triangle farther than this from a voxel cannot be the closest triangle of any voxel in the band reachable by the remaining steps.
+				const double maxPropagationDist = settings.TruncationValue + sqrt3 * static_cast<double>(cellSize) * static_cast<double>(2 * step);
+				const double maxPropagationDistSq = maxPropagationDist * maxPropagationDist;
+				const auto iStep = static_cast<int64_t>(step);
+
+				Utils::ParallelForChunks(izMin, izMax + 1, nWorkers, [&](const size_t izStart, const size_t izEnd, [[maybe_unused]] const unsigned int threadId)
+				{
+					for (size_t iz = izStart; iz < izEnd; iz++)
+					{
+						for (size_t iy = iyMin; iy <= iyMax; iy++)
+						{
+							for (size_t ix = ixMin; ix <= ixMax; ix++)
+							{
+								const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
+								unsigned int bestTriId = closestTriIds[gridPos];
+								if (gridFrozenVals[gridPos])
+								{
+									nextClosestTriIds[gridPos] = bestTriId;
+									continue; // seeds keep their triangles
+								}
+
+								double bestDistSq = closestDistSq[gridPos];
+								const auto center = voxelCenter(ix, iy, iz);
+								for (int64_t dz = -iStep; dz <= iStep; dz += iStep)
+								{
+									const int64_t nz = static_cast<int64_t>(iz) + dz;
+									if (nz < 0 || nz >= static_cast<int64_t>(Nz))
+										continue;
+									for (int64_t dy = -iStep; dy <= iStep; dy += iStep)
+									{
+										const int64_t ny = static_cast<int64_t>(iy) + dy;
+										if (ny < 0 || ny >= static_cast<int64_t>(Ny))
+											continue;
+										for (int64_t dx = -iStep; dx <= iStep; dx += iStep)
+										{
+											const int64_t nx = static_cast<int64_t>(ix) + dx;
+											if (nx < 0 || nx >= static_cast<int64_t>(Nx))
+												continue;
+
+											const unsigned int candidateTriId = closestTriIds[Nx * Ny * nz + Nx * ny + nx];
+											if (candidateTriId == NO_CLOSEST_TRIANGLE || candidateTriId == bestTriId)
+												continue;
+
+											const double distSq = GetDistanceToKdTreeTriangleSq(kdTree, candidateTriId, center);
+											if (distSq >= bestDistSq || distSq > maxPropagationDistSq)
+												continue;
+
+											bestDistSq = distSq;
+											bestTriId = candidateTriId;
+										}
+									}
+								}
+
+								closestDistSq[gridPos] = bestDistSq;
+								nextClosestTriIds[gridPos] = bestTriId;
+							}
+						}
+					}
+				});
+				std::swap(closestTriIds, nextClosestTriIds);
+			}
+
+			// write the exact distances clamped to the truncation value
+			Utils::ParallelForChunks(0, nVoxels, nWorkers, [&](const size_t start, const size_t end, [[maybe_unused]] const unsigned int threadId)
+			{
+				for (size_t gridPos = start; gridPos < end; gridPos++)
+				{
+					if (gridFrozenVals[gridPos] || closestTriIds[gridPos] == NO_CLOSEST_TRIANGLE)
+						continue;
+
+					gridVals[gridPos] = static_cast<T>(std::min(std::sqrt(closestDistSq[gridPos]), settings.TruncationValue));
+				}
+			});
+		}
+
+	} // anonymous namespace
+
+	void PropagateClosestTriangles(Geometry::ScalarGrid& grid, const Geometry::CollisionKdTree& kdTree, const ClosestTrianglePropagationSettings& settings)
+	{
+		PropagateClosestTrianglesInternal(grid, kdTree, settings);
+	}
+
+	void PropagateClosestTriangles(Geometry::ScalarGridF& grid, const Geometry::CollisionKdTree& kdTree, const ClosestTrianglePropagationSettings& settings)
+	{
+		PropagateClosestTrianglesInternal(grid, kdTree, settings);
+	}
+
+} // namespace SDF
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "geometry/CollisionKdTree.h"
+#include "geometry/Grid.h"
+
+namespace SDF
+{
+	/// \brief A set of settings for the PropagateClosestTriangles function.
+	struct ClosestTrianglePropagationSettings
+	{
+		double TruncationValue{ Geometry::DEFAULT_SCALAR_GRID_INIT_VAL }; //>! distance values are clamped to this value, and closest triangles are only propagated through a band of this width.
+		unsigned int NThreads{ 1 }; //>! the number of worker threads (z-slabs of each pass). NThreads == 0 uses all hardware threads.
+	};
+
+	/**
+	 * \brief An alternative to FastSweep which evaluates exact point-triangle distances in the whole truncation band.
+	 *        The closest triangles of frozen voxels (found in the kd-tree) are propagated to the remaining voxels by a jump-flooding algorithm [Rong & Tan, 2006]
+	 *        with steps 2^k, ..., 2, 1 followed by an extra pass with step 1. Each voxel keeps the triangle closest to its center among those of its 26 neighbors at the current step.
+	 * \param grid        a modifiable input grid with frozen outline voxels (e.g.: from PreprocessGridWithOctree). Non-frozen voxel values are expected to be initialized to settings.TruncationValue.
+	 * \param kdTree      kd-tree of the mesh whose distance field is computed.
+	 * \param settings    settings for this function.
+	 *
+	 * DISCLAIMER: Frozen voxel values are kept. Every other voxel value is a distance to an actual mesh triangle, so it is never below the exact distance,
+	 *             and it differs from the exact distance only where jump flooding fails to deliver the closest triangle (rare, and typically by a fraction of the cell size).
+	 */
+	void PropagateClosestTriangles(Geometry::ScalarGrid& grid, const Geometry::CollisionKdTree& kdTree, const ClosestTrianglePropagationSettings& settings);
+
+	/**
+	 * \brief A single precision variant of PropagateClosestTriangles. The distances are evaluated in double precision and stored as float.
+	 * \param grid        a modifiable input grid with frozen outline voxels.
+	 * \param kdTree      kd-tree of the mesh whose distance field is computed.
+	 * \param settings    settings for this function.
+	 */
+	void PropagateClosestTriangles(Geometry::ScalarGridF& grid, const Geometry::CollisionKdTree& kdTree, const ClosestTrianglePropagationSettings& settings);
+
+} // namespace SDF
@@ -1,154 +1,398 @@
 #include "FastSweep.h"
 
 #include "pmp/BoundingBox.h"
+#include "utils/ParallelUtils.h"
+
+#include <barrier>
+#include <cstdint>
 
 namespace SDF
 {
-	void FastSweep(Geometry::ScalarGrid& grid, const SweepSolverSettings& settings)
+	namespace
 	{
-		const double f = settings.EikonalRHS;
-		assert(grid.CellSize() > 0.0);
-		const auto h = static_cast<double>(grid.CellSize());
-		const unsigned int NSweeps = settings.NSweeps;
+		/// \brief index steps { x, y, z } of each of the 8 sweep orderings (matching the sweep directions of the serial solver).
+		constexpr int SWEEP_STEPS[8][3] = {
+			{ 1, 1, 1 }, { -1, 1, 1 }, { -1, -1, 1 }, { -1, -1, -1 },
+			{ -1, 1, -1 }, { 1, 1, -1 }, { 1, -1, -1 }, { 1, -1, 1 } };
 
-		const auto& dims = grid.Dimensions();
-		auto& gridValues = grid.Values();
-		const auto& gridFrozen = grid.FrozenValues();
-
-		const int Nx = static_cast<int>(dims.Nx);
-		const int Ny = static_cast<int>(dims.Ny);
-		const int Nz = static_cast<int>(dims.Nz);
-
-		// sweep directions { start, end, step }
-		const int dirX[8][3] = {
-			{ 0, Nx - 1, 1 }, { Nx - 1, 0, -1 }, { Nx - 1, 0, -1 }, { Nx - 1, 0, -1 },
-			{ Nx - 1, 0, -1 }, { 0, Nx - 1, 1 }, { 0, Nx - 1, 1 }, { 0, Nx - 1, 1 } };
-		const int dirY[8][3] = {
-			{ 0, Ny - 1, 1 }, { 0, Ny - 1, 1 }, { Ny - 1, 0, -1 }, { Ny - 1, 0, -1 },
-			{ 0, Ny - 1, 1 }, { 0, Ny - 1, 1 }, { Ny - 1, 0, -1 }, { Ny - 1, 0, -1 } };
-		const int dirZ[8][3] = {
-			{ 0, Nz - 1, 1 }, { 0, Nz - 1, 1 }, { 0, Nz - 1, 1 }, { Nz - 1, 0, -1 },
-			{ Nz - 1, 0, -1 }, { Nz - 1, 0, -1 }, { Nz - 1, 0, -1 }, { 0, Nz - 1, 1 } };
-
-		unsigned int s;
-		int ix, iy, iz, gridPos;
-		double aa[3], tmp, eps = 1e-6;
-		double d_curr, d_new, a, b, c, D;
-
-		for (s = 0; s < NSweeps; s++) {
-			// std::cout << "sweep " << s << " ... " << std::endl;
-			for (iz = dirZ[s][0]; dirZ[s][2] * iz <= dirZ[s][1]; iz += dirZ[s][2]) {
-				for (iy = dirY[s][0]; dirY[s][2] * iy <= dirY[s][1]; iy += dirY[s][2]) {
-					for (ix = dirX[s][0]; dirX[s][2] * ix <= dirX[s][1]; ix += dirX[s][2]) {
-
-						gridPos = ((iz * Ny + iy) * Nx + ix);
-						if (gridFrozen[gridPos])
-							continue;
+		/**
+		 * \brief Solves the discretized (upwind Godunov) Eikonal equation for a single voxel.
+		 * \param aa    minimum neighbor values along each axis (will be sorted).
+		 * \param h     cell size.
+		 * \param f     the right-hand side of the Eikonal equation.
+		 * \return the new value estimate of the voxel.
+		 */
+		[[nodiscard]] double SolveUpwindEikonal(double aa[3], const double& h, const double& f)
+		{
+			double tmp;
+			constexpr double eps = 1e-6;
+			double d_curr, d_new, a, b, c, D;
 
-						// === neighboring cells (Upwind Godunov) ===
-						if (iz == 0 || iz == (Nz - 1)) 
-						{
-							if (iz == 0)
-							{
-								aa[2] = gridValues[gridPos] < gridValues[((iz + 1) * Ny + iy) * Nx + ix] ? gridValues[gridPos] : gridValues[((iz + 1) * Ny + iy) * Nx + ix];
-							}
-							if (iz == (Nz - 1)) 
-							{
-								aa[2] = gridValues[((iz - 1) * Ny + iy) * Nx + ix] < gridValues[gridPos] ? gridValues[((iz - 1) * Ny + iy) * Nx + ix] : gridValues[gridPos];
-							}
-						}
-						else 
-						{
-							aa[2] = gridValues[((iz - 1) * Ny + iy) * Nx + ix] < gridValues[((iz + 1) * Ny + iy) * Nx + ix] ? gridValues[((iz - 1) * Ny + iy) * Nx + ix] : gridValues[((iz + 1) * Ny + iy) * Nx + ix];
-						}
+			// simple bubble sort
+			if (aa[0] > aa[1]) { tmp = aa[0]; aa[0] = aa[1]; aa[1] = tmp; }
+			if (aa[1] > aa[2]) { tmp = aa[1]; aa[1] = aa[2]; aa[2] = tmp; }
+			if (aa[0] > aa[1]) { tmp = aa[0]; aa[0] = aa[1]; aa[1] = tmp; }
 
-						if (iy == 0 || iy == (Ny - 1)) 
-						{
-							if (iy == 0)
-							{
-								aa[1] = gridValues[gridPos] < gridValues[(iz * Ny + (iy + 1)) * Nx + ix] ? gridValues[gridPos] : gridValues[(iz * Ny + (iy + 1)) * Nx + ix];
-							}
-							if (iy == (Ny - 1))
-							{
-								aa[1] = gridValues[(iz * Ny + (iy - 1)) * Nx + ix] < gridValues[gridPos] ? gridValues[(iz * Ny + (iy - 1)) * Nx + ix] : gridValues[gridPos];
-							}
-						}
-						else 
-						{
-							aa[1] = gridValues[(iz * Ny + (iy - 1)) * Nx + ix] < gridValues[(iz * Ny + (iy + 1)) * Nx + ix] ? gridValues[(iz * Ny + (iy - 1)) * Nx + ix] : gridValues[(iz * Ny + (iy + 1)) * Nx + ix];
-						}
+			d_curr = aa[0] + h * f; // first estimate
+
+			if (d_curr <= (aa[1] + eps)) // second estimate
+			{
+				d_new = d_curr;
+			}
+			else 
+			{
+				// third estimate
+				a = 2.0; b = -2.0 * (aa[0] + aa[1]);
+				c = aa[0] * aa[0] + aa[1] * aa[1] - h * h * f * f;
+				D = b * b - 4.0 * a * c;
+
+				if (D > 0)
+				{
+					d_curr = (-b + sqrt(D));
+				}
+				else
+				{
+					d_curr = (-b + sqrt(-D));
+				}
+				d_curr /= (2.0 * a);
+
+				if (d_curr <= (aa[2] + eps))
+					d_new = d_curr;
+				else 
+				{
+					a = 3.0;
+					b = -2.0 * (aa[0] + aa[1] + aa[2]);
+					c = aa[0] * aa[0] + aa[1] * aa[1] + aa[2] * aa[2] - h * h * f * f;
+					D = b * b - 4.0 * a * c;
+
+					if (D > 0)
+					{
+						d_new = (-b + sqrt(D));
+					}
+					else
+					{
+						d_new = (-b + sqrt(-D));
+					}
+					d_new /= (2.0 * a);
+				}
+			}
+
+			return d_new;
+		}
+
+		/**
+		 * \brief Updates the value of a single (non-frozen) voxel from its upwind neighbors.
+		 * \param gridValues    values of the solved grid.
+		 * \param ix, iy, iz    voxel index.
+		 * \param Nx, Ny, Nz    grid dimensions.
+		 * \param h             cell size.
+		 * \param f             the right-hand side of the Eikonal equation.
+		 *
+		 * DISCLAIMER: The update is evaluated in double precision regardless of the grid's value type T.
+		 */
+		template <typename T>
+		void UpdateVoxelValue(std::vector<T>& gridValues, 
+			const int64_t& ix, const int64_t& iy, const int64_t& iz, 
+			const int64_t& Nx, const int64_t& Ny, const int64_t& Nz, 
+			const double& h, const double& f)
+		{
+			const int64_t gridPos = ((iz * Ny + iy) * Nx + ix);
+			double aa[3];
+
+			// === neighboring cells (Upwind Godunov) ===
+			if (iz == 0 || iz == (Nz - 1)) 
+			{
+				if (iz == 0)
+				{
+					aa[2] = gridValues[gridPos] < gridValues[((iz + 1) * Ny + iy) * Nx + ix] ? gridValues[gridPos] : gridValues[((iz + 1) * Ny + iy) * Nx + ix];
+				}
+				if (iz == (Nz - 1)) 
+				{
+					aa[2] = gridValues[((iz - 1) * Ny + iy) * Nx + ix] < gridValues[gridPos] ? gridValues[((iz - 1) * Ny + iy) * Nx + ix] : gridValues[gridPos];
+				}
+			}
+			else 
+			{
+				aa[2] = gridValues[((iz - 1) * Ny + iy) * Nx + ix] < gridValues[((iz + 1) * Ny + iy) * Nx + ix] ? gridValues[((iz - 1) * Ny + iy) * Nx + ix] : gridValues[((iz + 1) * Ny + iy) * Nx + ix];
+			}
+
+			if (iy == 0 || iy == (Ny - 1)) 
+			{
+				if (iy == 0)
+				{
+					aa[1] = gridValues[gridPos] < gridValues[(iz * Ny + (iy + 1)) * Nx + ix] ? gridValues[gridPos] : gridValues[(iz * Ny + (iy + 1)) * Nx + ix];
+				}
+				if (iy == (Ny - 1))
+				{
+					aa[1] = gridValues[(iz * Ny + (iy - 1)) * Nx + ix] < gridValues[gridPos] ? gridValues[(iz * Ny + (iy - 1)) * Nx + ix] : gridValues[gridPos];
+				}
+			}
+			else 
+			{
+				aa[1] = gridValues[(iz * Ny + (iy - 1)) * Nx + ix] < gridValues[(iz * Ny + (iy + 1)) * Nx + ix] ? gridValues[(iz * Ny + (iy - 1)) * Nx + ix] : gridValues[(iz * Ny + (iy + 1)) * Nx + ix];
+			}
+
+			if (ix == 0 || ix == (Nx - 1)) 
+			{
+				if (ix == 0) 
+				{
+					aa[0] = gridValues[gridPos] < gridValues[(iz * Ny + iy) * Nx + (ix + 1)] ? gridValues[gridPos] : gridValues[(iz * Ny + iy) * Nx + (ix + 1)];
+				}
+				if (ix == (Nx - 1))
+				{
+					aa[0] = gridValues[(iz * Ny + iy) * Nx + (ix - 1)] < gridValues[gridPos] ? gridValues[(iz * Ny + iy) * Nx + (ix - 1)] : gridValues[gridPos];
+				}
+			}
+			else 
+			{
+				aa[0] = gridValues[(iz * Ny + iy) * Nx + (ix - 1)] < gridValues[(iz * Ny + iy) * Nx + (ix + 1)] ? gridValues[(iz * Ny + iy) * Nx + (ix - 1)] : gridValues[(iz * Ny + iy) * Nx + (ix + 1)];
+			}
+
+			const double d_new = SolveUpwindEikonal(aa, h, f);
+
+			if (gridValues[gridPos] >= d_new)
+				gridValues[gridPos] = static_cast<T>(d_new);
+		}
+
+		/**
+		 * \brief A parallel version of the fast sweeping solver. Voxels of each sweep are visited along hyperplanes ix + iy + iz = const (in sweep-ordered indices).
+		 *        Since all upwind neighbors of a voxel lie on the previous hyperplane, voxels of one hyperplane are mutually independent, and can be updated concurrently.
+		 * \param grid        a modifiable input grid with proper initial condition setup.
+		 * \param settings    settings for this solver function.
+		 * \param nThreads    number of worker threads (> 1).
+		 *
+		 * DISCLAIMER: Each voxel reads the same neighbor values as in the serial Gauss-Seidel sweep, so the result matches the serial FastSweep.
+		 */
+		template <typename T>
+		void FastSweepWavefront(Geometry::BasicScalarGrid<T>& grid, const SweepSolverSettings& settings, const unsigned int& nThreads)
+		{
+			const double f = settings.EikonalRHS;
+			const auto h = static_cast<double>(grid.CellSize());
+			const unsigned int NSweeps = settings.NSweeps;
 
-						if (ix == 0 || ix == (Nx - 1)) 
+			const auto& dims = grid.Dimensions();
+			auto& gridValues = grid.Values();
+			const auto& gridFrozen = grid.FrozenValues();
+
+			const auto Nx = static_cast<int64_t>(dims.Nx);
+			const auto Ny = static_cast<int64_t>(dims.Ny);
+			const auto Nz = static_cast<int64_t>(dims.Nz);
+			const int64_t nLevels = (Nx - 1) + (Ny - 1) + (Nz - 1) + 1;
+			const auto nWorkers = static_cast<int64_t>(nThreads);
+
+			std::barrier levelSync(static_cast<std::ptrdiff_t>(nThreads));
+
+			const auto sweepWorker = [&](const int64_t workerId)
+			{
+				for (unsigned int s = 0; s < NSweeps; s++)
+				{
+					const int stepX = SWEEP_STEPS[s][0];
+					const int stepY = SWEEP_STEPS[s][1];
+					const int stepZ = SWEEP_STEPS[s][2];
+
+					for (int64_t level = 0; level < nLevels; level++)
+					{
+						// sweep-ordered z-index range intersecting this hyperplane
+						const int64_t izoMin = std::max<int64_t>(0, level - (Nx - 1) - (Ny - 1));
+						const int64_t izoMax = std::min(Nz - 1, level);
+
+						for (int64_t izo = izoMin + workerId; izo <= izoMax; izo += nWorkers)
 						{
-							if (ix == 0) 
-							{
-								aa[0] = gridValues[gridPos] < gridValues[(iz * Ny + iy) * Nx + (ix + 1)] ? gridValues[gridPos] : gridValues[(iz * Ny + iy) * Nx + (ix + 1)];
-							}
-							if (ix == (Nx - 1))
+							const int64_t iz = (stepZ > 0 ? izo : Nz - 1 - izo);
+							const int64_t iyoMin = std::max<int64_t>(0, level - izo - (Nx - 1));
+							const int64_t iyoMax = std::min(Ny - 1, level - izo);
+
+							for (int64_t iyo = iyoMin; iyo <= iyoMax; iyo++)
 							{
-								aa[0] = gridValues[(iz * Ny + iy) * Nx + (ix - 1)] < gridValues[gridPos] ? gridValues[(iz * Ny + iy) * Nx + (ix - 1)] : gridValues[gridPos];
+								const int64_t ixo = level - izo - iyo;
+								const int64_t iy = (stepY > 0 ? iyo : Ny - 1 - iyo);
+								const int64_t ix = (stepX > 0 ? ixo : Nx - 1 - ixo);
+
+								if (gridFrozen[(iz * Ny + iy) * Nx + ix])
+									continue;
+
+								UpdateVoxelValue(gridValues, ix, iy, iz, Nx, Ny, Nz, h, f);
 							}
 						}
-						else 
-						{
-							aa[0] = gridValues[(iz * Ny + iy) * Nx + (ix - 1)] < gridValues[(iz * Ny + iy) * Nx + (ix + 1)] ? gridValues[(iz * Ny + iy) * Nx + (ix - 1)] : gridValues[(iz * Ny + iy) * Nx + (ix + 1)];
-						}
 
-						// simple bubble sort
-						if (aa[0] > aa[1]) { tmp = aa[0]; aa[0] = aa[1]; aa[1] = tmp; }
-						if (aa[1] > aa[2]) { tmp = aa[1]; aa[1] = aa[2]; aa[2] = tmp; }
-						if (aa[0] > aa[1]) { tmp = aa[0]; aa[0] = aa[1]; aa[1] = tmp; }
+						// the next hyperplane depends on the values of this one
+						levelSync.arrive_and_wait();
+					}
+				}
+			};
 
-						d_curr = aa[0] + h * f; // first estimate
+			std::vector<std::thread> threads(nThreads);
+			for (int64_t i = 0; i < nWorkers; ++i)
+			{
+				threads[i] = std::thread(sweepWorker, i);
+			}
 
-						if (d_curr <= (aa[1] + eps)) // second estimate
-						{
-							d_new = d_curr;
+			// Wait for all threads to finish
+			for (auto& t : threads) {
+				t.join();
+			}
+		}
+
+		/**
+		 * \brief Updates the value of a single (non-frozen) voxel of a sparse grid from its upwind neighbors.
+		 * \param grid          solved sparse grid.
+		 * \param ix, iy, iz    voxel index.
+		 * \param h             cell size.
+		 * \param f             the right-hand side of the Eikonal equation.
+		 */
+		void UpdateSparseVoxelValue(Geometry::SparseScalarGrid& grid,
+			const size_t& ix, const size_t& iy, const size_t& iz,
+			const double& h, const double& f)
+		{
+			const auto& [Nx, Ny, Nz] = grid.Dimensions();
+			const double currentValue = grid.Value(ix, iy, iz);
+			double aa[3];
+
+			// === neighboring cells (Upwind Godunov) ===
+			const double zPrev = (iz > 0 ? grid.Value(ix, iy, iz - 1) : currentValue);
+			const double zNext = (iz < Nz - 1 ? grid.Value(ix, iy, iz + 1) : currentValue);
+			aa[2] = zPrev < zNext ? zPrev : zNext;
+
+			const double yPrev = (iy > 0 ? grid.Value(ix, iy - 1, iz) : currentValue);
+			const double yNext = (iy < Ny - 1 ? grid.Value(ix, iy + 1, iz) : currentValue);
+			aa[1] = yPrev < yNext ? yPrev : yNext;
+
+			const double xPrev = (ix > 0 ? grid.Value(ix - 1, iy, iz) : currentValue);
+			const double xNext = (ix < Nx - 1 ? grid.Value(ix + 1, iy, iz) : currentValue);
+			aa[0] = xPrev < xNext ? xPrev : xNext;
+
+			const double d_new = SolveUpwindEikonal(aa, h, f);
+
+			if (currentValue >= d_new)
+				grid.SetValue(ix, iy, iz, d_new);
+		}
+
+		/**
+		 * \brief The fast sweeping solver for a dense grid of value type T.
+		 * \param grid        a modifiable input grid with proper initial condition setup.
+		 * \param settings    settings for this solver function.
+		 */
+		template <typename T>
+		void FastSweepInternal(Geometry::BasicScalarGrid<T>& grid, const SweepSolverSettings& settings)
+		{
+			assert(grid.CellSize() > 0.0);
+			assert(settings.NSweeps <= 8);
+
+			const unsigned int nThreads = Utils::GetWorkerThreadCount(settings.NThreads);
+			if (nThreads > 1)
+			{
+				FastSweepWavefront(grid, settings, nThreads);
+				return;
+			}
+
+			const double f = settings.EikonalRHS;
+			const auto h = static_cast<double>(grid.CellSize());
+			const unsigned int NSweeps = settings.NSweeps;
+
+			const auto& dims = grid.Dimensions();
+			auto& gridValues = grid.Values();
+			const auto& gridFrozen = grid.FrozenValues();
+
+			const auto Nx = static_cast<int64_t>(dims.Nx);
+			const auto Ny = static_cast<int64_t>(dims.Ny);
+			const auto Nz = static_cast<int64_t>(dims.Nz);
+
+			// sweep directions { start, end, step }
+			const int64_t dirX[8][3] = {
+				{ 0, Nx - 1, 1 }, { Nx - 1, 0, -1 }, { Nx - 1, 0, -1 }, { Nx - 1, 0, -1 },
+				{ Nx - 1, 0, -1 }, { 0, Nx - 1, 1 }, { 0, Nx - 1, 1 }, { 0, Nx - 1, 1 } };
+			const int64_t dirY[8][3] = {
+				{ 0, Ny - 1, 1 }, { 0, Ny - 1, 1 }, { Ny - 1, 0, -1 }, { Ny - 1, 0, -1 },
+				{ 0, Ny - 1, 1 }, { 0, Ny - 1, 1 }, { Ny - 1, 0, -1 }, { Ny - 1, 0, -1 } };
+			const int64_t dirZ[8][3] = {
+				{ 0, Nz - 1, 1 }, { 0, Nz - 1, 1 }, { 0, Nz - 1, 1 }, { Nz - 1, 0, -1 },
+				{ Nz - 1, 0, -1 }, { Nz - 1, 0, -1 }, { Nz - 1, 0, -1 }, { 0, Nz - 1, 1 } };
+
+			unsigned int s;
+			int64_t ix, iy, iz, gridPos;
+
+			for (s = 0; s < NSweeps; s++) {
+				// std::cout << "sweep " << s << " ... " << std::endl;
+				for (iz = dirZ[s][0]; dirZ[s][2] * iz <= dirZ[s][1]; iz += dirZ[s][2]) {
+					for (iy = dirY[s][0]; dirY[s][2] * iy <= dirY[s][1]; iy += dirY[s][2]) {
+						for (ix = dirX[s][0]; dirX[s][2] * ix <= dirX[s][1]; ix += dirX[s][2]) {
+
+							gridPos = ((iz * Ny + iy) * Nx + ix);
+							if (gridFrozen[gridPos])
+								continue;
+
+							UpdateVoxelValue(gridValues, ix, iy, iz, Nx, Ny, Nz, h, f);
 						}
-						else 
-						{
-							// third estimate
-							a = 2.0; b = -2.0 * (aa[0] + aa[1]);
-							c = aa[0] * aa[0] + aa[1] * aa[1] - h * h * f * f;
-							D = b * b - 4.0 * a * c;
+					}
+				}
+			}
 
-							if (D > 0)
-							{
-								d_curr = (-b + sqrt(D));
-							}
-							else
-							{
-								d_curr = (-b + sqrt(-D));
-							}
-							d_curr /= (2.0 * a);
+		}
 
-							if (d_curr <= (aa[2] + eps))
-								d_new = d_curr;
-							else 
-							{
-								a = 3.0;
-								b = -2.0 * (aa[0] + aa[1] + aa[2]);
-								c = aa[0] * aa[0] + aa[1] * aa[1] + aa[2] * aa[2] - h * h * f * f;
-								D = b * b - 4.0 * a * c;
-
-								if (D > 0)
-								{
-									d_new = (-b + sqrt(D));
-								}
-								else
-								{
-									d_new = (-b + sqrt(-D));
+	} // anonymous namespace
+
+	void FastSweep(Geometry::ScalarGrid& grid, const SweepSolverSettings& settings)
+	{
+		FastSweepInternal(grid, settings);
+	}
+
+	void FastSweep(Geometry::ScalarGridF& grid, const SweepSolverSettings& settings)
+	{
+		FastSweepInternal(grid, settings);
+	}
+
+	void FastSweep(Geometry::SparseScalarGrid& grid, const SweepSolverSettings& settings)
+	{
+		assert(grid.CellSize() > 0.0);
+		assert(settings.NSweeps <= 8);
+
+		const double f = settings.EikonalRHS;
+		const auto h = static_cast<double>(grid.CellSize());
+		const unsigned int NSweeps = settings.NSweeps;
+
+		const auto& [Nx, Ny, Nz] = grid.Dimensions();
+		const auto& [NBx, NBy, NBz] = grid.BlockDimensions();
+
+		// maps a sweep-ordered index to a grid index
+		const auto orderedIndex = [](const size_t& io, const size_t& n, const int& step) { return step > 0 ? io : n - 1 - io; };
+
+		for (unsigned int s = 0; s < NSweeps; s++)
+		{
+			const int stepX = SWEEP_STEPS[s][0];
+			const int stepY = SWEEP_STEPS[s][1];
+			const int stepZ = SWEEP_STEPS[s][2];
+
+			// blocks are visited in sweep order, and so are the voxels within each block.
+			for (size_t bzo = 0; bzo < NBz; bzo++) {
+				const size_t bz = orderedIndex(bzo, NBz, stepZ);
+				for (size_t byo = 0; byo < NBy; byo++) {
+					const size_t by = orderedIndex(byo, NBy, stepY);
+					for (size_t bxo = 0; bxo < NBx; bxo++) {
+						const size_t bx = orderedIndex(bxo, NBx, stepX);
+						if (!grid.IsBlockAllocated(bx, by, bz))
+							continue;
+
+						const size_t nVoxZ = std::min(Geometry::SPARSE_BLOCK_DIM, Nz - bz * Geometry::SPARSE_BLOCK_DIM);
+						const size_t nVoxY = std::min(Geometry::SPARSE_BLOCK_DIM, Ny - by * Geometry::SPARSE_BLOCK_DIM);
+						const size_t nVoxX = std::min(Geometry::SPARSE_BLOCK_DIM, Nx - bx * Geometry::SPARSE_BLOCK_DIM);
+
+						for (size_t lzo = 0; lzo < nVoxZ; lzo++) {
+							const size_t iz = bz * Geometry::SPARSE_BLOCK_DIM + orderedIndex(lzo, nVoxZ, stepZ);
+							for (size_t lyo = 0; lyo < nVoxY; lyo++) {
+								const size_t iy = by * Geometry::SPARSE_BLOCK_DIM + orderedIndex(lyo, nVoxY, stepY);
+								for (size_t lxo = 0; lxo < nVoxX; lxo++) {
+									const size_t ix = bx * Geometry::SPARSE_BLOCK_DIM + orderedIndex(lxo, nVoxX, stepX);
+
+									if (grid.IsFrozen(ix, iy, iz))
+										continue;
+
+									UpdateSparseVoxelValue(grid, ix, iy, iz, h, f);
 								}
-								d_new /= (2.0 * a);
 							}
 						}
-
-						if (gridValues[gridPos] >= d_new)
-							gridValues[gridPos] = d_new;						
 					}
 				}
 			}
 		}
-
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "geometry/Grid.h"
+#include "geometry/SparseGrid.h"
 
 namespace SDF
 {
@@ -9,13 +10,33 @@ namespace SDF
 	{
 		unsigned int NSweeps{ 8 }; //>! the number of sweeps for the solver.
 		double EikonalRHS{ 1.0 }; //>! the right-hand side f of the Eikonal equation ||grad(u)|| = f.
+		unsigned int NThreads{ 1 }; //>! the number of worker threads. For NThreads != 1 the voxels are swept in parallel along hyperplanes ix + iy + iz = const. NThreads == 0 uses all hardware threads.
 	};
 
 	/**
 	 * \brief A utility for solving the Eikonal equation using the Fast-Sweeping algorithm [Zhao, 2005].
 	 * \param grid        a modifiable input grid with proper initial condition setup.
 	 * \param settings    settings for this solver function.
+	 *
+	 * DISCLAIMER: The parallel (hyperplane) sweep visits the voxels in a different order, but each voxel is updated from the same upwind neighbor values as in the serial sweep.
 	 */
 	void FastSweep(Geometry::ScalarGrid& grid, const SweepSolverSettings& settings);
 
+	/**
+	 * \brief A single precision variant of FastSweep. The voxel updates are evaluated in double precision and stored as float.
+	 * \param grid        a modifiable input grid with proper initial condition setup.
+	 * \param settings    settings for this solver function.
+	 */
+	void FastSweep(Geometry::ScalarGridF& grid, const SweepSolverSettings& settings);
+
+	/**
+	 * \brief A utility for solving the Eikonal equation on a sparse (narrow-band) grid using the Fast-Sweeping algorithm [Zhao, 2005].
+	 * \param grid        a modifiable input sparse grid with proper initial condition setup. Only voxels of allocated blocks are updated.
+	 * \param settings    settings for this solver function.
+	 *
+	 * DISCLAIMER: Allocated blocks are swept block-by-block in the sweep direction, and voxels of unallocated blocks act as fixed boundary values
+	 *             (background value). The sparse sweep is single-threaded, i.e.: settings.NThreads is ignored.
+	 */
+	void FastSweep(Geometry::SparseScalarGrid& grid, const SweepSolverSettings& settings);
+
 } // namespace SDF
\ No newline at end of file
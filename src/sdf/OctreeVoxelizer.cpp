@@ -3,6 +3,7 @@
 #include <stack>
 
 #include "geometry/GeometryUtil.h"
+#include "utils/ParallelUtils.h"
 
 
 namespace SDF
@@ -47,14 +48,22 @@ namespace SDF
 		return { cubeBoxMin, cubeBoxMax };
 	}
 
-	OctreeVoxelizer::OctreeVoxelizer(const Geometry::CollisionKdTree& kdTree, const pmp::BoundingBox& startBox, const float& targetLeafSize)
+	OctreeVoxelizer::OctreeVoxelizer(const Geometry::CollisionKdTree& kdTree, const pmp::BoundingBox& startBox, const float& targetLeafSize, const unsigned int& nThreads)
 		: m_KdTree(kdTree), m_LeafSize(targetLeafSize)
 	{
 		m_Root = new Node(this);
 		m_NodeCount++;
 
 		const auto cubeBox = ComputeCubeBoxFromTargetLeafSize(startBox, targetLeafSize);
-		BuildRecurse(m_Root, cubeBox, MAX_OCTREE_DEPTH);
+		const unsigned int nWorkers = Utils::GetWorkerThreadCount(nThreads);
+		if (nWorkers > 1)
+		{
+			BuildParallel(cubeBox, nWorkers);
+			return;
+		}
+
+		std::vector<unsigned int> triangleIdBuffer{};
+		BuildRecurse(m_Root, cubeBox, MAX_OCTREE_DEPTH, triangleIdBuffer, m_NodeCount);
 	}
 
 	// ======================== Helper macros for Octree subdivision ======================
@@ -69,45 +78,37 @@ namespace SDF
 			b.max()[1] = B.min()[1] + (static_cast<float>(j + 1) / 2.0f) * (size);	\
 			b.max()[2] = B.min()[2] + (static_cast<float>(k + 1) / 2.0f) * (size)
 
-	void OctreeVoxelizer::BuildRecurse(Node* node, const pmp::BoundingBox& box, unsigned int remainingDepth)
+	bool OctreeVoxelizer::IsLeafBox(const pmp::BoundingBox& box, const unsigned int& remainingDepth) const
 	{
-		assert(!box.is_empty());
-		node->cubeBox = box;
-
 		const float boxSize = box.max()[0] - box.min()[0];
+		return remainingDepth == 0 || boxSize < m_LeafSize + LEAF_SIZE_EPSILON;
+	}
 
-		if (remainingDepth == 0 || boxSize < m_LeafSize + LEAF_SIZE_EPSILON)
-		{
-			// ============  process a leaf node ==================
-
-			std::vector<unsigned int> voxelTriangleIds{};
-			m_KdTree.GetTrianglesInABox(box, voxelTriangleIds);
-			const auto center = box.center();
-
-			assert(!voxelTriangleIds.empty());
+	void OctreeVoxelizer::ProcessLeaf(Node* node, std::vector<unsigned int>& triangleIdBuffer) const
+	{
+		triangleIdBuffer.clear();
+		m_KdTree.GetTrianglesInABox(node->cubeBox, triangleIdBuffer);
+		const auto center = node->cubeBox.center();
 
-			const auto& vertexPositions = m_KdTree.VertexPositions();
-			const auto& triangles = m_KdTree.TriVertexIds();
+		assert(!triangleIdBuffer.empty());
 
-			double distToTriSq = DBL_MAX;
-			std::vector triangle{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
-			for (const auto& triId : voxelTriangleIds)
-			{
-				triangle[0] = vertexPositions[triangles[triId].v0Id];
-				triangle[1] = vertexPositions[triangles[triId].v1Id];
-				triangle[2] = vertexPositions[triangles[triId].v2Id];
+		const auto& triangleData = m_KdTree.TriangleVertexData();
 
-				const double currentTriDistSq = Geometry::GetDistanceToTriangleSq(triangle, center);
+		double distToTriSq = DBL_MAX;
+		for (const auto& triId : triangleIdBuffer)
+		{
+			const double currentTriDistSq = Geometry::GetDistanceToTriangleSq(triangleData, triId, center);
 
-				if (currentTriDistSq < distToTriSq)
-					distToTriSq = currentTriDistSq;
-			}
-			assert(distToTriSq < DBL_MAX);
-			node->distanceVal = sqrt(distToTriSq);
-			return;
+			if (currentTriDistSq < distToTriSq)
+				distToTriSq = currentTriDistSq;
 		}
+		assert(distToTriSq < DBL_MAX);
+		node->distanceVal = sqrt(distToTriSq);
+	}
 
-		// ============ subdivide a non-leaf node ===============
+	void OctreeVoxelizer::Subdivide(Node* node, const pmp::BoundingBox& box, const unsigned int& remainingDepth, std::vector<BuildTask>& childTasks, size_t& nodeCount)
+	{
+		const float boxSize = box.max()[0] - box.min()[0];
 
 		node->children.reserve(MAX_OCTREE_CHILDREN);
 		pmp::BoundingBox childBox{};
@@ -124,14 +125,72 @@ namespace SDF
 						continue;
 
 					node->children.emplace_back(new Node(this));
-					m_NodeCount++;
-					BuildRecurse(node->children[node->children.size() - 1], childBox, remainingDepth - 1);
+					nodeCount++;
+					childTasks.push_back({ node->children[node->children.size() - 1], childBox, remainingDepth - 1 });
 				}
 			}
 		}
 		node->children.shrink_to_fit();
 	}
 
+	void OctreeVoxelizer::BuildRecurse(Node* node, const pmp::BoundingBox& box, unsigned int remainingDepth, std::vector<unsigned int>& triangleIdBuffer, size_t& nodeCount)
+	{
+		assert(!box.is_empty());
+		node->cubeBox = box;
+
+		if (IsLeafBox(box, remainingDepth))
+		{
+			// ============  process a leaf node ==================
+			ProcessLeaf(node, triangleIdBuffer);
+			return;
+		}
+
+		// ============ subdivide a non-leaf node ===============
+
+		std::vector<BuildTask> childTasks{};
+		childTasks.reserve(MAX_OCTREE_CHILDREN);
+		Subdivide(node, box, remainingDepth, childTasks, nodeCount);
+		for (const auto& task : childTasks)
+			BuildRecurse(task.node, task.box, task.remainingDepth, triangleIdBuffer, nodeCount);
+	}
+
+	void OctreeVoxelizer::BuildParallel(const pmp::BoundingBox& cubeBox, const unsigned int& nThreads)
+	{
+		// expand the top levels serially until there are enough independent subtrees for all threads
+		std::vector<unsigned int> triangleIdBuffer{};
+		std::vector<BuildTask> tasks{ { m_Root, cubeBox, static_cast<unsigned int>(MAX_OCTREE_DEPTH) } };
+		const size_t minSubtreeCount = OCTREE_SUBTREES_PER_THREAD * nThreads;
+		while (!tasks.empty() && tasks.size() < minSubtreeCount)
+		{
+			std::vector<BuildTask> nextTasks{};
+			nextTasks.reserve(MAX_OCTREE_CHILDREN * tasks.size());
+			for (const auto& task : tasks)
+			{
+				assert(!task.box.is_empty());
+				task.node->cubeBox = task.box;
+				if (IsLeafBox(task.box, task.remainingDepth))
+				{
+					ProcessLeaf(task.node, triangleIdBuffer);
+					continue;
+				}
+				Subdivide(task.node, task.box, task.remainingDepth, nextTasks, m_NodeCount);
+			}
+			tasks = std::move(nextTasks);
+		}
+
+		// build the subtrees, each thread with its own query buffer and node counter
+		std::vector<std::vector<unsigned int>> threadTriangleIdBuffers(nThreads);
+		std::vector<size_t> threadNodeCounts(nThreads, 0);
+		Utils::ParallelForEachIndex(0, tasks.size(), nThreads, [&](const size_t taskId, const unsigned int threadId)
+		{
+			const auto& task = tasks[taskId];
+			BuildRecurse(task.node, task.box, task.remainingDepth, threadTriangleIdBuffers[threadId], threadNodeCounts[threadId]);
+		});
+
+		for (const auto& nodeCount : threadNodeCounts)
+			m_NodeCount += nodeCount;
+	}
+
 	void OctreeVoxelizer::GetLeafBoxesAndValues(std::vector<pmp::BoundingBox*>& boxBuffer, std::vector<double>& valueBuffer) const
 	{
 		assert(boxBuffer.empty() && valueBuffer.empty());
@@ -15,6 +15,9 @@ namespace SDF
 	//! \brief tolerance for leaf size verification.
 	constexpr float LEAF_SIZE_EPSILON = 1e-5f;
 
+	//! \brief the number of independent subtrees per worker thread, to be expanded serially before a parallel octree build.
+	constexpr size_t OCTREE_SUBTREES_PER_THREAD = 8;
+
 	//! \brief An Octree for generating a "voxel outline" of a mesh using its KD-tree.
 	class OctreeVoxelizer
 	{
@@ -24,8 +27,11 @@ namespace SDF
 		 * \param kdTree            a non-null collision kd-tree to be used for intersection queries.
 		 * \param startBox          starting box, will be converted to a cube centered at the original box center.
 		 * \param targetLeafSize    the leaf size preference for this octree. This value will become the voxel size.
+		 * \param nThreads          the number of worker threads building the octree's subtrees. Zero means "use all hardware threads".
+		 *
+		 * DISCLAIMER: The parallel build produces the same tree (including the order of children) as the serial build.
 		 */
-		OctreeVoxelizer(const Geometry::CollisionKdTree& kdTree, const pmp::BoundingBox& startBox, const float& targetLeafSize);
+		OctreeVoxelizer(const Geometry::CollisionKdTree& kdTree, const pmp::BoundingBox& startBox, const float& targetLeafSize, const unsigned int& nThreads = 1);
 
 		/**
 		 * \brief Collects leaf nodes' (cube) boxes and the distance values stored in the leaf nodes themselves.
@@ -73,13 +79,50 @@ namespace SDF
 			OctreeVoxelizer* octreeEnvironment{ nullptr };
 		};
 
+		/// \brief a node to be initialized with its box and remaining depth.
+		struct BuildTask
+		{
+			Node* node{ nullptr };
+			pmp::BoundingBox box{};
+			unsigned int remainingDepth{ 0 };
+		};
+
+		/// \brief verifies whether a node with given box and remaining depth is to become a leaf.
+		[[nodiscard]] bool IsLeafBox(const pmp::BoundingBox& box, const unsigned int& remainingDepth) const;
+
 		/**
-		 * \brief The recursive part of building this Octree.
-		 * \param node             node to be initialized.
-		 * \param box              bounding box of the node to be initialized.
+		 * \brief Computes the distance value of a leaf node from its box center to the nearest triangle intersecting its box.
+		 * \param node                leaf node with initialized cubeBox.
+		 * \param triangleIdBuffer    reusable buffer for triangle ids.
+		 */
+		void ProcessLeaf(Node* node, std::vector<unsigned int>& triangleIdBuffer) const;
+
+		/**
+		 * \brief Creates the children of a non-leaf node whose boxes intersect a triangle.
+		 * \param node             subdivided node.
+		 * \param box              bounding box of the subdivided node.
 		 * \param remainingDepth   depth remaining for node construction.
+		 * \param childTasks       buffer to which the children's build tasks are appended.
+		 * \param nodeCount        node counter to be incremented.
+		 */
+		void Subdivide(Node* node, const pmp::BoundingBox& box, const unsigned int& remainingDepth, std::vector<BuildTask>& childTasks, size_t& nodeCount);
+
+		/**
+		 * \brief The recursive part of building this Octree.
+		 * \param node               node to be initialized.
+		 * \param box                bounding box of the node to be initialized.
+		 * \param remainingDepth     depth remaining for node construction.
+		 * \param triangleIdBuffer   reusable buffer for leaf triangle queries.
+		 * \param nodeCount          node counter to be incremented.
+		 */
+		void BuildRecurse(Node* node, const pmp::BoundingBox& box, unsigned int remainingDepth, std::vector<unsigned int>& triangleIdBuffer, size_t& nodeCount);
+
+		/**
+		 * \brief Builds this Octree by expanding its top levels serially, and building the resulting subtrees on nThreads worker threads.
+		 * \param cubeBox     root box.
+		 * \param nThreads    number of worker threads (> 1).
 		 */
-		void BuildRecurse(Node* node, const pmp::BoundingBox& box, unsigned int remainingDepth);
+		void BuildParallel(const pmp::BoundingBox& cubeBox, const unsigned int& nThreads);
 
 		// =====================================================================
 
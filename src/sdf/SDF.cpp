@@ -2,88 +2,103 @@
 
 #include "geometry/GeometryUtil.h"
 #include "geometry/GridUtil.h"
+#include "geometry/VoxelBitMask.h"
 
+#include "ClosestTrianglePropagation.h"
 #include "FastSweep.h"
 #include "OctreeVoxelizer.h"
 #include "pmp/algorithms/HoleFilling.h"
+#include "utils/ParallelUtils.h"
 
+#include <nanoflann.hpp>
+
+#include <algorithm>
+#include <optional>
 #include <stack>
-#include <nmmintrin.h>
 
 namespace SDF
 {
-	void DistanceFieldGenerator::PreprocessGridNoOctree(Geometry::ScalarGrid& grid)
+	/// \brief ray-triangle hits closer than this to a voxel's ray start point are not counted (matches the Moller-Trumbore test tolerance).
+	constexpr float RAY_HIT_PARAM_EPSILON = 1e-6f;
+
+	template <typename T>
+	void DistanceFieldGenerator::PreprocessGridNoOctree(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) const
 	{
 		assert(m_KdTree);
 		auto& gridVals = grid.Values();
 		auto& gridFrozenVals = grid.FrozenValues();
-		const auto& vertexPositions = m_KdTree->VertexPositions();
-		const auto& triangles = m_KdTree->TriVertexIds();
 
 		const auto& dims = grid.Dimensions();
 		const auto& orig = grid.Box().min();
 		const float cellSize = grid.CellSize();
 
-		std::vector triangle{ pmp::vec3(), pmp::vec3(), pmp::vec3() };
-		pmp::vec3 voxelCenter, voxelMin, voxelMax;
+		// a triangle intersecting a voxel is closer to the voxel's center than half of the voxel's diagonal (< cellSize).
+		const auto maxOutlineDistance = static_cast<double>(cellSize);
+
+		// frozen flags are bit-packed, so each thread collects its outline voxels, and the flags are set after all threads finish.
+		const unsigned int nWorkers = Utils::GetWorkerThreadCount(nThreads);
+		std::vector<std::vector<size_t>> threadOutlineVoxelIds(nWorkers);
 
-		for (unsigned int iz = 0; iz < dims.Nz; iz++)
+		Utils::ParallelForChunks(0, dims.Nz, nWorkers, [&](const size_t izStart, const size_t izEnd, const unsigned int threadId)
 		{
-			for (unsigned int iy = 0; iy < dims.Ny; iy++)
+			auto& outlineVoxelIds = threadOutlineVoxelIds[threadId];
+			std::vector<pmp::vec3> outlineVoxelCenters{};
+			pmp::vec3 voxelCenter, voxelMin, voxelMax;
+
+			for (size_t iz = izStart; iz < izEnd; iz++)
 			{
-				for (unsigned int ix = 0; ix < dims.Nx; ix++)
+				for (size_t iy = 0; iy < dims.Ny; iy++)
 				{
-					voxelCenter[0] = orig[0] + (static_cast<float>(ix) + 0.5f) * cellSize;
-					voxelCenter[1] = orig[1] + (static_cast<float>(iy) + 0.5f) * cellSize;
-					voxelCenter[2] = orig[2] + (static_cast<float>(iz) + 0.5f) * cellSize;
-
-					voxelMin[0] = voxelCenter[0] - 0.5f * cellSize;
-					voxelMin[1] = voxelCenter[1] - 0.5f * cellSize;
-					voxelMin[2] = voxelCenter[2] - 0.5f * cellSize;
-
-					voxelMax[0] = voxelCenter[0] + 0.5f * cellSize;
-					voxelMax[1] = voxelCenter[1] + 0.5f * cellSize;
-					voxelMax[2] = voxelCenter[2] + 0.5f * cellSize;
-
-					const pmp::BoundingBox voxelBox{ voxelMin , voxelMax };
-					std::vector<unsigned int> voxelTriangleIds{};
-					m_KdTree->GetTrianglesInABox(voxelBox, voxelTriangleIds);
-
-					if (voxelTriangleIds.empty())
-						continue; // no triangles found
-
-					double distToTriSq = DBL_MAX;
-
-					for (const auto& triId : voxelTriangleIds)
+					for (size_t ix = 0; ix < dims.Nx; ix++)
 					{
-						triangle[0] = vertexPositions[triangles[triId].v0Id];
-						triangle[1] = vertexPositions[triangles[triId].v1Id];
-						triangle[2] = vertexPositions[triangles[triId].v2Id];
+						voxelCenter[0] = orig[0] + (static_cast<float>(ix) + 0.5f) * cellSize;
+						voxelCenter[1] = orig[1] + (static_cast<float>(iy) + 0.5f) * cellSize;
+						voxelCenter[2] = orig[2] + (static_cast<float>(iz) + 0.5f) * cellSize;
 
-						const double currentTriDistSq = Geometry::GetDistanceToTriangleSq(triangle, voxelCenter);
+						voxelMin[0] = voxelCenter[0] - 0.5f * cellSize;
+						voxelMin[1] = voxelCenter[1] - 0.5f * cellSize;
+						voxelMin[2] = voxelCenter[2] - 0.5f * cellSize;
 
-						if (currentTriDistSq < distToTriSq)
-							distToTriSq = currentTriDistSq;
-					}
+						voxelMax[0] = voxelCenter[0] + 0.5f * cellSize;
+						voxelMax[1] = voxelCenter[1] + 0.5f * cellSize;
+						voxelMax[2] = voxelCenter[2] + 0.5f * cellSize;
 
-					assert(distToTriSq < DBL_MAX);
+						const pmp::BoundingBox voxelBox{ voxelMin , voxelMax };
+						if (!m_KdTree->BoxIntersectsATriangle(voxelBox))
+							continue; // no triangles found
 
-					const unsigned int gridPos = dims.Nx * dims.Ny * iz + dims.Nx * iy + ix;
-					gridVals[gridPos] = sqrt(distToTriSq);
-					gridFrozenVals[gridPos] = true;
+						outlineVoxelIds.push_back(dims.Nx * dims.Ny * iz + dims.Nx * iy + ix);
+						outlineVoxelCenters.push_back(voxelCenter);
+					}
 				}
 			}
+
+			// outline voxels of a slab are spatially coherent, so a single batch query serves them all
+			std::vector<Geometry::ClosestTriangleResult> closestTriangles{};
+			m_KdTree->FindClosestTriangles(outlineVoxelCenters, closestTriangles, maxOutlineDistance);
+			for (size_t i = 0; i < outlineVoxelIds.size(); i++)
+			{
+				assert(closestTriangles[i].TriangleId != Geometry::NO_CLOSEST_TRIANGLE_ID);
+				gridVals[outlineVoxelIds[i]] = static_cast<T>(sqrt(closestTriangles[i].DistanceSq));
+			}
+		});
+
+		for (const auto& outlineVoxelIds : threadOutlineVoxelIds)
+		{
+			for (const auto& gridPos : outlineVoxelIds)
+				gridFrozenVals[gridPos] = true;
 		}
 	}
 
-	void DistanceFieldGenerator::PreprocessGridWithOctree(Geometry::ScalarGrid& grid)
+	template <typename T>
+	void DistanceFieldGenerator::PreprocessGridWithOctree(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) const
 	{
 		assert(m_KdTree);
 		auto& gridVals = grid.Values();
 		auto& gridFrozenVals = grid.FrozenValues();
 		const float cellSize = grid.CellSize();
 		const auto& gridBox = grid.Box();
-		const auto octreeVox = OctreeVoxelizer(*m_KdTree, gridBox, cellSize);
+		const auto octreeVox = OctreeVoxelizer(*m_KdTree, gridBox, cellSize, nThreads);
 
 		// extract leaf boxes and distance values from their centroids
 		std::vector<pmp::BoundingBox*> boxBuffer{};
@@ -95,29 +110,59 @@ namespace SDF
 		const float gBoxMinZ = gridBox.min()[2];
 
 		const auto& dims = grid.Dimensions();
-		const auto Nx = static_cast<unsigned int>(dims.Nx);
-		const auto Ny = static_cast<unsigned int>(dims.Ny);
-		unsigned int ix, iy, iz, gridPos;
+		const size_t Nx = dims.Nx;
+		const size_t Ny = dims.Ny;
+		size_t ix, iy, iz, gridPos;
 
 		for (size_t i = 0; i < nOutlineVoxels; i++)
 		{
 			// transform from real space to grid index space
-			ix = static_cast<unsigned int>(std::floor((0.5f * (boxBuffer[i]->min()[0] + boxBuffer[i]->max()[0]) - gBoxMinX) / cellSize));
-			iy = static_cast<unsigned int>(std::floor((0.5f * (boxBuffer[i]->min()[1] + boxBuffer[i]->max()[1]) - gBoxMinY) / cellSize));
-			iz = static_cast<unsigned int>(std::floor((0.5f * (boxBuffer[i]->min()[2] + boxBuffer[i]->max()[2]) - gBoxMinZ) / cellSize));
+			ix = static_cast<size_t>(std::floor((0.5f * (boxBuffer[i]->min()[0] + boxBuffer[i]->max()[0]) - gBoxMinX) / cellSize));
+			iy = static_cast<size_t>(std::floor((0.5f * (boxBuffer[i]->min()[1] + boxBuffer[i]->max()[1]) - gBoxMinY) / cellSize));
+			iz = static_cast<size_t>(std::floor((0.5f * (boxBuffer[i]->min()[2] + boxBuffer[i]->max()[2]) - gBoxMinZ) / cellSize));
 
 			gridPos = Nx * Ny * iz + Nx * iy + ix;
-			gridVals[gridPos] = valueBuffer[i];
+			gridVals[gridPos] = static_cast<T>(valueBuffer[i]);
 			gridFrozenVals[gridPos] = true; // freeze initial condition for FastSweep
 		}
 	}
 
-	PreprocessingFunction DistanceFieldGenerator::GetPreprocessingFunction(const PreprocessingType& preprocType)
+	void DistanceFieldGenerator::PreprocessSparseGridWithOctree(Geometry::SparseScalarGrid& grid, const unsigned int& nThreads) const
+	{
+		assert(m_KdTree);
+		const float cellSize = grid.CellSize();
+		const auto& gridBox = grid.Box();
+		const auto octreeVox = OctreeVoxelizer(*m_KdTree, gridBox, cellSize, nThreads);
+
+		// extract leaf boxes and distance values from their centroids
+		std::vector<pmp::BoundingBox*> boxBuffer{};
+		std::vector<double> valueBuffer{};
+		octreeVox.GetLeafBoxesAndValues(boxBuffer, valueBuffer);
+		const size_t nOutlineVoxels = boxBuffer.size();
+		const float gBoxMinX = gridBox.min()[0];
+		const float gBoxMinY = gridBox.min()[1];
+		const float gBoxMinZ = gridBox.min()[2];
+		size_t ix, iy, iz;
+
+		for (size_t i = 0; i < nOutlineVoxels; i++)
+		{
+			// transform from real space to grid index space
+			ix = static_cast<size_t>(std::floor((0.5f * (boxBuffer[i]->min()[0] + boxBuffer[i]->max()[0]) - gBoxMinX) / cellSize));
+			iy = static_cast<size_t>(std::floor((0.5f * (boxBuffer[i]->min()[1] + boxBuffer[i]->max()[1]) - gBoxMinY) / cellSize));
+			iz = static_cast<size_t>(std::floor((0.5f * (boxBuffer[i]->min()[2] + boxBuffer[i]->max()[2]) - gBoxMinZ) / cellSize));
+
+			grid.SetValue(ix, iy, iz, valueBuffer[i]);
+			grid.SetFrozen(ix, iy, iz, true); // freeze initial condition for FastSweep
+		}
+	}
+
+	template <typename T>
+	BasicPreprocessingFunction<T> DistanceFieldGenerator::GetPreprocessingFunction(const PreprocessingType& preprocType)
 	{
 		if (preprocType == PreprocessingType::Octree)
-			return PreprocessGridWithOctree;
+			return [this](Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) { PreprocessGridWithOctree(grid, nThreads); };
 
-		return PreprocessGridNoOctree;
+		return [this](Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) { PreprocessGridNoOctree(grid, nThreads); };
 	}
 
 	/**
@@ -130,41 +175,47 @@ namespace SDF
 		if (splitType == KDTreeSplitType::Center)
 			return Geometry::CenterSplitFunction;
 
+		if (splitType == KDTreeSplitType::SAH)
+			return Geometry::SAHSplitFunction;
+
 		return Geometry::AdaptiveSplitFunction;
 	}
 
-	/// \brief a blur function for postprocessing the distance field.
-	using BlurFunction = std::function<void(Geometry::ScalarGrid&)>;
+	/// \brief a blur function for postprocessing the distance field with value type T using a given number of worker threads.
+	template <typename T>
+	using BlurFunction = std::function<void(Geometry::BasicScalarGrid<T>&, const unsigned int&)>;
 
 	/**
 	 * \brief Provides a blur functor according to the given setting.
 	 * \param blurType      blur type identifier.
 	 * \return the blur function identified by splitType.
 	 */
-	[[nodiscard]] BlurFunction GetBlurFunction(const BlurPostprocessingType& blurType)
+	template <typename T>
+	[[nodiscard]] BlurFunction<T> GetBlurFunction(const BlurPostprocessingType& blurType)
 	{
 		if (blurType == BlurPostprocessingType::ThreeCubedVoxelAveraging)
-			return Geometry::ApplyNarrowAveragingBlur;
+			return Geometry::ApplyNarrowAveragingBlur<T>;
 
 		if (blurType == BlurPostprocessingType::FiveCubedVoxelAveraging)
-			return Geometry::ApplyWideAveragingBlur;
+			return Geometry::ApplyWideAveragingBlur<T>;
 
 		if (blurType == BlurPostprocessingType::ThreeCubedVoxelGaussian)
-			return Geometry::ApplyNarrowGaussianBlur;
+			return Geometry::ApplyNarrowGaussianBlur<T>;
 
 		if (blurType == BlurPostprocessingType::FiveCubedVoxelGaussian)
-			return Geometry::ApplyWideGaussianBlur;
+			return Geometry::ApplyWideGaussianBlur<T>;
 
 		return {}; // empty blur function
 	}
 
-	SignFunction DistanceFieldGenerator::GetSignFunction(const SignComputation& signCompType)
+	template <typename T>
+	BasicSignFunction<T> DistanceFieldGenerator::GetSignFunction(const SignComputation& signCompType)
 	{
 		if (signCompType == SignComputation::VoxelFloodFill)
-			return ComputeSignUsingFloodFill;
+			return ComputeSignUsingFloodFill<T>;
 
 		if (signCompType == SignComputation::RayFromAHoleFilledMesh)
-			return ComputeSignUsingRays;
+			return [this](Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) { ComputeSignUsingRays(grid, nThreads); };
 
 		return {}; // empty sign function
 	}
@@ -194,6 +245,8 @@ namespace SDF
 	{
 		if (type == KDTreeSplitType::Adaptive)
 			return "KDTreeSplitType::Adaptive";
+		if (type == KDTreeSplitType::SAH)
+			return "KDTreeSplitType::SAH";
 
 		return "KDTreeSplitType::Center";
 	}
@@ -208,6 +261,14 @@ namespace SDF
 		return "SignComputation::None";
 	}
 
+	[[nodiscard]] std::string PrintDistanceMethod(const DistanceComputation& type)
+	{
+		if (type == DistanceComputation::ClosestTrianglePropagation)
+			return "DistanceComputation::ClosestTrianglePropagation";
+
+		return "DistanceComputation::FastSweep";
+	}
+
 	[[nodiscard]] std::string PrintBlurType(const BlurPostprocessingType& type)
 	{
 		if (type == BlurPostprocessingType::ThreeCubedVoxelAveraging)
@@ -257,6 +318,8 @@ namespace SDF
 		os << "KDTreeSplit: " << PrintKDTreeSplitType(settings.KDTreeSplit) << "\n";
 		os << "SignMethod: " << PrintSignMethod(settings.SignMethod) << "\n";
 		os << "BlurType: " << PrintBlurType(settings.BlurType) << "\n";
+		os << "DistanceMethod: " << PrintDistanceMethod(settings.DistanceMethod) << "\n";
+		os << "NThreads: " << settings.NThreads << "\n";
 		os << "----------------------------------------------------------------------\n";
 	}
 
@@ -284,7 +347,147 @@ namespace SDF
 	// ===============================================================================================
 	//
 
+	/// \brief a functor computing the i-th distance field of a batch.
+	using BatchItemFunction = std::function<Geometry::ScalarGrid(size_t)>;
+
+	/**
+	 * \brief Computes a batch of distance fields concurrently.
+	 * \param nItems        the number of distance fields in the batch.
+	 * \param nThreads      the number of distance fields computed at the same time.
+	 * \param itemFunc      functor computing the i-th distance field.
+	 * \return the computed distance fields in batch order.
+	 * \throw the first exception thrown by itemFunc (after all items are processed).
+	 */
+	[[nodiscard]] std::vector<Geometry::ScalarGrid> GenerateBatchInternal(const size_t& nItems, const unsigned int& nThreads, const BatchItemFunction& itemFunc)
+	{
+		std::vector<std::optional<Geometry::ScalarGrid>> results(nItems);
+		std::vector<std::exception_ptr> exceptions(nItems, nullptr);
+		Utils::ParallelForEachIndex(0, nItems, nThreads, [&](const size_t i, [[maybe_unused]] const unsigned int threadId)
+		{
+			try
+			{
+				results[i].emplace(itemFunc(i));
+			}
+			catch (...)
+			{
+				exceptions[i] = std::current_exception(); // exceptions cannot leave a std::thread
+			}
+		});
+
+		for (const auto& e : exceptions)
+		{
+			if (e)
+				std::rethrow_exception(e);
+		}
+
+		std::vector<Geometry::ScalarGrid> resultGrids{};
+		resultGrids.reserve(nItems);
+		for (auto& result : results)
+			resultGrids.emplace_back(std::move(*result));
+		return resultGrids;
+	}
+
 	Geometry::ScalarGrid DistanceFieldGenerator::Generate(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings)
+	{
+		DistanceFieldGenerator generator{};
+		return generator.Compute<double>(inputMesh, settings);
+	}
+
+	Geometry::ScalarGridF DistanceFieldGenerator::GenerateSinglePrecision(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings)
+	{
+		DistanceFieldGenerator generator{};
+		return generator.Compute<float>(inputMesh, settings);
+	}
+
+	Geometry::SparseScalarGrid DistanceFieldGenerator::GenerateSparse(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings)
+	{
+		DistanceFieldGenerator generator{};
+		return generator.ComputeSparse(inputMesh, settings);
+	}
+
+	Geometry::MappedScalarGridF DistanceFieldGenerator::GenerateOutOfCore(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings, const std::string& filePath, const size_t& nSlabLayers)
+	{
+		DistanceFieldGenerator generator{};
+		return generator.ComputeOutOfCore(inputMesh, settings, filePath, nSlabLayers);
+	}
+
+	std::vector<Geometry::ScalarGrid> DistanceFieldGenerator::GenerateBatch(
+		const std::vector<const Geometry::MeshAdapter*>& inputMeshes, const std::vector<DistanceFieldSettings>& settings, const unsigned int& nThreads)
+	{
+		if (inputMeshes.size() != settings.size())
+			throw std::invalid_argument("DistanceFieldGenerator::GenerateBatch: inputMeshes.size() != settings.size()!\n");
+		if (std::any_of(inputMeshes.begin(), inputMeshes.end(), [](const auto* mesh) { return mesh == nullptr; }))
+			throw std::invalid_argument("DistanceFieldGenerator::GenerateBatch: null mesh adapter in inputMeshes!\n");
+
+		return GenerateBatchInternal(inputMeshes.size(), nThreads, [&](const size_t i) { return Generate(*inputMeshes[i], settings[i]); });
+	}
+
+	template <typename T>
+	void DistanceFieldGenerator::ComputeGridValues(Geometry::BasicScalarGrid<T>& grid, const DistanceFieldSettings& settings, const PreprocessingType& preprocType, const double& truncationValue)
+	{
+#if REPORT_SDF_STEPS
+		std::cout << "preprocessGrid ... ";
+#endif
+		const auto preprocessGrid = GetPreprocessingFunction<T>(preprocType);
+		preprocessGrid(grid, settings.NThreads);
+#if REPORT_SDF_STEPS
+		std::cout << "done\n";
+#endif
+
+		if (truncationValue > 0.0 && settings.DistanceMethod == DistanceComputation::ClosestTrianglePropagation)
+		{
+#if REPORT_SDF_STEPS
+			std::cout << "PropagateClosestTriangles ... ";
+#endif
+			ClosestTrianglePropagationSettings ctpSettings{};
+			ctpSettings.TruncationValue = truncationValue;
+			ctpSettings.NThreads = settings.NThreads;
+			PropagateClosestTriangles(grid, *m_KdTree, ctpSettings);
+#if REPORT_SDF_STEPS
+			std::cout << "done\n";
+#endif
+		}
+		else if (truncationValue > 0.0)
+		{
+#if REPORT_SDF_STEPS
+			std::cout << "FastSweep ... ";
+#endif
+			SweepSolverSettings fsSettings{};
+			fsSettings.NThreads = settings.NThreads;
+			FastSweep(grid, fsSettings);
+#if REPORT_SDF_STEPS
+			std::cout << "done\n";
+#endif
+		}
+
+		if (settings.SignMethod != SignComputation::None)
+		{
+#if REPORT_SDF_STEPS
+			std::cout << "signFunction ... ";
+#endif
+			const auto signFunction = GetSignFunction<T>(settings.SignMethod);
+			signFunction(grid, settings.NThreads);
+#if REPORT_SDF_STEPS
+			std::cout << "done\n";
+#endif
+		}
+
+		// blur postprocessing
+		if (settings.BlurType != BlurPostprocessingType::None)
+		{
+#if REPORT_SDF_STEPS
+			std::cout << "blurFunction ... ";
+#endif
+			const auto blurFunction = GetBlurFunction<T>(settings.BlurType);
+			blurFunction(grid, settings.NThreads);
+#if REPORT_SDF_STEPS
+			std::cout << "done\n";
+#endif
+		}
+	}
+
+	template <typename T>
+	Geometry::BasicScalarGrid<T> DistanceFieldGenerator::Compute(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings)
 	{
 		assert(settings.CellSize > 0.0f);
 		assert(settings.VolumeExpansionFactor >= 0.0f);
@@ -314,22 +517,71 @@ namespace SDF
 
 		// percentage of the minimum half-size of the mesh's bounding box.
 		const double truncationValue = (settings.TruncationFactor < Geometry::DEFAULT_SCALAR_GRID_INIT_VAL ? settings.TruncationFactor * (static_cast<double>(minSize) / 2.0) : Geometry::DEFAULT_SCALAR_GRID_INIT_VAL);
-		Geometry::ScalarGrid resultGrid(settings.CellSize, sdfBBox, truncationValue);
+		Geometry::BasicScalarGrid<T> resultGrid(settings.CellSize, sdfBBox, truncationValue);
 #if REPORT_SDF_STEPS
 		std::cout << "truncationValue: " << truncationValue << "\n";
 		std::cout << "CollisionKdTree ... ";
 #endif
-		m_KdTree = std::make_unique<Geometry::CollisionKdTree>(*m_Mesh, GetSplitFunction(settings.KDTreeSplit));
+		m_KdTree = std::make_unique<Geometry::CollisionKdTree>(*m_Mesh, GetSplitFunction(settings.KDTreeSplit), settings.NThreads);
 #if REPORT_SDF_STEPS
 		std::cout << "done\n";
 #endif
+		ComputeGridValues(resultGrid, settings, settings.PreprocType, truncationValue);
+		return resultGrid;
+	}
+
+	/**
+	 * \brief Computes the number of block layers a sparse grid needs to be dilated by, so that it contains all voxels within truncationValue from its initially allocated blocks.
+	 * \param truncationValue    truncation value of the distance field.
+	 * \param cellSize           size of a single voxel.
+	 * \return the number of dilation layers.
+	 */
+	[[nodiscard]] unsigned int GetNarrowBandBlockLayerCount(const double& truncationValue, const float& cellSize)
+	{
+		const double blockSize = static_cast<double>(Geometry::SPARSE_BLOCK_DIM) * static_cast<double>(cellSize);
+		return static_cast<unsigned int>(std::ceil(truncationValue / blockSize));
+	}
+
+	Geometry::SparseScalarGrid DistanceFieldGenerator::ComputeSparse(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings)
+	{
+		assert(settings.CellSize > 0.0f);
+		assert(settings.VolumeExpansionFactor >= 0.0f);
+		assert(settings.TruncationFactor > 0);
+
+		if (settings.TruncationFactor >= Geometry::DEFAULT_SCALAR_GRID_INIT_VAL)
+			throw std::invalid_argument("DistanceFieldGenerator::GenerateSparse: a sparse distance field requires a finite settings.TruncationFactor!\n");
+
+		if (settings.SignMethod != SignComputation::None || settings.BlurType != BlurPostprocessingType::None)
+			std::cerr << "DistanceFieldGenerator::GenerateSparse: sign computation and blur are not supported for sparse grids! Ignoring.\n";
+
+		m_Mesh = inputMesh.Clone();
+
+		auto sdfBBox = m_Mesh->GetBounds();
+		const auto size = sdfBBox.max() - sdfBBox.min();
+		const float minSize = std::min({ size[0], size[1], size[2] });
+
+		if (settings.VolumeExpansionFactor > 0.0f)
+		{
+			const float expansion = settings.VolumeExpansionFactor * minSize;
+			sdfBBox.expand(expansion, expansion, expansion);
+		}
+
+		// percentage of the minimum half-size of the mesh's bounding box.
+		const double truncationValue = settings.TruncationFactor * (static_cast<double>(minSize) / 2.0);
+		Geometry::SparseScalarGrid resultGrid(settings.CellSize, sdfBBox, truncationValue);
 #if REPORT_SDF_STEPS
-		std::cout << "preprocessGrid ... ";
+		std::cout << "truncationValue: " << truncationValue << "\n";
+		std::cout << "CollisionKdTree ... ";
 #endif
-		const auto preprocessGrid = GetPreprocessingFunction(settings.PreprocType);
-		preprocessGrid(resultGrid);
+		m_KdTree = std::make_unique<Geometry::CollisionKdTree>(*m_Mesh, GetSplitFunction(settings.KDTreeSplit), settings.NThreads);
 #if REPORT_SDF_STEPS
 		std::cout << "done\n";
+		std::cout << "preprocessGrid ... ";
+#endif
+		PreprocessSparseGridWithOctree(resultGrid, settings.NThreads);
+		resultGrid.DilateAllocatedBlocks(GetNarrowBandBlockLayerCount(truncationValue, settings.CellSize));
+#if REPORT_SDF_STEPS
+		std::cout << "done, allocated blocks: " << resultGrid.NAllocatedBlocks() << "\n";
 #endif
 
 		if (truncationValue > 0.0)
@@ -337,185 +589,139 @@ namespace SDF
 #if REPORT_SDF_STEPS
 			std::cout << "FastSweep ... ";
 #endif
-			constexpr SweepSolverSettings fsSettings{};
-			FastSweep(resultGrid, fsSettings);
+			FastSweep(resultGrid, SweepSolverSettings{});
 #if REPORT_SDF_STEPS
 			std::cout << "done\n";
 #endif
 		}
+		return resultGrid;
+	}
+
+	Geometry::MappedScalarGridF DistanceFieldGenerator::ComputeOutOfCore(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings, const std::string& filePath, const size_t& nSlabLayers)
+	{
+		assert(settings.CellSize > 0.0f);
+		assert(settings.VolumeExpansionFactor >= 0.0f);
+		assert(settings.TruncationFactor > 0);
+
+		if (settings.TruncationFactor >= Geometry::DEFAULT_SCALAR_GRID_INIT_VAL)
+			throw std::invalid_argument("DistanceFieldGenerator::GenerateOutOfCore: an out-of-core distance field requires a finite settings.TruncationFactor!\n");
+		if (settings.SignMethod == SignComputation::VoxelFloodFill)
+			throw std::invalid_argument("DistanceFieldGenerator::GenerateOutOfCore: SignComputation::VoxelFloodFill requires the whole grid! Use SignComputation::RayFromAHoleFilledMesh.\n");
+		if (nSlabLayers == 0)
+			throw std::invalid_argument("DistanceFieldGenerator::GenerateOutOfCore: nSlabLayers == 0!\n");
 
+		m_Mesh = inputMesh.Clone();
 		if (settings.SignMethod != SignComputation::None)
 		{
 #if REPORT_SDF_STEPS
-			std::cout << "signFunction ... ";
+			std::cout << "FillMeshHoles ... ";
 #endif
-			const auto signFunction = GetSignFunction(settings.SignMethod);
-			signFunction(resultGrid);
+			FillMeshHoles(*m_Mesh); // make mesh watertight
 #if REPORT_SDF_STEPS
 			std::cout << "done\n";
 #endif
 		}
 
-		// blur postprocessing
-		if (settings.BlurType != BlurPostprocessingType::None)
+		auto sdfBBox = m_Mesh->GetBounds();
+		const auto size = sdfBBox.max() - sdfBBox.min();
+		const float minSize = std::min({ size[0], size[1], size[2] });
+
+		if (settings.VolumeExpansionFactor > 0.0f)
 		{
+			const float expansion = settings.VolumeExpansionFactor * minSize;
+			sdfBBox.expand(expansion, expansion, expansion);
+		}
+
+		// percentage of the minimum half-size of the mesh's bounding box.
+		const double truncationValue = settings.TruncationFactor * (static_cast<double>(minSize) / 2.0);
+		Geometry::MappedScalarGridF resultGrid(filePath, settings.CellSize, sdfBBox, truncationValue);
 #if REPORT_SDF_STEPS
-			std::cout << "blurFunction ... ";
+		std::cout << "truncationValue: " << truncationValue << "\n";
+		std::cout << "CollisionKdTree ... ";
 #endif
-			const auto blurFunction = GetBlurFunction(settings.BlurType);
-			blurFunction(resultGrid);
+		m_KdTree = std::make_unique<Geometry::CollisionKdTree>(*m_Mesh, GetSplitFunction(settings.KDTreeSplit), settings.NThreads);
 #if REPORT_SDF_STEPS
-			std::cout << "done\n";
+		std::cout << "done\n";
 #endif
+
+		// outline voxels within the truncation band of a slab's layer lie within the halo, and so do the voxels read by a blur kernel (radius <= 2).
+		const size_t nBlurLayers = (settings.BlurType != BlurPostprocessingType::None ? 2 : 0);
+		const size_t nHaloLayers = static_cast<size_t>(std::ceil(truncationValue / static_cast<double>(settings.CellSize))) + 1 + nBlurLayers;
+		const size_t Nz = resultGrid.Dimensions().Nz;
+		for (size_t izStart = 0; izStart < Nz; izStart += nSlabLayers)
+		{
+			const size_t izEnd = std::min(izStart + nSlabLayers, Nz);
+			const size_t izHaloStart = (izStart > nHaloLayers ? izStart - nHaloLayers : 0);
+			const size_t izHaloEnd = std::min(izEnd + nHaloLayers, Nz);
+#if REPORT_SDF_STEPS
+			std::cout << "slab [" << izStart << ", " << izEnd << ") of " << Nz << " z-layers ...\n";
+#endif
+			auto slabGrid = resultGrid.CreateSlab(izHaloStart, izHaloEnd, truncationValue);
+			ComputeGridValues(slabGrid, settings, PreprocessingType::NoOctree, truncationValue);
+			resultGrid.WriteSlab(slabGrid, izHaloStart, izStart, izEnd);
 		}
+		resultGrid.Flush();
 		return resultGrid;
 	}
 
-	//! \brief if true __m128i avx buffers will be used for iterating through the field.
-#define USE_INTRINSICS false
-
-	void DistanceFieldGenerator::ComputeSignUsingFloodFill(Geometry::ScalarGrid& grid)
+	template <typename T>
+	void DistanceFieldGenerator::ComputeSignUsingFloodFill(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads)
 	{
-		const auto origFrozenFlags = grid.FrozenValues();
-		Geometry::NegateGrid(grid);
-		auto& gridVals = grid.Values();
-		auto& gridFrozenVals = grid.FrozenValues();
-		const auto& dim = grid.Dimensions();
-
-		const auto Nx = static_cast<unsigned int>(dim.Nx);
-		const auto Ny = static_cast<unsigned int>(dim.Ny);
-		const int nx = static_cast<int>(dim.Nx) - 1;
-		const int ny = static_cast<int>(dim.Ny) - 1;
-		const int nz = static_cast<int>(dim.Nz) - 1;
-
-		unsigned int gridPos;
-		int iz = 0, iy = 0, ix = 0;
-
-#if USE_INTRINSICS
-		// TODO: some distance fields remain negated (when using intrinsics) even though they're closed.
-		union { __m128i idsTriple; int ids[3]; };
-		union { __m128i idsMask; int imask[3]; };
-		std::stack<__m128i> stack = {};
-
-		idsTriple = _mm_setr_epi32(ix, iy, iz, INT_MAX);
-
-		// find the first unfrozen cell
-		gridPos = 0;
-		while (gridFrozenVals[gridPos]) 
-		{
-			idsMask = _mm_cmplt_epi32(idsTriple, _mm_setr_epi32(nx, ny, nz, INT_MAX));
-			idsTriple = _mm_add_epi32(
-				idsTriple, _mm_setr_epi32(
-					(imask[0] > 0) * 1, (imask[1] > 0) * 1, (imask[2] > 0) * 1, 0)
-			);
-			ix = ids[0]; iy = ids[1]; iz = ids[2];
-			gridPos = Nx * Ny * iz + Nx * iy + ix;
-		}
-
-		ids[0] = ix;
-		ids[1] = iy;
-		ids[2] = iz;
-		stack.push(idsTriple);
-
-		// a simple voxel flood
-		while (!stack.empty()) 
-		{
-			idsTriple = stack.top();
-			stack.pop();
-
-			ix = ids[0]; iy = ids[1]; iz = ids[2];
-			gridPos = Nx * Ny * iz + Nx * iy + ix;
-
-			if (!gridFrozenVals[gridPos])
-			{
-				gridVals[gridPos] = -1.0 * gridVals[gridPos];
-				gridFrozenVals[gridPos] = true; // freeze cell when done
-
-				idsMask = _mm_cmpgt_epi32(idsTriple, _mm_set1_epi32(0)); // lower bounds
+		if (!grid.IsValid())
+			return;
 
-				if (imask[0] > 0) {
-					stack.push(_mm_setr_epi32(ix - 1, iy, iz, INT_MAX));
-				}
-				if (imask[1] > 0) {
-					stack.push(_mm_setr_epi32(ix, iy - 1, iz, INT_MAX));
-				}
-				if (imask[2] > 0) {
-					stack.push(_mm_setr_epi32(ix, iy, iz - 1, INT_MAX));
-				}
+		const auto& dim = grid.Dimensions();
+		const size_t nx = dim.Nx - 1;
+		const size_t ny = dim.Ny - 1;
+		const size_t nz = dim.Nz - 1;
 
-				idsMask = _mm_cmplt_epi32(idsTriple, _mm_setr_epi32(nx, ny, nz, INT_MAX)); // upper bounds
+		// the flood passes through non-frozen voxels
+		const Geometry::VoxelBitMask passable(grid.FrozenValues(), dim, true);
 
-				if (imask[0] > 0) {
-					stack.push(_mm_setr_epi32(ix + 1, iy, iz, INT_MAX));
-				}
-				if (imask[1] > 0) {
-					stack.push(_mm_setr_epi32(ix, iy + 1, iz, INT_MAX));
-				}
-				if (imask[2] > 0) {
-					stack.push(_mm_setr_epi32(ix, iy, iz + 1, INT_MAX));
-				}
-			}
-		}
-#else
-		std::stack<std::tuple<int, int, int>> stack = {};
-		std::tuple<int, int, int> idsTriple{};
 		// find the first unfrozen cell
-		gridPos = 0;
-		while (gridFrozenVals[gridPos])
+		size_t ix = 0, iy = 0, iz = 0;
+		while (!passable.Get(ix, iy, iz) && (ix < nx || iy < ny || iz < nz))
 		{
 			ix += (ix < nx ? 1 : 0);
 			iy += (iy < ny ? 1 : 0);
 			iz += (iz < nz ? 1 : 0);
-			gridPos = Nx * Ny * iz + Nx * iy + ix;
 		}
 
-		stack.push({ ix, iy, iz });
-		// a simple voxel flood
-		while (!stack.empty())
+		const auto exterior = Geometry::FloodFillConnectedVoxels(passable, ix, iy, iz, nThreads);
+
+		// negate all voxels not reached by the flood
+		auto& gridVals = grid.Values();
+		Utils::ParallelForChunks(0, dim.Nz, nThreads, [&](const size_t izStart, const size_t izEnd, [[maybe_unused]] const unsigned int threadId)
 		{
-			idsTriple = stack.top();
-			stack.pop();
-			ix = std::get<0>(idsTriple);
-			iy = std::get<1>(idsTriple);
-			iz = std::get<2>(idsTriple);
-			gridPos = Nx * Ny * iz + Nx * iy + ix;
-			if (!gridFrozenVals[gridPos])
+			for (size_t z = izStart; z < izEnd; z++)
 			{
-				gridVals[gridPos] = -1.0 * gridVals[gridPos];
-				gridFrozenVals[gridPos] = true; // freeze cell when done
+				for (size_t y = 0; y < dim.Ny; y++)
+				{
+					for (size_t x = 0; x < dim.Nx; x++)
+					{
+						if (exterior.Get(x, y, z))
+							continue;
 
-				if (ix > 0) {
-					stack.push({ ix - 1, iy, iz });
-				}
-				if (ix < nx) {
-					stack.push({ ix + 1, iy, iz });
-				}
-				if (iy > 0) {
-					stack.push({ ix, iy - 1, iz });
-				}
-				if (iy < ny) {
-					stack.push({ ix, iy + 1, iz });
-				}
-				if (iz > 0) {
-					stack.push({ ix, iy, iz - 1 });
-				}
-				if (iz < nz) {
-					stack.push({ ix, iy, iz + 1 });
+						const size_t gridPos = dim.Nx * dim.Ny * z + dim.Nx * y + x;
+						gridVals[gridPos] = -gridVals[gridPos];
+					}
 				}
 			}
-		}
-#endif
-
-		grid.FrozenValues() = origFrozenFlags;
+		});
 	}
 
-	void DistanceFieldGenerator::ComputeSignUsingRays(Geometry::ScalarGrid& grid)
+	template <typename T>
+	void DistanceFieldGenerator::ComputeSignUsingRays(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) const
 	{
+		const auto& gridBox = grid.Box();
+		if (!gridBox.Intersects(m_Mesh->GetBounds()))
+			return; // e.g.: an out-of-core slab beyond the mesh, all voxels are exterior
+
 		const auto origFrozenFlags = grid.FrozenValues();
 		//Geometry::NegateGrid(grid);
-		const auto origMeshBox = m_Mesh->GetBounds();
+		// the mesh box is clipped to the grid box, since a grid (slab) computed out of core does not have to contain the whole mesh
+		const auto origMeshBox = gridBox.Intersect(m_Mesh->GetBounds());
 		Geometry::NegateGridSubVolume(grid, origMeshBox);
-		const auto& gridBox = grid.Box();
 
 		// grid sub-bounds
 		const auto dMin = origMeshBox.min() - gridBox.min();
@@ -525,54 +731,77 @@ namespace SDF
 
 		// compute sub-grid bounds
 		const auto& cellSize = grid.CellSize();
-		const unsigned int iXStart = std::floor(dMin[0] / cellSize);
-		const unsigned int iYStart = std::floor(dMin[1] / cellSize);
-		const unsigned int iZStart = std::floor(dMin[2] / cellSize);
+		const auto iXStart = static_cast<size_t>(std::floor(dMin[0] / cellSize));
+		const auto iYStart = static_cast<size_t>(std::floor(dMin[1] / cellSize));
+		const auto iZStart = static_cast<size_t>(std::floor(dMin[2] / cellSize));
 
-		const unsigned int iXEnd = std::ceil(dMax[0] / cellSize);
-		const unsigned int iYEnd = std::ceil(dMax[1] / cellSize);
-		const unsigned int iZEnd = std::ceil(dMax[2] / cellSize);
+		const auto iXEnd = static_cast<size_t>(std::ceil(dMax[0] / cellSize));
+		const auto iYEnd = static_cast<size_t>(std::ceil(dMax[1] / cellSize));
+		const auto iZEnd = static_cast<size_t>(std::ceil(dMax[2] / cellSize));
 
 		auto& gridVals = grid.Values();
 		const auto& dims = grid.Dimensions();
 		const auto& orig = grid.Box().min();
-
-		pmp::vec3 gridPt;
 		const pmp::vec3 rayXDir{ 1.0f, 0.0, 0.0 };
-		Geometry::Ray ray{ gridPt, rayXDir };
 
-		for (unsigned int iz = iZStart; iz < iZEnd; iz++)
+		// A single +x ray per grid row (starting one cell before the row's sub-grid start) is traced through the kd-tree.
+		// The interior test of voxel ix then counts the row's hits beyond the voxel, so every crossing is computed once per row.
+		const float rowRayStartOffset = static_cast<float>(iXStart) * cellSize - cellSize;
+		Utils::ParallelForChunks(iZStart, iZEnd, nThreads, [&](const size_t izStart, const size_t izEnd, [[maybe_unused]] const unsigned int threadId)
 		{
-			for (unsigned int iy = iYStart; iy < iYEnd; iy++)
+			Geometry::Ray ray{ pmp::vec3{}, rayXDir };
+			std::vector<float> hitParams{};
+			for (size_t iz = izStart; iz < izEnd; iz++)
 			{
-				for (unsigned int ix = iXStart; ix < iXEnd; ix++)
+				for (size_t iy = iYStart; iy < iYEnd; iy++)
 				{
-					gridPt[0] = orig[0] + ix * cellSize;
-					gridPt[1] = orig[1] + iy * cellSize;
-					gridPt[2] = orig[2] + iz * cellSize;
-
-					ray.StartPt = gridPt;
+					ray.StartPt = pmp::vec3{ orig[0] + rowRayStartOffset, orig[1] + iy * cellSize, orig[2] + iz * cellSize };
 					ray.HitParam = FLT_MAX;
-					const unsigned int nRayTriIntersections = m_KdTree->GetRayTriangleIntersectionCount(ray);
-					if (nRayTriIntersections % 2 == 1)
-						continue; // skip negated values of interior grid points
+					m_KdTree->GetRayTriangleIntersectionParams(ray, hitParams);
+					std::ranges::sort(hitParams);
+
+					// hits are sorted, so the number of hits beyond a voxel only decreases with ix
+					size_t nHitsBeforeVoxel = 0;
+					for (size_t ix = iXStart; ix < iXEnd; ix++)
+					{
+						const float voxelParam = static_cast<float>(ix - iXStart + 1) * cellSize;
+						while (nHitsBeforeVoxel < hitParams.size() && hitParams[nHitsBeforeVoxel] <= voxelParam + RAY_HIT_PARAM_EPSILON)
+							nHitsBeforeVoxel++;
+
+						const size_t nRayTriIntersections = hitParams.size() - nHitsBeforeVoxel;
+						if (nRayTriIntersections % 2 == 1)
+							continue; // skip negated values of interior grid points
 
-					// negate negated values for exterior grid points
-					const unsigned int gridPos = dims.Nx * dims.Ny * iz + dims.Nx * iy + ix;
-					gridVals[gridPos] *= -1.0;
+						// negate negated values for exterior grid points
+						const size_t gridPos = dims.Nx * dims.Ny * iz + dims.Nx * iy + ix;
+						gridVals[gridPos] *= -1.0;
+					}
 				}
 			}
-		}
+		});
 		grid.FrozenValues() = origFrozenFlags;
 	}
 
 	Geometry::ScalarGrid PointCloudDistanceFieldGenerator::Generate(const std::vector<pmp::vec3>& inputPoints, const PointCloudDistanceFieldSettings& settings)
+	{
+		const PointCloudDistanceFieldGenerator generator(inputPoints);
+		return generator.Compute<double>(settings);
+	}
+
+	Geometry::ScalarGridF PointCloudDistanceFieldGenerator::GenerateSinglePrecision(const std::vector<pmp::vec3>& inputPoints, const PointCloudDistanceFieldSettings& settings)
+	{
+		const PointCloudDistanceFieldGenerator generator(inputPoints);
+		return generator.Compute<float>(settings);
+	}
+
+	template <typename T>
+	Geometry::BasicScalarGrid<T> PointCloudDistanceFieldGenerator::Compute(const PointCloudDistanceFieldSettings& settings) const
 	{
 		assert(settings.CellSize > 0.0f);
 		assert(settings.VolumeExpansionFactor >= 0.0f);
 		assert(settings.TruncationFactor > 0);
 
-		pmp::BoundingBox dfBBox(inputPoints);
+		pmp::BoundingBox dfBBox(m_Points);
 		const auto size = dfBBox.max() - dfBBox.min();
 		const float minSize = std::min({ size[0], size[1], size[2] });
 
@@ -584,17 +813,27 @@ namespace SDF
 
 		// percentage of the minimum half-size of the mesh's bounding box.
 		const double truncationValue = (settings.TruncationFactor < Geometry::DEFAULT_SCALAR_GRID_INIT_VAL ? settings.TruncationFactor * (static_cast<double>(minSize) / 2.0) : Geometry::DEFAULT_SCALAR_GRID_INIT_VAL);
-		Geometry::ScalarGrid resultGrid(settings.CellSize, dfBBox, truncationValue);
+		Geometry::BasicScalarGrid<T> resultGrid(settings.CellSize, dfBBox, truncationValue);
 
-		m_Points = inputPoints;
 		PreprocessGridFromPoints(resultGrid);
 
-		if (truncationValue > 0.0)
+		if (truncationValue > 0.0 && settings.DistanceMethod == PointCloudDistanceComputation::ExactNearestPoint)
+		{
+#if REPORT_SDF_STEPS
+			std::cout << "ComputeExactDistancesToPoints ... ";
+#endif
+			ComputeExactDistancesToPoints(resultGrid, truncationValue, settings.NThreads);
+#if REPORT_SDF_STEPS
+			std::cout << "done\n";
+#endif
+		}
+		else if (truncationValue > 0.0)
 		{
 #if REPORT_SDF_STEPS
 			std::cout << "FastSweep ... ";
 #endif
-			constexpr SweepSolverSettings fsSettings{};
+			SweepSolverSettings fsSettings{};
+			fsSettings.NThreads = settings.NThreads;
 			FastSweep(resultGrid, fsSettings);
 #if REPORT_SDF_STEPS
 			std::cout << "done\n";
@@ -607,8 +846,8 @@ namespace SDF
 #if REPORT_SDF_STEPS
 			std::cout << "blurFunction ... ";
 #endif
-			const auto blurFunction = GetBlurFunction(settings.BlurType);
-			blurFunction(resultGrid);
+			const auto blurFunction = GetBlurFunction<T>(settings.BlurType);
+			blurFunction(resultGrid, settings.NThreads);
 #if REPORT_SDF_STEPS
 			std::cout << "done\n";
 #endif
@@ -616,7 +855,60 @@ namespace SDF
 		return resultGrid;
 	}
 
-	void PointCloudDistanceFieldGenerator::PreprocessGridFromPoints(Geometry::ScalarGrid& grid)
+	Geometry::SparseScalarGrid PointCloudDistanceFieldGenerator::GenerateSparse(const std::vector<pmp::vec3>& inputPoints, const PointCloudDistanceFieldSettings& settings)
+	{
+		const PointCloudDistanceFieldGenerator generator(inputPoints);
+		assert(settings.CellSize > 0.0f);
+		assert(settings.VolumeExpansionFactor >= 0.0f);
+		assert(settings.TruncationFactor > 0);
+
+		if (settings.TruncationFactor >= Geometry::DEFAULT_SCALAR_GRID_INIT_VAL)
+			throw std::invalid_argument("PointCloudDistanceFieldGenerator::GenerateSparse: a sparse distance field requires a finite settings.TruncationFactor!\n");
+
+		if (settings.BlurType != BlurPostprocessingType::None)
+			std::cerr << "PointCloudDistanceFieldGenerator::GenerateSparse: blur is not supported for sparse grids! Ignoring.\n";
+
+		pmp::BoundingBox dfBBox(inputPoints);
+		const auto size = dfBBox.max() - dfBBox.min();
+		const float minSize = std::min({ size[0], size[1], size[2] });
+
+		if (settings.VolumeExpansionFactor > 0.0f)
+		{
+			const float expansion = settings.VolumeExpansionFactor * minSize;
+			dfBBox.expand(expansion, expansion, expansion);
+		}
+
+		// percentage of the minimum half-size of the mesh's bounding box.
+		const double truncationValue = settings.TruncationFactor * (static_cast<double>(minSize) / 2.0);
+		Geometry::SparseScalarGrid resultGrid(settings.CellSize, dfBBox, truncationValue);
+
+		generator.PreprocessSparseGridFromPoints(resultGrid);
+		resultGrid.DilateAllocatedBlocks(GetNarrowBandBlockLayerCount(truncationValue, settings.CellSize));
+
+		if (truncationValue > 0.0)
+		{
+#if REPORT_SDF_STEPS
+			std::cout << "FastSweep ... ";
+#endif
+			FastSweep(resultGrid, SweepSolverSettings{});
+#if REPORT_SDF_STEPS
+			std::cout << "done\n";
+#endif
+		}
+		return resultGrid;
+	}
+
+	std::vector<Geometry::ScalarGrid> PointCloudDistanceFieldGenerator::GenerateBatch(
+		const std::vector<std::vector<pmp::vec3>>& inputPointClouds, const std::vector<PointCloudDistanceFieldSettings>& settings, const unsigned int& nThreads)
+	{
+		if (inputPointClouds.size() != settings.size())
+			throw std::invalid_argument("PointCloudDistanceFieldGenerator::GenerateBatch: inputPointClouds.size() != settings.size()!\n");
+
+		return GenerateBatchInternal(inputPointClouds.size(), nThreads, [&](const size_t i) { return Generate(inputPointClouds[i], settings[i]); });
+	}
+
+	template <typename T>
+	void PointCloudDistanceFieldGenerator::PreprocessGridFromPoints(Geometry::BasicScalarGrid<T>& grid) const
 	{
 		if (m_Points.empty())
 		{
@@ -633,17 +925,17 @@ namespace SDF
 		const float gBoxMinZ = gridBox.min()[2];
 
 		const auto& dims = grid.Dimensions();
-		const auto Nx = static_cast<unsigned int>(dims.Nx);
-		const auto Ny = static_cast<unsigned int>(dims.Ny);
-		unsigned int ix, iy, iz, gridPos;
+		const size_t Nx = dims.Nx;
+		const size_t Ny = dims.Ny;
+		size_t ix, iy, iz, gridPos;
 		pmp::vec3 gridPt;
 
 		for (const auto& p : m_Points)
 		{
 			// transform from real space to grid index space
-			ix = static_cast<unsigned int>(std::floor((p[0] - gBoxMinX) / cellSize));
-			iy = static_cast<unsigned int>(std::floor((p[1] - gBoxMinY) / cellSize));
-			iz = static_cast<unsigned int>(std::floor((p[2] - gBoxMinZ) / cellSize));
+			ix = static_cast<size_t>(std::floor((p[0] - gBoxMinX) / cellSize));
+			iy = static_cast<size_t>(std::floor((p[1] - gBoxMinY) / cellSize));
+			iz = static_cast<size_t>(std::floor((p[2] - gBoxMinZ) / cellSize));
 
 			gridPt[0] = gBoxMinX + ix * cellSize;
 			gridPt[1] = gBoxMinY + iy * cellSize;
@@ -656,4 +948,173 @@ namespace SDF
 		}
 	}
 
+	/// \brief a nanoflann dataset adaptor for a point cloud (without copying the points).
+	struct PointCloudKdTreeAdaptor
+	{
+		const std::vector<pmp::vec3>& Points; //>! the adapted point cloud
+
+		[[nodiscard]] size_t kdtree_get_point_count() const
+		{
+			return Points.size();
+		}
+
+		[[nodiscard]] pmp::Scalar kdtree_get_pt(const size_t idx, const size_t dim) const
+		{
+			return Points[idx][static_cast<int>(dim)];
+		}
+
+		template <class BBOX>
+		[[nodiscard]] bool kdtree_get_bbox(BBOX& /* bb */) const
+		{
+			return false; // use nanoflann's bounding box computation
+		}
+	};
+
+	/// \brief a nanoflann kd-tree index of a point cloud.
+	using PointCloudKdTreeIndex = nanoflann::KDTreeSingleIndexAdaptor<
+		nanoflann::L2_Simple_Adaptor<pmp::Scalar, PointCloudKdTreeAdaptor>, PointCloudKdTreeAdaptor, 3 /* dim */>;
+
+	/// \brief the maximum number of points in a leaf of PointCloudKdTreeIndex.
+	constexpr size_t POINT_CLOUD_KD_TREE_MAX_LEAF_SIZE = 10;
+
+	/**
+	 * \brief Finds the nearest point of a point cloud kd-tree index to a query point.
+	 * \param index            kd-tree index of the point cloud.
+	 * \param queryPt          query point coordinates.
+	 * \param nearestPtId      resulting index of the nearest point.
+	 * \param nearestDistSq    resulting squared distance to the nearest point.
+	 * \return true if the nearest point was found.
+	 *
+	 * DISCLAIMER: The vendored nanoflann findNeighbors (and knnSearch) prints debug output for every query, so the tree is searched directly.
+	 */
+	[[nodiscard]] bool FindNearestPoint(const PointCloudKdTreeIndex& index, const pmp::Scalar* queryPt, uint32_t& nearestPtId, pmp::Scalar& nearestDistSq)
+	{
+		if (index.size(index) == 0 || !index.root_node_)
+			return false;
+
+		nanoflann::KNNResultSet<pmp::Scalar, uint32_t> resultSet(1);
+		resultSet.init(&nearestPtId, &nearestDistSq);
+		PointCloudKdTreeIndex::distance_vector_t dists{};
+		const auto initialDist = index.computeInitialDistances(index, queryPt, dists);
+		index.searchLevel(resultSet, queryPt, index.root_node_, initialDist, dists, 1.0f /* exact search */);
+		return resultSet.size() > 0;
+	}
+
+	template <typename T>
+	void PointCloudDistanceFieldGenerator::ComputeExactDistancesToPoints(Geometry::BasicScalarGrid<T>& grid, const double& truncationValue, const unsigned int& nThreads) const
+	{
+		if (m_Points.empty())
+		{
+			std::cerr << "PointCloudDistanceFieldGenerator::ComputeExactDistancesToPoints: m_Points.empty()!\n";
+			return;
+		}
+		auto& gridVals = grid.Values();
+		const float cellSize = grid.CellSize();
+		const auto& orig = grid.Box().min();
+		const auto& [Nx, Ny, Nz] = grid.Dimensions();
+
+		// mark the blocks containing points, and dilate them to cover the truncation band
+		constexpr size_t blockDim = Geometry::SPARSE_BLOCK_DIM;
+		const size_t NBx = (Nx + blockDim - 1) / blockDim, NBy = (Ny + blockDim - 1) / blockDim, NBz = (Nz + blockDim - 1) / blockDim;
+		std::vector<char> pointBlocks(NBx * NBy * NBz, 0);
+		for (const auto& p : m_Points)
+		{
+			const auto ix = std::min(static_cast<size_t>(std::max(std::floor((p[0] - orig[0]) / cellSize), 0.0f)), Nx - 1);
+			const auto iy = std::min(static_cast<size_t>(std::max(std::floor((p[1] - orig[1]) / cellSize), 0.0f)), Ny - 1);
+			const auto iz = std::min(static_cast<size_t>(std::max(std::floor((p[2] - orig[2]) / cellSize), 0.0f)), Nz - 1);
+			pointBlocks[NBx * NBy * (iz / blockDim) + NBx * (iy / blockDim) + ix / blockDim] = 1;
+		}
+
+		const auto nLayers = static_cast<size_t>(std::min(GetNarrowBandBlockLayerCount(truncationValue, cellSize), static_cast<unsigned int>(std::max({ NBx, NBy, NBz }))));
+		std::vector<char> bandBlocks(NBx * NBy * NBz, 0);
+		for (size_t bz = 0; bz < NBz; bz++)
+		{
+			for (size_t by = 0; by < NBy; by++)
+			{
+				for (size_t bx = 0; bx < NBx; bx++)
+				{
+					if (!pointBlocks[NBx * NBy * bz + NBx * by + bx])
+						continue;
+
+					const size_t bzMin = (bz > nLayers ? bz - nLayers : 0), bzMax = std::min(bz + nLayers, NBz - 1);
+					const size_t byMin = (by > nLayers ? by - nLayers : 0), byMax = std::min(by + nLayers, NBy - 1);
+					const size_t bxMin = (bx > nLayers ? bx - nLayers : 0), bxMax = std::min(bx + nLayers, NBx - 1);
+					for (size_t nbz = bzMin; nbz <= bzMax; nbz++)
+						for (size_t nby = byMin; nby <= byMax; nby++)
+							for (size_t nbx = bxMin; nbx <= bxMax; nbx++)
+								bandBlocks[NBx * NBy * nbz + NBx * nby + nbx] = 1;
+				}
+			}
+		}
+
+		// the index is built once, and queried concurrently (queries do not modify it)
+		const PointCloudKdTreeAdaptor pointsAdaptor{ m_Points };
+		const PointCloudKdTreeIndex kdTreeIndex(3 /* dim */, pointsAdaptor, { POINT_CLOUD_KD_TREE_MAX_LEAF_SIZE });
+
+		Utils::ParallelForChunks(0, Nz, nThreads, [&](const size_t izStart, const size_t izEnd, [[maybe_unused]] const unsigned int threadId)
+		{
+			uint32_t nearestPtId = 0;
+			pmp::Scalar nearestDistSq = 0.0f;
+			for (size_t iz = izStart; iz < izEnd; iz++)
+			{
+				for (size_t iy = 0; iy < Ny; iy++)
+				{
+					for (size_t ix = 0; ix < Nx; ix++)
+					{
+						if (!bandBlocks[NBx * NBy * (iz / blockDim) + NBx * (iy / blockDim) + ix / blockDim])
+							continue;
+
+						// grid points are evaluated at voxel corners (as in PreprocessGridFromPoints)
+						const pmp::vec3 gridPt{
+							orig[0] + static_cast<float>(ix) * cellSize,
+							orig[1] + static_cast<float>(iy) * cellSize,
+							orig[2] + static_cast<float>(iz) * cellSize
+						};
+						if (!FindNearestPoint(kdTreeIndex, gridPt.data(), nearestPtId, nearestDistSq))
+							continue;
+
+						const double nearestDist = norm(pmp::dvec3(gridPt) - pmp::dvec3(m_Points[nearestPtId]));
+						const size_t gridPos = Nx * Ny * iz + Nx * iy + ix;
+						gridVals[gridPos] = static_cast<T>(std::min(nearestDist, truncationValue));
+					}
+				}
+			}
+		});
+	}
+
+	void PointCloudDistanceFieldGenerator::PreprocessSparseGridFromPoints(Geometry::SparseScalarGrid& grid) const
+	{
+		if (m_Points.empty())
+		{
+			std::cerr << "PointCloudDistanceFieldGenerator::PreprocessSparseGridFromPoints: m_Points.empty()!\n";
+			return;
+		}
+		const float cellSize = grid.CellSize();
+
+		const auto& gridBox = grid.Box();
+		const float gBoxMinX = gridBox.min()[0];
+		const float gBoxMinY = gridBox.min()[1];
+		const float gBoxMinZ = gridBox.min()[2];
+
+		[[maybe_unused]] const auto& dims = grid.Dimensions();
+		size_t ix, iy, iz;
+		pmp::vec3 gridPt;
+
+		for (const auto& p : m_Points)
+		{
+			// transform from real space to grid index space
+			ix = static_cast<size_t>(std::floor((p[0] - gBoxMinX) / cellSize));
+			iy = static_cast<size_t>(std::floor((p[1] - gBoxMinY) / cellSize));
+			iz = static_cast<size_t>(std::floor((p[2] - gBoxMinZ) / cellSize));
+			assert(ix < dims.Nx && iy < dims.Ny && iz < dims.Nz);
+
+			gridPt[0] = gBoxMinX + ix * cellSize;
+			gridPt[1] = gBoxMinY + iy * cellSize;
+			gridPt[2] = gBoxMinZ + iz * cellSize;
+
+			grid.SetValue(ix, iy, iz, norm(gridPt - p));
+			grid.SetFrozen(ix, iy, iz, true); // freeze initial condition for FastSweep
+		}
+	}
+
 } // namespace SDF
\ No newline at end of file
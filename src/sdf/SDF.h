@@ -2,6 +2,8 @@
 
 #include "geometry/CollisionKdTree.h"
 #include "geometry/Grid.h"
+#include "geometry/MappedScalarGrid.h"
+#include "geometry/SparseGrid.h"
 #include "pmp/SurfaceMesh.h"
 
 namespace SDF
@@ -17,17 +19,25 @@ namespace SDF
 	enum class [[nodiscard]] KDTreeSplitType
 	{
 		Center = 0, // simplest split function is chosen, evaluates the split position to box center
-		Adaptive = 1 // a more robust split function, adaptively re-samples the kd-node's box according to triangle distribution within.
+		Adaptive = 1, // a more robust split function, adaptively re-samples the kd-node's box according to triangle distribution within.
+		SAH = 2 // binned surface area heuristic, nodes whose split does not pay off become leaves.
 	};
 
 	/// \brief enumerator for the approach to the computation of sign of the distance field to a mesh (negative inside, positive outside).
 	enum class [[nodiscard]] SignComputation
 	{
 		None = 0, //>! no sign for the distance field is to be computed.
-		VoxelFloodFill = 1, //>! negate and apply recursive flood-fill algorithm for non-frozen voxels.
+		VoxelFloodFill = 1, //>! negate all voxels not reached by a scanline flood-fill of non-frozen voxels.
 		RayFromAHoleFilledMesh = 2 //>! compute distance field to a mesh after applying a pmp::HoleFilling, then all voxels whose outgoing ray intersects the mesh are interior.
 	};
 
+	/// \brief enumerator for the approach to the computation of distance values outside of the mesh outline voxels.
+	enum class [[nodiscard]] DistanceComputation
+	{
+		FastSweep = 0, //>! solve the Eikonal equation from the outline voxels using FastSweep (first-order accurate).
+		ClosestTrianglePropagation = 1 //>! propagate the closest triangles of the outline voxels by jump flooding, and evaluate exact point-triangle distances.
+	};
+
 	/// \brief enumerator for which type of blur filter to apply after the distance field is completed.
 	enum class [[nodiscard]] BlurPostprocessingType
 	{
@@ -48,20 +58,32 @@ namespace SDF
 		SignComputation SignMethod{ SignComputation::None }; //>! method by which the sign of the distance field should be computed.
 		BlurPostprocessingType BlurType{ BlurPostprocessingType::None }; //>! type of blur filter to be used for post-processing.
 		PreprocessingType PreprocType{ PreprocessingType::Octree }; //>! function type for the preprocessing of distance field scalar grid.
+		unsigned int NThreads{ 1 }; //>! the number of worker threads for the parallelized stages of the pipeline. NThreads == 0 uses all hardware threads.
+		DistanceComputation DistanceMethod{ DistanceComputation::FastSweep }; //>! method by which distance values outside of the outline voxels are computed (ignored by GenerateSparse).
 	};
 
+	/// \brief a functor for computing the sign of the distance field with value type T using a given number of worker threads.
+	template <typename T>
+	using BasicSignFunction = std::function<void(Geometry::BasicScalarGrid<T>&, const unsigned int&)> const;
+
 	/// \brief a functor for computing the sign of the distance field.
-	using SignFunction = std::function<void(Geometry::ScalarGrid&)> const;
+	using SignFunction = BasicSignFunction<double>;
+
+	/// \brief a functor for preprocessing the scalar grid for distance field with value type T using a given number of worker threads.
+	template <typename T>
+	using BasicPreprocessingFunction = std::function<void(Geometry::BasicScalarGrid<T>&, const unsigned int&)>;
 
-	/// \brief a functor for preprocessing the scalar grid for distance field.
-	using PreprocessingFunction = std::function<void(Geometry::ScalarGrid&)>;
+	/// \brief a functor for preprocessing the scalar grid for distance field using a given number of worker threads.
+	using PreprocessingFunction = BasicPreprocessingFunction<double>;
 
-	/// \brief A singleton object for computing distance fields to triangle meshes.
+	/**
+	 * \brief An object for computing distance fields to triangle meshes.
+	 *        Each call of Generate (or GenerateSparse) uses its own generator instance holding the mesh and its kd-tree,
+	 *        so that multiple distance fields can be computed concurrently.
+	 */
 	class DistanceFieldGenerator
 	{
 	public:
-		/// \brief a deleted default constructor because m_KdTree is not default-constructable.
-		DistanceFieldGenerator() = delete;
 
 		/**
 		 * \brief Compute the signed distance field of given input mesh.
@@ -70,42 +92,156 @@ namespace SDF
 		 * \return the computed distance field's ScalarGrid.
 		 */
 		static [[nodiscard]] Geometry::ScalarGrid Generate(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings);
+
+		/**
+		 * \brief Compute the signed distance field of given input mesh stored in single precision.
+		 *        The pipeline is the same as for Generate, but the grid takes up half the memory.
+		 * \param inputMesh               an adapter for the evaluated mesh.
+		 * \param settings                settings for the distance field.
+		 * \return the computed distance field's ScalarGridF.
+		 *
+		 * DISCLAIMER: Distances are evaluated in double precision and stored as float, so the result differs from Generate by float rounding errors (~1e-7 relative).
+		 */
+		static [[nodiscard]] Geometry::ScalarGridF GenerateSinglePrecision(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings);
+
+		/**
+		 * \brief Compute the (unsigned) narrow-band distance field of given input mesh stored in a sparse grid.
+		 *        Only blocks within the truncation distance from the mesh are allocated, and the remaining voxels have the truncation value.
+		 * \param inputMesh               an adapter for the evaluated mesh.
+		 * \param settings                settings for the distance field.
+		 * \return the computed distance field's SparseScalarGrid.
+		 *
+		 * \throw std::invalid_argument if settings.TruncationFactor does not give rise to a finite truncation value.
+		 *
+		 * DISCLAIMER: The mesh outline is always preprocessed using an OctreeVoxelizer (settings.PreprocType is ignored). Sign computation and blur post-processing
+		 *             are not supported for sparse grids, so settings.SignMethod and settings.BlurType are ignored.
+		 */
+		static [[nodiscard]] Geometry::SparseScalarGrid GenerateSparse(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings);
+
+		/**
+		 * \brief Compute the signed distance field of given input mesh out of core: the field is stored in single precision in a memory-mapped file,
+		 *        and computed in z-slabs of nSlabLayers layers, so that only a single slab (with its halo layers) is held in RAM.
+		 * \param inputMesh               an adapter for the evaluated mesh.
+		 * \param settings                settings for the distance field.
+		 * \param filePath                path of the file backing the resulting grid values (an existing file is overwritten).
+		 * \param nSlabLayers             the number of z-layers of the resulting grid computed at a time.
+		 * \return the computed distance field's MappedScalarGridF.
+		 *
+		 * \throw std::invalid_argument if settings.TruncationFactor does not give rise to a finite truncation value, if settings.SignMethod is SignComputation::VoxelFloodFill,
+		 *        or if nSlabLayers == 0.
+		 * \throw std::runtime_error if the file mapping could not be created.
+		 *
+		 * DISCLAIMER: Each slab is extended by halo layers covering the truncation band (and the blur kernel), so the outline voxels reaching its own layers are found within the slab.
+		 *             The mesh outline is always preprocessed without an OctreeVoxelizer (settings.PreprocType is ignored), since an octree would span the whole mesh for every slab.
+		 *             The values match GenerateSinglePrecision up to float rounding (~1e-6 relative), except for DistanceComputation::ClosestTrianglePropagation,
+		 *             whose jump flooding steps depend on the slab's extent, and may deliver a different (near-closest) triangle in rare voxels.
+		 */
+		static [[nodiscard]] Geometry::MappedScalarGridF GenerateOutOfCore(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings, const std::string& filePath, const size_t& nSlabLayers);
+
+		/**
+		 * \brief Compute the distance fields of multiple input meshes concurrently.
+		 * \param inputMeshes             adapters for the evaluated meshes.
+		 * \param settings                settings for each distance field (one item per mesh).
+		 * \param nThreads                the number of distance fields computed at the same time. Zero means "use all hardware threads".
+		 * \return the computed distance fields' ScalarGrids in the order of inputMeshes.
+		 *
+		 * \throw std::invalid_argument if inputMeshes and settings differ in size, or if a mesh adapter is null.
+		 *
+		 * DISCLAIMER: settings[i].NThreads worker threads are used within each distance field, so settings[i].NThreads == 1 is recommended for large batches.
+		 *             If any of the fields fails, the first exception is rethrown after all fields are processed.
+		 */
+		static [[nodiscard]] std::vector<Geometry::ScalarGrid> GenerateBatch(
+			const std::vector<const Geometry::MeshAdapter*>& inputMeshes, const std::vector<DistanceFieldSettings>& settings, const unsigned int& nThreads);
 		
 	private:
-		inline static std::unique_ptr<Geometry::MeshAdapter> m_Mesh{ nullptr }; //>! mesh to be (pre)processed.
-		inline static std::unique_ptr<Geometry::CollisionKdTree> m_KdTree{ nullptr }; //>! mesh kd tree.
+		/// \brief a private default constructor. Generator instances are created by Generate functions only.
+		DistanceFieldGenerator() = default;
+
+		/// \brief the Generate function body for this generator instance, computing a grid with value type T.
+		template <typename T>
+		[[nodiscard]] Geometry::BasicScalarGrid<T> Compute(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings);
+
+		/// \brief the GenerateSparse function body for this generator instance.
+		[[nodiscard]] Geometry::SparseScalarGrid ComputeSparse(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings);
+
+		/// \brief the GenerateOutOfCore function body for this generator instance.
+		[[nodiscard]] Geometry::MappedScalarGridF ComputeOutOfCore(const Geometry::MeshAdapter& inputMesh, const DistanceFieldSettings& settings, const std::string& filePath, const size_t& nSlabLayers);
+
+		/**
+		 * \brief Computes the distance values of a grid initialized to truncationValue: preprocessing, distance computation, sign and blur according to settings.
+		 * \param grid               modifiable input grid.
+		 * \param settings           settings for the distance field.
+		 * \param preprocType        preprocessing type identifier.
+		 * \param truncationValue    truncation value of the distance field.
+		 */
+		template <typename T>
+		void ComputeGridValues(Geometry::BasicScalarGrid<T>& grid, const DistanceFieldSettings& settings, const PreprocessingType& preprocType, const double& truncationValue);
+
+		std::unique_ptr<Geometry::MeshAdapter> m_Mesh{ nullptr }; //>! mesh to be (pre)processed.
+		std::unique_ptr<Geometry::CollisionKdTree> m_KdTree{ nullptr }; //>! mesh kd tree.
 
 		/**
 		 * \brief provides the SignFunction, a function from this generator's private interface that computes the sign of the distance field.
 		 * \param signCompType      sign computation function type identifier.
 		 * \return the sign function identified by signCompType.
 		 */
-		static [[nodiscard]] SignFunction GetSignFunction(const SignComputation& signCompType);
+		template <typename T>
+		[[nodiscard]] BasicSignFunction<T> GetSignFunction(const SignComputation& signCompType);
 
 		/**
 		 * \brief Provides a preprocessing functor according to the given setting.
 		 * \param preprocType      preprocessing type identifier.
 		 * \return the preprocessing function identified by preprocType.
 		 */
-		static [[nodiscard]] PreprocessingFunction GetPreprocessingFunction(const PreprocessingType& preprocType);
+		template <typename T>
+		[[nodiscard]] BasicPreprocessingFunction<T> GetPreprocessingFunction(const PreprocessingType& preprocType);
 
 		/**
 		 * \brief A preprocessing approach for distance grid using CollisionKdTree to create "voxel outline" of inputMesh.
+		 *        Voxels intersected by a triangle are frozen with the exact distance from their centers to the mesh (a batched closest triangle query).
 		 * \param grid         modifiable input grid.
+		 * \param nThreads     the number of worker threads processing z-slabs of the grid.
 		 */
-		static void PreprocessGridNoOctree(Geometry::ScalarGrid& grid);
+		template <typename T>
+		void PreprocessGridNoOctree(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) const;
 
 		/**
 		 * \brief A preprocessing approach for distance grid using CollisionKdTree and OctreeVoxelizer to create "voxel outline" of inputMesh.
 		 * \param grid         modifiable input grid.
+		 * \param nThreads     the number of worker threads building the octree's subtrees.
+		 */
+		template <typename T>
+		void PreprocessGridWithOctree(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) const;
+
+		/**
+		 * \brief A preprocessing approach for sparse distance grid using CollisionKdTree and OctreeVoxelizer to create "voxel outline" of inputMesh.
+		 * \param grid         modifiable input sparse grid.
+		 * \param nThreads     the number of worker threads building the octree's subtrees.
+		 */
+		void PreprocessSparseGridWithOctree(Geometry::SparseScalarGrid& grid, const unsigned int& nThreads) const;
+
+		/**
+		 * \brief computes sign of the distance field by a flood-fill of non-frozen voxels from the grid's corner. All voxels not reached by the flood are negated.
+		 * \param grid         modifiable input grid.
+		 * \param nThreads     the number of worker threads (z-slabs) of the flood fill.
 		 */
-		static void PreprocessGridWithOctree(Geometry::ScalarGrid& grid);
+		template <typename T>
+		static void ComputeSignUsingFloodFill(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads);
 
-		/// \brief computes sign of the distance field by negating and applying a recursive flood-fill algorithm for non-frozen voxels.
-		static void ComputeSignUsingFloodFill(Geometry::ScalarGrid& grid);
+		/**
+		 * \brief after applying a pmp::HoleFilling, then all voxels whose outgoing ray intersects the mesh are interior.
+		 * \param grid         modifiable input grid.
+		 * \param nThreads     the number of worker threads (z-slabs of grid rows). Each row is resolved by a single ray traversal.
+		 */
+		template <typename T>
+		void ComputeSignUsingRays(Geometry::BasicScalarGrid<T>& grid, const unsigned int& nThreads) const;
+	};
 
-		/// \brief after applying a pmp::HoleFilling, then all voxels whose outgoing ray intersects the mesh are interior.
-		static void ComputeSignUsingRays(Geometry::ScalarGrid& grid);
+	/// \brief enumerator for the approach to the computation of point cloud distance values outside of the voxels containing points.
+	enum class [[nodiscard]] PointCloudDistanceComputation
+	{
+		FastSweep = 0, //>! solve the Eikonal equation from the voxels containing points using FastSweep (first-order accurate).
+		ExactNearestPoint = 1 //>! evaluate exact distances to the nearest point (found in a nanoflann kd-tree) for all voxels within the truncation band.
 	};
 
 	/// \brief A wrapper for input settings for computing distance field.
@@ -115,14 +251,18 @@ namespace SDF
 		float VolumeExpansionFactor{ 1.0f }; //>! expansion factor (how many times the minimum dimension of the point cloud's bounding box) for the resulting scalar grid volume.
 		double TruncationFactor{ 0.1 }; //>! factor by which the minimum half-dimension of point cloud's bounding box gives rise to a truncation (cutoff) value for the distance field.
 		BlurPostprocessingType BlurType{ BlurPostprocessingType::None }; //>! type of blur filter to be used for post-processing.
+		unsigned int NThreads{ 1 }; //>! the number of worker threads for the parallelized stages of the pipeline. NThreads == 0 uses all hardware threads.
+		PointCloudDistanceComputation DistanceMethod{ PointCloudDistanceComputation::FastSweep }; //>! method by which distance values outside of the voxels containing points are computed (ignored by GenerateSparse).
 	};
 
-	/// \brief A singleton object for computing distance fields to point clouds.
+	/**
+	 * \brief An object for computing distance fields to point clouds.
+	 *        Each call of Generate (or GenerateSparse) uses its own generator instance referencing the input points,
+	 *        so that multiple distance fields can be computed concurrently.
+	 */
 	class PointCloudDistanceFieldGenerator
 	{
 	public:
-		/// \brief a deleted default constructor because m_KdTree is not default-constructable.
-		PointCloudDistanceFieldGenerator() = delete;
 
 		/**
 		 * \brief Compute the signed distance field of given input point cloud.
@@ -132,19 +272,88 @@ namespace SDF
 		 */
 		static [[nodiscard]] Geometry::ScalarGrid Generate(const std::vector<pmp::vec3>& inputPoints, const PointCloudDistanceFieldSettings& settings);
 
+		/**
+		 * \brief Compute the signed distance field of given input point cloud stored in single precision.
+		 * \param inputPoints             evaluated point cloud.
+		 * \param settings                settings for the distance field.
+		 * \return the computed distance field's ScalarGridF.
+		 *
+		 * DISCLAIMER: Distances are evaluated in double precision and stored as float, so the result differs from Generate by float rounding errors (~1e-7 relative).
+		 */
+		static [[nodiscard]] Geometry::ScalarGridF GenerateSinglePrecision(const std::vector<pmp::vec3>& inputPoints, const PointCloudDistanceFieldSettings& settings);
+
+		/**
+		 * \brief Compute the narrow-band distance field of given input point cloud stored in a sparse grid.
+		 *        Only blocks within the truncation distance from the points are allocated, and the remaining voxels have the truncation value.
+		 * \param inputPoints             evaluated point cloud.
+		 * \param settings                settings for the distance field.
+		 * \return the computed distance field's SparseScalarGrid.
+		 *
+		 * \throw std::invalid_argument if settings.TruncationFactor does not give rise to a finite truncation value.
+		 *
+		 * DISCLAIMER: Blur post-processing is not supported for sparse grids, so settings.BlurType is ignored.
+		 */
+		static [[nodiscard]] Geometry::SparseScalarGrid GenerateSparse(const std::vector<pmp::vec3>& inputPoints, const PointCloudDistanceFieldSettings& settings);
+
+		/**
+		 * \brief Compute the distance fields of multiple input point clouds concurrently.
+		 * \param inputPointClouds        evaluated point clouds.
+		 * \param settings                settings for each distance field (one item per point cloud).
+		 * \param nThreads                the number of distance fields computed at the same time. Zero means "use all hardware threads".
+		 * \return the computed distance fields' ScalarGrids in the order of inputPointClouds.
+		 *
+		 * \throw std::invalid_argument if inputPointClouds and settings differ in size.
+		 *
+		 * DISCLAIMER: settings[i].NThreads worker threads are used within each distance field, so settings[i].NThreads == 1 is recommended for large batches.
+		 *             If any of the fields fails, the first exception is rethrown after all fields are processed.
+		 */
+		static [[nodiscard]] std::vector<Geometry::ScalarGrid> GenerateBatch(
+			const std::vector<std::vector<pmp::vec3>>& inputPointClouds, const std::vector<PointCloudDistanceFieldSettings>& settings, const unsigned int& nThreads);
+
 	private:
+		/**
+		 * \brief Constructor. Generator instances are created by Generate functions only.
+		 * \param inputPoints             evaluated point cloud (needs to outlive this generator).
+		 */
+		explicit PointCloudDistanceFieldGenerator(const std::vector<pmp::vec3>& inputPoints)
+			: m_Points(inputPoints)
+		{
+		}
+
+		/// \brief the Generate function body for this generator instance, computing a grid with value type T.
+		template <typename T>
+		[[nodiscard]] Geometry::BasicScalarGrid<T> Compute(const PointCloudDistanceFieldSettings& settings) const;
 
 		/**
 		 * \brief A preprocessing approach for distance grid using nearest neighbor approximation
 		 * \param grid         modifiable input grid.
 		 */
-		static void PreprocessGridFromPoints(Geometry::ScalarGrid& grid);
+		template <typename T>
+		void PreprocessGridFromPoints(Geometry::BasicScalarGrid<T>& grid) const;
+
+		/**
+		 * \brief Evaluates exact distances to the nearest points for all voxels within truncationValue from the points.
+		 *        A nanoflann kd-tree of the points is built once, and the voxels of the truncation band are queried in parallel.
+		 * \param grid               modifiable input grid (voxels outside of the band keep their values).
+		 * \param truncationValue    truncation value of the distance field (distances are clamped to this value).
+		 * \param nThreads           the number of worker threads (z-slabs).
+		 *
+		 * DISCLAIMER: The band consists of grid blocks of Geometry::SPARSE_BLOCK_DIM^3 voxels within truncationValue from the blocks containing points.
+		 */
+		template <typename T>
+		void ComputeExactDistancesToPoints(Geometry::BasicScalarGrid<T>& grid, const double& truncationValue, const unsigned int& nThreads) const;
+
+		/**
+		 * \brief A preprocessing approach for sparse distance grid using nearest neighbor approximation
+		 * \param grid         modifiable input sparse grid.
+		 */
+		void PreprocessSparseGridFromPoints(Geometry::SparseScalarGrid& grid) const;
 
 		//
 		// ===================================================
 		//
 
-		inline static std::vector<pmp::vec3> m_Points{}; //>! the input point cloud
+		const std::vector<pmp::vec3>& m_Points; //>! the input point cloud
 	};
 
 	/**
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Utils
+{
+	/**
+	 * \brief Resolves the number of worker threads to be used.
+	 * \param nRequestedThreads    requested number of threads. Zero means "use all hardware threads".
+	 * \return the number of worker threads (at least 1).
+	 */
+	[[nodiscard]] inline unsigned int GetWorkerThreadCount(const unsigned int& nRequestedThreads)
+	{
+		if (nRequestedThreads > 0)
+			return nRequestedThreads;
+
+		const unsigned int nHardwareThreads = std::thread::hardware_concurrency();
+		return nHardwareThreads > 0 ? nHardwareThreads : 1;
+	}
+
+	/// \brief a functor processing index range [chunkStart, chunkEnd) on thread with index threadId.
+	using ChunkFunction = std::function<void(size_t /* chunkStart */, size_t /* chunkEnd */, unsigned int /* threadId */)>;
+
+	/**
+	 * \brief Splits index range [begin, end) into contiguous chunks, and processes each chunk on its own std::thread.
+	 * \param begin          start of the processed range.
+	 * \param end            end of the processed range (exclusive).
+	 * \param nThreads       number of worker threads. Zero means "use all hardware threads".
+	 * \param chunkFunc      chunk processing functor.
+	 *
+	 * DISCLAIMER: For nThreads == 1 (or a range shorter than the thread count) the chunks are processed on the calling thread.
+	 */
+	inline void ParallelForChunks(const size_t& begin, const size_t& end, const unsigned int& nThreads, const ChunkFunction& chunkFunc)
+	{
+		if (end <= begin)
+			return;
+
+		const size_t rangeSize = end - begin;
+		const size_t threadCount = std::min(static_cast<size_t>(GetWorkerThreadCount(nThreads)), rangeSize);
+		if (threadCount <= 1)
+		{
+			chunkFunc(begin, end, 0);
+			return;
+		}
+
+		const size_t chunkSize = rangeSize / threadCount;
+		const size_t remainder = rangeSize % threadCount;
+		std::vector<std::thread> threads(threadCount);
+		size_t chunkStart = begin;
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			const size_t chunkEnd = chunkStart + chunkSize + (i < remainder ? 1 : 0);
+			threads[i] = std::thread(chunkFunc, chunkStart, chunkEnd, static_cast<unsigned int>(i));
+			chunkStart = chunkEnd;
+		}
+
+		// Wait for all threads to finish
+		for (auto& t : threads) {
+			t.join();
+		}
+	}
+
+	/// \brief a functor processing a single index on thread with index threadId.
+	using IndexFunction = std::function<void(size_t /* index */, unsigned int /* threadId */)>;
+
+	/**
+	 * \brief Processes each index of range [begin, end) on a set of std::threads. Each thread fetches the next unprocessed index when it is done with the previous one,
+	 *        which balances the load for tasks of very different cost (e.g.: octree subtrees).
+	 * \param begin          start of the processed range.
+	 * \param end            end of the processed range (exclusive).
+	 * \param nThreads       number of worker threads. Zero means "use all hardware threads".
+	 * \param indexFunc      index processing functor.
+	 *
+	 * DISCLAIMER: For nThreads == 1 the indices are processed in order on the calling thread.
+	 */
+	inline void ParallelForEachIndex(const size_t& begin, const size_t& end, const unsigned int& nThreads, const IndexFunction& indexFunc)
+	{
+		if (end <= begin)
+			return;
+
+		const size_t threadCount = std::min(static_cast<size_t>(GetWorkerThreadCount(nThreads)), end - begin);
+		if (threadCount <= 1)
+		{
+			for (size_t i = begin; i < end; ++i)
+				indexFunc(i, 0);
+			return;
+		}
+
+		std::atomic<size_t> nextIndex{ begin };
+		const auto worker = [&](const unsigned int threadId)
+		{
+			for (size_t i = nextIndex++; i < end; i = nextIndex++)
+				indexFunc(i, threadId);
+		};
+
+		std::vector<std::thread> threads(threadCount);
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			threads[i] = std::thread(worker, static_cast<unsigned int>(i));
+		}
+
+		// Wait for all threads to finish
+		for (auto& t : threads) {
+			t.join();
+		}
+	}
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "WritableFileMappingWrapper.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace Utils
+{
+	WritableFileMappingWrapper::WritableFileMappingWrapper(const std::string& filePath, const size_t& fileSize)
+	{
+		CreateMappedFile(filePath, fileSize);
+	}
+
+	WritableFileMappingWrapper::~WritableFileMappingWrapper()
+	{
+		if (m_FileMemory) UnmapViewOfFile(m_FileMemory);
+		if (m_FileMapping) CloseHandle(m_FileMapping);
+		if (m_FileHandle != INVALID_HANDLE_VALUE) CloseHandle(m_FileHandle);
+	}
+
+	char* WritableFileMappingWrapper::GetFileMemory() const
+	{
+		return static_cast<char*>(m_FileMemory);
+	}
+
+	size_t WritableFileMappingWrapper::GetFileSize() const
+	{
+		return static_cast<size_t>(m_FileSize.QuadPart);
+	}
+
+	void WritableFileMappingWrapper::Flush(const size_t& offset, const size_t& size) const
+	{
+		if (!IsValid() || offset >= GetFileSize())
+			return;
+
+		const size_t flushedSize = (size == 0 ? GetFileSize() - offset : std::min(size, GetFileSize() - offset));
+		if (!FlushViewOfFile(GetFileMemory() + offset, flushedSize))
+			std::cerr << "WritableFileMappingWrapper::Flush: Failed to flush view of file.";
+	}
+
+	void WritableFileMappingWrapper::CreateMappedFile(const std::string& filePath, const size_t& fileSize)
+	{
+		// Create the file with GENERIC_READ | GENERIC_WRITE access (no sharing while it is being written).
+		m_FileHandle = CreateFile(filePath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_FileHandle == INVALID_HANDLE_VALUE)
+		{
+			std::cerr << "WritableFileMappingWrapper::CreateMappedFile: Failed to create file.";
+			return;
+		}
+
+		// The file mapping object extends the file to its maximum size.
+		m_FileSize.QuadPart = static_cast<LONGLONG>(fileSize);
+		m_FileMapping = CreateFileMapping(m_FileHandle, nullptr, PAGE_READWRITE, m_FileSize.HighPart, m_FileSize.LowPart, nullptr);
+		if (!m_FileMapping)
+		{
+			CloseHandle(m_FileHandle);
+			m_FileHandle = INVALID_HANDLE_VALUE;
+			std::cerr << "WritableFileMappingWrapper::CreateMappedFile: Failed to create file mapping.";
+			return;
+		}
+
+		// Map a writable view of the whole file into the address space of the calling process.
+		m_FileMemory = MapViewOfFile(m_FileMapping, FILE_MAP_WRITE, 0, 0, 0);
+		if (!m_FileMemory)
+		{
+			CloseHandle(m_FileMapping);
+			CloseHandle(m_FileHandle);
+			m_FileMapping = nullptr;
+			m_FileHandle = INVALID_HANDLE_VALUE;
+			std::cerr << "WritableFileMappingWrapper::CreateMappedFile: Failed to map view of file.";
+		}
+	}
+
+} // namespace Utils
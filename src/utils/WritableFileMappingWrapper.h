@@ -0,0 +1,61 @@
+#pragma once
+
+#ifdef _WINDOWS
+// Windows-specific headers
+#include <windows.h>
+#include <fcntl.h>
+#else
+// Unsupported platform
+#error "Unsupported platform"
+#endif
+
+#include <string>
+
+namespace Utils
+{
+    /// ==================================================================
+    /// \brief A read-write file mapping of a fixed size. The file is created (or overwritten) by the constructor,
+    ///        and the mapped memory is written back to the file by the operating system as its pages are evicted or flushed.
+    /// \class WritableFileMappingWrapper
+    /// ==================================================================
+    class WritableFileMappingWrapper
+    {
+    public:
+        /**
+         * \brief Constructor. Creates a file of the given size and maps it into the address space of this process.
+         * \param filePath    path of the created file (an existing file is overwritten).
+         * \param fileSize    size of the created file in bytes.
+         */
+        WritableFileMappingWrapper(const std::string& filePath, const size_t& fileSize);
+
+        ~WritableFileMappingWrapper();
+
+        WritableFileMappingWrapper(const WritableFileMappingWrapper&) = delete;
+        WritableFileMappingWrapper& operator=(const WritableFileMappingWrapper&) = delete;
+
+        [[nodiscard]] bool IsValid() const
+        {
+            return m_FileHandle != INVALID_HANDLE_VALUE && m_FileMapping && m_FileMemory;
+        }
+
+        [[nodiscard]] char* GetFileMemory() const;
+
+        [[nodiscard]] size_t GetFileSize() const;
+
+        /**
+         * \brief Writes the modified pages of the byte range [offset, offset + size) back to the file.
+         * \param offset    start of the flushed range in bytes.
+         * \param size      size of the flushed range in bytes. Zero means "until the end of the file".
+         */
+        void Flush(const size_t& offset = 0, const size_t& size = 0) const;
+
+    private:
+        void CreateMappedFile(const std::string& filePath, const size_t& fileSize);
+
+        HANDLE m_FileHandle = INVALID_HANDLE_VALUE;
+        HANDLE m_FileMapping = nullptr;
+        LPVOID m_FileMemory = nullptr;
+        LARGE_INTEGER m_FileSize{};
+    };
+
+} // namespace Utils